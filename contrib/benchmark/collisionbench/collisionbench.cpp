@@ -0,0 +1,349 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// Collision and navigation micro-benchmark: replays a corpus of terrain height, liquid, line of sight
+/// and path queries recorded by mangosd (CollisionQueryLog.File) against extracted map, vmap and mmap
+/// data, and reports ns per query and percentiles for each query type. All tiles used by the corpus are
+/// loaded before measuring, so only the query cost is measured.
+
+#include "LatencyStats.h"
+
+#include "Chat/Chat.h"
+#include "Database/DatabaseEnv.h"
+#include "Maps/CollisionQueryLog.h"
+#include "Maps/GridDefines.h"
+#include "Maps/GridMap.h"
+#include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/MoveMapSharedDefines.h"
+#include "Vmap/IVMapManager.h"
+#include "Vmap/VMapFactory.h"
+#include "World/World.h"
+
+#include <Detour/Include/DetourNavMeshQuery.h>
+
+#include <boost/program_options.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+// game library is linked without the server, its database accessors are never used here
+DatabaseType WorldDatabase;
+DatabaseType CharacterDatabase;
+DatabaseType LoginDatabase;
+DatabaseType LogsDatabase;
+uint32 realmID = 0;
+
+// console commands are implemented by the server executable, never called here
+bool ChatHandler::HandleAccountCreateCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleAccountDeleteCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleAccountOnlineListCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleCharacterDeletedDeleteCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleCharacterDeletedListCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleCharacterDeletedOldCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleCharacterDeletedRestoreCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleCharacterEraseCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleQuitCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleServerExitCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleServerLogFilterCommand(char* /*args*/) { return false; }
+bool ChatHandler::HandleServerLogLevelCommand(char* /*args*/) { return false; }
+
+using namespace Benchmark;
+
+static char const* s_queryNames[MAX_COLLISION_QUERY_TYPE] = { "los", "height", "liquid", "path" };
+
+#define PATH_POLY_LIMIT     (74 * 4)                        // PathFinder limit for long paths
+#define PATH_POINT_LIMIT    74
+
+static bool LoadCorpus(std::string const& fileName, std::vector<CollisionQueryRecord>& records)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    uint32 magic = 0;
+    if (fread(&magic, sizeof(magic), 1, file) != 1 || magic != COLLISION_QUERY_LOG_MAGIC)
+    {
+        fclose(file);
+        return false;
+    }
+
+    CollisionQueryRecord record;
+    while (fread(&record, sizeof(record), 1, file) == 1)
+        if (record.type < MAX_COLLISION_QUERY_TYPE)
+            records.push_back(record);
+
+    fclose(file);
+    return true;
+}
+
+static int GetGridCoord(float c)
+{
+    return int(32 - c / SIZE_OF_GRIDS);
+}
+
+/// Replays path queries like PathFinder::BuildPolyPath and BuildPointPath with the player filter
+class PathReplayer
+{
+    public:
+        PathReplayer()
+        {
+            m_filter.setIncludeFlags(NAV_GROUND | NAV_WATER);
+            m_filter.setExcludeFlags(0);
+        }
+
+        uint32 Replay(dtNavMeshQuery const* query, CollisionQueryRecord const& record)
+        {
+            float start[3] = { record.start[1], record.start[2], record.start[0] };
+            float end[3] = { record.end[1], record.end[2], record.end[0] };
+
+            dtPolyRef startRef = FindNearestPoly(query, start);
+            dtPolyRef endRef = FindNearestPoly(query, end);
+            if (!startRef || !endRef)
+                return 0;
+
+            int polyCount = 0;
+            if (dtStatusFailed(query->findPath(startRef, endRef, start, end, &m_filter, m_polys, &polyCount, PATH_POLY_LIMIT)) || !polyCount)
+                return 0;
+
+            float points[PATH_POINT_LIMIT * 3];
+            int pointCount = 0;
+            if (dtStatusFailed(query->findStraightPath(start, end, m_polys, polyCount, points, nullptr, nullptr, &pointCount, PATH_POINT_LIMIT)))
+                return 0;
+
+            return uint32(pointCount);
+        }
+
+    private:
+        dtPolyRef FindNearestPoly(dtNavMeshQuery const* query, float const* point)
+        {
+            static float const nearBound[3] = { 5.0f, 5.0f, 5.0f };
+            static float const farBound[3] = { 10.0f, 10.0f, 10.0f };
+
+            dtPolyRef polyRef = 0;
+            float closest[3];
+            if (dtStatusSucceed(query->findNearestPoly(point, nearBound, &m_filter, &polyRef, closest)) && polyRef)
+                return polyRef;
+
+            if (dtStatusSucceed(query->findNearestPoly(point, farBound, &m_filter, &polyRef, closest)))
+                return polyRef;
+
+            return 0;
+        }
+
+        dtQueryFilter m_filter;
+        dtPolyRef m_polys[PATH_POLY_LIMIT];
+};
+
+int main(int argc, char** argv)
+{
+    std::string corpusFile;
+    std::string dataDir;
+    std::string types;
+    uint32 passes;
+    uint32 losBatch;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("help,h", "print usage message")
+    ("corpus", boost::program_options::value<std::string>(&corpusFile), "query corpus recorded with CollisionQueryLog.File")
+    ("data", boost::program_options::value<std::string>(&dataDir)->default_value("."), "directory with maps, vmaps and mmaps (DataDir of mangosd)")
+    ("types", boost::program_options::value<std::string>(&types)->default_value("los,height,liquid,path"), "comma separated query types to replay")
+    ("passes", boost::program_options::value<uint32>(&passes)->default_value(3), "times the corpus is replayed")
+    ("los-batch", boost::program_options::value<uint32>(&losBatch)->default_value(0), "replay line of sight queries in batches of this size through the batched check, 0 checks one by one");
+
+    boost::program_options::positional_options_description positional;
+    positional.add("corpus", 1);
+
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        printf("ERROR: %s\n\n", e.what());
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help") || corpusFile.empty())
+    {
+        std::cout << "Usage: collisionbench [options] <corpus>" << std::endl << desc << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    bool replayType[MAX_COLLISION_QUERY_TYPE] = {};
+    for (uint32 i = 0; i < MAX_COLLISION_QUERY_TYPE; ++i)
+        replayType[i] = ("," + types + ",").find(std::string(",") + s_queryNames[i] + ",") != std::string::npos;
+
+    std::vector<CollisionQueryRecord> records;
+    if (!LoadCorpus(corpusFile, records))
+    {
+        printf("ERROR: can not read corpus %s\n", corpusFile.c_str());
+        return 1;
+    }
+
+    if (dataDir.empty() || (dataDir.back() != '/' && dataDir.back() != '\\'))
+        dataDir.push_back('/');
+    sWorld.SetDataPath(dataDir);
+
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    vmgr->setEnableLineOfSightCalc(true);
+    vmgr->setEnableHeightCalc(true);
+    MMAP::MMapManager* mmgr = MMAP::MMapFactory::createOrGetMMapManager();
+
+    // load every grid touched by the corpus, terrain grid loading also loads its vmap tile
+    std::map<uint32, TerrainInfo*> terrains;
+    std::set<std::pair<uint32, uint32>> loadedTiles;
+    uint32 queryCount[MAX_COLLISION_QUERY_TYPE] = {};
+    for (CollisionQueryRecord const& record : records)
+    {
+        ++queryCount[record.type];
+
+        TerrainInfo*& terrain = terrains[record.mapId];
+        if (!terrain)
+            terrain = sTerrainMgr.LoadTerrain(record.mapId);
+
+        float const* points[2] = { record.start, record.end };
+        uint32 pointCount = (record.type == COLLISION_QUERY_LOS || record.type == COLLISION_QUERY_PATH) ? 2 : 1;
+        for (uint32 i = 0; i < pointCount; ++i)
+        {
+            int gx = GetGridCoord(points[i][0]);
+            int gy = GetGridCoord(points[i][1]);
+            if (gx < 0 || gy < 0 || gx >= MAX_NUMBER_OF_GRIDS || gy >= MAX_NUMBER_OF_GRIDS)
+                continue;
+
+            if (!loadedTiles.insert(std::make_pair(record.mapId, uint32(gx << 16 | gy))).second)
+                continue;
+
+            terrain->GetHeightStatic(points[i][0], points[i][1], points[i][2]);
+            if (!mmgr->IsMMapTileLoaded(record.mapId, 0, gx, gy))
+                mmgr->loadMap(record.mapId, 0, gx, gy, 0);
+        }
+    }
+
+    printf("Corpus %s: %zu queries on %zu maps, %zu grids loaded\n", corpusFile.c_str(), records.size(), terrains.size(), loadedTiles.size());
+    for (uint32 i = 0; i < MAX_COLLISION_QUERY_TYPE; ++i)
+        printf("    %-8s %u\n", s_queryNames[i], queryCount[i]);
+
+    LatencyStats stats[MAX_COLLISION_QUERY_TYPE];
+    uint64 totalTime[MAX_COLLISION_QUERY_TYPE] = {};
+    uint64 results[MAX_COLLISION_QUERY_TYPE] = {};     // kept so queries are not optimized away, also compared between passes
+    PathReplayer pathReplayer;
+    std::vector<VMAP::LineOfSightQuery> losQueries;
+
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        uint64 passResults[MAX_COLLISION_QUERY_TYPE] = {};
+
+        for (size_t index = 0; index < records.size(); ++index)
+        {
+            CollisionQueryRecord const& record = records[index];
+            if (!replayType[record.type])
+                continue;
+
+            TerrainInfo const* terrain = terrains[record.mapId];
+
+            if (record.type == COLLISION_QUERY_LOS && losBatch > 1)
+            {
+                // consecutive queries of the same map, as a spell or target selection would check them
+                losQueries.clear();
+                size_t last = index;
+                for (; last < records.size() && losQueries.size() < losBatch; ++last)
+                {
+                    CollisionQueryRecord const& losRecord = records[last];
+                    if (losRecord.type != COLLISION_QUERY_LOS || losRecord.mapId != record.mapId || losRecord.flags != record.flags)
+                        break;
+
+                    VMAP::LineOfSightQuery query;
+                    query.x1 = losRecord.start[0];
+                    query.y1 = losRecord.start[1];
+                    query.z1 = losRecord.start[2];
+                    query.x2 = losRecord.end[0];
+                    query.y2 = losRecord.end[1];
+                    query.z2 = losRecord.end[2];
+                    query.inLineOfSight = true;
+                    losQueries.push_back(query);
+                }
+
+                SteadyClock::time_point start = SteadyClock::now();
+                vmgr->isInLineOfSight(record.mapId, losQueries.data(), losQueries.size(), record.flags != 0);
+                uint64 elapsed = ElapsedNs(start);
+
+                for (VMAP::LineOfSightQuery const& query : losQueries)
+                {
+                    stats[COLLISION_QUERY_LOS].Add(elapsed / losQueries.size());
+                    passResults[COLLISION_QUERY_LOS] += query.inLineOfSight;
+                }
+                totalTime[COLLISION_QUERY_LOS] += elapsed;
+                index = last - 1;
+                continue;
+            }
+
+            uint64 result = 0;
+            SteadyClock::time_point start = SteadyClock::now();
+            switch (record.type)
+            {
+                case COLLISION_QUERY_LOS:
+                    result = vmgr->isInLineOfSight(record.mapId, record.start[0], record.start[1], record.start[2], record.end[0], record.end[1], record.end[2], record.flags != 0);
+                    break;
+                case COLLISION_QUERY_HEIGHT:
+                    result = terrain->GetHeightStatic(record.start[0], record.start[1], record.start[2], record.flags != 0, record.end[0]) > INVALID_HEIGHT;
+                    break;
+                case COLLISION_QUERY_LIQUID:
+                {
+                    GridMapLiquidData data;
+                    result = terrain->getLiquidStatus(record.start[0], record.start[1], record.start[2], record.flags, &data, record.end[0]);
+                    break;
+                }
+                case COLLISION_QUERY_PATH:
+                    if (dtNavMeshQuery const* query = mmgr->GetNavMeshQuery(record.mapId, 0))
+                        result = pathReplayer.Replay(query, record);
+                    break;
+            }
+            uint64 elapsed = ElapsedNs(start);
+
+            stats[record.type].Add(elapsed);
+            totalTime[record.type] += elapsed;
+            passResults[record.type] += result;
+        }
+
+        for (uint32 i = 0; i < MAX_COLLISION_QUERY_TYPE; ++i)
+        {
+            if (pass && passResults[i] != results[i])
+                printf("WARNING: %s results differ between passes (%llu != %llu)\n", s_queryNames[i], (unsigned long long)passResults[i], (unsigned long long)results[i]);
+            results[i] = passResults[i];
+        }
+    }
+
+    printf("\nns per query over %u passes%s:\n", passes, losBatch > 1 ? " (los: batch time divided by batch size)" : "");
+    for (uint32 i = 0; i < MAX_COLLISION_QUERY_TYPE; ++i)
+    {
+        if (!replayType[i] || !stats[i].Count())
+            continue;
+
+        printf("    %-8s %s total=%.1fms result=%llu\n", s_queryNames[i], stats[i].Summary(1.0).c_str(), totalTime[i] / 1000000.0, (unsigned long long)results[i]);
+    }
+
+    return 0;
+}
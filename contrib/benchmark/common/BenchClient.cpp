@@ -0,0 +1,463 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "BenchClient.h"
+#include "Auth/CryptoHash.h"
+#include "Auth/HMACSHA1.h"
+#include "Auth/SRP6.h"
+#include "Util/Util.h"
+
+#include <openssl/opensslv.h>
+#include <openssl/crypto.h>
+#if defined(OPENSSL_VERSION_MAJOR) && (OPENSSL_VERSION_MAJOR >= 3)
+#include <openssl/provider.h>
+#endif
+#include <zlib.h>
+
+namespace Benchmark
+{
+    static Sha1Hash HashAccount(std::string const& account, std::string const& password)
+    {
+        Sha1Hash sha;
+        sha.Initialize();
+        sha.UpdateData(account);
+        sha.UpdateData(":");
+        sha.UpdateData(password);
+        sha.Finalize();
+        return sha;
+    }
+
+    bool InitCrypto()
+    {
+#if defined(OPENSSL_VERSION_MAJOR) && (OPENSSL_VERSION_MAJOR >= 3)
+        // same as mangosd, providers stay loaded until exit
+        if (!OSSL_PROVIDER_load(nullptr, "legacy") || !OSSL_PROVIDER_load(nullptr, "default"))
+            return false;
+#endif
+        return true;
+    }
+
+    std::string MakeAccountSqlInsert(std::string const& account, std::string const& password, uint32 expansion)
+    {
+        // same as AccountMgr::CreateAccount
+        Sha1Hash sha = HashAccount(account, password);
+        std::string rI;
+        hexEncodeByteArray(sha.GetDigest(), Sha1Hash::GetLength(), rI);
+
+        SRP6 srp;
+        srp.CalculateVerifier(rI);
+        const char* s_hex = srp.GetSalt().AsHexStr();
+        const char* v_hex = srp.GetVerifier().AsHexStr();
+
+        char buf[512];
+        snprintf(buf, sizeof(buf), "INSERT INTO account(username,v,s,expansion) VALUES('%s','%s','%s',%u);",
+                 account.c_str(), v_hex, s_hex, expansion);
+
+        OPENSSL_free((void*)s_hex);
+        OPENSSL_free((void*)v_hex);
+        return buf;
+    }
+
+    // -----------------------------------  RealmClient  -------------------------------------------- //
+
+    bool RealmClient::Connect(std::string const& host, uint16 port)
+    {
+        boost::system::error_code error;
+        m_socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(host, error), port), error);
+        if (error)
+            return false;
+
+        m_socket.set_option(boost::asio::ip::tcp::no_delay(true), error);
+        return true;
+    }
+
+    void RealmClient::Close()
+    {
+        boost::system::error_code error;
+        m_socket.close(error);
+    }
+
+    bool RealmClient::Read(void* data, size_t size)
+    {
+        boost::system::error_code error;
+        boost::asio::read(m_socket, boost::asio::buffer(data, size), error);
+        return !error;
+    }
+
+    bool RealmClient::Write(void const* data, size_t size)
+    {
+        boost::system::error_code error;
+        boost::asio::write(m_socket, boost::asio::buffer(data, size), error);
+        return !error;
+    }
+
+    bool RealmClient::LogonChallenge(std::string const& account)
+    {
+        // see sAuthLogonChallenge_C, platform/os/country are sent byte reversed
+        ByteBuffer pkt;
+        pkt << uint8(0x00);                                 // CMD_AUTH_LOGON_CHALLENGE
+        pkt << uint8(0x08);                                 // error
+        pkt << uint16(30 + account.size());                 // size of the remaining packet
+        pkt.append("WoW", 4);
+        pkt << uint8(3) << uint8(3) << uint8(5);
+        pkt << uint16(CLIENT_BUILD);
+        pkt.append("68x", 4);
+        pkt.append("niW", 4);
+        pkt.append("SUne", 4);
+        pkt << uint32(0);                                   // timezone bias
+        pkt << uint32(0x0100007F);                          // ip
+        pkt << uint8(account.size());
+        pkt.append(account.c_str(), account.size());
+
+        if (!Write(pkt.contents(), pkt.size()))
+            return false;
+
+        uint8 header[3];                                    // cmd, error, result
+        if (!Read(header, sizeof(header)) || header[2] != 0)
+            return false;
+
+        uint8 B[32];
+        uint8 length;
+        uint8 g[255];
+        uint8 N[255];
+        uint8 s[32];
+        uint8 versionChallenge[16];
+        uint8 securityFlags;
+
+        if (!Read(B, sizeof(B)) || !Read(&length, 1) || !Read(g, length))
+            return false;
+        m_g.SetBinary(g, length);
+
+        if (!Read(&length, 1) || !Read(N, length))
+            return false;
+        m_N.SetBinary(N, length);
+
+        if (!Read(s, sizeof(s)) || !Read(versionChallenge, sizeof(versionChallenge)) || !Read(&securityFlags, 1))
+            return false;
+
+        // PIN, matrix or authenticator input is not supported by synthetic clients
+        if (securityFlags)
+            return false;
+
+        m_B.SetBinary(B, sizeof(B));
+        m_s.SetBinary(s, sizeof(s));
+        return true;
+    }
+
+    bool RealmClient::LogonProof(std::string const& account, std::string const& password)
+    {
+        // x = H(s | H(I:P))
+        Sha1Hash sha = HashAccount(account, password);
+        uint8 passHash[Sha1Hash::GetLength()];
+        memcpy(passHash, sha.GetDigest(), Sha1Hash::GetLength());
+
+        sha.Initialize();
+        sha.UpdateData(m_s.AsByteArray());
+        sha.UpdateData(passHash, Sha1Hash::GetLength());
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), Sha1Hash::GetLength());
+
+        // A = g^a
+        BigNumber a;
+        a.SetRand(19 * 8);
+        BigNumber A = m_g.ModExp(a, m_N);
+
+        // u = H(A | B)
+        sha.Initialize();
+        sha.UpdateBigNumbers(&A, &m_B, nullptr);
+        sha.Finalize();
+        BigNumber u;
+        u.SetBinary(sha.GetDigest(), Sha1Hash::GetLength());
+
+        // S = (B - k * g^x) ^ (a + u * x), kept positive by adding N before subtraction
+        BigNumber kgx = (m_g.ModExp(x, m_N) * BigNumber(3)) % m_N;
+        BigNumber base = (m_B + m_N) - kgx;
+        BigNumber S = base.ModExp(a + u * x, m_N);
+
+        // K = interleaved hash of S, same as SRP6::HashSessionKey
+        std::vector<uint8> t = S.AsByteArray(32);
+        uint8 half[16];
+        uint8 vK[40];
+        for (int i = 0; i < 16; ++i)
+            half[i] = t[i * 2];
+        sha.Initialize();
+        sha.UpdateData(half, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+            vK[i * 2] = sha.GetDigest()[i];
+        for (int i = 0; i < 16; ++i)
+            half[i] = t[i * 2 + 1];
+        sha.Initialize();
+        sha.UpdateData(half, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+            vK[i * 2 + 1] = sha.GetDigest()[i];
+        m_K.SetBinary(vK, 40);
+
+        // M1 = H(H(N) xor H(g), H(I), s, A, B, K), same as SRP6::CalculateProof
+        uint8 hash[20];
+        sha.Initialize();
+        sha.UpdateBigNumbers(&m_N, nullptr);
+        sha.Finalize();
+        memcpy(hash, sha.GetDigest(), 20);
+        sha.Initialize();
+        sha.UpdateBigNumbers(&m_g, nullptr);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+            hash[i] ^= sha.GetDigest()[i];
+        BigNumber t3;
+        t3.SetBinary(hash, 20);
+
+        sha.Initialize();
+        sha.UpdateData(account);
+        sha.Finalize();
+        uint8 t4[Sha1Hash::GetLength()];
+        memcpy(t4, sha.GetDigest(), Sha1Hash::GetLength());
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&t3, nullptr);
+        sha.UpdateData(t4, Sha1Hash::GetLength());
+        sha.UpdateBigNumbers(&m_s, &A, &m_B, &m_K, nullptr);
+        sha.Finalize();
+        BigNumber M1;
+        M1.SetBinary(sha.GetDigest(), 20);
+
+        // see sAuthLogonProof_C
+        ByteBuffer pkt;
+        pkt << uint8(0x01);                                 // CMD_AUTH_LOGON_PROOF
+        pkt.append(A.AsByteArray(32));
+        pkt.append(M1.AsByteArray(20));
+        for (int i = 0; i < 20; ++i)
+            pkt << uint8(0);                                // crc hash, server accepts zeros without StrictVersionCheck
+        pkt << uint8(0);                                    // number of keys
+        pkt << uint8(0);                                    // security flags
+
+        if (!Write(pkt.contents(), pkt.size()))
+            return false;
+
+        uint8 header[2];                                    // cmd, error
+        if (!Read(header, sizeof(header)) || header[1] != 0)
+            return false;
+
+        // see sAuthLogonProof_S
+        uint8 M2[20];
+        uint8 tail[10];
+        if (!Read(M2, sizeof(M2)) || !Read(tail, sizeof(tail)))
+            return false;
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&A, &M1, &m_K, nullptr);
+        sha.Finalize();
+        return memcmp(M2, sha.GetDigest(), sizeof(M2)) == 0;
+    }
+
+    bool RealmClient::RealmList()
+    {
+        uint8 const request[5] = { 0x10, 0, 0, 0, 0 };   // CMD_REALM_LIST
+        if (!Write(request, sizeof(request)))
+            return false;
+
+        uint8 header[3];                                    // cmd, uint16 size
+        if (!Read(header, sizeof(header)))
+            return false;
+
+        std::vector<uint8> body(header[1] | (header[2] << 8));
+        return body.empty() || Read(body.data(), body.size());
+    }
+
+    // -----------------------------------  WorldClient  -------------------------------------------- //
+
+    bool WorldClient::Connect(std::string const& host, uint16 port)
+    {
+        boost::system::error_code error;
+        m_socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(host, error), port), error);
+        if (error)
+            return false;
+
+        m_socket.set_option(boost::asio::ip::tcp::no_delay(true), error);
+        return true;
+    }
+
+    void WorldClient::Close()
+    {
+        boost::system::error_code error;
+        m_socket.close(error);
+        m_crypted = false;
+    }
+
+    bool WorldClient::Read(void* data, size_t size)
+    {
+        boost::system::error_code error;
+        boost::asio::read(m_socket, boost::asio::buffer(data, size), error);
+        m_bytesReceived += size;
+        return !error;
+    }
+
+    bool WorldClient::Write(void const* data, size_t size)
+    {
+        boost::system::error_code error;
+        boost::asio::write(m_socket, boost::asio::buffer(data, size), error);
+        m_bytesSent += size;
+        return !error;
+    }
+
+    void WorldClient::InitCrypt(BigNumber& K)
+    {
+        // mirror of AuthCrypt::Init, client encrypts with server decryption key and vice versa
+        uint8 ServerEncryptionKey[SEED_KEY_SIZE] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
+        uint8 ServerDecryptionKey[SEED_KEY_SIZE] = { 0xC2, 0xB3, 0x72, 0x3C, 0xC6, 0xAE, 0xD9, 0xB5, 0x34, 0x3C, 0x53, 0xEE, 0x2F, 0x43, 0x67, 0xCE };
+
+        HMACSHA1 decryptHmac(SEED_KEY_SIZE, ServerEncryptionKey);
+        m_decrypt.Init(decryptHmac.ComputeHash(&K));
+
+        HMACSHA1 encryptHmac(SEED_KEY_SIZE, ServerDecryptionKey);
+        m_encrypt.Init(encryptHmac.ComputeHash(&K));
+
+        uint8 syncBuf[1024];
+        memset(syncBuf, 0, 1024);
+        m_encrypt.UpdateData(syncBuf, 1024);
+        memset(syncBuf, 0, 1024);
+        m_decrypt.UpdateData(syncBuf, 1024);
+
+        m_crypted = true;
+    }
+
+    bool WorldClient::SendPacket(uint16 opcode, ByteBuffer const& body)
+    {
+        // client header: uint16 size (big endian, includes opcode) + uint32 opcode
+        uint8 header[6];
+        uint16 size = uint16(body.size() + 4);
+        header[0] = uint8(size >> 8);
+        header[1] = uint8(size);
+        header[2] = uint8(opcode);
+        header[3] = uint8(opcode >> 8);
+        header[4] = 0;
+        header[5] = 0;
+
+        if (m_crypted)
+            m_encrypt.UpdateData(header, sizeof(header));
+
+        if (!Write(header, sizeof(header)))
+            return false;
+
+        return body.empty() || Write(body.contents(), body.size());
+    }
+
+    bool WorldClient::ReadPacket(uint16& opcode, ByteBuffer& body)
+    {
+        // server header: uint16 size (big endian, 3 bytes with 0x80 flag for large packets) + uint16 opcode
+        uint8 header[5];
+        if (!Read(header, 1))
+            return false;
+
+        if (m_crypted)
+            m_decrypt.UpdateData(header, 1);
+
+        uint32 size;
+        if (header[0] & 0x80)
+        {
+            if (!Read(header + 1, 4))
+                return false;
+            if (m_crypted)
+                m_decrypt.UpdateData(header + 1, 4);
+            size = ((header[0] & 0x7F) << 16) | (header[1] << 8) | header[2];
+            opcode = header[3] | (header[4] << 8);
+        }
+        else
+        {
+            if (!Read(header + 1, 3))
+                return false;
+            if (m_crypted)
+                m_decrypt.UpdateData(header + 1, 3);
+            size = (header[0] << 8) | header[1];
+            opcode = header[2] | (header[3] << 8);
+        }
+
+        if (size < 2)
+            return false;
+
+        body.clear();
+        body.resize(size - 2);
+        return body.empty() || Read(const_cast<uint8*>(body.contents()), body.size());
+    }
+
+    int WorldClient::Authenticate(std::string const& account, BigNumber& K, uint32 realmId)
+    {
+        uint16 opcode;
+        ByteBuffer challenge;
+        if (!ReadPacket(opcode, challenge) || opcode != OPCODE_SMSG_AUTH_CHALLENGE)
+            return -1;
+
+        challenge.read_skip<uint32>();
+        uint32 serverSeed = challenge.read<uint32>();
+
+        BigNumber clientSeedBN;
+        clientSeedBN.SetRand(32);
+        uint32 clientSeed = clientSeedBN.AsDword();
+
+        // digest checked in WorldSocket::HandleAuthSession
+        uint32 t = 0;
+        Sha1Hash sha;
+        sha.UpdateData(account);
+        sha.UpdateData((uint8*)&t, 4);
+        sha.UpdateData((uint8*)&clientSeed, 4);
+        sha.UpdateData((uint8*)&serverSeed, 4);
+        sha.UpdateBigNumbers(&K, nullptr);
+        sha.Finalize();
+
+        ByteBuffer pkt;
+        pkt << uint32(CLIENT_BUILD);
+        pkt << uint32(0);                                   // login server id
+        pkt << account;
+        pkt << uint32(0);                                   // login server type
+        pkt << uint32(clientSeed);
+        pkt << uint32(0);                                   // region id
+        pkt << uint32(0);                                   // battlegroup id
+        pkt << uint32(realmId);
+        pkt << uint64(0);                                   // dos response
+        pkt.append(sha.GetDigest(), 20);
+
+        // addon info: zero addons + unk timestamp, zlib compressed with uncompressed size in front
+        uint8 addonData[8] = { 0 };
+        uLongf compressedSize = compressBound(sizeof(addonData));
+        std::vector<uint8> compressed(compressedSize);
+        if (compress(compressed.data(), &compressedSize, addonData, sizeof(addonData)) != Z_OK)
+            return -1;
+        pkt << uint32(sizeof(addonData));
+        pkt.append(compressed.data(), compressedSize);
+
+        if (!SendPacket(OPCODE_CMSG_AUTH_SESSION, pkt))
+            return -1;
+
+        InitCrypt(K);
+
+        // other packets (addon info, tutorial flags) may follow, auth response comes first for non queued logins
+        ByteBuffer response;
+        for (int i = 0; i < 16; ++i)
+        {
+            if (!ReadPacket(opcode, response))
+                return -1;
+
+            if (opcode == OPCODE_SMSG_AUTH_RESPONSE)
+                return response.empty() ? -1 : int(response.read<uint8>());
+        }
+
+        return -1;
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCHMARK_BENCHCLIENT_H
+#define BENCHMARK_BENCHCLIENT_H
+
+#include "Common.h"
+#include "Auth/BigNumber.h"
+#include "Auth/SARC4.h"
+#include "Util/ByteBuffer.h"
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace Benchmark
+{
+    // client opcodes and codes used by the synthetic clients, see Opcodes.h and SharedDefines.h
+    enum
+    {
+        CLIENT_BUILD                        = 12340,                // 3.3.5a
+
+        OPCODE_CMSG_CHAR_CREATE             = 0x036,
+        OPCODE_CMSG_CHAR_ENUM               = 0x037,
+        OPCODE_CMSG_CHAR_DELETE             = 0x038,
+        OPCODE_SMSG_CHAR_CREATE             = 0x03A,
+        OPCODE_SMSG_CHAR_ENUM               = 0x03B,
+        OPCODE_CMSG_PLAYER_LOGIN            = 0x03D,
+        OPCODE_SMSG_CHARACTER_LOGIN_FAILED  = 0x041,
+        OPCODE_CMSG_LOGOUT_REQUEST          = 0x04B,
+        OPCODE_CMSG_QUERY_TIME              = 0x1CE,
+        OPCODE_SMSG_QUERY_TIME_RESPONSE     = 0x1CF,
+        OPCODE_SMSG_AUTH_CHALLENGE          = 0x1EC,
+        OPCODE_CMSG_AUTH_SESSION            = 0x1ED,
+        OPCODE_SMSG_AUTH_RESPONSE           = 0x1EE,
+        OPCODE_SMSG_LOGIN_VERIFY_WORLD      = 0x236,
+        OPCODE_CMSG_WARDEN_DATA             = 0x2E7,
+        OPCODE_SMSG_TIME_SYNC_REQ           = 0x390,
+        OPCODE_CMSG_TIME_SYNC_RESP          = 0x391,
+
+        AUTH_RESPONSE_OK                    = 0x0C,
+        AUTH_RESPONSE_WAIT_QUEUE            = 0x1B,
+        CHAR_CREATE_SUCCESS                 = 0x2F,
+    };
+
+    /// loads OpenSSL 3 legacy provider needed for the world socket ARC4, must be called before creating a WorldClient
+    bool InitCrypto();
+
+    /// INSERT statement for realmd account table with SRP6 verifier and salt of given (upper case) account and password
+    std::string MakeAccountSqlInsert(std::string const& account, std::string const& password, uint32 expansion);
+
+    /// Blocking client side of the realmd SRP6 logon (AUTH_LOGON_CHALLENGE / AUTH_LOGON_PROOF / REALM_LIST)
+    class RealmClient
+    {
+        public:
+            explicit RealmClient(boost::asio::io_service& service) : m_socket(service) {}
+
+            bool Connect(std::string const& host, uint16 port);
+            void Close();
+
+            // sends challenge and reads server reply with B, g, N, s
+            bool LogonChallenge(std::string const& account);
+            // computes A, M1 and K, sends proof and verifies server M2
+            bool LogonProof(std::string const& account, std::string const& password);
+            bool RealmList();
+
+            BigNumber const& GetSessionKey() const { return m_K; }
+
+        private:
+            bool Read(void* data, size_t size);
+            bool Write(void const* data, size_t size);
+
+            boost::asio::ip::tcp::socket m_socket;
+
+            BigNumber m_N, m_g, m_s, m_B;
+            BigNumber m_K;
+    };
+
+    /// Blocking client side of the world socket: CMSG_AUTH_SESSION handshake and header encrypted packets
+    class WorldClient
+    {
+        public:
+            explicit WorldClient(boost::asio::io_service& service) : m_socket(service), m_encrypt(20), m_decrypt(20), m_crypted(false), m_bytesSent(0), m_bytesReceived(0) {}
+
+            bool Connect(std::string const& host, uint16 port);
+            void Close();
+
+            // reads SMSG_AUTH_CHALLENGE, sends CMSG_AUTH_SESSION and waits for SMSG_AUTH_RESPONSE, returns auth result code or -1
+            int Authenticate(std::string const& account, BigNumber& K, uint32 realmId);
+
+            // reading and sending may be done by different threads, concurrent senders need own locking
+            bool SendPacket(uint16 opcode, ByteBuffer const& body);
+            bool ReadPacket(uint16& opcode, ByteBuffer& body);
+
+            // may be polled from other threads while the client is running
+            uint64 GetBytesSent() const { return m_bytesSent; }
+            uint64 GetBytesReceived() const { return m_bytesReceived; }
+
+        private:
+            bool Read(void* data, size_t size);
+            bool Write(void const* data, size_t size);
+            void InitCrypt(BigNumber& K);
+
+            boost::asio::ip::tcp::socket m_socket;
+
+            SARC4 m_encrypt;
+            SARC4 m_decrypt;
+            bool m_crypted;
+
+            std::atomic<uint64> m_bytesSent;
+            std::atomic<uint64> m_bytesReceived;
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCHMARK_LATENCYSTATS_H
+#define BENCHMARK_LATENCYSTATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+    typedef std::chrono::steady_clock SteadyClock;
+
+    inline uint64_t ElapsedNs(SteadyClock::time_point start)
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - start).count());
+    }
+
+    /// Collects raw samples (in ns) and reports count, mean and percentiles. Not thread safe, merge per thread copies.
+    class LatencyStats
+    {
+        public:
+            void Add(uint64_t ns) { m_samples.push_back(ns); m_sorted = false; }
+            void Merge(LatencyStats const& other)
+            {
+                m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+                m_sorted = false;
+            }
+            void Clear() { m_samples.clear(); m_sorted = true; }
+
+            size_t Count() const { return m_samples.size(); }
+
+            uint64_t Percentile(double p)
+            {
+                if (m_samples.empty())
+                    return 0;
+
+                Sort();
+                size_t index = size_t(p / 100.0 * (m_samples.size() - 1) + 0.5);
+                return m_samples[std::min(index, m_samples.size() - 1)];
+            }
+
+            double Mean() const
+            {
+                if (m_samples.empty())
+                    return 0.0;
+
+                double sum = 0.0;
+                for (uint64_t sample : m_samples)
+                    sum += double(sample);
+                return sum / m_samples.size();
+            }
+
+            // "n=1000 mean=12.3 p50=10.1 p90=20.0 p99=41.2 max=80.3" with values in given unit (1000 = us)
+            std::string Summary(double divider = 1000.0)
+            {
+                char buf[256];
+                snprintf(buf, sizeof(buf), "n=%zu mean=%.1f p50=%.1f p90=%.1f p99=%.1f max=%.1f",
+                         Count(), Mean() / divider, Percentile(50) / divider, Percentile(90) / divider,
+                         Percentile(99) / divider, Percentile(100) / divider);
+                return buf;
+            }
+
+        private:
+            void Sort()
+            {
+                if (!m_sorted)
+                    std::sort(m_samples.begin(), m_samples.end());
+                m_sorted = true;
+            }
+
+            std::vector<uint64_t> m_samples;
+            bool m_sorted = true;
+    };
+}
+
+#endif
@@ -0,0 +1,262 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// Login storm load generator: ramps concurrent synthetic clients doing the realmd SRP6 logon
+/// (challenge, proof, realm list) and optionally the world CMSG_AUTH_SESSION handshake,
+/// reporting logins per second and per phase latency percentiles for every ramp step.
+
+#include "BenchClient.h"
+#include "LatencyStats.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Benchmark;
+
+struct Config
+{
+    std::string realmHost;
+    uint16 realmPort;
+    std::string worldHost;
+    uint16 worldPort;
+    std::string accountPrefix;
+    uint32 accountCount;
+    std::string password;
+    uint32 realmId;
+    uint32 startClients;
+    uint32 stepClients;
+    uint32 maxClients;
+    uint32 stepSeconds;
+};
+
+struct WorkerStats
+{
+    LatencyStats challenge;
+    LatencyStats proof;
+    LatencyStats realmList;
+    LatencyStats worldAuth;
+    LatencyStats total;
+    uint32 failedRealm = 0;
+    uint32 failedWorld = 0;
+    uint32 queued = 0;
+
+    void Merge(WorkerStats const& other)
+    {
+        challenge.Merge(other.challenge);
+        proof.Merge(other.proof);
+        realmList.Merge(other.realmList);
+        worldAuth.Merge(other.worldAuth);
+        total.Merge(other.total);
+        failedRealm += other.failedRealm;
+        failedWorld += other.failedWorld;
+        queued += other.queued;
+    }
+};
+
+static std::string AccountName(Config const& config, uint32 index)
+{
+    return config.accountPrefix + std::to_string(index + 1);
+}
+
+// one full login of one account, every phase timed separately
+static void DoLogin(Config const& config, boost::asio::io_service& service, std::string const& account, WorkerStats& stats)
+{
+    SteadyClock::time_point start = SteadyClock::now();
+
+    RealmClient realm(service);
+    if (!realm.Connect(config.realmHost, config.realmPort))
+    {
+        ++stats.failedRealm;
+        return;
+    }
+
+    SteadyClock::time_point phase = SteadyClock::now();
+    if (!realm.LogonChallenge(account))
+    {
+        ++stats.failedRealm;
+        return;
+    }
+    stats.challenge.Add(ElapsedNs(phase));
+
+    phase = SteadyClock::now();
+    if (!realm.LogonProof(account, config.password))
+    {
+        ++stats.failedRealm;
+        return;
+    }
+    stats.proof.Add(ElapsedNs(phase));
+
+    phase = SteadyClock::now();
+    if (!realm.RealmList())
+    {
+        ++stats.failedRealm;
+        return;
+    }
+    stats.realmList.Add(ElapsedNs(phase));
+    realm.Close();
+
+    if (config.worldPort)
+    {
+        BigNumber K = realm.GetSessionKey();
+
+        phase = SteadyClock::now();
+        WorldClient world(service);
+        int result = world.Connect(config.worldHost, config.worldPort) ? world.Authenticate(account, K, config.realmId) : -1;
+        if (result == AUTH_RESPONSE_WAIT_QUEUE)
+            ++stats.queued;
+        else if (result != AUTH_RESPONSE_OK)
+        {
+            ++stats.failedWorld;
+            return;
+        }
+        stats.worldAuth.Add(ElapsedNs(phase));
+        world.Close();
+    }
+
+    stats.total.Add(ElapsedNs(start));
+}
+
+// client thread: logs in its own share of accounts (index, index + clients, ...) until the step ends
+static void Worker(Config const& config, uint32 index, uint32 clients, std::atomic<bool> const& stop, WorkerStats& stats)
+{
+    boost::asio::io_service service;
+    uint32 accountsPerClient = std::max(config.accountCount / clients, 1u);
+
+    for (uint32 i = 0; !stop; ++i)
+    {
+        uint32 account = (index + (i % accountsPerClient) * clients) % config.accountCount;
+        DoLogin(config, service, AccountName(config, account), stats);
+    }
+}
+
+static void RunStep(Config const& config, uint32 clients)
+{
+    std::atomic<bool> stop(false);
+    std::vector<WorkerStats> workerStats(clients);
+    std::vector<std::thread> threads;
+    threads.reserve(clients);
+
+    SteadyClock::time_point start = SteadyClock::now();
+    for (uint32 i = 0; i < clients; ++i)
+        threads.emplace_back(Worker, std::cref(config), i, clients, std::cref(stop), std::ref(workerStats[i]));
+
+    std::this_thread::sleep_for(std::chrono::seconds(config.stepSeconds));
+    stop = true;
+    for (std::thread& thread : threads)
+        thread.join();
+    double seconds = ElapsedNs(start) / 1e9;
+
+    WorkerStats stats;
+    for (WorkerStats const& worker : workerStats)
+        stats.Merge(worker);
+
+    printf("clients=%u logins=%zu (%.1f/s) failed realm=%u world=%u queued=%u\n",
+           clients, stats.total.Count(), stats.total.Count() / seconds, stats.failedRealm, stats.failedWorld, stats.queued);
+    printf("  challenge  [us] %s\n", stats.challenge.Summary().c_str());
+    printf("  proof      [us] %s\n", stats.proof.Summary().c_str());
+    printf("  realmlist  [us] %s\n", stats.realmList.Summary().c_str());
+    if (config.worldPort)
+        printf("  worldauth  [us] %s\n", stats.worldAuth.Summary().c_str());
+    printf("  total      [us] %s\n", stats.total.Summary().c_str());
+    fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    Config config;
+    bool makeAccounts = false;
+    uint32 expansion;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("help,h", "print usage message")
+    ("realm-host", boost::program_options::value<std::string>(&config.realmHost)->default_value("127.0.0.1"), "realmd address")
+    ("realm-port", boost::program_options::value<uint16>(&config.realmPort)->default_value(3724), "realmd port")
+    ("world-host", boost::program_options::value<std::string>(&config.worldHost)->default_value("127.0.0.1"), "mangosd address")
+    ("world-port", boost::program_options::value<uint16>(&config.worldPort)->default_value(0), "mangosd port, 0 skips world auth")
+    ("realm-id", boost::program_options::value<uint32>(&config.realmId)->default_value(1), "realm id sent in CMSG_AUTH_SESSION")
+    ("prefix", boost::program_options::value<std::string>(&config.accountPrefix)->default_value("BENCH"), "account name prefix")
+    ("accounts", boost::program_options::value<uint32>(&config.accountCount)->default_value(1000), "number of accounts <prefix>1..<prefix>N")
+    ("password", boost::program_options::value<std::string>(&config.password)->default_value("BENCH"), "password of all accounts")
+    ("start", boost::program_options::value<uint32>(&config.startClients)->default_value(1), "concurrent clients of first step")
+    ("step", boost::program_options::value<uint32>(&config.stepClients)->default_value(8), "clients added per step")
+    ("max", boost::program_options::value<uint32>(&config.maxClients)->default_value(64), "concurrent clients of last step")
+    ("step-time", boost::program_options::value<uint32>(&config.stepSeconds)->default_value(10), "seconds per step")
+    ("make-accounts", "print SQL creating the accounts and exit")
+    ("expansion", boost::program_options::value<uint32>(&expansion)->default_value(2), "expansion of created accounts");
+
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        printf("ERROR: %s\n\n", e.what());
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    makeAccounts = vm.count("make-accounts") > 0;
+
+    // realmd upper cases account and password before hashing
+    std::transform(config.accountPrefix.begin(), config.accountPrefix.end(), config.accountPrefix.begin(), ::toupper);
+    std::transform(config.password.begin(), config.password.end(), config.password.begin(), ::toupper);
+
+    if (!config.accountCount || !config.startClients || !config.stepSeconds)
+    {
+        printf("ERROR: accounts, start and step-time must be greater than 0\n");
+        return 1;
+    }
+
+    if (makeAccounts)
+    {
+        for (uint32 i = 0; i < config.accountCount; ++i)
+            printf("%s\n", MakeAccountSqlInsert(AccountName(config, i), config.password, expansion).c_str());
+        return 0;
+    }
+
+    if (!InitCrypto())
+    {
+        printf("ERROR: can not load OpenSSL legacy provider\n");
+        return 1;
+    }
+
+    if (config.accountCount < config.maxClients)
+        printf("WARNING: less accounts than clients, the same account will log in concurrently\n");
+
+    for (uint32 clients = config.startClients; clients <= config.maxClients; clients += std::max(config.stepClients, 1u))
+        RunStep(config, clients);
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PacketCapture.h"
+#include "BenchClient.h"
+
+#include <cstdio>
+#include <map>
+
+namespace Benchmark
+{
+    // see LogHeader and PacketHeader in PacketLog.cpp
+    static size_t const LOG_HEADER_SIZE       = 66;
+    static size_t const PACKET_HEADER_SIZE    = 20;
+    static uint32 const DIRECTION_CMSG        = 0x47534d43;
+
+    template<typename T>
+    static bool ReadValue(std::vector<uint8> const& buffer, size_t& pos, T& value)
+    {
+        if (pos + sizeof(T) > buffer.size())
+            return false;
+
+        memcpy(&value, &buffer[pos], sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool PacketCapture::Load(std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+            return false;
+
+        std::vector<uint8> buffer;
+        uint8 chunk[64 * 1024];
+        size_t count;
+        while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            buffer.insert(buffer.end(), chunk, chunk + count);
+        fclose(file);
+
+        if (buffer.size() < LOG_HEADER_SIZE || memcmp(buffer.data(), "PKT", 3) != 0)
+            return false;
+
+        uint16 version;
+        uint32 optionalSize;
+        size_t pos = 3;
+        if (!ReadValue(buffer, pos, version))
+            return false;
+        pos = 6;
+        if (!ReadValue(buffer, pos, m_build))
+            return false;
+        pos = LOG_HEADER_SIZE - sizeof(uint32);
+        if (!ReadValue(buffer, pos, optionalSize))
+            return false;
+        pos += optionalSize;
+
+        if (version != 0x0301)
+            return false;
+
+        // PacketLog writes 0 as connection id, so connections are told apart by client address and port
+        std::map<std::vector<uint8>, size_t> connectionIndex;
+        std::vector<uint32> loginTime;
+
+        while (pos + PACKET_HEADER_SIZE <= buffer.size())
+        {
+            uint32 direction, connectionId, ticks, length, opcode;
+            if (!ReadValue(buffer, pos, direction) || !ReadValue(buffer, pos, connectionId) || !ReadValue(buffer, pos, ticks) ||
+                    !ReadValue(buffer, pos, optionalSize) || !ReadValue(buffer, pos, length))
+                return false;
+
+            if (pos + optionalSize + length > buffer.size() || length < sizeof(opcode))
+                return false;
+
+            std::vector<uint8> key(buffer.begin() + pos, buffer.begin() + pos + optionalSize);
+            key.insert(key.end(), (uint8*)&connectionId, (uint8*)&connectionId + sizeof(connectionId));
+            pos += optionalSize;
+
+            if (!ReadValue(buffer, pos, opcode))
+                return false;
+            size_t dataSize = length - sizeof(opcode);
+            size_t dataPos = pos;
+            pos += dataSize;
+
+            auto itr = connectionIndex.find(key);
+            if (direction != DIRECTION_CMSG)
+            {
+                if (itr != connectionIndex.end())
+                    m_connections[itr->second].bytesReceived += dataSize + 4;
+                continue;
+            }
+
+            if (opcode == OPCODE_CMSG_PLAYER_LOGIN)
+            {
+                // relog on the same connection starts a new one, first login wins for the character guid
+                if (dataSize < sizeof(uint64))
+                    continue;
+
+                connectionIndex[key] = m_connections.size();
+                loginTime.push_back(ticks);
+                m_connections.emplace_back();
+                memcpy(&m_connections.back().playerGuid, &buffer[dataPos], sizeof(uint64));
+                continue;
+            }
+
+            // traffic before the player login (auth, character list) is done by the replay client itself
+            if (itr == connectionIndex.end())
+                continue;
+
+            CapturedPacket packet;
+            packet.time = ticks - loginTime[itr->second];
+            packet.opcode = uint16(opcode);
+            packet.data.assign(buffer.begin() + dataPos, buffer.begin() + dataPos + dataSize);
+            m_connections[itr->second].packets.push_back(std::move(packet));
+        }
+
+        return true;
+    }
+}
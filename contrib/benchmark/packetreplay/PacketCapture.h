@@ -0,0 +1,61 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCHMARK_PACKETCAPTURE_H
+#define BENCHMARK_PACKETCAPTURE_H
+
+#include "Common.h"
+
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+    struct CapturedPacket
+    {
+        uint32 time;                                        // ms since the player login of its connection
+        uint16 opcode;
+        std::vector<uint8> data;
+    };
+
+    /// client to server traffic of one recorded world connection, starting with its CMSG_PLAYER_LOGIN
+    struct CapturedConnection
+    {
+        uint64 playerGuid = 0;
+        uint64 bytesReceived = 0;                           // server to client bytes of the recording
+        std::vector<CapturedPacket> packets;
+
+        uint32 GetDuration() const { return packets.empty() ? 0 : packets.back().time; }
+    };
+
+    /// Reader of PKT 3.1 files written by PacketLog (mangosd PacketLogFile option)
+    class PacketCapture
+    {
+        public:
+            bool Load(std::string const& fileName);
+
+            std::vector<CapturedConnection> const& GetConnections() const { return m_connections; }
+            uint32 GetBuild() const { return m_build; }
+
+        private:
+            std::vector<CapturedConnection> m_connections;
+            uint32 m_build = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,618 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \file
+/// Packet capture replay load generator: logs N synthetic clients into mangosd, each one on its own
+/// account and character, and replays the client to server traffic of one recorded connection of a
+/// PacketLog capture with its original timing. The recorded player guid is remapped to the guid of
+/// the synthetic client's character. Reports world update latency (CMSG_QUERY_TIME round trip, handled
+/// in the world update), bandwidth, the count of every replayed opcode and the request/response latency
+/// of the opcodes in s_requestOpcodes. Handler time of the other opcodes is only known by the server
+/// (.server opcodestats).
+
+#include "BenchClient.h"
+#include "LatencyStats.h"
+#include "PacketCapture.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Benchmark;
+
+struct Config
+{
+    std::string realmHost;
+    uint16 realmPort;
+    std::string worldHost;
+    uint16 worldPort;
+    std::string accountPrefix;
+    uint32 firstAccount;
+    std::string password;
+    uint32 realmId;
+    uint32 clients;
+    uint32 rampMs;
+    double speed;
+    bool loop;
+    uint32 duration;
+    uint32 reportInterval;
+    uint32 probeInterval;
+};
+
+// request opcodes answered by exactly one response to the sender, their round trip is reported as handler latency
+// other opcodes have no reply the client can match, their latency is not measured
+static std::map<uint16, std::pair<uint16, char const*>> const s_requestOpcodes =
+{
+    { 0x050, { 0x051, "CMSG_NAME_QUERY" } },
+    { 0x056, { 0x058, "CMSG_ITEM_QUERY_SINGLE" } },
+    { 0x05E, { 0x05F, "CMSG_GAMEOBJECT_QUERY" } },
+    { 0x060, { 0x061, "CMSG_CREATURE_QUERY" } },
+    { 0x062, { 0x063, "CMSG_WHO" } },
+    { 0x15D, { 0x160, "CMSG_LOOT" } },
+    { 0x17B, { 0x17D, "CMSG_GOSSIP_HELLO" } },
+    { 0x1CE, { 0x1CF, "CMSG_QUERY_TIME" } },
+    { 0x1DC, { 0x1DD, "CMSG_PING" } },
+};
+
+// recorded packets not replayed, login and time sync are done by the synthetic client itself
+static bool IsReplayed(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case OPCODE_CMSG_AUTH_SESSION:
+        case OPCODE_CMSG_CHAR_ENUM:
+        case OPCODE_CMSG_CHAR_CREATE:
+        case OPCODE_CMSG_CHAR_DELETE:
+        case OPCODE_CMSG_LOGOUT_REQUEST:
+        case OPCODE_CMSG_TIME_SYNC_RESP:
+        case OPCODE_CMSG_WARDEN_DATA:
+            return false;
+        default:
+            return true;
+    }
+}
+
+static std::vector<uint8> PackGuid(uint64 guid)
+{
+    std::vector<uint8> packed(1, 0);
+    for (int i = 0; i < 8; ++i)
+    {
+        if (uint8 byte = uint8(guid >> (i * 8)))
+        {
+            packed[0] |= uint8(1 << i);
+            packed.push_back(byte);
+        }
+    }
+    return packed;
+}
+
+class ReplayStats
+{
+    public:
+        void AddResponse(uint16 request, uint64 ns)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_opcodeLatency[request].Add(ns);
+            if (request == OPCODE_CMSG_QUERY_TIME)
+                m_tickInterval.Add(ns);
+        }
+
+        // world update latency of the last interval, cleared on call
+        std::string TakeTickSummary()
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            std::string summary = m_tickInterval.Summary(1000000.0);
+            m_tickInterval.Clear();
+            return summary;
+        }
+
+        std::map<uint16, LatencyStats>& GetOpcodeLatency() { return m_opcodeLatency; }
+
+        std::atomic<uint32> online{0};
+        std::atomic<uint32> failed{0};
+        std::atomic<uint64> packetsSent{0};
+
+    private:
+        std::mutex m_lock;
+        std::map<uint16, LatencyStats> m_opcodeLatency;
+        LatencyStats m_tickInterval;
+};
+
+class ReplayClient
+{
+    public:
+        ReplayClient(Config const& config, uint32 index, CapturedConnection const& connection, ReplayStats& stats) :
+            m_config(config), m_index(index), m_connection(connection), m_stats(stats), m_world(m_service), m_guid(0)
+        {
+            m_account = config.accountPrefix + std::to_string(config.firstAccount + index);
+        }
+
+        void Run(std::atomic<bool> const& stop);
+
+        uint64 GetBytesSent() const { return m_world.GetBytesSent(); }
+        uint64 GetBytesReceived() const { return m_world.GetBytesReceived(); }
+        // replayed packets per opcode, read after Run returned
+        std::map<uint16, uint64> const& GetReplayedOpcodes() const { return m_replayedOpcodes; }
+
+    private:
+        bool Login();
+        bool WaitFor(uint16 expected, ByteBuffer& body, uint16 failOpcode = 0);
+        bool Send(uint16 opcode, ByteBuffer const& body);
+        void ReadLoop();
+        ByteBuffer Remap(CapturedPacket const& packet) const;
+        std::string GetCharacterName() const;
+
+        Config const& m_config;
+        uint32 m_index;
+        CapturedConnection const& m_connection;
+        ReplayStats& m_stats;
+        std::string m_account;
+
+        boost::asio::io_service m_service;
+        WorldClient m_world;
+        uint64 m_guid;
+        SteadyClock::time_point m_start;
+
+        std::mutex m_sendLock;
+        std::mutex m_pendingLock;
+        std::map<uint16, std::deque<SteadyClock::time_point>> m_pending;   // response opcode -> send times of requests
+        std::map<uint16, uint64> m_replayedOpcodes;
+};
+
+std::string ReplayClient::GetCharacterName() const
+{
+    // names must be letters only
+    std::string name = "Bench";
+    uint32 value = m_config.firstAccount + m_index;
+    for (int i = 0; i < 6; ++i, value /= 26)
+        name.push_back(char('a' + value % 26));
+    return name;
+}
+
+bool ReplayClient::WaitFor(uint16 expected, ByteBuffer& body, uint16 failOpcode)
+{
+    uint16 opcode;
+    while (m_world.ReadPacket(opcode, body))
+    {
+        if (opcode == expected)
+            return true;
+        if (failOpcode && opcode == failOpcode)
+            return false;
+    }
+    return false;
+}
+
+bool ReplayClient::Login()
+{
+    RealmClient realm(m_service);
+    if (!realm.Connect(m_config.realmHost, m_config.realmPort) || !realm.LogonChallenge(m_account) ||
+            !realm.LogonProof(m_account, m_config.password))
+        return false;
+    realm.Close();
+
+    BigNumber K = realm.GetSessionKey();
+    if (!m_world.Connect(m_config.worldHost, m_config.worldPort))
+        return false;
+
+    ByteBuffer body;
+    int result = m_world.Authenticate(m_account, K, m_config.realmId);
+    if (result == AUTH_RESPONSE_WAIT_QUEUE)
+    {
+        // stay in queue until the server lets us in
+        do
+        {
+            if (!WaitFor(OPCODE_SMSG_AUTH_RESPONSE, body))
+                return false;
+        }
+        while (body.read<uint8>() != AUTH_RESPONSE_OK);
+    }
+    else if (result != AUTH_RESPONSE_OK)
+        return false;
+
+    for (int attempt = 0; attempt < 2 && !m_guid; ++attempt)
+    {
+        if (!m_world.SendPacket(OPCODE_CMSG_CHAR_ENUM, ByteBuffer()) || !WaitFor(OPCODE_SMSG_CHAR_ENUM, body))
+            return false;
+
+        if (body.read<uint8>() > 0)
+        {
+            m_guid = body.read<uint64>();
+            break;
+        }
+
+        // first use of the account, create a human warrior
+        ByteBuffer create;
+        create << GetCharacterName();
+        create << uint8(1) << uint8(1) << uint8(0);         // race, class, gender
+        create << uint8(0) << uint8(0) << uint8(0) << uint8(0) << uint8(0) << uint8(0);
+        if (!m_world.SendPacket(OPCODE_CMSG_CHAR_CREATE, create) || !WaitFor(OPCODE_SMSG_CHAR_CREATE, body) ||
+                body.read<uint8>() != CHAR_CREATE_SUCCESS)
+            return false;
+    }
+
+    if (!m_guid)
+        return false;
+
+    ByteBuffer login;
+    login << m_guid;
+    return m_world.SendPacket(OPCODE_CMSG_PLAYER_LOGIN, login) &&
+           WaitFor(OPCODE_SMSG_LOGIN_VERIFY_WORLD, body, OPCODE_SMSG_CHARACTER_LOGIN_FAILED);
+}
+
+bool ReplayClient::Send(uint16 opcode, ByteBuffer const& body)
+{
+    auto itr = s_requestOpcodes.find(opcode);
+    if (itr != s_requestOpcodes.end())
+    {
+        std::lock_guard<std::mutex> guard(m_pendingLock);
+        m_pending[itr->second.first].push_back(SteadyClock::now());
+    }
+
+    std::lock_guard<std::mutex> guard(m_sendLock);
+    return m_world.SendPacket(opcode, body);
+}
+
+void ReplayClient::ReadLoop()
+{
+    uint16 opcode;
+    ByteBuffer body;
+    while (m_world.ReadPacket(opcode, body))
+    {
+        if (opcode == OPCODE_SMSG_TIME_SYNC_REQ && body.size() >= 4)
+        {
+            ByteBuffer resp;
+            resp << body.read<uint32>();
+            resp << uint32(ElapsedNs(m_start) / 1000000);
+            Send(OPCODE_CMSG_TIME_SYNC_RESP, resp);
+            continue;
+        }
+
+        SteadyClock::time_point sent;
+        {
+            std::lock_guard<std::mutex> guard(m_pendingLock);
+            auto itr = m_pending.find(opcode);
+            if (itr == m_pending.end() || itr->second.empty())
+                continue;
+            sent = itr->second.front();
+            itr->second.pop_front();
+        }
+
+        for (auto const& request : s_requestOpcodes)
+        {
+            if (request.second.first == opcode)
+            {
+                m_stats.AddResponse(request.first, ElapsedNs(sent));
+                break;
+            }
+        }
+    }
+}
+
+ByteBuffer ReplayClient::Remap(CapturedPacket const& packet) const
+{
+    std::vector<uint8> data = packet.data;
+
+    // movement and ack packets start with the packed mover guid
+    std::vector<uint8> recordedPacked = PackGuid(m_connection.playerGuid);
+    if (data.size() >= recordedPacked.size() && std::equal(recordedPacked.begin(), recordedPacked.end(), data.begin()))
+    {
+        std::vector<uint8> packed = PackGuid(m_guid);
+        data.erase(data.begin(), data.begin() + recordedPacked.size());
+        data.insert(data.begin(), packed.begin(), packed.end());
+    }
+
+    // full guids anywhere in the packet
+    uint8 const* recorded = reinterpret_cast<uint8 const*>(&m_connection.playerGuid);
+    for (size_t i = 0; i + sizeof(uint64) <= data.size(); ++i)
+    {
+        if (memcmp(&data[i], recorded, sizeof(uint64)) == 0)
+        {
+            memcpy(&data[i], &m_guid, sizeof(uint64));
+            i += sizeof(uint64) - 1;
+        }
+    }
+
+    ByteBuffer body(data.size());
+    if (!data.empty())
+        body.append(data.data(), data.size());
+    return body;
+}
+
+void ReplayClient::Run(std::atomic<bool> const& stop)
+{
+    bool loggedIn = false;
+    try
+    {
+        loggedIn = Login();
+    }
+    catch (ByteBufferException const&)
+    {
+        // malformed reply, counted as failed login
+    }
+
+    if (!loggedIn)
+    {
+        ++m_stats.failed;
+        m_world.Close();
+        return;
+    }
+
+    ++m_stats.online;
+    m_start = SteadyClock::now();
+    std::thread reader(&ReplayClient::ReadLoop, this);
+
+    SteadyClock::time_point passStart = m_start;
+    SteadyClock::time_point nextProbe = m_start;
+    size_t next = 0;
+
+    while (!stop)
+    {
+        if (next == m_connection.packets.size())
+        {
+            if (!m_config.loop)
+                break;
+
+            next = 0;
+            passStart = SteadyClock::now();
+        }
+
+        CapturedPacket const& packet = m_connection.packets[next];
+        SteadyClock::time_point due = passStart + std::chrono::microseconds(uint64(packet.time * 1000.0 / m_config.speed));
+        SteadyClock::time_point now = SteadyClock::now();
+
+        if (m_config.probeInterval && nextProbe <= now)
+        {
+            if (!Send(OPCODE_CMSG_QUERY_TIME, ByteBuffer()))
+                break;
+            nextProbe = now + std::chrono::milliseconds(m_config.probeInterval);
+        }
+
+        if (due > now)
+        {
+            // wake up for probes and stop requests while waiting for the recorded time
+            SteadyClock::time_point wake = std::min(due, now + std::chrono::milliseconds(100));
+            if (m_config.probeInterval)
+                wake = std::min(wake, nextProbe);
+            std::this_thread::sleep_until(wake);
+            continue;
+        }
+
+        ++next;
+        if (!IsReplayed(packet.opcode))
+            continue;
+
+        if (!Send(packet.opcode, Remap(packet)))
+            break;
+        ++m_stats.packetsSent;
+        ++m_replayedOpcodes[packet.opcode];
+    }
+
+    m_world.Close();
+    reader.join();
+    --m_stats.online;
+}
+
+int main(int argc, char** argv)
+{
+    Config config;
+    std::string captureFile;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("help,h", "print usage message")
+    ("capture", boost::program_options::value<std::string>(&captureFile), "PacketLog capture file (PKT 3.1)")
+    ("realm-host", boost::program_options::value<std::string>(&config.realmHost)->default_value("127.0.0.1"), "realmd address")
+    ("realm-port", boost::program_options::value<uint16>(&config.realmPort)->default_value(3724), "realmd port")
+    ("world-host", boost::program_options::value<std::string>(&config.worldHost)->default_value("127.0.0.1"), "mangosd address")
+    ("world-port", boost::program_options::value<uint16>(&config.worldPort)->default_value(8085), "mangosd port")
+    ("realm-id", boost::program_options::value<uint32>(&config.realmId)->default_value(1), "realm id sent in CMSG_AUTH_SESSION")
+    ("prefix", boost::program_options::value<std::string>(&config.accountPrefix)->default_value("BENCH"), "account name prefix")
+    ("first-account", boost::program_options::value<uint32>(&config.firstAccount)->default_value(1), "number of the first account used")
+    ("password", boost::program_options::value<std::string>(&config.password)->default_value("BENCH"), "password of all accounts")
+    ("clients", boost::program_options::value<uint32>(&config.clients)->default_value(10), "number of synthetic clients, recorded connections are reused round robin")
+    ("ramp", boost::program_options::value<uint32>(&config.rampMs)->default_value(100), "delay between client logins in ms")
+    ("speed", boost::program_options::value<double>(&config.speed)->default_value(1.0), "replay speed factor")
+    ("loop", "restart the recorded traffic when it ends")
+    ("duration", boost::program_options::value<uint32>(&config.duration)->default_value(0), "stop after given seconds, 0 runs until all clients finished")
+    ("report", boost::program_options::value<uint32>(&config.reportInterval)->default_value(5), "seconds between reports")
+    ("probe", boost::program_options::value<uint32>(&config.probeInterval)->default_value(1000), "ms between CMSG_QUERY_TIME probes of each client, 0 disables");
+
+    boost::program_options::positional_options_description positional;
+    positional.add("capture", 1);
+
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        printf("ERROR: %s\n\n", e.what());
+        std::cout << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help") || captureFile.empty())
+    {
+        std::cout << "Usage: packetreplay [options] <capture>" << std::endl << desc << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    config.loop = vm.count("loop") > 0;
+    if (config.loop && !config.duration)
+    {
+        printf("ERROR: --loop needs --duration\n");
+        return 1;
+    }
+
+    if (config.speed <= 0.0 || !config.reportInterval)
+    {
+        printf("ERROR: speed and report must be greater than 0\n");
+        return 1;
+    }
+
+    // realmd upper cases account and password before hashing
+    std::transform(config.accountPrefix.begin(), config.accountPrefix.end(), config.accountPrefix.begin(), ::toupper);
+    std::transform(config.password.begin(), config.password.end(), config.password.begin(), ::toupper);
+
+    if (!InitCrypto())
+    {
+        printf("ERROR: can not load OpenSSL legacy provider\n");
+        return 1;
+    }
+
+    PacketCapture capture;
+    if (!capture.Load(captureFile))
+    {
+        printf("ERROR: can not read capture %s\n", captureFile.c_str());
+        return 1;
+    }
+
+    std::vector<CapturedConnection const*> connections;
+    uint64 recordedBytesSent = 0;
+    uint64 recordedBytesReceived = 0;
+    uint64 recordedDuration = 0;
+    for (CapturedConnection const& connection : capture.GetConnections())
+    {
+        if (connection.packets.empty())
+            continue;
+
+        connections.push_back(&connection);
+        for (CapturedPacket const& packet : connection.packets)
+            recordedBytesSent += packet.data.size() + 6;
+        recordedBytesReceived += connection.bytesReceived;
+        recordedDuration += connection.GetDuration();
+    }
+
+    if (connections.empty())
+    {
+        printf("ERROR: capture %s has no connection with a player login\n", captureFile.c_str());
+        return 1;
+    }
+
+    if (capture.GetBuild() != CLIENT_BUILD)
+        printf("WARNING: capture is from build %u, replay client is build %u\n", capture.GetBuild(), uint32(CLIENT_BUILD));
+
+    double recordedSeconds = std::max(recordedDuration / 1000.0, 0.001);
+    printf("Capture: %zu connections, recorded per connection avg %.1f kbit/s out, %.1f kbit/s in\n", connections.size(),
+           recordedBytesSent * 8 / 1000.0 / recordedSeconds, recordedBytesReceived * 8 / 1000.0 / recordedSeconds);
+
+    ReplayStats stats;
+    std::atomic<bool> stop(false);
+    std::atomic<uint32> started(0);
+    std::atomic<uint32> finished(0);
+    std::vector<std::unique_ptr<ReplayClient>> clients;
+    std::vector<std::thread> threads;
+
+    SteadyClock::time_point start = SteadyClock::now();
+    for (uint32 i = 0; i < config.clients; ++i)
+        clients.emplace_back(new ReplayClient(config, i, *connections[i % connections.size()], stats));
+
+    // logins are spread by the ramp delay, the starter thread keeps reporting independent of it
+    std::thread starter([&]()
+    {
+        for (uint32 i = 0; i < config.clients && !stop; ++i)
+        {
+            threads.emplace_back([&, i]() { clients[i]->Run(stop); ++finished; });
+            ++started;
+            std::this_thread::sleep_for(std::chrono::milliseconds(config.rampMs));
+        }
+    });
+
+    uint64 lastSent = 0;
+    uint64 lastReceived = 0;
+    uint64 lastPackets = 0;
+    SteadyClock::time_point lastReport = start;
+    bool starterDone = false;
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(config.reportInterval));
+
+        SteadyClock::time_point now = SteadyClock::now();
+        double interval = std::chrono::duration<double>(now - lastReport).count();
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        lastReport = now;
+
+        uint64 sent = 0;
+        uint64 received = 0;
+        for (auto const& client : clients)
+        {
+            sent += client->GetBytesSent();
+            received += client->GetBytesReceived();
+        }
+        uint64 packets = stats.packetsSent;
+
+        printf("[%5.0fs] online=%u failed=%u sent=%.0f pkt/s out=%.1f kbit/s in=%.1f kbit/s\n", elapsed,
+               stats.online.load(), stats.failed.load(), (packets - lastPackets) / interval,
+               (sent - lastSent) * 8 / 1000.0 / interval, (received - lastReceived) * 8 / 1000.0 / interval);
+        printf("        world update [ms] %s\n", stats.TakeTickSummary().c_str());
+        fflush(stdout);
+
+        lastSent = sent;
+        lastReceived = received;
+        lastPackets = packets;
+
+        if (config.duration && elapsed >= config.duration)
+            stop = true;
+
+        if (!starterDone && (stop || started == config.clients))
+        {
+            starter.join();
+            starterDone = true;
+        }
+
+        if (stop || (starterDone && finished == config.clients))
+            break;
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::map<uint16, uint64> replayed;
+    for (auto const& client : clients)
+        for (auto const& opcode : client->GetReplayedOpcodes())
+            replayed[opcode.first] += opcode.second;
+
+    // only requests with a matching response have a client side latency
+    printf("\nReplayed opcodes, request latency [ms] of the %zu opcodes with a matching response:\n", s_requestOpcodes.size());
+    for (auto const& opcode : replayed)
+    {
+        auto request = s_requestOpcodes.find(opcode.first);
+        auto latency = stats.GetOpcodeLatency().find(opcode.first);
+        if (request != s_requestOpcodes.end() && latency != stats.GetOpcodeLatency().end())
+            printf("  %-24s %10llu  %s\n", request->second.second, (unsigned long long)opcode.second, latency->second.Summary(1000000.0).c_str());
+        else
+            printf("  0x%03X %-18s %10llu  not measured\n", opcode.first, request != s_requestOpcodes.end() ? request->second.second : "", (unsigned long long)opcode.second);
+    }
+
+    printf("Handler time of all opcodes is shown by .server opcodestats on mangosd, reset it before the replay.\n");
+
+    return 0;
+}
@@ -56,6 +56,68 @@ void from_json(const json& j, rcConfig& config)
 
 namespace MMAP
 {
+    // FNV-1a over the input of a tile, only used to find the tiles whose input changed since last build
+    class TileInputHash
+    {
+        public:
+            TileInputHash() : m_hash(14695981039346656037ULL) {}
+
+            void add(void const* data, size_t size)
+            {
+                uint8 const* bytes = static_cast<uint8 const*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    m_hash ^= bytes[i];
+                    m_hash *= 1099511628211ULL;
+                }
+            }
+
+            template<typename T>
+            void add(T value) { add(&value, sizeof(T)); }
+
+            void add(std::string const& str)
+            {
+                add(uint32(str.size()));
+                add(str.data(), str.size());
+            }
+
+            // whole content of the file, missing file differs from an empty one
+            void addFile(std::string const& fileName)
+            {
+                FILE* file = fopen(fileName.c_str(), "rb");
+                add(uint8(file ? 1 : 0));
+                if (!file)
+                    return;
+
+                char buffer[64 * 1024];
+                size_t count;
+                while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+                    add(buffer, count);
+                fclose(file);
+            }
+
+            void add(TileBuilding const* building)
+            {
+                add(building->modelName);
+                add(building->x);
+                add(building->y);
+                add(building->z);
+                add(building->ori);
+                add(building->qx);
+                add(building->qy);
+                add(building->qz);
+                add(building->qw);
+                add(building->displayId);
+                add(building->tileNumber);
+                add(building->goEntry);
+            }
+
+            uint64 get() const { return m_hash; }
+
+        private:
+            uint64 m_hash;
+    };
+
     inline char const* GetDTErrorReason(dtStatus status) {
         if ((status & DT_WRONG_MAGIC) != 0)
             return "Reason: 'Input data is not recognized'";
@@ -76,15 +138,21 @@ namespace MMAP
     }
 
     MapBuilder::MapBuilder(const char* configInputPath, int threads, bool skipLiquid, bool skipContinents, bool skipJunkMaps,
-                           bool skipBattlegrounds, bool debug, bool buildAlternate, const char* offMeshFilePath, const char* workdir) :
+                           bool skipBattlegrounds, bool debug, bool buildAlternate, const char* offMeshFilePath, const char* workdir, bool forceRebuild) :
         m_taskQueue(new TaskQueue(this, threads)),
         m_debug(debug),
+        m_skipLiquid(skipLiquid),
+        m_forceRebuild(forceRebuild),
         m_skipContinents(skipContinents),
         m_skipJunkMaps(skipJunkMaps),
         m_skipBattlegrounds(skipBattlegrounds),
         m_buildAlternate(buildAlternate),
         m_offMeshFilePath(offMeshFilePath),
-        m_workdir(workdir)
+        m_workdir(workdir),
+        m_tilesNew(0),
+        m_tilesChanged(0),
+        m_tilesMissingOutput(0),
+        m_tilesSkipped(0)
     {
         std::ifstream jsonConfig(configInputPath);
         if (jsonConfig)
@@ -133,6 +201,11 @@ namespace MMAP
 
         // Wait all work to be done
         m_taskQueue->WaitAll();
+
+        for (auto& hashes : m_tileHashes)
+            saveTileHashes(hashes.first);
+
+        printBuildReport();
     }
 
     /**************************************************************************/
@@ -578,8 +651,14 @@ namespace MMAP
             return;
         }
 
+        loadTileHashes(mapID);
+        uint64 hash = getTileInputHash(mapID, tileX, tileY);
+
         buildTile(mapID, tileX, tileY, navMesh, 1, 1);
         dtFreeNavMesh(navMesh);
+
+        storeTileHash(mapID, tileX, tileY, hash);
+        saveTileHashes(mapID);
     }
 
     /**************************************************************************/
@@ -617,6 +696,14 @@ namespace MMAP
         // now start building mmtiles for each tile
         printf("[Map %03i] We have %u tiles.                          \n", mapID, uint32(tiles.size()));
 
+        // workers store the hashes of the tiles they build meanwhile, so check against a copy taken under the lock
+        loadTileHashes(mapID);
+        TileHashes builtHashes;
+        {
+            std::lock_guard<std::mutex> guard(m_tileHashLock);
+            builtHashes = m_tileHashes[mapID];
+        }
+
         uint32 currentTile = 0;
         for (std::set<uint32>::iterator it = tiles.begin(); it != tiles.end(); ++it)
         {
@@ -626,8 +713,25 @@ namespace MMAP
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
-                continue;
+            // skip tiles built from the same input, unless their navmesh tile was removed since
+            uint64 hash = getTileInputHash(mapID, tileX, tileY);
+            if (!m_forceRebuild)
+            {
+                auto builtItr = builtHashes.find(*it);
+                if (builtItr == builtHashes.end())
+                    ++m_tilesNew;
+                else if (builtItr->second.hash != hash)
+                    ++m_tilesChanged;
+                else if (builtItr->second.hasOutput && !shouldSkipTile(mapID, tileX, tileY))
+                    ++m_tilesMissingOutput;
+                else
+                {
+                    ++m_tilesSkipped;
+                    continue;
+                }
+            }
+            else
+                ++m_tilesChanged;
 
             // Make a copy of the original navMesh object to work on a separate
             // thread since "the data should not be reused in other nav meshes"
@@ -649,6 +753,8 @@ namespace MMAP
 
                 // free this navmesh
                 dtFreeNavMesh(navMeshCopy);
+
+                storeTileHash(mapID, tileX, tileY, hash);
             };
 
             m_taskQueue->PushWork(builder, mapID);
@@ -1400,4 +1506,195 @@ namespace MMAP
 
         return config;
     }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        TileInputHash hash;
+        hash.add(uint32(MMAP_VERSION));
+        hash.add(uint32(DT_NAVMESH_VERSION));
+
+        // terrain of the tile and of its neighbours, their borders are added to the tile (see TerrainBuilder::loadMap)
+        static int const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        char fileName[255];
+        for (auto const& neighbour : neighbours)
+        {
+            sprintf(fileName, "%s/maps/%03u%02u%02u.map", m_workdir, mapID, tileY + neighbour[1], tileX + neighbour[0]);
+            hash.add(getFileHash(fileName));
+        }
+
+        // model spawns of the tile (see TerrainBuilder::loadVMap). The .vmtree of a tiled map only holds the tree
+        // over all its spawns and changes with any of them, only a non tiled map keeps its global model there
+        sprintf(fileName, "%s/vmaps/%03u.vmtree", m_workdir, mapID);
+        if (!isTiledVMap(fileName))
+            hash.add(getFileHash(fileName));
+        hash.add(getFileHash(std::string(m_workdir) + "/vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX)));
+
+        // off mesh connections of the tile only, same parsing as TerrainBuilder::loadOffMeshConnections
+        if (FILE* fp = m_offMeshFilePath ? fopen(m_offMeshFilePath, "rb") : nullptr)
+        {
+            char buf[512];
+            while (fgets(buf, sizeof(buf), fp))
+            {
+                float p0[3], p1[3];
+                int mid, tx, ty;
+                float size;
+                if (sscanf(buf, "%d %d,%d (%f %f %f) (%f %f %f) %f", &mid, &tx, &ty,
+                    &p0[0], &p0[1], &p0[2], &p1[0], &p1[1], &p1[2], &size) != 10)
+                    continue;
+
+                if (mapID != mid || tileX != tx || tileY != ty)
+                    continue;
+
+                hash.add(std::string(buf));
+            }
+            fclose(fp);
+        }
+
+        // build settings
+        hash.add(getTileConfig(mapID, tileX, tileY).dump());
+        hash.add(m_skipLiquid);
+        hash.add(m_buildAlternate);
+
+        // gameobject models that give alternate tiles
+        std::vector<TileBuilding const*> buildingsByDefault;
+        std::map<uint32, std::vector<TileBuilding const*>> buildingsInTile;
+        std::map<uint32, std::vector<TileBuilding const*>> buildingsByGroup;
+        std::map<uint32, uint32> flagToGroup;
+
+        std::tie(buildingsByDefault, buildingsInTile, buildingsByGroup, flagToGroup) = GameobjectModelData::GetTileBuildingData(mapID, tileX, tileY, m_modelList);
+
+        for (TileBuilding const* building : buildingsByDefault)
+            hash.add(building);
+
+        for (auto const* buildings : { &buildingsInTile, &buildingsByGroup })
+        {
+            hash.add(uint32(buildings->size()));
+            for (auto const& data : *buildings)
+            {
+                hash.add(data.first);
+                for (TileBuilding const* building : data.second)
+                    hash.add(building);
+            }
+        }
+
+        return hash.get();
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getFileHash(std::string const& fileName)
+    {
+        // a .map file is input of up to five tiles, read it only once
+        {
+            std::lock_guard<std::mutex> guard(m_fileHashLock);
+            auto itr = m_fileHashes.find(fileName);
+            if (itr != m_fileHashes.end())
+                return itr->second;
+        }
+
+        TileInputHash hash;
+        hash.addFile(fileName);
+
+        std::lock_guard<std::mutex> guard(m_fileHashLock);
+        m_fileHashes[fileName] = hash.get();
+        return hash.get();
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::isTiledVMap(char const* fileName)
+    {
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        // same header as read by StaticMapTree::InitMap
+        char magic[8];
+        uint8 tiled = 0;
+        bool success = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && fread(&tiled, 1, 1, file) == 1 &&
+                       memcmp(magic, VMAP_MAGIC, sizeof(magic)) == 0;
+        fclose(file);
+
+        return success && tiled != 0;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::loadTileHashes(uint32 mapID)
+    {
+        std::lock_guard<std::mutex> guard(m_tileHashLock);
+
+        if (m_tileHashes.find(mapID) != m_tileHashes.end())
+            return;
+
+        TileHashes& hashes = m_tileHashes[mapID];
+
+        char fileName[255];
+        sprintf(fileName, "%s/mmaps/%03u.mmhash", m_workdir, mapID);
+        FILE* file = fopen(fileName, "r");
+        if (!file)
+            return;
+
+        // records are appended as tiles are done, the last one of a tile is the valid one
+        uint32 tileX, tileY, hasOutput;
+        unsigned long long hash;
+        while (fscanf(file, "%u %u %llx %u", &tileX, &tileY, &hash, &hasOutput) == 4)
+            hashes[StaticMapTree::packTileID(tileX, tileY)] = { uint64(hash), hasOutput != 0 };
+
+        fclose(file);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::saveTileHashes(uint32 mapID)
+    {
+        std::lock_guard<std::mutex> guard(m_tileHashLock);
+
+        char fileName[255];
+        sprintf(fileName, "%s/mmaps/%03u.mmhash", m_workdir, mapID);
+        FILE* file = fopen(fileName, "w");
+        if (!file)
+        {
+            printf("[Map %03i] Failed to open %s for writing, tiles will be rebuilt next time!\n", mapID, fileName);
+            return;
+        }
+
+        for (auto const& record : m_tileHashes[mapID])
+        {
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(record.first, tileX, tileY);
+            fprintf(file, "%u %u %016llx %u\n", tileX, tileY, (unsigned long long)record.second.hash, record.second.hasOutput ? 1 : 0);
+        }
+
+        fclose(file);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::storeTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 hash)
+    {
+        // tile with no data is remembered too, it is not worth to try it again with the same input
+        bool hasOutput = shouldSkipTile(mapID, tileX, tileY);
+
+        std::lock_guard<std::mutex> guard(m_tileHashLock);
+
+        m_tileHashes[mapID][StaticMapTree::packTileID(tileX, tileY)] = { hash, hasOutput };
+
+        // appended at once, so tiles done before an interrupted build are not built again
+        char fileName[255];
+        sprintf(fileName, "%s/mmaps/%03u.mmhash", m_workdir, mapID);
+        if (FILE* file = fopen(fileName, "a"))
+        {
+            fprintf(file, "%u %u %016llx %u\n", tileX, tileY, (unsigned long long)hash, hasOutput ? 1 : 0);
+            fclose(file);
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::printBuildReport() const
+    {
+        uint32 built = m_tilesNew + m_tilesChanged + m_tilesMissingOutput;
+
+        printf("\nTiles built: %u, skipped with unchanged input: %u\n", built, m_tilesSkipped);
+        if (m_forceRebuild)
+            printf("* all tiles forced to be rebuilt\n");
+        else
+            printf("* new: %u, changed input: %u, missing navmesh tile: %u\n", m_tilesNew, m_tilesChanged, m_tilesMissingOutput);
+    }
 }
@@ -23,6 +23,7 @@
 #include <set>
 #include <map>
 #include <future>
+#include <mutex>
 #include <sstream>
 
 #include "TerrainBuilder.h"
@@ -62,6 +63,14 @@ namespace MMAP
     typedef std::set<uint32> MapSet;
     typedef std::unique_ptr<TaskQueue> TaskQueueUPtr;
 
+    // input hash of a tile at its last build, stored per map in mmaps/###.mmhash
+    struct TileHashRecord
+    {
+        uint64 hash;
+        bool hasOutput;                                     // false when the input did not give any navmesh tile
+    };
+    typedef std::map<uint32, TileHashRecord> TileHashes;
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -93,7 +102,8 @@ namespace MMAP
                        bool debug               = false,
                        bool buildAlternate      = true,
                        const char* offMeshFilePath = NULL,
-                       const char* workdir = NULL);
+                       const char* workdir = NULL,
+                       bool forceRebuild        = false);
 
             ~MapBuilder();
 
@@ -137,10 +147,21 @@ namespace MMAP
             json getMapIdConfig(uint32 mapId);
             json getTileConfig(uint32 mapId, uint32 tileX, uint32 tileY);
 
+            // incremental build, tiles are only rebuilt when the hash of their input changed
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            uint64 getFileHash(std::string const& fileName);
+            bool isTiledVMap(char const* fileName);
+            void loadTileHashes(uint32 mapID);
+            void saveTileHashes(uint32 mapID);
+            void storeTileHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 hash);
+            void printBuildReport() const;
+
             TerrainBuilder* m_terrainBuilder;
             TileList m_tiles;
 
             bool m_debug;
+            bool m_skipLiquid;
+            bool m_forceRebuild;
 
             const char* m_offMeshFilePath;
             const char* m_workdir;
@@ -161,6 +182,19 @@ namespace MMAP
             MapSet m_mapDone;
 
             ModelList m_modelList;
+
+            std::map<uint32, TileHashes> m_tileHashes;
+            std::mutex m_tileHashLock;
+
+            // content hashes of input files, shared by neighbouring tiles
+            std::map<std::string, uint64> m_fileHashes;
+            std::mutex m_fileHashLock;
+
+            // build report
+            uint32 m_tilesNew;
+            uint32 m_tilesChanged;
+            uint32 m_tilesMissingOutput;
+            uint32 m_tilesSkipped;
     };
 
     // Task queue : not thread safe (do not add worker asynchronously)
@@ -86,6 +86,7 @@ void printUsage()
     printf("--buildAlternate : builds only tiles with GOs inside (including default tile)\n\n");
     printf("--threads [#]: specifies number of threads to use for maps processing\n\n");
     printf("--workdir [directory] : Path to basedir of maps/vmaps.\n\n");
+    printf("--forceRebuild : rebuild all tiles, even when their input did not change since last build\n\n");
     printf("Example:\nmovemapgen (generate all mmap with default arg\n"
            "movemapgen \"1 0 169\" (generate maps 1, 0 and 169)\n"
            "movemapgen 0 --tile 34,46 (builds only tile 34,46 of map 0)\n\n");
@@ -107,7 +108,8 @@ bool handleArgs(int argc, char** argv,
                 char*& offMeshInputPath,
                 char*& configInputPath,
                 int& threads,
-                char*& workdir)
+                char*& workdir,
+                bool& forceRebuild)
 {
     char* param = NULL;
     workdir = "./";
@@ -165,6 +167,10 @@ bool handleArgs(int argc, char** argv,
         {
             buildGameObjects = true;
         }
+        else if (strcmp(argv[i], "--forceRebuild") == 0)
+        {
+            forceRebuild = true;
+        }
         else if (strcmp(argv[i], "--buildAlternate") == 0)
         {
             buildAlternate = true;
@@ -253,6 +259,7 @@ int main(int argc, char** argv)
     bool silent = false;
     bool buildGameObjects = false;
     bool buildAlternate = false;
+    bool forceRebuild = false;
 
     char* offMeshInputPath = "offmesh.txt";
     char* configInputPath = "config.json";
@@ -261,7 +268,7 @@ int main(int argc, char** argv)
     bool validParam = handleArgs(argc, argv, mapIds, tileX, tileY, skipLiquid,
                                  skipContinents, skipJunkMaps, skipBattlegrounds,
                                  debug, silent, buildGameObjects, buildAlternate,
-                                 offMeshInputPath, configInputPath, threads, workdir);
+                                 offMeshInputPath, configInputPath, threads, workdir, forceRebuild);
 
     if (!validParam)
     {
@@ -292,7 +299,7 @@ int main(int argc, char** argv)
     if (!checkDirectories(debug, workdir))
         return -3;
 
-    MapBuilder builder(configInputPath, threads, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds, debug, buildAlternate, offMeshInputPath, workdir);
+    MapBuilder builder(configInputPath, threads, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds, debug, buildAlternate, offMeshInputPath, workdir, forceRebuild);
 
     if (mapIds.size() == 1 && tileX > -1 && tileY > -1)
         builder.buildSingleTile(mapIds.front(), tileX, tileY);
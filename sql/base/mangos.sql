@@ -24,7 +24,7 @@ CREATE TABLE `db_version` (
   `version` varchar(120) DEFAULT NULL,
   `creature_ai_version` varchar(120) DEFAULT NULL,
   `cache_id` int(10) DEFAULT '0',
-  `required_14082_01_mangos_spell_template` bit(1) DEFAULT NULL
+  `required_14086_01_mangos_table_change_counter` bit(1) DEFAULT NULL
 ) ENGINE=MyISAM DEFAULT CHARSET=utf8 ROW_FORMAT=DYNAMIC COMMENT='Used DB version notes';
 
 --
@@ -871,7 +871,9 @@ INSERT INTO `command` VALUES
 ('send mass money',3,'Syntax: .send mass money #racemask|$racename|alliance|horde|all \"#subject\" \"#text\" #money\r\n\r\nSend mail with money to players. Subject and mail text must be in \"\".'),
 ('send message',3,'Syntax: .send message $playername $message\r\n\r\nSend screen message to player from ADMINISTRATOR.'),
 ('send money',3,'Syntax: .send money #playername \"#subject\" \"#text\" #money\r\n\r\nSend mail with money to a player. Subject and mail text must be in \"\".'),
+('server bufferpool',3,'Syntax: .server bufferpool\r\n\r\nShow hits, misses, hit rate and oversized requests of the packet buffer pool and the size of the buffers it keeps.'),
 ('server corpses',2,'Syntax: .server corpses\r\n\r\nTriggering corpses expire check in world.'),
+('server dbscriptstats',3,'Syntax: .server dbscriptstats [#count] [reset]\r\n\r\nShow the #count (default 10) db scripts with the most total step time, then most steps, over all maps, with step count, total, average and maximum step time in microseconds. With reset the collected stats are cleared afterwards.'),
 ('server exit',4,'Syntax: .server exit\r\n\r\nTerminate mangosd NOW. Exit code 0.'),
 ('server idlerestart',3,'Syntax: .server idlerestart #delay\r\n\r\nRestart the server after #delay seconds if no active connections are present (no players). Use #exist_code or 2 as program exist code.'),
 ('server idlerestart cancel',3,'Syntax: .server idlerestart cancel\r\n\r\nCancel the restart/shutdown timer if any.'),
@@ -881,6 +883,7 @@ INSERT INTO `command` VALUES
 ('server log filter',4,'Syntax: .server log filter [($filtername|all) (on|off)]\r\n\r\nShow or set server log filters. If used \"all\" then all filters will be set to on/off state.'),
 ('server log level',4,'Syntax: .server log level [#level]\r\n\r\nShow or set server log level (0 - errors only, 1 - basic, 2 - detail, 3 - debug).'),
 ('server motd',0,'Syntax: .server motd\r\n\r\nShow server Message of the day.'),
+('server opcodestats',3,'Syntax: .server opcodestats [world|map|network] [#count] [reset]\r\n\r\nShow the #count (default 10) packet handlers of the world, map or network thread (default world) with the most total handling time, with call count, average, median, 99th percentile and maximum time in microseconds. With reset the collected times of that thread are cleared afterwards. Requires PacketHandlerStats enabled.'),
 ('server plimit',3,'Syntax: .server plimit [#num|-1|-2|-3|reset|player|moderator|gamemaster|administrator]\r\n\r\nWithout arg show current player amount and security level limitations for login to server, with arg set player linit ($num > 0) or securiti limitation ($num < 0 or security leme name. With `reset` sets player limit to the one in the config file'),
 ('server restart',3,'Syntax: .server restart #delay\r\n\r\nRestart the server after #delay seconds. Use #exist_code or 2 as program exist code.'),
 ('server restart cancel',3,'Syntax: .server restart cancel\r\n\r\nCancel the restart/shutdown timer if any.'),
@@ -19808,6 +19811,26 @@ INSERT INTO `spell_threat` VALUES
 /*!40000 ALTER TABLE `spell_threat` ENABLE KEYS */;
 UNLOCK TABLES;
 
+--
+-- Table structure for table `table_change_counter`
+--
+
+DROP TABLE IF EXISTS `table_change_counter`;
+CREATE TABLE `table_change_counter` (
+  `table_name` varchar(64) NOT NULL DEFAULT '' COMMENT 'World table name',
+  `counter` bigint(20) unsigned NOT NULL DEFAULT '0' COMMENT 'Changed rows of the table',
+  PRIMARY KEY (`table_name`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8 COMMENT='Row change counters of template tables, kept by tcc_ triggers';
+
+--
+-- Dumping data for table `table_change_counter`
+--
+
+LOCK TABLES `table_change_counter` WRITE;
+/*!40000 ALTER TABLE `table_change_counter` DISABLE KEYS */;
+/*!40000 ALTER TABLE `table_change_counter` ENABLE KEYS */;
+UNLOCK TABLES;
+
 --
 -- Table structure for table `taxi_shortcuts`
 --
@@ -20066,6 +20089,68 @@ LOCK TABLES `world_template` WRITE;
 /*!40000 ALTER TABLE `world_template` DISABLE KEYS */;
 /*!40000 ALTER TABLE `world_template` ENABLE KEYS */;
 UNLOCK TABLES;
+--
+-- Triggers counting row changes for table_change_counter
+--
+
+CREATE TRIGGER `tcc_area_group_template_ins` AFTER INSERT ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_area_group_template_upd` AFTER UPDATE ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_area_group_template_del` AFTER DELETE ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_conditions_ins` AFTER INSERT ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_conditions_upd` AFTER UPDATE ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_conditions_del` AFTER DELETE ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_addon_ins` AFTER INSERT ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_addon_upd` AFTER UPDATE ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_addon_del` AFTER DELETE ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_conditional_spawn_ins` AFTER INSERT ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_conditional_spawn_upd` AFTER UPDATE ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_conditional_spawn_del` AFTER DELETE ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_equip_template_ins` AFTER INSERT ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_equip_template_upd` AFTER UPDATE ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_equip_template_del` AFTER DELETE ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_model_info_ins` AFTER INSERT ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_model_info_upd` AFTER UPDATE ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_model_info_del` AFTER DELETE ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_ins` AFTER INSERT ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_upd` AFTER UPDATE ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_del` AFTER DELETE ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_addon_ins` AFTER INSERT ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_addon_upd` AFTER UPDATE ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_creature_template_addon_del` AFTER DELETE ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_gameobject_template_ins` AFTER INSERT ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_gameobject_template_upd` AFTER UPDATE ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_gameobject_template_del` AFTER DELETE ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_ins` AFTER INSERT ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_upd` AFTER UPDATE ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_del` AFTER DELETE ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_template_ins` AFTER INSERT ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_template_upd` AFTER UPDATE ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_instance_template_del` AFTER DELETE ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_item_template_ins` AFTER INSERT ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_item_template_upd` AFTER UPDATE ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_item_template_del` AFTER DELETE ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_page_text_ins` AFTER INSERT ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_page_text_upd` AFTER UPDATE ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_page_text_del` AFTER DELETE ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_cone_ins` AFTER INSERT ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_cone_upd` AFTER UPDATE ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_cone_del` AFTER DELETE ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_script_target_ins` AFTER INSERT ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_script_target_upd` AFTER UPDATE ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_script_target_del` AFTER DELETE ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_template_ins` AFTER INSERT ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_template_upd` AFTER UPDATE ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_spell_template_del` AFTER DELETE ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_vehicle_accessory_ins` AFTER INSERT ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_vehicle_accessory_upd` AFTER UPDATE ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_vehicle_accessory_del` AFTER DELETE ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_safe_locs_ins` AFTER INSERT ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_safe_locs_upd` AFTER UPDATE ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_safe_locs_del` AFTER DELETE ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_template_ins` AFTER INSERT ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_template_upd` AFTER UPDATE ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+CREATE TRIGGER `tcc_world_template_del` AFTER DELETE ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+
 /*!40103 SET TIME_ZONE=@OLD_TIME_ZONE */;
 
 /*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
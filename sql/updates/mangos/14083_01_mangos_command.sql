@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_14082_01_mangos_spell_template required_14083_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server dbscriptstats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('server dbscriptstats', 3, 'Syntax: .server dbscriptstats [#count] [reset]\r\n\r\nShow the #count (default 10) db scripts with the most total step time, then most steps, over all maps, with step count, total, average and maximum step time in microseconds. With reset the collected stats are cleared afterwards.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_14083_01_mangos_command required_14084_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server opcodestats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('server opcodestats', 3, 'Syntax: .server opcodestats [world|map|network] [#count] [reset]\r\n\r\nShow the #count (default 10) packet handlers of the world, map or network thread (default world) with the most total handling time, with call count, average, median, 99th percentile and maximum time in microseconds. With reset the collected times of that thread are cleared afterwards. Requires PacketHandlerStats enabled.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_14084_01_mangos_command required_14085_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server bufferpool');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('server bufferpool', 3, 'Syntax: .server bufferpool\r\n\r\nShow hits, misses, hit rate and oversized requests of the packet buffer pool and the size of the buffers it keeps.');
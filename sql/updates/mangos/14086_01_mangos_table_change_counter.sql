@@ -0,0 +1,124 @@
+ALTER TABLE db_version CHANGE COLUMN required_14085_01_mangos_command required_14086_01_mangos_table_change_counter bit;
+
+-- row change counters for the world table snapshots (WorldDataSnapshotDir)
+DROP TABLE IF EXISTS `table_change_counter`;
+CREATE TABLE `table_change_counter` (
+  `table_name` varchar(64) NOT NULL DEFAULT '' COMMENT 'World table name',
+  `counter` bigint(20) unsigned NOT NULL DEFAULT '0' COMMENT 'Changed rows of the table',
+  PRIMARY KEY (`table_name`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8 COMMENT='Row change counters of template tables, kept by tcc_ triggers';
+
+DROP TRIGGER IF EXISTS `tcc_area_group_template_ins`;
+CREATE TRIGGER `tcc_area_group_template_ins` AFTER INSERT ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_area_group_template_upd`;
+CREATE TRIGGER `tcc_area_group_template_upd` AFTER UPDATE ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_area_group_template_del`;
+CREATE TRIGGER `tcc_area_group_template_del` AFTER DELETE ON `area_group_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('area_group_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_conditions_ins`;
+CREATE TRIGGER `tcc_conditions_ins` AFTER INSERT ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_conditions_upd`;
+CREATE TRIGGER `tcc_conditions_upd` AFTER UPDATE ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_conditions_del`;
+CREATE TRIGGER `tcc_conditions_del` AFTER DELETE ON `conditions` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('conditions', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_addon_ins`;
+CREATE TRIGGER `tcc_creature_addon_ins` AFTER INSERT ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_addon_upd`;
+CREATE TRIGGER `tcc_creature_addon_upd` AFTER UPDATE ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_addon_del`;
+CREATE TRIGGER `tcc_creature_addon_del` AFTER DELETE ON `creature_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_conditional_spawn_ins`;
+CREATE TRIGGER `tcc_creature_conditional_spawn_ins` AFTER INSERT ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_conditional_spawn_upd`;
+CREATE TRIGGER `tcc_creature_conditional_spawn_upd` AFTER UPDATE ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_conditional_spawn_del`;
+CREATE TRIGGER `tcc_creature_conditional_spawn_del` AFTER DELETE ON `creature_conditional_spawn` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_conditional_spawn', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_equip_template_ins`;
+CREATE TRIGGER `tcc_creature_equip_template_ins` AFTER INSERT ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_equip_template_upd`;
+CREATE TRIGGER `tcc_creature_equip_template_upd` AFTER UPDATE ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_equip_template_del`;
+CREATE TRIGGER `tcc_creature_equip_template_del` AFTER DELETE ON `creature_equip_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_equip_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_model_info_ins`;
+CREATE TRIGGER `tcc_creature_model_info_ins` AFTER INSERT ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_model_info_upd`;
+CREATE TRIGGER `tcc_creature_model_info_upd` AFTER UPDATE ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_model_info_del`;
+CREATE TRIGGER `tcc_creature_model_info_del` AFTER DELETE ON `creature_model_info` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_model_info', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_ins`;
+CREATE TRIGGER `tcc_creature_template_ins` AFTER INSERT ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_upd`;
+CREATE TRIGGER `tcc_creature_template_upd` AFTER UPDATE ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_del`;
+CREATE TRIGGER `tcc_creature_template_del` AFTER DELETE ON `creature_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_addon_ins`;
+CREATE TRIGGER `tcc_creature_template_addon_ins` AFTER INSERT ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_addon_upd`;
+CREATE TRIGGER `tcc_creature_template_addon_upd` AFTER UPDATE ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_creature_template_addon_del`;
+CREATE TRIGGER `tcc_creature_template_addon_del` AFTER DELETE ON `creature_template_addon` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('creature_template_addon', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_gameobject_template_ins`;
+CREATE TRIGGER `tcc_gameobject_template_ins` AFTER INSERT ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_gameobject_template_upd`;
+CREATE TRIGGER `tcc_gameobject_template_upd` AFTER UPDATE ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_gameobject_template_del`;
+CREATE TRIGGER `tcc_gameobject_template_del` AFTER DELETE ON `gameobject_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('gameobject_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_dungeon_encounters_ins`;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_ins` AFTER INSERT ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_dungeon_encounters_upd`;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_upd` AFTER UPDATE ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_dungeon_encounters_del`;
+CREATE TRIGGER `tcc_instance_dungeon_encounters_del` AFTER DELETE ON `instance_dungeon_encounters` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_dungeon_encounters', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_template_ins`;
+CREATE TRIGGER `tcc_instance_template_ins` AFTER INSERT ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_template_upd`;
+CREATE TRIGGER `tcc_instance_template_upd` AFTER UPDATE ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_instance_template_del`;
+CREATE TRIGGER `tcc_instance_template_del` AFTER DELETE ON `instance_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('instance_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_item_template_ins`;
+CREATE TRIGGER `tcc_item_template_ins` AFTER INSERT ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_item_template_upd`;
+CREATE TRIGGER `tcc_item_template_upd` AFTER UPDATE ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_item_template_del`;
+CREATE TRIGGER `tcc_item_template_del` AFTER DELETE ON `item_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('item_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_page_text_ins`;
+CREATE TRIGGER `tcc_page_text_ins` AFTER INSERT ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_page_text_upd`;
+CREATE TRIGGER `tcc_page_text_upd` AFTER UPDATE ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_page_text_del`;
+CREATE TRIGGER `tcc_page_text_del` AFTER DELETE ON `page_text` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('page_text', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_cone_ins`;
+CREATE TRIGGER `tcc_spell_cone_ins` AFTER INSERT ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_cone_upd`;
+CREATE TRIGGER `tcc_spell_cone_upd` AFTER UPDATE ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_cone_del`;
+CREATE TRIGGER `tcc_spell_cone_del` AFTER DELETE ON `spell_cone` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_cone', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_script_target_ins`;
+CREATE TRIGGER `tcc_spell_script_target_ins` AFTER INSERT ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_script_target_upd`;
+CREATE TRIGGER `tcc_spell_script_target_upd` AFTER UPDATE ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_script_target_del`;
+CREATE TRIGGER `tcc_spell_script_target_del` AFTER DELETE ON `spell_script_target` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_script_target', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_template_ins`;
+CREATE TRIGGER `tcc_spell_template_ins` AFTER INSERT ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_template_upd`;
+CREATE TRIGGER `tcc_spell_template_upd` AFTER UPDATE ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_spell_template_del`;
+CREATE TRIGGER `tcc_spell_template_del` AFTER DELETE ON `spell_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('spell_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_vehicle_accessory_ins`;
+CREATE TRIGGER `tcc_vehicle_accessory_ins` AFTER INSERT ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_vehicle_accessory_upd`;
+CREATE TRIGGER `tcc_vehicle_accessory_upd` AFTER UPDATE ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_vehicle_accessory_del`;
+CREATE TRIGGER `tcc_vehicle_accessory_del` AFTER DELETE ON `vehicle_accessory` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('vehicle_accessory', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_safe_locs_ins`;
+CREATE TRIGGER `tcc_world_safe_locs_ins` AFTER INSERT ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_safe_locs_upd`;
+CREATE TRIGGER `tcc_world_safe_locs_upd` AFTER UPDATE ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_safe_locs_del`;
+CREATE TRIGGER `tcc_world_safe_locs_del` AFTER DELETE ON `world_safe_locs` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_safe_locs', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_template_ins`;
+CREATE TRIGGER `tcc_world_template_ins` AFTER INSERT ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_template_upd`;
+CREATE TRIGGER `tcc_world_template_upd` AFTER UPDATE ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
+DROP TRIGGER IF EXISTS `tcc_world_template_del`;
+CREATE TRIGGER `tcc_world_template_del` AFTER DELETE ON `world_template` FOR EACH ROW INSERT INTO `table_change_counter` VALUES ('world_template', 1) ON DUPLICATE KEY UPDATE `counter` = `counter` + 1;
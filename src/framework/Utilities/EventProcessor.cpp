@@ -18,6 +18,12 @@
 
 #include "EventProcessor.h"
 
+SlabPool& BasicEvent::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("event", 256);
+    return *pool;
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
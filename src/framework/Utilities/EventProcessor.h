@@ -20,6 +20,7 @@
 #define __EVENTPROCESSOR_H
 
 #include "Platform/Define.h"
+#include "Util/SlabPool.h"
 
 #include <map>
 
@@ -38,6 +39,11 @@ class BasicEvent
         {
         };
 
+        // all event types share one pool, each size with own slabs
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
         // e_time is execution time, p_time is update interval
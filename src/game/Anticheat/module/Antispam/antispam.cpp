@@ -26,27 +26,6 @@
 #include <cstdio>
 #include <sstream>
 
-namespace
-{
-// gets the highest level toon on a given account, for enforcing anti spam max level, or 0 if not available
-uint32 GetAccountLevel(uint32 accountId)
-{
-    if (auto const session = sWorld.FindSession(accountId))
-    {
-        auto accountLevel = session->GetAccountMaxLevel();
-
-        // slight adjustment to account level logic to account for increasing character levels in the session
-        if (auto const player = session->GetPlayer())
-            if (player->GetLevel() > accountLevel)
-                accountLevel = player->GetLevel();
-
-        return accountLevel;
-    }
-
-    return 0;
-}
-}
-
 namespace NamreebAnticheat
 {
 float Antispam::Rate() const
@@ -61,7 +40,7 @@ float Antispam::Rate() const
     return Total() / (seconds * MINUTE);
 }
 
-void Antispam::Notify(const char *format, ...)
+void Antispam::Notify(std::vector<AntispamReport> &reports, const char *format, ...)
 {
     // if it is too soon, do nothing
     if ((_lastNotification + sAnticheatConfig.GetAntispamBlacklistNotifyCooldown() * MINUTE * IN_MILLISECONDS) > WorldTimer::getMSTime())
@@ -69,147 +48,50 @@ void Antispam::Notify(const char *format, ...)
 
     _lastNotification = WorldTimer::getMSTime();
 
-    auto const session = sWorld.FindSession(_account);
-
-    // do not log or notify GMs if the account is already silenced
-    if (!!session && sAntispamMgr.IsSilenced(session))
-        return;
-
-    char buffer[1024];
-
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-
-    std::stringstream message;
-
-    message << "Possible spammer.  Account: " << _account;
-
-    if (!!session)
-        message << " Player: " << session->GetPlayerName();
-
-    message << ".  " << buffer << "\nMost blacklisted messages:";
-
-    for (auto const &msg : _topBlacklistedMessages)
-        message << "\n" << msg;
-
-    message << "\nRecent messages:";
-
-    for (auto const &msg : _recentMessages)
-        message << "\n" << msg;
-
-    // LOGS DATABASE
-    static SqlStatementID logSilence;
-
-    LogsDatabase.BeginTransaction();
-
-    auto ins = LogsDatabase.CreateStatement(logSilence,
-        "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
-
-    ins.addUInt32(realmID);
-    ins.addUInt32(_account);
-
-    if (!!session)
-    {
-        ins.addString(session->GetRemoteAddress());
-
-        if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
-            ins.addUInt32(anticheat->GetFingerprint());
-        else
-            ins.addUInt32(0);
-    }
-    else
-    {
-        ins.addString("<unknown>");
-        ins.addUInt32(0);
-    }
-
-    ins.addString(message.str());
-
-    ins.Execute();
-
-    LogsDatabase.CommitTransaction();
-
-    // GM NOTIFICATION
-    sWorld.SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+    AddReport(reports, false, format, args);
+    va_end(args);
 }
 
-void Antispam::Silence(const char *format, ...)
+void Antispam::Silence(std::vector<AntispamReport> &reports, const char *format, ...)
 {
-    auto const session = sWorld.FindSession(_account);
-
-    // do not log or notify GMs if the account is already silenced
-    if (!!session && sAntispamMgr.IsSilenced(session))
-        return;
-
-    char buffer[1024];
-
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-
-    std::stringstream message;
+    AddReport(reports, true, format, args);
+    va_end(args);
+}
 
-    message << "Flagrant spammer.  Account: " << _account;
+void Antispam::AddReport(std::vector<AntispamReport> &reports, bool silence, const char *format, va_list args) const
+{
+    char buffer[1024];
+    vsnprintf(buffer, sizeof(buffer), format, args);
 
-    if (!!session)
-        message << " Player: " << session->GetPlayerName();
+    reports.emplace_back();
+    auto &report = reports.back();
+    report.account = _account;
+    report.silence = silence;
+    report.reason = buffer;
 
-    if (sAnticheatConfig.EnableAntispamSilence())
-    {
-        sAntispamMgr.Silence(_account);
-        message << " (silenced)";
-    }
+    std::stringstream messages;
 
-    message << ".  " << buffer << "\nMost blacklisted messages:";
+    messages << "\nMost blacklisted messages:";
 
     for (auto const &msg : _topBlacklistedMessages)
-        message << "\n" << msg;
+        messages << "\n" << msg;
 
-    message << "\nRecent messages:";
+    messages << "\nRecent messages:";
 
     for (auto const &msg : _recentMessages)
-        message << "\n" << msg;
-
-    // LOGS DATABASE
-    static SqlStatementID logSilence;
-
-    LogsDatabase.BeginTransaction();
-
-    auto ins = LogsDatabase.CreateStatement(logSilence,
-        "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
-
-    ins.addUInt32(realmID);
-    ins.addUInt32(_account);
-
-    if (!!session)
-    {
-        ins.addString(session->GetRemoteAddress());
-
-        if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
-            ins.addUInt32(anticheat->GetFingerprint());
-        else
-            ins.addUInt32(0);
-    }
-    else
-    {
-        ins.addString("<unknown>");
-        ins.addUInt32(0);
-    }
-
-    ins.addString(message.str());
-
-    ins.Execute();
+        messages << "\n" << msg;
 
-    LogsDatabase.CommitTransaction();
-    
-    // GM NOTIFICATION
-    sWorld.SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+    report.messages = messages.str();
 }
 
 Antispam::Antispam(uint32 account) :
     _account(account), _creationTime(WorldTimer::getMSTime()), _whisperCount(0), _sayCount(0), _yellCount(0),
-    _channelCount(0), _mailCount(0), _channelInviteCount(0), _partyInviteCount(0), _blacklistCount(0), _lastNotification(0) {}
+    _channelCount(0), _mailCount(0), _channelInviteCount(0), _partyInviteCount(0), _blacklistCount(0), _lastNotification(0),
+    _accountLevel(0), _distanceTraveled(0.f), _lastMovementTime(0) {}
 
 std::string Antispam::GetInfo() const
 {
@@ -343,30 +225,24 @@ void Antispam::NewMessage(const std::string &msg)
     sAntispamMgr.ScheduleAnalysis(shared_from_this());
 }
 
-float Antispam::GetDistanceTraveled() const
+void Antispam::SetSessionState(uint32 accountLevel, float distanceTraveled, uint32 lastMovementTime)
 {
-    auto const session = sWorld.FindSession(_account);
-
-    if (!session)
-        return 0.f;
-
-    auto const player = session->GetPlayer();
+    std::lock_guard<std::mutex> guard(_mutex);
 
-    if (!player)
-        return 0.f;
+    _accountLevel = accountLevel;
+    _distanceTraveled = distanceTraveled;
+    _lastMovementTime = lastMovementTime;
+}
 
+float Antispam::GetDistanceTraveled() const
+{
     auto const movementTimeout = sAnticheatConfig.GetAntispamRepetitionMovementTimeout() * IN_MILLISECONDS;
-    auto const lastMovement = WorldTimer::getMSTime() - player->m_movementInfo.ctime;
+    auto const lastMovement = WorldTimer::getMSTime() - _lastMovementTime;
 
     if (lastMovement > movementTimeout)
         return 0.f;
 
-    auto const anticheat = dynamic_cast<const NamreebAnticheat::SessionAnticheat *>(session->GetAnticheat());
-
-    if (!anticheat)
-        return 0.f;
-
-    return anticheat->GetDistanceTraveled();
+    return _distanceTraveled;
 }
 
 uint32 Antispam::RepetitionScore() const
@@ -409,14 +285,14 @@ uint32 Antispam::RepetitionScore() const
     return score;
 }
 
-void Antispam::Analyze()
+void Antispam::Analyze(std::vector<AntispamReport> &reports)
 {
+    std::lock_guard<std::mutex> guard(_mutex);
+
     // are they too high level to care about them?
-    if (GetAccountLevel(_account) > sAnticheatConfig.GetAntispamMaxLevel())
+    if (_accountLevel > sAnticheatConfig.GetAntispamMaxLevel())
         return;
 
-    std::lock_guard<std::mutex> guard(_mutex);
-
     // empty pending queue so we can halt at anytime without having to clean it up
     std::vector<std::string> messages = std::move(_pendingMessages);
 
@@ -431,7 +307,7 @@ void Antispam::Analyze()
         {
             if (rate > maxRate)
             {
-                Silence("Messaging rate too high.  %f > %u (messages per minute)", rate, maxRate);
+                Silence(reports, "Messaging rate too high.  %f > %u (messages per minute)", rate, maxRate);
                 return;
             }
         }
@@ -451,7 +327,7 @@ void Antispam::Analyze()
 
             if (percentage >= maxUniquePercentage)
             {
-                Silence("Too high unique target percentage.  %u of %u (%f >= %u)", unique, total, percentage, maxUniquePercentage);
+                Silence(reports, "Too high unique target percentage.  %u of %u (%f >= %u)", unique, total, percentage, maxUniquePercentage);
                 return;
             }
         }
@@ -501,7 +377,7 @@ void Antispam::Analyze()
             auto const milliseconds = WorldTimer::getMSTime() - _creationTime;
             auto const minutes = static_cast<float>(milliseconds) / (IN_MILLISECONDS * MINUTE);
 
-            Silence("Encountered too many blacklisted entries.  %u in %u messages in %f minutes", _blacklistCount, Total(), minutes);
+            Silence(reports, "Encountered too many blacklisted entries.  %u in %u messages in %f minutes", _blacklistCount, Total(), minutes);
             return;
         }
         // otherwise, if it is severe enough to inform GMs, do so
@@ -510,23 +386,33 @@ void Antispam::Analyze()
             auto const milliseconds = WorldTimer::getMSTime() - _creationTime;
             auto const minutes = static_cast<float>(milliseconds) / (IN_MILLISECONDS * MINUTE);
 
-            Notify("Encountered too many blacklisted entries.  %u in %u messages in %f minutes", _blacklistCount, Total(), minutes);
+            Notify(reports, "Encountered too many blacklisted entries.  %u in %u messages in %f minutes", _blacklistCount, Total(), minutes);
         }
     }
 
     // step 5: see if they are repeating their messages too often
+    auto const uniquenessThreshold = sAnticheatConfig.GetAntispamUniquenessThreshold();
+
     for (auto const &msg : messages)
     {
+        nam::osa_pattern const pattern(msg);
+
         // first see if the message is similar to previously observed unique messages
         bool found = false;
         for (auto i = 0u; i < _uniqueMessages.size(); ++i)
         {
             auto &u = _uniqueMessages[i];
 
-            auto const distance = static_cast<uint32>(nam::damerau_levenshtein_distance(msg, u.second));
+            // the length difference alone is a lower bound of the distance
+            auto const lengthDifference = msg.length() > u.second.length() ? msg.length() - u.second.length() : u.second.length() - msg.length();
+
+            if (lengthDifference >= uniquenessThreshold)
+                continue;
+
+            auto const distance = static_cast<uint32>(pattern.distance(u.second, static_cast<int>(uniquenessThreshold) - 1));
 
             // if these two messages are the same, increase the count
-            if (distance < sAnticheatConfig.GetAntispamUniquenessThreshold())
+            if (distance < uniquenessThreshold)
             {
                 ++u.first;
                 found = true;
@@ -546,14 +432,13 @@ void Antispam::Analyze()
     // if this is severe enough to silence them, do so
     if (score >= sAnticheatConfig.GetAntispamRepetitionSilence() && sAnticheatConfig.GetAntispamRepetitionSilence() > 0)
     {
-        Silence("Messages are too repetitive.  Score: %u", score);
+        Silence(reports, "Messages are too repetitive.  Score: %u", score);
         return;
     }
     // otherwise, if it is severe enough to inform GMs, do so
     else if (score >= sAnticheatConfig.GetAntispamRepetitionNotify() && sAnticheatConfig.GetAntispamRepetitionNotify() > 0)
     {
-        Notify("Messages are too repetitive.  Score: %u", score);
+        Notify(reports, "Messages are too repetitive.  Score: %u", score);
     }
-
 }
 }
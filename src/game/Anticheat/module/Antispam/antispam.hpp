@@ -14,6 +14,7 @@
 #include "../priority.hpp"
 #include "../cyclic.hpp"
 
+#include <cstdarg>
 #include <string>
 #include <unordered_set>
 #include <mutex>
@@ -32,6 +33,15 @@ enum SpamAction
     SPAM_ACTION_MAX
 };
 
+// outcome of an analysis, applied by AntispamMgr on the world thread as it needs the session and notifies GMs
+struct AntispamReport
+{
+    uint32 account;
+    bool silence;               // flagrant spammer, otherwise possible spammer
+    std::string reason;
+    std::string messages;       // most blacklisted and recent messages
+};
+
 class Antispam : public std::enable_shared_from_this<Antispam>
 {
     private:
@@ -72,17 +82,25 @@ class Antispam : public std::enable_shared_from_this<Antispam>
         // time of the last GM notification
         uint32 _lastNotification;
 
+        // state of the session as of the last message, analysis threads do not access the session
+        uint32 _accountLevel;
+        float _distanceTraveled;
+        uint32 _lastMovementTime;
+
         // how many total messages have been sent out
         uint32 Total() const { return _whisperCount + _sayCount + _yellCount + _channelCount + _mailCount + _channelInviteCount; }
 
         // how many messages per minute are being sent, or zero if still under grace period
         float Rate() const;
 
-        // send GM notification of possible spammer
-        void Notify(const char *format, ...);
+        // report possible spammer for GM notification, unless GMs were notified too recently
+        void Notify(std::vector<AntispamReport> &reports, const char *format, ...);
+
+        // report flagrant spammer for GM notification and silence (when automatic silencing is enabled)
+        void Silence(std::vector<AntispamReport> &reports, const char *format, ...);
 
-        // send GM notification of flagrant spammer and silence account (when automatic silencing is enabled)
-        void Silence(const char *format, ...);
+        // adds a report with the reason and recent messages
+        void AddReport(std::vector<AntispamReport> &reports, bool silence, const char *format, va_list args) const;
 
         // new message for analysis, assumes mutex is locked
         void NewMessage(const std::string &msg);
@@ -109,8 +127,12 @@ class Antispam : public std::enable_shared_from_this<Antispam>
         void ChannelInvite(const std::string &channelName, const ObjectGuid &to);
         void PartyInvite(const ObjectGuid& to);
 
-        // analyze results for this session to determine if spamming is taking place, and act accordingly
-        void Analyze();
+        // called from the session thread with each message
+        void SetSessionState(uint32 accountLevel, float distanceTraveled, uint32 lastMovementTime);
+
+        // analyze results for this session to determine if spamming is taking place, adding the actions to take to reports.
+        // touches nothing but this session data, so it can run on any thread
+        void Analyze(std::vector<AntispamReport> &reports);
 };
 }
 
@@ -8,9 +8,12 @@
 #include "antispammgr.hpp"
 #include "antispam.hpp"
 #include "../config.hpp"
+#include "../libanticheat.hpp"
 #include "Server/WorldSession.h"
 #include "World/World.h"
 #include "Accounts/AccountMgr.h"
+#include "Maps/MapWorkers.h"
+#include "Tools/Language.h"
 #include "Log/Log.h"
 
 #include "Database/DatabaseEnv.h"
@@ -18,6 +21,7 @@
 
 #include <string>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <regex>
 #include <algorithm>
@@ -26,6 +30,8 @@
 #include <thread>
 #include <chrono>
 #include <array>
+#include <iterator>
+#include <sstream>
 
 INSTANTIATE_SINGLETON_1(NamreebAnticheat::AntispamMgr);
 
@@ -50,13 +56,36 @@ void ReplaceAllW(std::wstring &str, const std::wstring& from, const std::wstring
         startPos += to.length();
     }
 }
+
+// analyzes queued sessions on a pool thread until none are left
+class AntispamAnalysisWorker : public Worker
+{
+    public:
+        AntispamAnalysisWorker(const std::vector<std::shared_ptr<NamreebAnticheat::Antispam> > &sessions,
+            std::vector<std::vector<NamreebAnticheat::AntispamReport> > &reports, std::atomic<size_t> &next, MapUpdater &updater) :
+            Worker(updater), m_sessions(sessions), m_reports(reports), m_next(next) {}
+
+        void execute() override
+        {
+            // each session is guarded by its own mutex and has its own report list, so different sessions can be analyzed at the same time
+            for (auto i = m_next++; i < m_sessions.size(); i = m_next++)
+                m_sessions[i]->Analyze(m_reports[i]);
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        const std::vector<std::shared_ptr<NamreebAnticheat::Antispam> > &m_sessions;
+        std::vector<std::vector<NamreebAnticheat::AntispamReport> > &m_reports;
+        std::atomic<size_t> &m_next;
+};
 }
 
 namespace NamreebAnticheat
 {
 std::string AntispamMgr::NormalizeString(const std::string &string, uint32 mask) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_blacklistMutex);
     return NormalizeStringInternal(string, mask);
 }
 
@@ -143,6 +172,9 @@ AntispamMgr::~AntispamMgr()
 {
     _shutdownRequested = true;
     _worker.join();
+
+    if (_analysisPool.activated())
+        _analysisPool.deactivate();
 }
 
 void AntispamMgr::WorkerLoop()
@@ -173,8 +205,15 @@ void AntispamMgr::WorkerLoop()
                 }
             }
 
-            for (auto const &s : workQueue)
-                s->Analyze();
+            auto reports = AnalyzeSessions(std::vector<std::shared_ptr<Antispam> >(workQueue.begin(), workQueue.end()));
+
+            // sessions and GM notifications belong to the world thread
+            if (!reports.empty())
+                sWorld.GetMessager().AddMessage([reports = std::move(reports)](World* /*world*/)
+                {
+                    for (auto const &report : reports)
+                        sAntispamMgr.ApplyReport(report);
+                });
         }
         else
         {
@@ -196,9 +235,113 @@ void AntispamMgr::WorkerLoop()
     }
 }
 
+std::vector<AntispamReport> AntispamMgr::AnalyzeSessions(const std::vector<std::shared_ptr<Antispam> > &sessions)
+{
+    std::vector<std::vector<AntispamReport> > sessionReports(sessions.size());
+    std::atomic<size_t> next(0);
+
+    auto const threadCount = std::min<size_t>(std::max(sAnticheatConfig.GetAntispamAnalysisThreads(), 1u), sessions.size());
+
+    if (threadCount > 1)
+    {
+        // threads are kept for the next analyses, their count is the one configured at the first use
+        if (!_analysisPool.activated())
+            _analysisPool.activate(sAnticheatConfig.GetAntispamAnalysisThreads());
+
+        for (auto i = 0u; i < threadCount; ++i)
+            _analysisPool.schedule_update(new AntispamAnalysisWorker(sessions, sessionReports, next, _analysisPool));
+
+        _analysisPool.wait();
+    }
+    else
+    {
+        for (auto i = 0u; i < sessions.size(); ++i)
+            sessions[i]->Analyze(sessionReports[i]);
+    }
+
+    std::vector<AntispamReport> reports;
+    for (auto &r : sessionReports)
+        std::move(r.begin(), r.end(), std::back_inserter(reports));
+
+    return reports;
+}
+
+void AntispamMgr::ApplyReport(const AntispamReport &report) const
+{
+    auto const session = sWorld.FindSession(report.account);
+
+    // do not log or notify GMs if the account is already silenced
+    if (!!session && IsSilenced(session))
+        return;
+
+    std::stringstream message;
+
+    message << (report.silence ? "Flagrant spammer.  Account: " : "Possible spammer.  Account: ") << report.account;
+
+    if (!!session)
+        message << " Player: " << session->GetPlayerName();
+
+    if (report.silence && sAnticheatConfig.EnableAntispamSilence())
+    {
+        Silence(report.account);
+        message << " (silenced)";
+    }
+
+    message << ".  " << report.reason << report.messages;
+
+    // LOGS DATABASE
+    static SqlStatementID logSilence;
+
+    LogsDatabase.BeginTransaction();
+
+    auto ins = LogsDatabase.CreateStatement(logSilence,
+        "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
+
+    ins.addUInt32(realmID);
+    ins.addUInt32(report.account);
+
+    if (!!session)
+    {
+        ins.addString(session->GetRemoteAddress());
+
+        if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
+            ins.addUInt32(anticheat->GetFingerprint());
+        else
+            ins.addUInt32(0);
+    }
+    else
+    {
+        ins.addString("<unknown>");
+        ins.addUInt32(0);
+    }
+
+    ins.addString(message.str());
+
+    ins.Execute();
+
+    LogsDatabase.CommitTransaction();
+
+    // GM NOTIFICATION
+    sWorld.SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+}
+
+void AntispamMgr::BuildBlacklistAutomata()
+{
+    std::vector<std::string> original, normalized;
+
+    for (auto const &entry : _blacklist)
+    {
+        original.push_back(entry.first);
+        normalized.push_back(entry.second);
+    }
+
+    _blacklistOriginal = nam::aho_corasick(original);
+    _blacklistNormalized = nam::aho_corasick(normalized);
+}
+
 void AntispamMgr::LoadFromDB()
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_blacklistMutex);
 
     auto const normMask = sAnticheatConfig.GetSpamNormalizationMask();
 
@@ -270,11 +413,13 @@ void AntispamMgr::LoadFromDB()
         } while (queryResult->NextRow());
 
     sLog.outString(">> %lu unicode character replacements loaded", uint64(_unicodeReplace.size()));
+
+    BuildBlacklistAutomata();
 }
 
 void AntispamMgr::BlacklistAdd(const std::string &string_)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_blacklistMutex);
 
     // cannot be empty!
     if (string_.empty())
@@ -303,11 +448,13 @@ void AntispamMgr::BlacklistAdd(const std::string &string_)
     LoginDatabase.CommitTransaction();
 
     _blacklist.emplace_back(entry, normEntry);
+
+    BuildBlacklistAutomata();
 }
 
 uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_blacklistMutex);
 
     auto const normalizationMask = sAnticheatConfig.GetSpamNormalizationMask();
     auto const msg = NormalizeStringInternal(string, normalizationMask);
@@ -317,27 +464,23 @@ uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log)
 
     uint32 result = 0;
 
-    // for each entry, search the given string for multiple occurrences of both the original and normalized form of the entry
-    for (auto const& entry : _blacklist)
+    // count the occurrences of all original entries in the original string and all normalized entries in the normalized string
+    std::vector<uint32> originalCount, normalizedCount;
+    _blacklistOriginal.count(string, originalCount);
+    _blacklistNormalized.count(msg, normalizedCount);
+
+    for (auto i = 0u; i < _blacklist.size(); ++i)
     {
-        // search the original string for the original blacklist entry
-        if (!entry.first.empty())
+        for (auto n = 0u; n < originalCount[i]; ++n)
         {
-            for (auto pos = string.find(entry.first); pos != std::string::npos; pos = string.find(entry.first, pos + entry.first.length()))
-            {
-                logstr << "\nOriginal: \"" << entry.first << "\"";
-                ++result;
-            }
+            logstr << "\nOriginal: \"" << _blacklist[i].first << "\"";
+            ++result;
         }
 
-        // search for the normalized blacklist entry
-        if (!entry.second.empty())
+        for (auto n = 0u; n < normalizedCount[i]; ++n)
         {
-            for (auto pos = msg.find(entry.second); pos != std::string::npos; pos = msg.find(entry.second, pos + entry.second.length()))
-            {
-                logstr << "\nNormalized: \"" << entry.second << "\"";
-                ++result;
-            }
+            logstr << "\nNormalized: \"" << _blacklist[i].second << "\"";
+            ++result;
         }
     }
 
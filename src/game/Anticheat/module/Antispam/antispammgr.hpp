@@ -9,11 +9,14 @@
 #define __ANTISPAMMGR_HPP_
 
 #include "Policies/Singleton.h"
+#include "Maps/MapUpdater.h"
+#include "../ahocorasick.hpp"
 
 #include <atomic>
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <thread>
@@ -25,21 +28,25 @@ class WorldSession;
 namespace NamreebAnticheat
 {
 class Antispam;
+struct AntispamReport;
 
 class AntispamMgr
 {
     private:
-        // note that once we begin using c++17, std::shared_mutex will be much more performant
-        // here as the guarded values are seldom changed but frequently read
+        // guards the work queue and the session cache, which change with nearly every chat message
         mutable std::mutex _mutex;
 
+        // guards the blacklist and the replacements, which are seldom changed but read by every analysis thread
+        mutable std::shared_mutex _blacklistMutex;
+
         std::atomic<bool> _shutdownRequested;
 
         // this collection contains a pair of strings, the original entry and the normalized version based on current settings
         std::vector<std::pair<std::string, std::string> > _blacklist;
 
-        // NOTE: _asciiReplace and _unicodeReplace are not protected by _mutex, because it would make the code much more complicated
-        // and they should never be changing once the world server has started.
+        // automata finding all original and all normalized blacklist entries in one pass, indexed as _blacklist
+        nam::aho_corasick _blacklistOriginal;
+        nam::aho_corasick _blacklistNormalized;
 
         std::vector<std::pair<std::string, std::string> > _asciiReplace;        // replacements for ascii strings (for things like @ -> A or \/\/ -> W etc.)
         std::vector<std::pair<std::wstring, std::wstring> > _unicodeReplace;    // replacements for individual unicode characters
@@ -50,12 +57,24 @@ class AntispamMgr
         // temporarily cache antispam session information in case they reconnect and resume spamming
         std::unordered_map<uint32, std::pair<uint32, std::shared_ptr<Antispam> > > _temporaryCache;
 
+        // persistent threads analyzing sessions, started at the first analysis using more than one thread
+        MapUpdater _analysisPool;
+
         // the thread is declared after all other members to guarantee that it is initialized last
         std::thread _worker;
 
-        // this function performs the actual normalization, but assumes that the mutex is already locked
+        // this function performs the actual normalization, but assumes that the blacklist mutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
+        // rebuilds the blacklist automata, assumes that the blacklist mutex is exclusively locked
+        void BuildBlacklistAutomata();
+
+        // analyzes the sessions on up to the configured number of threads, returning the reports once all are done
+        std::vector<AntispamReport> AnalyzeSessions(const std::vector<std::shared_ptr<Antispam> > &sessions);
+
+        // logs the report, notifies GMs and silences the account if requested, on the world thread
+        void ApplyReport(const AntispamReport &report) const;
+
         void WorkerLoop();
 
     public:
@@ -64,7 +83,7 @@ class AntispamMgr
 
         void LoadFromDB();
 
-        // assumes ownership of the mutex and normalizes a string
+        // assumes shared ownership of the blacklist mutex and normalizes a string
         std::string NormalizeString(const std::string &string, uint32 mask) const;
 
         void BlacklistAdd(const std::string &string);
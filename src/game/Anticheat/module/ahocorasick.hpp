@@ -0,0 +1,164 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __AHOCORASICK_HPP_
+#define __AHOCORASICK_HPP_
+
+#include <string>
+#include <vector>
+#include <array>
+#include <queue>
+#include <cstdint>
+
+namespace nam
+{
+// Aho-Corasick automaton over a set of byte strings, finding all of them in a single pass over the text.
+// the transitions are stored as a full table over the bytes which appear in the patterns, every other
+// byte leads back to the root.
+class aho_corasick
+{
+    private:
+        std::array<uint16_t, 256> _class;                   // byte -> column in _goto, 0 for bytes not in any pattern
+        size_t _classes;
+
+        std::vector<uint32_t> _goto;                        // state * _classes + class -> next state
+        std::vector<uint32_t> _output;                      // next state on the suffix link chain which ends a pattern, 0 for none
+        std::vector<uint32_t> _ends_begin;                  // patterns ending in state s are _ends[_ends_begin[s].._ends_begin[s + 1]]
+        std::vector<uint32_t> _ends;
+        std::vector<size_t> _lengths;
+
+    public:
+        aho_corasick() : _classes(1), _goto(1, 0), _output(1, 0), _ends_begin(2, 0) { _class.fill(0); }
+
+        // pattern indices are kept, empty patterns never match
+        explicit aho_corasick(const std::vector<std::string> &patterns) : _classes(1)
+        {
+            _class.fill(0);
+
+            for (auto const &p : patterns)
+                for (auto const ch : p)
+                    if (!_class[static_cast<unsigned char>(ch)])
+                        _class[static_cast<unsigned char>(ch)] = static_cast<uint16_t>(_classes++);
+
+            // trie
+            std::vector<std::vector<uint32_t> > ends(1);
+            _goto.assign(_classes, 0);
+
+            for (size_t i = 0; i < patterns.size(); ++i)
+            {
+                _lengths.push_back(patterns[i].length());
+
+                if (patterns[i].empty())
+                    continue;
+
+                uint32_t state = 0;
+                for (auto const ch : patterns[i])
+                {
+                    auto &next = _goto[state * _classes + _class[static_cast<unsigned char>(ch)]];
+
+                    if (!next)
+                    {
+                        next = static_cast<uint32_t>(ends.size());
+                        ends.emplace_back();
+                        _goto.resize(_goto.size() + _classes, 0);
+                    }
+
+                    state = _goto[state * _classes + _class[static_cast<unsigned char>(ch)]];
+                }
+
+                ends[state].push_back(static_cast<uint32_t>(i));
+            }
+
+            // breadth first, turn the trie into a complete transition table using the failure links
+            std::vector<uint32_t> fail(ends.size(), 0);
+            _output.assign(ends.size(), 0);
+
+            std::queue<uint32_t> queue;
+            for (size_t c = 1; c < _classes; ++c)
+                if (auto const child = _goto[c])
+                    queue.push(child);
+
+            while (!queue.empty())
+            {
+                auto const state = queue.front();
+                queue.pop();
+
+                for (size_t c = 1; c < _classes; ++c)
+                {
+                    auto &next = _goto[state * _classes + c];
+                    auto const fallback = _goto[fail[state] * _classes + c];
+
+                    if (!next)
+                    {
+                        next = fallback;
+                        continue;
+                    }
+
+                    fail[next] = fallback;
+                    _output[next] = ends[fallback].empty() ? _output[fallback] : fallback;
+                    queue.push(next);
+                }
+            }
+
+            _ends_begin.reserve(ends.size() + 1);
+            for (auto const &e : ends)
+            {
+                _ends_begin.push_back(static_cast<uint32_t>(_ends.size()));
+                _ends.insert(_ends.end(), e.begin(), e.end());
+            }
+            _ends_begin.push_back(static_cast<uint32_t>(_ends.size()));
+        }
+
+        size_t size() const { return _lengths.size(); }
+
+        // counts[i] is set to the number of non-overlapping occurrences of pattern i in 'text', taken
+        // from left to right as repeated calls to std::string::find after the previous occurrence would
+        void count(const std::string &text, std::vector<uint32_t> &counts) const
+        {
+            counts.assign(_lengths.size(), 0);
+
+            if (_lengths.empty())
+                return;
+
+            // position after the last occurrence counted for each pattern
+            std::vector<size_t> next_start(_lengths.size(), 0);
+
+            uint32_t state = 0;
+            for (size_t pos = 0; pos < text.length(); ++pos)
+            {
+                state = _goto[state * _classes + _class[static_cast<unsigned char>(text[pos])]];
+
+                for (auto s = _ends_begin[state] != _ends_begin[state + 1] ? state : _output[state]; s; s = _output[s])
+                {
+                    for (auto e = _ends_begin[s]; e < _ends_begin[s + 1]; ++e)
+                    {
+                        auto const i = _ends[e];
+                        auto const start = pos + 1 - _lengths[i];
+
+                        if (start < next_start[i])
+                            continue;
+
+                        ++counts[i];
+                        next_start[i] = pos + 1;
+                    }
+                }
+            }
+        }
+};
+}
+#endif /* !__AHOCORASICK_HPP_ */
@@ -27,72 +27,156 @@
 #define __DLDIST_HPP_
 
 #include <string>
-#include <algorithm>
 #include <vector>
+#include <cstdint>
 
 namespace nam
 {
-namespace
+// optimal string alignment distance (Damerau-Levenshtein with adjacent transpositions, where no substring
+// is edited twice) computed with the bit-parallel algorithm of Hyyro, "A Bit-Vector Algorithm for Computing
+// Levenshtein and Damerau Edit Distances" (2003).  the pattern is preprocessed once so it can be compared
+// against many strings, and is processed in blocks of 64 characters so its length is unrestricted.
+class osa_pattern
 {
-constexpr int get_index(size_t columns, int x, int y)
-{
-    return static_cast<int>(x * columns + y);
-}
+    private:
+        static constexpr size_t word_bits = 64;
 
-template <typename T>
-constexpr T min3(const T &a, const T &b, const T &c)
-{
-    return std::min(a, std::min(b, c));
-}
-}
+        size_t _length;
+        size_t _words;
 
-int damerau_levenshtein_distance(const std::string &string1, const std::string &string2)
-{
-    auto const string1_length = string1.length();
-    auto const string2_length = string2.length();
+        // for each byte value, bit i of its block is set when the pattern has this byte at position i
+        std::vector<uint64_t> _peq;
+
+        int distance_single(const std::string &text, int max) const
+        {
+            auto const *peq = _peq.data();
+            auto const last = uint64_t(1) << (_length - 1);
 
-    auto const max_dist = string1_length + string2_length;
+            uint64_t vp = ~uint64_t(0), vn = 0, d0 = 0, pm_prev = 0;
+            auto score = static_cast<int>(_length);
+            auto remaining = static_cast<int>(text.length());
+
+            for (auto const ch : text)
+            {
+                auto const pm = peq[static_cast<unsigned char>(ch)];
+                auto const tr = (((~d0) & pm) << 1) & pm_prev;
 
-    auto const rows = string1_length + 1;
-    auto const columns = string2_length + 1;
+                d0 = (((pm & vp) + vp) ^ vp) | pm | vn | tr;
 
-    std::vector<int> dist(rows*columns);
+                auto hp = vn | ~(d0 | vp);
+                auto hn = d0 & vp;
 
-    for (auto i = 0; i <= string1_length; ++i)
-    {
-        auto const volatile idx = get_index(columns, i, 0);
-        dist[get_index(columns, i, 0)] = i;
-    }
+                if (hp & last)
+                    ++score;
+                else if (hn & last)
+                    --score;
 
-    for (auto i = 0; i <= string2_length; ++i)
-    {
-        auto const volatile idx = get_index(columns, 0, i);
-        dist[get_index(columns, 0, i)] = i;
-    }
+                // score can drop by at most one for each remaining character
+                if (score - --remaining > max)
+                    return score - remaining;
 
-    for (auto i = 1; i <= string1_length; ++i)
-        for (auto j = 1; j <= string2_length; j++)
+                hp = (hp << 1) | 1;
+                hn = hn << 1;
+
+                vp = hn | ~(d0 | hp);
+                vn = hp & d0;
+                pm_prev = pm;
+            }
+
+            return score;
+        }
+
+        int distance_blocks(const std::string &text, int max) const
         {
-            auto const cost = string1[i - 1] == string2[j - 1] ? 0 : 1;
+            auto const last = uint64_t(1) << ((_length - 1) % word_bits);
 
-            dist[get_index(columns, i, j)] = min3(
-                dist[get_index(columns, i - 1, j - 0)] + 1,     // delete
-                dist[get_index(columns, i - 0, j - 1)] + 1,     // insert
-                dist[get_index(columns, i - 1, j - 1)] + cost); // substitution
+            std::vector<uint64_t> vp(_words, ~uint64_t(0)), vn(_words, 0), d0(_words, 0), pm_prev(_words, 0);
+            auto score = static_cast<int>(_length);
+            auto remaining = static_cast<int>(text.length());
 
-            if (i > 1 && j > 1 &&
-                string1[i - 1] == string2[j - 2] &&
-                string1[i - 2] == string2[j - 1]
-                )
+            for (auto const ch : text)
             {
-                dist[get_index(columns, i, j)] = std::min(
-                    dist[get_index(columns, i, j)],
-                    dist[get_index(columns, i - 2, j - 2)] + cost // transposition
-                );
+                auto const *pm = &_peq[static_cast<unsigned char>(ch) * _words];
+
+                // carries between the blocks for the shifts and the addition
+                uint64_t tr_carry = 0, add_carry = 0, hp_carry = 1, hn_carry = 0;
+
+                for (size_t w = 0; w < _words; ++w)
+                {
+                    auto const pm_w = pm[w];
+                    auto const vp_w = vp[w];
+                    auto const vn_w = vn[w];
+
+                    auto const tr_bits = (~d0[w]) & pm_w;
+                    auto const tr = ((tr_bits << 1) | tr_carry) & pm_prev[w];
+                    tr_carry = tr_bits >> (word_bits - 1);
+
+                    auto sum = (pm_w & vp_w) + add_carry;
+                    auto carry = sum < add_carry;
+                    sum += vp_w;
+                    add_carry = carry | (sum < vp_w);
+
+                    auto const d0_w = (sum ^ vp_w) | pm_w | vn_w | tr;
+                    auto const hp = vn_w | ~(d0_w | vp_w);
+                    auto const hn = d0_w & vp_w;
+
+                    if (w == _words - 1)
+                    {
+                        if (hp & last)
+                            ++score;
+                        else if (hn & last)
+                            --score;
+                    }
+
+                    auto const hp_shift = (hp << 1) | hp_carry;
+                    auto const hn_shift = (hn << 1) | hn_carry;
+                    hp_carry = hp >> (word_bits - 1);
+                    hn_carry = hn >> (word_bits - 1);
+
+                    vp[w] = hn_shift | ~(d0_w | hp_shift);
+                    vn[w] = hp_shift & d0_w;
+                    d0[w] = d0_w;
+                    pm_prev[w] = pm_w;
+                }
+
+                if (score - --remaining > max)
+                    return score - remaining;
             }
+
+            return score;
         }
 
-    return dist[get_index(columns, static_cast<int>(string1_length), static_cast<int>(string2_length))];
+    public:
+        explicit osa_pattern(const std::string &pattern) :
+            _length(pattern.length()), _words((pattern.length() + word_bits - 1) / word_bits), _peq(256 * _words, 0)
+        {
+            for (size_t i = 0; i < _length; ++i)
+                _peq[static_cast<unsigned char>(pattern[i]) * _words + i / word_bits] |= uint64_t(1) << (i % word_bits);
+        }
+
+        size_t length() const { return _length; }
+
+        // returns the distance to 'text', or some value greater than 'max' once it is known to exceed 'max'
+        int distance(const std::string &text, int max) const
+        {
+            if (!_length)
+                return static_cast<int>(text.length());
+
+            if (text.empty())
+                return static_cast<int>(_length);
+
+            return _words == 1 ? distance_single(text, max) : distance_blocks(text, max);
+        }
+
+        int distance(const std::string &text) const
+        {
+            return distance(text, static_cast<int>(_length + text.length()));
+        }
+};
+
+inline int damerau_levenshtein_distance(const std::string &string1, const std::string &string2)
+{
+    return osa_pattern(string1).distance(string2);
 }
 }
 #endif /* !__DLDIST_HPP_ */
\ No newline at end of file
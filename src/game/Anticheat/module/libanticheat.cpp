@@ -1014,51 +1014,75 @@ void SessionAnticheat::WardenPacket(WorldPacket &packet)
     _warden->HandlePacket(packet);
 }
 
+bool SessionAnticheat::PrepareAntispam()
+{
+    if (!_antispam || sAntispamMgr.IsSilenced(_session))
+        return false;
+
+    // analysis runs on antispam threads, which must not look up the session
+    auto accountLevel = _session->GetAccountMaxLevel();
+    uint32 lastMovementTime = 0;
+    float distanceTraveled = 0.f;
+
+    if (auto const player = _session->GetPlayer())
+    {
+        // slight adjustment to account level logic to account for increasing character levels in the session
+        if (player->GetLevel() > accountLevel)
+            accountLevel = player->GetLevel();
+
+        lastMovementTime = player->m_movementInfo.ctime;
+        distanceTraveled = GetDistanceTraveled();
+    }
+
+    _antispam->SetSessionState(accountLevel, distanceTraveled, lastMovementTime);
+    return true;
+}
+
 void SessionAnticheat::AutoReply(const std::string &msg)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->AutoReply(msg);
 }
 
 void SessionAnticheat::Whisper(const std::string &msg, const ObjectGuid &to)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->Whisper(msg, to);
 }
 
 void SessionAnticheat::Say(const std::string &msg)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->Say(msg);
 }
 
 void SessionAnticheat::Yell(const std::string &msg)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->Yell(msg);
 }
 
 void SessionAnticheat::Channel(const std::string &msg)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->Channel(msg);
 }
 
 void SessionAnticheat::Mail(const std::string &subject, const std::string &body, const ObjectGuid &to)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->Mail(subject, body, to);
 }
 
 void SessionAnticheat::ChannelInvite(const std::string& channelName, const ObjectGuid& to)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->ChannelInvite(channelName, to);
 }
 
 void SessionAnticheat::PartyInvite(const ObjectGuid& to)
 {
-    if (!!_antispam && !sAntispamMgr.IsSilenced(_session))
+    if (PrepareAntispam())
         _antispam->PartyInvite(to);
 }
 
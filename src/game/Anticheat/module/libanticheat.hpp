@@ -166,6 +166,9 @@ class SessionAnticheat final : public SessionAnticheatInterface
         // delayed ban (account and/or ip) when cheat is detected an ban action is identified
         void BeginBanTimer(bool account, bool ip);
 
+        // whether antispam records messages of this session, if so refreshes the account level and movement it analyzes
+        bool PrepareAntispam();
+
     public:
         // this is down here because a destructor is NOT required by the interface
         ~SessionAnticheat();
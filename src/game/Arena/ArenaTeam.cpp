@@ -22,6 +22,7 @@
 #include "Arena/ArenaTeam.h"
 #include "World/World.h"
 #include "Entities/Player.h"
+#include "Entities/PlayerLoginCache.h"
 
 void ArenaTeamMember::ModifyPersonalRating(Player* plr, int32 mod, uint32 slot)
 {
@@ -173,6 +174,7 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid)
     m_members.push_back(newmember);
 
     CharacterDatabase.PExecute("INSERT INTO arena_team_member (arenateamid, guid, personal_rating) VALUES ('%u', '%u', '%u')", m_TeamId, newmember.guid.GetCounter(), newmember.personal_rating);
+    sPlayerLoginCache.Invalidate(newmember.guid);
 
     if (pl)
     {
@@ -321,6 +323,7 @@ void ArenaTeam::DelMember(ObjectGuid guid)
     }
 
     CharacterDatabase.PExecute("DELETE FROM arena_team_member WHERE arenateamid = '%u' AND guid = '%u'", GetId(), guid.GetCounter());
+    sPlayerLoginCache.Invalidate(guid);
 }
 
 void ArenaTeam::Disband(WorldSession* session)
@@ -749,6 +752,7 @@ void ArenaTeam::SaveToDB()
     for (MemberList::const_iterator itr = m_members.begin(); itr !=  m_members.end(); ++itr)
     {
         CharacterDatabase.PExecute("UPDATE arena_team_member SET played_week = '%u', wons_week = '%u', played_season = '%u', wons_season = '%u', personal_rating = '%u' WHERE arenateamid = '%u' AND guid = '%u'", itr->games_week, itr->wins_week, itr->games_season, itr->wins_season, itr->personal_rating, m_TeamId, itr->guid.GetCounter());
+        sPlayerLoginCache.Invalidate(itr->guid);
     }
     CharacterDatabase.CommitTransaction();
 }
@@ -18,6 +18,7 @@
 
 #include "Entities/Object.h"
 #include "Entities/Player.h"
+#include "Entities/PlayerLoginCache.h"
 #include "BattleGround.h"
 #include "BattleGroundMgr.h"
 #include "Entities/Creature.h"
@@ -235,7 +236,6 @@ BattleGround::BattleGround(): m_buffChange(false), m_startDelayTime(0), m_arenaB
     m_name              = "";
     m_levelMin          = 0;
     m_levelMax          = 0;
-    m_hasBgFreeSlotQueue = false;
 
     m_maxPlayersPerTeam = 0;
     m_maxPlayers        = 0;
@@ -292,19 +292,20 @@ BattleGround::~BattleGround()
     // (this is done automatically in mapmanager update, when the instance is reset after the reset time)
     sBattleGroundMgr.RemoveBattleGround(GetInstanceId(), GetTypeId());
 
-    // skip template bgs as they were never added to visible bg list
-    BattleGroundBracketId bracketId = GetBracketId();
-    if (bracketId != BG_BRACKET_ID_TEMPLATE)
-        sBattleGroundMgr.DeleteClientVisibleInstanceId(GetTypeId(), bracketId, GetClientInstanceId());
+    // skip template bgs as they were never added to battleground queue
+    if (GetBracketId() != BG_BRACKET_ID_TEMPLATE)
+    {
+        sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId()](BattleGroundQueue* queue)
+        {
+            queue->RemoveBattleGroundInfo(instanceId);
+        });
+    }
 
     // unload map
     // map can be null at bg destruction
     if (m_bgMap)
         m_bgMap->SetUnload();
 
-    // remove from bg free slot queue
-    this->RemoveFromBgFreeSlotQueue();
-
     for (BattleGroundScoreMap::const_iterator itr = m_playerScores.begin(); itr != m_playerScores.end(); ++itr)
         delete itr->second;
 }
@@ -326,6 +327,7 @@ void BattleGround::Update(uint32 diff)
             {
                 // add deserter at next login
                 CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", uint32(AT_LOGIN_ADD_BG_DESERTER), itr->first.GetCounter());
+                sPlayerLoginCache.Invalidate(itr->first);
 
                 RemovePlayerAtLeave(itr->first, true, true);// remove player from BG
                 m_offlineQueue.pop_front();                 // remove from offline queue
@@ -769,7 +771,11 @@ void BattleGround::UpdateWorldStateForPlayer(uint32 field, uint32 value, Player*
 */
 void BattleGround::EndBattleGround(Team winner)
 {
-    this->RemoveFromBgFreeSlotQueue();
+    // stop inviting players to this battleground
+    sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId()](BattleGroundQueue* queue)
+    {
+        queue->EndBattleGround(instanceId);
+    });
 
     ArenaTeam* winner_arena_team = nullptr;
     ArenaTeam* loser_arena_team = nullptr;
@@ -1262,6 +1268,10 @@ void BattleGround::RemovePlayerAtLeave(ObjectGuid playerGuid, bool isOnTransport
     {
         UpdatePlayersCountByTeam(team, true);               // -1 player
         m_players.erase(itr);
+        sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId(), count = GetPlayersSize()](BattleGroundQueue* queue)
+        {
+            queue->SetPlayersCount(instanceId, count);
+        });
         // check if the player was a participant of the match, or only entered through gm command (goname)
         participant = true;
     }
@@ -1365,12 +1375,17 @@ void BattleGround::RemovePlayerAtLeave(ObjectGuid playerGuid, bool isOnTransport
         }
         DecreaseInvitedCount(team);
         // we should update battleground queue, but only if bg isn't ending
-        if (IsBattleGround() && GetStatus() < STATUS_WAIT_LEAVE)
+        sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId(), team, updateQueue = IsBattleGround() && GetStatus() < STATUS_WAIT_LEAVE,
+            bgQueueTypeId, bgTypeId, bracketId = GetBracketId()](BattleGroundQueue* queue)
         {
-            // a player has left the battleground, so there are free slots -> add to queue
-            AddToBgFreeSlotQueue();
-            sBattleGroundMgr.ScheduleQueueUpdate(0, ARENA_TYPE_NONE, bgQueueTypeId, bgTypeId, GetBracketId());
-        }
+            queue->DecreaseInvitedCount(instanceId, team);
+            if (updateQueue)
+            {
+                // a player has left the battleground, so there are free slots -> add to queue
+                queue->AddToBgFreeSlotQueue(instanceId);
+                queue->ScheduleQueueUpdate(0, ARENA_TYPE_NONE, bgQueueTypeId, bgTypeId, bracketId);
+            }
+        });
 
         // Let others know
         WorldPacket data;
@@ -1421,7 +1436,6 @@ void BattleGround::Reset()
 
     m_invitedAlliance = 0;
     m_invitedHorde = 0;
-    m_hasBgFreeSlotQueue = false;
 
     m_players.clear();
 
@@ -1465,9 +1479,6 @@ void BattleGround::StartBattleGround()
 {
     SetStartTime(0);
 
-    // add BG to free slot queue
-    AddToBgFreeSlotQueue();
-
     // add bg to update list
     // This must be done here, because we need to have already invited some players when first BG::Update() method is executed
     // and it doesn't matter if we call StartBattleGround() more times, because m_BattleGrounds is a map and instance id never changes
@@ -1511,6 +1522,10 @@ void BattleGround::AddPlayer(Player* player)
     m_players[guid] = bp;
 
     UpdatePlayersCountByTeam(team, false);                  // +1 player
+    sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId(), count = GetPlayersSize()](BattleGroundQueue* queue)
+    {
+        queue->SetPlayersCount(instanceId, count);
+    });
 
     WorldPacket data;
     sBattleGroundMgr.BuildPlayerJoinedBattleGroundPacket(data, player);
@@ -1688,52 +1703,6 @@ void BattleGround::RemovePlayer(Player* /*player*/, ObjectGuid /*guid*/)
     }
 }
 
-/**
-  Function that returns the number of players that can join a battleground based on the provided team
-*/
-void BattleGround::AddToBgFreeSlotQueue()
-{
-    // make sure to add only once
-    if (!m_hasBgFreeSlotQueue && IsBattleGround())
-    {
-        sBattleGroundMgr.BgFreeSlotQueue[m_typeId].push_front(this);
-        m_hasBgFreeSlotQueue = true;
-    }
-}
-
-/**
-  Method that removes this battleground from free queue - it must be called when deleting battleground
-*/
-void BattleGround::RemoveFromBgFreeSlotQueue()
-{
-    // set to be able to re-add if needed
-    m_hasBgFreeSlotQueue = false;
-    BgFreeSlotQueueType& bgFreeSlot = sBattleGroundMgr.BgFreeSlotQueue[m_typeId];
-
-    for (BgFreeSlotQueueType::iterator itr = bgFreeSlot.begin(); itr != bgFreeSlot.end(); ++itr)
-    {
-        if ((*itr)->GetInstanceId() == GetInstanceId())
-        {
-            bgFreeSlot.erase(itr);
-            return;
-        }
-    }
-}
-
-/**
-  Function that returns the number of players that can join a battleground based on the provided team
-
-  @param    team
-*/
-uint32 BattleGround::GetFreeSlotsForTeam(Team team) const
-{
-    // return free slot count to MaxPlayerPerTeam
-    if (GetStatus() == STATUS_WAIT_JOIN || GetStatus() == STATUS_IN_PROGRESS)
-        return (GetInvitedCount(team) < GetMaxPlayersPerTeam()) ? GetMaxPlayersPerTeam() - GetInvitedCount(team) : 0;
-
-    return 0;
-}
-
 /**
   Method that updates player score
 
@@ -2160,7 +2129,10 @@ void BattleGround::SendBcdToTeam(int32 bcdEntry, ChatMsg msgtype, Creature const
 */
 void BattleGround::EndNow()
 {
-    RemoveFromBgFreeSlotQueue();
+    sWorld.GetBGQueue().GetMessager().AddMessage([instanceId = GetInstanceId()](BattleGroundQueue* queue)
+    {
+        queue->EndBattleGround(instanceId);
+    });
     SetStatus(STATUS_WAIT_LEAVE);
     SetEndTime(0);
 }
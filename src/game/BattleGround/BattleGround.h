@@ -401,9 +401,6 @@ class BattleGround
         void SetMaxPlayersPerTeam(uint32 maxPlayers) { m_maxPlayersPerTeam = maxPlayers; }
         void SetMinPlayersPerTeam(uint32 minPlayers) { m_minPlayersPerTeam = minPlayers; }
 
-        void AddToBgFreeSlotQueue();                        // this queue will be useful when more battlegrounds instances will be available
-        void RemoveFromBgFreeSlotQueue();                   // this method could delete whole BG instance, if another free is available
-
         // Functions to decrease or increase player count
         void DecreaseInvitedCount(Team team)      { (team == ALLIANCE) ? --m_invitedAlliance : --m_invitedHorde; }
         void IncreaseInvitedCount(Team team)      { (team == ALLIANCE) ? ++m_invitedAlliance : ++m_invitedHorde; }
@@ -413,8 +410,6 @@ class BattleGround
                 return m_invitedAlliance;
             return m_invitedHorde;
         }
-        bool HasFreeSlots() const { return GetPlayersSize() < GetMaxPlayers(); }
-        uint32 GetFreeSlotsForTeam(Team team) const;
 
         // Functions that return if battleground is arena or if it's rated
         bool IsArena() const        { return m_isArena; }
@@ -719,7 +714,6 @@ class BattleGround
         int32  m_startDelayTime;
 
         bool m_arenaBuffSpawned;                            // to cache if arenabuff event is started (cause bool is faster than checking IsActiveEvent)
-        bool m_hasBgFreeSlotQueue;                          // used to make sure that BG is only once inserted into the BattleGroundMgr.BGFreeSlotQueue[bgTypeId] deque
         bool m_isRated;                                     // is this battle rated?
         bool m_prematureCountDown;
         bool m_isArena;
@@ -195,61 +195,56 @@ void WorldSession::HandleBattlemasterJoinOpcode(WorldPacket& recv_data)
     // if we're here, then the conditions to join a bg are met. We can proceed in joining.
 
     // _player->GetGroup() was already checked, grp is already initialized
-    BattleGroundQueue& bgQueue = sBattleGroundMgr.m_battleGroundQueues[bgQueueTypeId];
+    GuidVector members;
     if (joinAsGroup)
     {
-        GroupQueueInfo* queueInfo = nullptr;
-        uint32 avgTime = 0;
-
-        if (err > ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
+        if (err <= ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
         {
-            DEBUG_LOG("Battleground: the following players are joining as group:");
-            queueInfo = bgQueue.AddGroup(_player, grp, bgTypeId, bracketEntry, ARENA_TYPE_NONE, false, isPremade, instanceId, 0);
-            avgTime = bgQueue.GetAverageQueueWaitTime(queueInfo, bracketEntry->GetBracketId());
+            WorldPacket data;
+            sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
+            for (GroupReference* itr = grp->GetFirstMember(); itr != nullptr; itr = itr->next())
+                if (Player* member = itr->getSource())
+                    member->GetSession()->SendPacket(data);
+            return;
         }
 
+        DEBUG_LOG("Battleground: the following players are joining as group:");
         for (GroupReference* itr = grp->GetFirstMember(); itr != nullptr; itr = itr->next())
         {
             Player* member = itr->getSource();
             if (!member)
                 continue;                                   // this should never happen
 
-            WorldPacket data;
-
-            if (err <= ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
-            {
-                sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
-                member->GetSession()->SendPacket(data);
-                continue;
-            }
-
             // add to queue
-            uint32 queueSlot = member->AddBattleGroundQueueId(bgQueueTypeId);
-
-            // send status packet (in queue)
-            sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_QUEUE, avgTime, 0, queueInfo->arenaType, TEAM_NONE);
-            member->GetSession()->SendPacket(data);
-            sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
-            member->GetSession()->SendPacket(data);
+            member->AddBattleGroundQueueId(bgQueueTypeId);
+            members.push_back(member->GetObjectGuid());
             DEBUG_LOG("Battleground: player joined queue for bg queue type %u bg type %u: GUID %u, NAME %s", bgQueueTypeId, bgTypeId, member->GetGUIDLow(), member->GetName());
         }
         DEBUG_LOG("Battleground: group end");
     }
     else
     {
-        GroupQueueInfo* queueInfo = bgQueue.AddGroup(_player, nullptr, bgTypeId, bracketEntry, ARENA_TYPE_NONE, false, isPremade, instanceId, 0);
-        uint32 avgTime = bgQueue.GetAverageQueueWaitTime(queueInfo, bracketEntry->GetBracketId());
         // already checked if queueSlot is valid, now just get it
-        uint32 queueSlot = _player->AddBattleGroundQueueId(bgQueueTypeId);
-
-        WorldPacket data;
-        // send status packet (in queue)
-        sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_QUEUE, avgTime, 0, queueInfo->arenaType, TEAM_NONE);
-        SendPacket(data);
+        _player->AddBattleGroundQueueId(bgQueueTypeId);
+        members.push_back(_player->GetObjectGuid());
         DEBUG_LOG("Battleground: player joined queue for bg queue type %u bg type %u: GUID %u, NAME %s", bgQueueTypeId, bgTypeId, _player->GetGUIDLow(), _player->GetName());
     }
 
-    sBattleGroundMgr.ScheduleQueueUpdate(0, ARENA_TYPE_NONE, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+    // queue status packets are sent back once the queue thread has added the group
+    sWorld.GetBGQueue().GetMessager().AddMessage([leaderGuid = _player->GetObjectGuid(), members, team = _player->GetTeam(), bgQueueTypeId, bgTypeId, bracketEntry, isPremade, instanceId,
+        joinResult = joinAsGroup ? err : ERR_BATTLEGROUND_NONE](BattleGroundQueue* queue)
+    {
+        BattleGroundQueueItem& queueItem = queue->GetQueueItem(bgQueueTypeId);
+        GroupQueueInfo* queueInfo = queueItem.AddGroup(*queue, leaderGuid, members, team, bgTypeId, bracketEntry, ARENA_TYPE_NONE, false, isPremade, instanceId, 0);
+        uint32 avgTime = queueItem.GetAverageQueueWaitTime(queueInfo, bracketEntry->GetBracketId());
+
+        sWorld.GetMessager().AddMessage([members, bgQueueTypeId, bgTypeId, instanceId, avgTime, joinResult](World* /*world*/)
+        {
+            sBattleGroundMgr.SendQueuedStatus(members, bgQueueTypeId, bgTypeId, instanceId, ARENA_TYPE_NONE, avgTime, joinResult);
+        });
+
+        queue->ScheduleQueueUpdate(0, ARENA_TYPE_NONE, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+    });
 }
 
 // Sent by client while inside battleground; depends on the battleground type
@@ -420,15 +415,39 @@ void WorldSession::HandleBattlefieldPortOpcode(WorldPacket& recv_data)
     // get GroupQueueInfo from BattleGroundQueue
     BattleGroundTypeId bgTypeId = BattleGroundTypeId(receivedBgTypeId);
     BattleGroundQueueTypeId bgQueueTypeId = BattleGroundMgr::BgQueueTypeId(bgTypeId, ArenaType(type));
-    BattleGroundQueue& bgQueue = sBattleGroundMgr.m_battleGroundQueues[bgQueueTypeId];
 
-    // we must use temporary variable, because GroupQueueInfo pointer can be deleted in BattleGroundQueue::RemovePlayer() function
-    GroupQueueInfo queueInfo;
-    if (!bgQueue.GetPlayerGroupInfoData(_player->GetObjectGuid(), &queueInfo))
+    sWorld.GetBGQueue().GetMessager().AddMessage([playerGuid = _player->GetObjectGuid(), bgQueueTypeId, bgTypeId, action](BattleGroundQueue* queue)
     {
-        sLog.outError("BattlegroundHandler: itrplayerstatus not found.");
+        // we must use temporary variable, because GroupQueueInfo pointer can be deleted in BattleGroundQueue::RemovePlayer() function
+        GroupQueueInfo queueInfo;
+        if (!queue->GetQueueItem(bgQueueTypeId).GetPlayerGroupInfoData(playerGuid, &queueInfo))
+        {
+            sLog.outError("BattlegroundHandler: itrplayerstatus not found.");
+            return;
+        }
+
+        sWorld.GetMessager().AddMessage([playerGuid, queueInfo, bgTypeId, action](World* /*world*/)
+        {
+            if (Player* player = sObjectMgr.GetPlayer(playerGuid))
+                player->GetSession()->HandleBattlefieldPort(queueInfo, bgTypeId, action);
+        });
+    });
+}
+
+/**
+  Finishes CMSG_BATTLEFIELD_PORT with the queue data read on the battleground queue thread
+
+  @param    group queue info
+  @param    battleground type id
+  @param    action
+*/
+void WorldSession::HandleBattlefieldPort(GroupQueueInfo const& queueInfo, BattleGroundTypeId bgTypeId, uint8 action)
+{
+    BattleGroundQueueTypeId bgQueueTypeId = BattleGroundMgr::BgQueueTypeId(bgTypeId, queueInfo.arenaType);
+
+    // player may have left the queue while it was looked up
+    if (!_player->InBattleGroundQueueForBattleGroundQueueType(bgQueueTypeId))
         return;
-    }
 
     // if action == 1, then instanceId is required
     if (!queueInfo.isInvitedToBgInstanceGuid && action == 1)
@@ -485,6 +504,10 @@ void WorldSession::HandleBattlefieldPortOpcode(WorldPacket& recv_data)
             if (!_player->IsInvitedForBattleGroundQueueType(bgQueueTypeId))
                 return;                                 // cheating?
 
+            // port already requested
+            if (_player->GetBattleGroundId() == queueInfo.isInvitedToBgInstanceGuid)
+                return;
+
             if (!_player->InBattleGround())
                 _player->SetBattleGroundEntryPoint();
 
@@ -501,7 +524,10 @@ void WorldSession::HandleBattlefieldPortOpcode(WorldPacket& recv_data)
             _player->GetSession()->SendPacket(data);
 
             // remove battleground queue status from BGmgr
-            bgQueue.RemovePlayer(_player->GetObjectGuid(), false);
+            sWorld.GetBGQueue().GetMessager().AddMessage([playerGuid = _player->GetObjectGuid(), bgQueueTypeId](BattleGroundQueue* queue)
+            {
+                queue->GetQueueItem(bgQueueTypeId).RemovePlayer(*queue, playerGuid, false);
+            });
 
             // this is still needed here if battleground "jumping" shouldn't add deserter debuff
             // also this is required to prevent stuck at old battleground after SetBattleGroundId set to new
@@ -535,11 +561,15 @@ void WorldSession::HandleBattlefieldPortOpcode(WorldPacket& recv_data)
 
             _player->RemoveBattleGroundQueueId(bgQueueTypeId);  // must be called this way, because if you move this call to queue->removeplayer, it causes bugs
             sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_NONE, 0, 0, ARENA_TYPE_NONE, TEAM_NONE);
-            bgQueue.RemovePlayer(_player->GetObjectGuid(), true);
+            sWorld.GetBGQueue().GetMessager().AddMessage([playerGuid = _player->GetObjectGuid(), bgQueueTypeId, bgTypeId, arenaType = queueInfo.arenaType,
+                arenaTeamRating = queueInfo.arenaTeamRating, bracketId = bracketEntry->GetBracketId()](BattleGroundQueue* queue)
+            {
+                queue->GetQueueItem(bgQueueTypeId).RemovePlayer(*queue, playerGuid, true);
 
-            // player left queue, we should update it - do not update Arena Queue
-            if (queueInfo.arenaType == ARENA_TYPE_NONE)
-                sBattleGroundMgr.ScheduleQueueUpdate(queueInfo.arenaTeamRating, queueInfo.arenaType, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+                // player left queue, we should update it - do not update Arena Queue
+                if (arenaType == ARENA_TYPE_NONE)
+                    queue->ScheduleQueueUpdate(arenaTeamRating, arenaType, bgQueueTypeId, bgTypeId, bracketId);
+            });
 
             SendPacket(data);
 
@@ -609,38 +639,43 @@ void WorldSession::HandleBattlefieldStatusOpcode(WorldPacket& /*recv_data*/)
         }
         // we are sending update to player about queue - he can be invited there!
         // get GroupQueueInfo for queue status
-        BattleGroundQueue& bgQueue = sBattleGroundMgr.m_battleGroundQueues[bgQueueTypeId];
-        GroupQueueInfo queueInfo;
-        if (!bgQueue.GetPlayerGroupInfoData(_player->GetObjectGuid(), &queueInfo))
-            continue;
-
-        if (queueInfo.isInvitedToBgInstanceGuid)
+        sWorld.GetBGQueue().GetMessager().AddMessage([playerGuid = _player->GetObjectGuid(), queueSlot = i, bgQueueTypeId, bgTypeId, arenaType](BattleGroundQueue* queue)
         {
-            bg = sBattleGroundMgr.GetBattleGround(queueInfo.isInvitedToBgInstanceGuid, bgTypeId);
-            if (!bg)
-                continue;
+            BattleGroundQueueItem& queueItem = queue->GetQueueItem(bgQueueTypeId);
+            GroupQueueInfo queueInfo;
+            if (!queueItem.GetPlayerGroupInfoData(playerGuid, &queueInfo))
+                return;
 
-            uint32 remainingTime = WorldTimer::getMSTimeDiff(WorldTimer::getMSTime(), queueInfo.removeInviteTime);
-            // send status invited to BattleGround
-            sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, i, STATUS_WAIT_JOIN, remainingTime, 0, arenaType, TEAM_NONE);
-            SendPacket(data);
-        }
-        else
-        {
-            bg = sBattleGroundMgr.GetBattleGroundTemplate(bgTypeId);
-            if (!bg)
-                continue;
+            uint32 avgTime = queueInfo.isInvitedToBgInstanceGuid ? 0 : queueItem.GetAverageQueueWaitTime(&queueInfo, queueInfo.bracketId);
+            sWorld.GetMessager().AddMessage([playerGuid, queueSlot, bgQueueTypeId, bgTypeId, arenaType, queueInfo, avgTime](World* /*world*/)
+            {
+                Player* player = sObjectMgr.GetPlayer(playerGuid);
+                if (!player || player->GetBattleGroundQueueTypeId(queueSlot) != bgQueueTypeId)
+                    return;
 
-            // expected bracket entry
-            PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketByLevel(bg->GetMapId(), _player->GetLevel());
-            if (!bracketEntry)
-                continue;
+                WorldPacket data;
+                if (queueInfo.isInvitedToBgInstanceGuid)
+                {
+                    BattleGround* bg = sBattleGroundMgr.GetBattleGround(queueInfo.isInvitedToBgInstanceGuid, bgTypeId);
+                    if (!bg)
+                        return;
 
-            uint32 avgTime = bgQueue.GetAverageQueueWaitTime(&queueInfo, bracketEntry->GetBracketId());
-            // send status in BattleGround Queue
-            sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, i, STATUS_WAIT_QUEUE, avgTime, WorldTimer::getMSTimeDiff(queueInfo.joinTime, WorldTimer::getMSTime()), arenaType, TEAM_NONE);
-            SendPacket(data);
-        }
+                    uint32 remainingTime = WorldTimer::getMSTimeDiff(WorldTimer::getMSTime(), queueInfo.removeInviteTime);
+                    // send status invited to BattleGround
+                    sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_JOIN, remainingTime, 0, arenaType, TEAM_NONE);
+                }
+                else
+                {
+                    BattleGround* bg = sBattleGroundMgr.GetBattleGroundTemplate(bgTypeId);
+                    if (!bg)
+                        return;
+
+                    // send status in BattleGround Queue
+                    sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_QUEUE, avgTime, WorldTimer::getMSTimeDiff(queueInfo.joinTime, WorldTimer::getMSTime()), arenaType, TEAM_NONE);
+                }
+                player->GetSession()->SendPacket(data);
+            });
+        });
     }
 }
 
@@ -813,23 +848,25 @@ void WorldSession::HandleBattlemasterJoinArena(WorldPacket& recv_data)
             arenaRating = avg_pers_rating;
     }
 
-    BattleGroundQueue& bgQueue = sBattleGroundMgr.m_battleGroundQueues[bgQueueTypeId];
+    GuidVector members;
     if (asGroup)
     {
-        uint32 avgTime = 0;
-
-        if (err > ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
+        if (err <= ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
         {
-            DEBUG_LOG("Battleground: arena join as group start");
-            if (isRated)
-                DEBUG_LOG("Battleground: arena team id %u, leader %s queued with rating %u for type %u", _player->GetArenaTeamId(arenaslot), _player->GetName(), arenaRating, arenatype);
+            WorldPacket data;
+            sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
+            for (GroupReference* itr = group->GetFirstMember(); itr != nullptr; itr = itr->next())
+                if (Player* member = itr->getSource())
+                    member->GetSession()->SendPacket(data);
+            return;
+        }
 
-            // set arena rated type to show correct minimap arena icon
-            bg->SetRated(isRated != 0);
+        DEBUG_LOG("Battleground: arena join as group start");
+        if (isRated)
+            DEBUG_LOG("Battleground: arena team id %u, leader %s queued with rating %u for type %u", _player->GetArenaTeamId(arenaslot), _player->GetName(), arenaRating, arenatype);
 
-            GroupQueueInfo* ginfo = bgQueue.AddGroup(_player, group, bgTypeId, bracketEntry, arenatype, isRated != 0, false, 0, arenaRating, ateamId);
-            avgTime = bgQueue.GetAverageQueueWaitTime(ginfo, bracketEntry->GetBracketId());
-        }
+        // set arena rated type to show correct minimap arena icon
+        bg->SetRated(isRated != 0);
 
         for (GroupReference* itr = group->GetFirstMember(); itr != nullptr; itr = itr->next())
         {
@@ -837,40 +874,35 @@ void WorldSession::HandleBattlemasterJoinArena(WorldPacket& recv_data)
             if (!member)
                 continue;
 
-            WorldPacket data;
-
-            if (err <= ERR_GROUP_JOIN_BATTLEGROUND_FAIL)
-            {
-                sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
-                member->GetSession()->SendPacket(data);
-                continue;
-            }
-
             // add to queue
-            uint32 queueSlot = member->AddBattleGroundQueueId(bgQueueTypeId);
-
-            // send status packet (in queue)
-            sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_QUEUE, avgTime, 0, arenatype, TEAM_NONE);
-            member->GetSession()->SendPacket(data);
-            sBattleGroundMgr.BuildGroupJoinedBattlegroundPacket(data, err);
-            member->GetSession()->SendPacket(data);
+            member->AddBattleGroundQueueId(bgQueueTypeId);
+            members.push_back(member->GetObjectGuid());
             DEBUG_LOG("Battleground: player joined queue for arena as group bg queue type %u bg type %u: GUID %u, NAME %s", bgQueueTypeId, bgTypeId, member->GetGUIDLow(), member->GetName());
         }
         DEBUG_LOG("Battleground: arena join as group end");
     }
     else
     {
-        GroupQueueInfo* ginfo = bgQueue.AddGroup(_player, nullptr, bgTypeId, bracketEntry, arenatype, isRated != 0, false, 0, arenaRating, ateamId);
-        uint32 avgTime = bgQueue.GetAverageQueueWaitTime(ginfo, bracketEntry->GetBracketId());
-        uint32 queueSlot = _player->AddBattleGroundQueueId(bgQueueTypeId);
-
-        WorldPacket data;
-        // send status packet (in queue)
-        sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_WAIT_QUEUE, avgTime, 0, arenatype, TEAM_NONE);
-        SendPacket(data);
+        _player->AddBattleGroundQueueId(bgQueueTypeId);
+        members.push_back(_player->GetObjectGuid());
         DEBUG_LOG("Battleground: player joined queue for arena, skirmish, bg queue type %u bg type %u: GUID %u, NAME %s", bgQueueTypeId, bgTypeId, _player->GetGUIDLow(), _player->GetName());
     }
-    sBattleGroundMgr.ScheduleQueueUpdate(arenaRating, arenatype, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+
+    // queue status packets are sent back once the queue thread has added the group
+    sWorld.GetBGQueue().GetMessager().AddMessage([leaderGuid = _player->GetObjectGuid(), members, team = _player->GetTeam(), bgQueueTypeId, bgTypeId, bracketEntry, arenatype, isRated = isRated != 0,
+        arenaRating, ateamId, joinResult = asGroup ? err : ERR_BATTLEGROUND_NONE](BattleGroundQueue* queue)
+    {
+        BattleGroundQueueItem& queueItem = queue->GetQueueItem(bgQueueTypeId);
+        GroupQueueInfo* queueInfo = queueItem.AddGroup(*queue, leaderGuid, members, team, bgTypeId, bracketEntry, arenatype, isRated, false, 0, arenaRating, ateamId);
+        uint32 avgTime = queueItem.GetAverageQueueWaitTime(queueInfo, bracketEntry->GetBracketId());
+
+        sWorld.GetMessager().AddMessage([members, bgQueueTypeId, bgTypeId, arenatype, avgTime, joinResult](World* /*world*/)
+        {
+            sBattleGroundMgr.SendQueuedStatus(members, bgQueueTypeId, bgTypeId, 0, arenatype, avgTime, joinResult);
+        });
+
+        queue->ScheduleQueueUpdate(arenaRating, arenatype, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+    });
 }
 
 // Sent by client when reporting AFK
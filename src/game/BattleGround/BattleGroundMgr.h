@@ -24,120 +24,15 @@
 #include "Globals/SharedDefines.h"
 #include "Server/DBCEnums.h"
 #include "BattleGround.h"
-
-#include <mutex>
+#include "BattleGroundQueue.h"
 
 typedef std::map<uint32, BattleGround*> BattleGroundSet;
 
-// this container can't be deque, because deque doesn't like removing the last element - if you remove it, it invalidates next iterator and crash appears
-typedef std::list<BattleGround*> BgFreeSlotQueueType;
-
 typedef std::unordered_map<uint32, BattleGroundTypeId> BattleMastersMap;
 typedef std::unordered_map<uint32, BattleGroundEventIdx> CreatureBattleEventIndexesMap;
 typedef std::unordered_map<uint32, BattleGroundEventIdx> GameObjectBattleEventIndexesMap;
 
 #define BATTLEGROUND_ARENA_POINT_DISTRIBUTION_DAY 86400     // seconds in a day
-#define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
-
-struct GroupQueueInfo;                                      // type predefinition
-struct PlayerQueueInfo                                      // stores information for players in queue
-{
-    uint32  lastOnlineTime;                                 // for tracking and removing offline players from queue after 5 minutes
-    GroupQueueInfo* groupInfo;                              // pointer to the associated groupqueueinfo
-};
-
-typedef std::map<ObjectGuid, PlayerQueueInfo*> GroupQueueInfoPlayers;
-
-struct GroupQueueInfo                                       // stores information about the group in queue (also used when joined as solo!)
-{
-    GroupQueueInfoPlayers players;                          // player queue info map
-    Team  groupTeam;                                        // Player team (ALLIANCE/HORDE)
-    BattleGroundTypeId bgTypeId;                            // battleground type id
-    bool    isRated;                                        // rated
-    ArenaType arenaType;                                    // 2v2, 3v3, 5v5 or 0 when BG
-    uint32  arenaTeamId;                                    // team id if rated match
-    uint32  joinTime;                                       // time when group was added
-    uint32  removeInviteTime;                               // time when we will remove invite for players in group
-    uint32  isInvitedToBgInstanceGuid;                      // was invited to certain BG
-    uint32  desiredInstanceId;                              // queued for this instance specifically
-    uint32  arenaTeamRating;                                // if rated match, inited to the rating of the team
-    uint32  opponentsTeamRating;                            // for rated arena matches
-};
-
-enum BattleGroundQueueGroupTypes
-{
-    BG_QUEUE_PREMADE_ALLIANCE   = 0,
-    BG_QUEUE_PREMADE_HORDE      = 1,
-    BG_QUEUE_NORMAL_ALLIANCE    = 2,
-    BG_QUEUE_NORMAL_HORDE       = 3
-};
-
-#define BG_QUEUE_GROUP_TYPES_COUNT 4
-
-class BattleGround;
-class BattleGroundQueue
-{
-    public:
-        BattleGroundQueue();
-        ~BattleGroundQueue();
-
-        void Update(BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/, ArenaType arenaType = ARENA_TYPE_NONE, bool isRated = false, uint32 arenaRating = 0);
-
-        void FillPlayersToBg(BattleGround* /*bg*/, BattleGroundBracketId /*bracketId*/);
-        bool CheckPremadeMatch(BattleGroundBracketId /*bracketId*/, uint32 /*minPlayersPerTeam*/, uint32 /*maxPlayersPerTeam*/);
-        bool CheckNormalMatch(BattleGround* /*bgTemplate*/, BattleGroundBracketId /*bracketId*/, uint32 /*minPlayers*/, uint32 /*maxPlayers*/);
-        bool CheckSkirmishForSameFaction(BattleGroundBracketId /*bracketId*/, uint32 /*minPlayersPerTeam*/);
-        GroupQueueInfo* AddGroup(Player* /*leader*/, Group* /*group*/, BattleGroundTypeId /*bgTypeId*/, PvPDifficultyEntry const* /*bracketEntry*/, ArenaType /*arenaType*/, bool /*isRated*/, bool /*isPremade*/, uint32 /*instanceId*/, uint32 /*arenaRating*/, uint32 arenaTeamId = 0);
-        void RemovePlayer(ObjectGuid /*guid*/, bool /*decreaseInvitedCount*/);
-        bool IsPlayerInvited(ObjectGuid /*playerGuid*/, const uint32 /*bgInstanceGuid*/, const uint32 /*removeTime*/);
-        bool GetPlayerGroupInfoData(ObjectGuid /*guid*/, GroupQueueInfo* /*groupInfo*/);
-        void PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
-        uint32 GetAverageQueueWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
-
-    private:
-        // mutex that should not allow changing private data, nor allowing to update Queue during private data change.
-        std::recursive_mutex m_lock;
-
-        typedef std::map<ObjectGuid, PlayerQueueInfo> QueuedPlayersMap;
-        QueuedPlayersMap m_queuedPlayers;
-
-        // we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
-
-        /*
-        This two dimensional array is used to store All queued groups
-        First dimension specifies the bgTypeId
-        Second dimension specifies the player's group types -
-             BG_QUEUE_PREMADE_ALLIANCE  is used for premade alliance groups and alliance rated arena teams
-             BG_QUEUE_PREMADE_HORDE     is used for premade horde groups and horde rated arena teams
-             BG_QUEUE_NORMAL_ALLIANCE   is used for normal (or small) alliance groups or non-rated arena matches
-             BG_QUEUE_NORMAL_HORDE      is used for normal (or small) horde groups or non-rated arena matches
-        */
-        GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
-
-        // class to select and invite groups to bg
-        class SelectionPool
-        {
-            public:
-                SelectionPool() : playerCount(0) {}
-                void Init();
-                bool AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount, uint32 bgInstanceId);
-                bool KickGroup(uint32 size);
-                uint32 GetPlayerCount() const {return playerCount;}
-                GroupsQueueType selectedGroups;
-            private:
-                uint32 playerCount;
-        };
-
-        // one selection pool for horde, other one for alliance
-        SelectionPool m_selectionPools[PVP_TEAM_COUNT];
-
-        bool InviteGroupToBg(GroupQueueInfo* /*groupInfo*/, BattleGround* /*bg*/, Team /*side*/);
-
-        uint32 m_waitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
-        uint32 m_waitTimeLastPlayer[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
-        uint32 m_sumOfWaitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
-};
 
 /*
     This class is used to invite player to BG again, when minute lasts from his first invitation
@@ -211,31 +106,23 @@ class BattleGroundMgr
         BattleGround* GetBattleGround(uint32 /*instanceId*/, BattleGroundTypeId /*bgTypeId*/); // there must be uint32 because MAX_BATTLEGROUND_TYPE_ID means unknown
 
         BattleGround* GetBattleGroundTemplate(BattleGroundTypeId /*bgTypeId*/);
-        BattleGround* CreateNewBattleGround(BattleGroundTypeId /*bgTypeId*/, PvPDifficultyEntry const* /*bracketEntry*/, ArenaType /*arenaType*/, bool /*isRated*/);
+        BattleGround* CreateNewBattleGround(BattleGroundTypeId /*bgTypeId*/, BattleGroundTypeId /*selectedTypeId*/, PvPDifficultyEntry const* /*bracketEntry*/, ArenaType /*arenaType*/, bool /*isRated*/, uint32 /*instanceId*/, uint32 /*clientInstanceId*/);
 
         uint32 CreateBattleGround(BattleGroundTypeId /*bgTypeId*/, bool /*isArena*/, uint32 /*minPlayersPerTeam*/, uint32 /*maxPlayersPerTeam*/, uint32 /*levelMin*/, uint32 /*levelMax*/, char const* /*battleGroundName*/, uint32 /*mapId*/, float /*team1StartLocX*/, float /*team1StartLocY*/, float /*team1StartLocZ*/, float /*team1StartLocO*/, float /*team2StartLocX*/, float /*team2StartLocY*/, float /*team2StartLocZ*/, float /*team2StartLocO*/, float /*startMaxDist*/, uint32 /*playerSkinReflootId*/);
 
         void AddBattleGround(uint32 instanceId, BattleGroundTypeId bgTypeId, BattleGround* bg) { m_battleGrounds[bgTypeId][instanceId] = bg; };
         void RemoveBattleGround(uint32 instanceId, BattleGroundTypeId bgTypeId) { m_battleGrounds[bgTypeId].erase(instanceId); }
 
-        uint32 CreateClientVisibleInstanceId(BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
-        void DeleteClientVisibleInstanceId(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId, uint32 clientInstanceId)
-        {
-            m_clientBattleGroundIds[bgTypeId][bracketId].erase(clientInstanceId);
-        }
-
         void CreateInitialBattleGrounds();
         void DeleteAllBattleGrounds();
 
         void SendToBattleGround(Player* /*player*/, uint32 /*instanceId*/, BattleGroundTypeId /*bgTypeId*/);
 
         /* Battleground queues */
-        // these queues are instantiated when creating BattlegroundMrg
-        BattleGroundQueue m_battleGroundQueues[MAX_BATTLEGROUND_QUEUE_TYPES]; // public, because we need to access them in BG handler code
-
-        BgFreeSlotQueueType BgFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID];
+        // queues are matched in their own thread, these apply the results to the battlegrounds and players
+        void InviteGroupsToBattleGround(BattleGroundInQueueInfo const& /*bgInfo*/, PvPDifficultyEntry const* /*bracketEntry*/, std::vector<BattleGroundQueueInvite> const& /*invites*/, bool /*isNew*/);
+        void SendQueuedStatus(GuidVector const& /*members*/, BattleGroundQueueTypeId /*bgQueueTypeId*/, BattleGroundTypeId /*bgTypeId*/, uint32 /*instanceId*/, ArenaType /*arenaType*/, uint32 /*avgTime*/, GroupJoinBattlegroundResult /*joinResult*/);
 
-        void ScheduleQueueUpdate(uint32 /*arenaRating*/, ArenaType /*arenaType*/, BattleGroundQueueTypeId /*bgQueueTypeId*/, BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
         uint32 GetMaxRatingDifference() const;
         uint32 GetRatingDiscardTimer()  const;
         uint32 GetPrematureFinishTime() const;
@@ -291,17 +178,14 @@ class BattleGroundMgr
 
         std::set<uint32> const& GetUsedRefLootIds() const { return m_usedRefloot; }
     private:
-        std::mutex schedulerLock;
+        void InviteGroupToBattleGround(BattleGround* /*bg*/, BattleGroundQueueInvite const& /*invite*/);
+
         BattleMastersMap m_battleMastersMap;
         CreatureBattleEventIndexesMap m_creatureBattleEventIndexMap;
         GameObjectBattleEventIndexesMap m_gameObjectBattleEventIndexMap;
 
         /* Battlegrounds */
         BattleGroundSet m_battleGrounds[MAX_BATTLEGROUND_TYPE_ID];
-        std::vector<uint64> m_queueUpdateScheduler;
-        typedef std::set<uint32> ClientBattleGroundIdSet;
-        ClientBattleGroundIdSet m_clientBattleGroundIds[MAX_BATTLEGROUND_TYPE_ID][MAX_BATTLEGROUND_BRACKETS]; // the instanceids just visible for the client
-        uint32 m_nextRatingDiscardUpdate;
         time_t m_nextAutoDistributionTime;
         uint32 m_autoDistributionTimeChecker;
         bool   m_arenaTesting;
@@ -0,0 +1,1457 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "BattleGround/BattleGroundQueue.h"
+#include "BattleGround/BattleGroundMgr.h"
+#include "Globals/ObjectMgr.h"
+#include "Chat/Chat.h"
+#include "Arena/ArenaTeam.h"
+#include "World/World.h"
+#include "Server/WorldPacket.h"
+#include "Server/DBCStores.h"
+#include "Entities/Player.h"
+#include "Tools/Language.h"
+
+/*********************************************************/
+/***            BATTLEGROUND QUEUE SYSTEM              ***/
+/*********************************************************/
+
+BattleGroundQueueItem::BattleGroundQueueItem()
+{
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+    {
+        for (uint8 j = 0; j < MAX_BATTLEGROUND_BRACKETS; ++j)
+        {
+            m_sumOfWaitTimes[i][j] = 0;
+            m_waitTimeLastPlayer[i][j] = 0;
+
+            for (uint8 k = 0; k < COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME; ++k)
+                m_waitTimes[i][j][k] = 0;
+        }
+    }
+}
+
+BattleGroundQueueItem::~BattleGroundQueueItem()
+{
+    m_queuedPlayers.clear();
+    for (auto& m_queuedGroup : m_queuedGroups)
+    {
+        for (uint8 j = 0; j < BG_QUEUE_GROUP_TYPES_COUNT; ++j)
+        {
+            for (GroupsQueueType::iterator itr = m_queuedGroup[j].begin(); itr != m_queuedGroup[j].end(); ++itr)
+                delete (*itr);
+
+            m_queuedGroup[j].clear();
+        }
+    }
+}
+
+/*********************************************************/
+/***      BATTLEGROUND QUEUE SELECTION POOLS           ***/
+/*********************************************************/
+
+// selection pool initialization, used to clean up from prev selection
+void BattleGroundQueueItem::SelectionPool::Init()
+{
+    selectedGroups.clear();
+    playerCount = 0;
+}
+
+/**
+  Function that removes group infr from pool selection
+  - returns true when we need to try to add new group to selection pool
+  - returns false when selection pool is ok or when we kicked smaller group than we need to kick
+  - sometimes it can be called on empty selection pool
+
+  @param    size
+*/
+bool BattleGroundQueueItem::SelectionPool::KickGroup(uint32 size)
+{
+    // find maxgroup or LAST group with size == size and kick it
+    bool found = false;
+    GroupsQueueType::iterator groupToKick = selectedGroups.begin();
+
+    for (GroupsQueueType::iterator itr = groupToKick; itr != selectedGroups.end(); ++itr)
+    {
+        if (abs((int32)((*itr)->players.size() - size)) <= 1)
+        {
+            groupToKick = itr;
+            found = true;
+        }
+        else if (!found && (*itr)->players.size() >= (*groupToKick)->players.size())
+            groupToKick = itr;
+    }
+
+    // if pool is empty, do nothing
+    if (GetPlayerCount())
+    {
+        // update player count
+        GroupQueueInfo* queueInfo = (*groupToKick);
+        selectedGroups.erase(groupToKick);
+        playerCount -= queueInfo->players.size();
+
+        // return false if we kicked smaller group or there are enough players in selection pool
+        if (queueInfo->players.size() <= size + 1)
+            return false;
+    }
+    return true;
+}
+
+/**
+  Function that adds group to selection pool
+  - returns true if we can invite more players, or when we added group to selection pool
+  - returns false when selection pool is full
+
+  @param    group queue info
+  @param    desired count
+*/
+bool BattleGroundQueueItem::SelectionPool::AddGroup(GroupQueueInfo* queueInfo, uint32 desiredCount, uint32 bgInstanceId)
+{
+    // if group is larger than desired count - don't allow to add it to pool
+    if (!queueInfo->isInvitedToBgInstanceGuid &&
+        (!queueInfo->desiredInstanceId || queueInfo->desiredInstanceId == bgInstanceId) &&
+        (desiredCount >= playerCount + queueInfo->players.size()))
+    {
+        selectedGroups.push_back(queueInfo);
+        // increase selected players count
+        playerCount += queueInfo->players.size();
+
+        return true;
+    }
+
+    return playerCount < desiredCount;
+}
+
+/*********************************************************/
+/***               BATTLEGROUND QUEUES                 ***/
+/*********************************************************/
+
+/**
+  Function that adds group or player (members holds only the leader) to battleground queue with the given leader and specifications
+
+  @param    battleground queue
+  @param    leader guid
+  @param    member guids
+  @param    team
+  @param    battleground type id
+  @param    bracket entry
+  @param    arena type
+  @param    isRated
+  @param    isPremade
+  @param    arena rating
+  @param    arena team id
+*/
+GroupQueueInfo* BattleGroundQueueItem::AddGroup(BattleGroundQueue& queue, ObjectGuid leaderGuid, GuidVector const& members, Team team, BattleGroundTypeId bgTypeId, PvPDifficultyEntry const*  bracketEntry, ArenaType arenaType, bool isRated, bool isPremade, uint32 instanceId, uint32 arenaRating, uint32 arenaTeamId)
+{
+    BattleGroundBracketId bracketId =  bracketEntry->GetBracketId();
+
+    // create new ginfo
+    GroupQueueInfo* queueInfo = new GroupQueueInfo;
+    queueInfo->bgTypeId                  = bgTypeId;
+    queueInfo->arenaType                 = arenaType;
+    queueInfo->arenaTeamId               = arenaTeamId;
+    queueInfo->isRated                   = isRated;
+    queueInfo->isInvitedToBgInstanceGuid = 0;
+    queueInfo->joinTime                  = WorldTimer::getMSTime();
+    queueInfo->removeInviteTime          = 0;
+    queueInfo->groupTeam                 = team;
+    queueInfo->desiredInstanceId         = instanceId;
+    queueInfo->arenaTeamRating           = arenaRating;
+    queueInfo->opponentsTeamRating       = 0;
+
+    queueInfo->players.clear();
+
+    // compute index (if group is premade or joined a rated match) to queues
+    uint32 index = 0;
+    if (!isRated && !isPremade)
+        index += PVP_TEAM_COUNT;                            // BG_QUEUE_PREMADE_* -> BG_QUEUE_NORMAL_*
+
+    if (queueInfo->groupTeam == HORDE)
+        ++index;                                            // BG_QUEUE_*_ALLIANCE -> BG_QUEUE_*_HORDE
+
+    DEBUG_LOG("Adding Group to BattleGroundQueue bgTypeId : %u, bracket_id : %u, index : %u", bgTypeId, bracketId, index);
+
+    uint32 lastOnlineTime = WorldTimer::getMSTime();
+
+    // announce world
+    if (isRated && sWorld.getConfig(CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_JOIN))
+    {
+        sWorld.GetMessager().AddMessage([arenaType = queueInfo->arenaType, arenaRating = queueInfo->arenaTeamRating](World* world)
+        {
+            world->SendWorldText(LANG_ARENA_QUEUE_ANNOUNCE_WORLD_JOIN, arenaType, arenaType, arenaRating);
+        });
+    }
+
+    // add players from group to ginfo
+    for (ObjectGuid const& member : members)
+    {
+        PlayerQueueInfo& playerInfo = m_queuedPlayers[member];
+        playerInfo.lastOnlineTime   = lastOnlineTime;
+        playerInfo.groupInfo        = queueInfo;
+        // add the pinfo to ginfo's list
+        queueInfo->players[member]  = &playerInfo;
+    }
+
+    // add GroupInfo to m_QueuedGroups
+    m_queuedGroups[bracketId][index].push_back(queueInfo);
+    queueInfo->bracketId = bracketId;
+    queueInfo->queueIndex = index;
+    queueInfo->queuePosition = std::prev(m_queuedGroups[bracketId][index].end());
+
+    if (isRated)
+    {
+        m_ratedTeams[bracketId].emplace(arenaRating, queueInfo);
+        queueInfo->joinTimePosition = m_ratedTeamsByJoinTime[bracketId][index].emplace(queueInfo->joinTime, queueInfo);
+    }
+
+    // announce to world
+    if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
+    {
+        if (BattleGroundQueueTemplate const* bgTemplate = queue.GetBattleGroundTemplate(queueInfo->bgTypeId))
+        {
+            uint32 minPlayers = bgTemplate->minPlayersPerTeam;
+            uint32 qHorde = 0;
+            uint32 qAlliance = 0;
+            uint32 qMinLevel = bracketEntry->minLevel;
+            uint32 qMaxLevel = bracketEntry->maxLevel;
+
+            GroupsQueueType::const_iterator itr;
+            for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
+                if (!(*itr)->isInvitedToBgInstanceGuid)
+                    qAlliance += (*itr)->players.size();
+
+            for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
+                if (!(*itr)->isInvitedToBgInstanceGuid)
+                    qHorde += (*itr)->players.size();
+
+            uint32 needAlliance = (minPlayers > qAlliance) ? minPlayers - qAlliance : (uint32)0;
+            uint32 needHorde = (minPlayers > qHorde) ? minPlayers - qHorde : (uint32)0;
+
+            sWorld.GetMessager().AddMessage([leaderGuid, bgName = bgTemplate->name, qMinLevel, qMaxLevel, qAlliance, needAlliance, qHorde, needHorde](World* world)
+            {
+                // Show queue status to player only (when joining queue)
+                if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN) == 1)
+                {
+                    if (Player* leader = sObjectMgr.GetPlayer(leaderGuid))
+                        ChatHandler(leader).PSendSysMessage(LANG_BG_QUEUE_ANNOUNCE_SELF, bgName.c_str(), qMinLevel, qMaxLevel, qAlliance, needAlliance, qHorde, needHorde);
+                }
+                // System message
+                else
+                    world->SendWorldText(LANG_BG_QUEUE_ANNOUNCE_WORLD, bgName.c_str(), qMinLevel, qMaxLevel, qAlliance, needAlliance, qHorde, needHorde);
+            });
+        }
+    }
+
+    return queueInfo;
+}
+
+/**
+  Method that updates average update wait time
+
+  @param    group queue info
+  @param    bracket id
+*/
+void BattleGroundQueueItem::PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* queueInfo, BattleGroundBracketId bracketId)
+{
+    uint32 timeInQueue = WorldTimer::getMSTimeDiff(queueInfo->joinTime, WorldTimer::getMSTime());
+    uint8 teamIndex = TEAM_INDEX_ALLIANCE;                     // default set to BG_TEAM_ALLIANCE - or non rated arenas!
+
+    if (queueInfo->arenaType == ARENA_TYPE_NONE)
+    {
+        if (queueInfo->groupTeam == HORDE)
+            teamIndex = TEAM_INDEX_HORDE;
+    }
+    else
+    {
+        if (queueInfo->isRated)
+            teamIndex = TEAM_INDEX_HORDE;                     // for rated arenas use BG_TEAM_HORDE
+    }
+
+    // store pointer to arrayindex of player that was added first
+    uint32* lastPlayerAddedPointer = &(m_waitTimeLastPlayer[teamIndex][bracketId]);
+
+    // remove his time from sum
+    m_sumOfWaitTimes[teamIndex][bracketId] -= m_waitTimes[teamIndex][bracketId][(*lastPlayerAddedPointer)];
+
+    // set average time to new
+    m_waitTimes[teamIndex][bracketId][(*lastPlayerAddedPointer)] = timeInQueue;
+
+    // add new time to sum
+    m_sumOfWaitTimes[teamIndex][bracketId] += timeInQueue;
+
+    // set index of last player added to next one
+    (*lastPlayerAddedPointer)++;
+    (*lastPlayerAddedPointer) %= COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME;
+}
+
+/**
+  Function that returns averate queue wait time
+
+  @param    group queue info
+  @param    bracket id
+*/
+uint32 BattleGroundQueueItem::GetAverageQueueWaitTime(GroupQueueInfo* queueInfo, BattleGroundBracketId bracketId)
+{
+    uint8 teamIndex = TEAM_INDEX_ALLIANCE;                     // default set to BG_TEAM_ALLIANCE - or non rated arenas!
+    if (queueInfo->arenaType == ARENA_TYPE_NONE)
+    {
+        if (queueInfo->groupTeam == HORDE)
+            teamIndex = TEAM_INDEX_HORDE;
+    }
+    else
+    {
+        if (queueInfo->isRated)
+            teamIndex = TEAM_INDEX_HORDE;                     // for rated arenas use BG_TEAM_HORDE
+    }
+
+    // check if there is enought values(we always add values > 0)
+    if (m_waitTimes[teamIndex][bracketId][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME - 1])
+        return (m_sumOfWaitTimes[teamIndex][bracketId] / COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME);
+
+    // if there aren't enough values return 0 - not available
+    return 0;
+}
+
+/**
+  Method that removes player from queue and from group info, if group info is empty then remove it too
+
+  @param    battleground queue
+  @param    guid
+  @param    decrease invite count
+*/
+void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid guid, bool decreaseInvitedCount)
+{
+    // remove player from map, if he's there
+    QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
+    if (itr == m_queuedPlayers.end())
+    {
+        sLog.outError("BattleGroundQueue: couldn't find for remove: %s", guid.GetString().c_str());
+        return;
+    }
+
+    GroupQueueInfo* group = itr->second.groupInfo;
+    // group knows its queue position, it is kept up to date when moved between queues
+    BattleGroundBracketId bracketId = group->bracketId;
+    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), uint32(bracketId));
+
+    // ALL variables are correctly set
+    // We can ignore leveling up in queue - it should not cause crash
+    // remove player from group
+    // if only one player there, remove group
+
+    // remove player queue info from group queue info
+    GroupQueueInfoPlayers::iterator pitr = group->players.find(guid);
+    if (pitr != group->players.end())
+        group->players.erase(pitr);
+
+    // if invited to bg, and should decrease invited count, then do it
+    if (decreaseInvitedCount && group->isInvitedToBgInstanceGuid)
+    {
+        if (BattleGroundInQueueInfo* bgInfo = queue.GetBattleGroundInfo(group->isInvitedToBgInstanceGuid))
+        {
+            bgInfo->DecreaseInvitedCount(group->groupTeam);
+
+            sWorld.GetMessager().AddMessage([instanceId = bgInfo->instanceId, bgTypeId = bgInfo->typeId, team = group->groupTeam](World* /*world*/)
+            {
+                if (BattleGround* bg = sBattleGroundMgr.GetBattleGround(instanceId, bgTypeId))
+                    bg->DecreaseInvitedCount(team);
+            });
+        }
+    }
+
+    // remove player queue info
+    m_queuedPlayers.erase(itr);
+
+    // announce to world if arena team left queue for rated match, show only once
+    if (group->arenaType != ARENA_TYPE_NONE && group->isRated && group->players.empty() && sWorld.getConfig(CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_EXIT))
+    {
+        sWorld.GetMessager().AddMessage([arenaType = group->arenaType, arenaRating = group->arenaTeamRating](World* world)
+        {
+            world->SendWorldText(LANG_ARENA_QUEUE_ANNOUNCE_WORLD_EXIT, arenaType, arenaType, arenaRating);
+        });
+    }
+
+    // if player leaves queue and he is invited to rated arena match, then he have to loose
+    if (group->isInvitedToBgInstanceGuid && group->isRated && decreaseInvitedCount)
+    {
+        sWorld.GetMessager().AddMessage([guid, arenaTeamId = group->arenaTeamId, opponentsTeamRating = group->opponentsTeamRating](World* /*world*/)
+        {
+            ArenaTeam* at = sObjectMgr.GetArenaTeamById(arenaTeamId);
+            if (!at)
+                return;
+
+            DEBUG_LOG("UPDATING memberLost's personal arena rating for %s by opponents rating: %u", guid.GetString().c_str(), opponentsTeamRating);
+            if (Player* plr = sObjectMgr.GetPlayer(guid))
+                at->MemberLost(plr, opponentsTeamRating);
+            else
+                at->OfflineMemberLost(guid, opponentsTeamRating);
+
+            at->SaveToDB();
+        });
+    }
+
+    // remove group queue info if needed
+    if (group->players.empty())
+    {
+        m_queuedGroups[bracketId][group->queueIndex].erase(group->queuePosition);
+
+        if (group->isRated)
+        {
+            m_ratedTeamsByJoinTime[bracketId][group->queueIndex].erase(group->joinTimePosition);
+
+            auto bounds = m_ratedTeams[bracketId].equal_range(group->arenaTeamRating);
+            for (auto ratedItr = bounds.first; ratedItr != bounds.second; ++ratedItr)
+            {
+                if (ratedItr->second == group)
+                {
+                    m_ratedTeams[bracketId].erase(ratedItr);
+                    break;
+                }
+            }
+        }
+
+        delete group;
+    }
+    // if group wasn't empty, so it wasn't deleted, and player have left a rated
+    // queue -> everyone from the group should leave too
+    // don't remove recursively if already invited to bg!
+    else if (!group->isInvitedToBgInstanceGuid && group->isRated)
+    {
+        // remove next player, this is recursive
+        // first send removal information
+        sWorld.GetMessager().AddMessage([guid = group->players.begin()->first, bgTypeId = group->bgTypeId, arenaType = group->arenaType](World* /*world*/)
+        {
+            Player* plr2 = sObjectMgr.GetPlayer(guid);
+            if (!plr2)
+                return;
+
+            BattleGround* bg = sBattleGroundMgr.GetBattleGroundTemplate(bgTypeId);
+            BattleGroundQueueTypeId bgQueueTypeId = BattleGroundMgr::BgQueueTypeId(bgTypeId, arenaType);
+
+            uint32 queueSlot = plr2->GetBattleGroundQueueIndex(bgQueueTypeId);
+            plr2->RemoveBattleGroundQueueId(bgQueueTypeId); // must be called this way, because if you move this call to
+
+            // queue->removeplayer, it causes bugs
+            WorldPacket data;
+            sBattleGroundMgr.BuildBattleGroundStatusPacket(data, bg, queueSlot, STATUS_NONE, 0, 0, ARENA_TYPE_NONE, TEAM_NONE);
+            plr2->GetSession()->SendPacket(data);
+        });
+
+        // then actually delete, this may delete the group as well!
+        RemovePlayer(queue, group->players.begin()->first, decreaseInvitedCount);
+    }
+}
+
+/**
+  Function that returns true when player is in queue and is invited to bgInstanceGuid
+
+  @param    player guid
+  @param    battleground instance guid
+  @param    remove time
+*/
+bool BattleGroundQueueItem::IsPlayerInvited(ObjectGuid playerGuid, const uint32 bgInstanceGuid, const uint32 removeTime)
+{
+    QueuedPlayersMap::const_iterator qItr = m_queuedPlayers.find(playerGuid);
+    return (qItr != m_queuedPlayers.end()
+            && qItr->second.groupInfo->isInvitedToBgInstanceGuid == bgInstanceGuid
+            && qItr->second.groupInfo->removeInviteTime == removeTime);
+}
+
+/**
+  Function that returns player group info data
+  - returns true when the player is found in queue
+
+  @param    player guid
+  @param    group queue info
+*/
+bool BattleGroundQueueItem::GetPlayerGroupInfoData(ObjectGuid guid, GroupQueueInfo* queueInfo)
+{
+    QueuedPlayersMap::const_iterator qItr = m_queuedPlayers.find(guid);
+    if (qItr == m_queuedPlayers.end())
+        return false;
+
+    *queueInfo = *(qItr->second.groupInfo);
+    return true;
+}
+
+/**
+  Function that invites group to battleground
+  - only the queue side is changed here, the collected invite is applied to the battleground on the world thread
+
+  @param    group queue info
+  @param    battleground queue data
+  @param    team
+  @param    invites to send
+*/
+bool BattleGroundQueueItem::InviteGroupToBg(GroupQueueInfo* queueInfo, BattleGroundInQueueInfo& bgInfo, Team team, std::vector<BattleGroundQueueInvite>& invites)
+{
+    // set side if needed
+    if (team == ALLIANCE || team == HORDE)
+        queueInfo->groupTeam = team;
+
+    if (!queueInfo->isInvitedToBgInstanceGuid)
+    {
+        // not yet invited
+        // set invitation
+        queueInfo->isInvitedToBgInstanceGuid = bgInfo.instanceId;
+        queueInfo->removeInviteTime = WorldTimer::getMSTime() + INVITE_ACCEPT_WAIT_TIME;
+
+        BattleGroundQueueInvite invite;
+        invite.team = queueInfo->groupTeam;
+        invite.arenaType = queueInfo->arenaType;
+        invite.arenaTeamId = queueInfo->arenaTeamId;
+        invite.removeInviteTime = queueInfo->removeInviteTime;
+
+        // loop through the players
+        for (GroupQueueInfoPlayers::iterator itr = queueInfo->players.begin(); itr != queueInfo->players.end(); ++itr)
+        {
+            // invite the player
+            PlayerInvitedToBgUpdateAverageWaitTime(queueInfo, bgInfo.bracketId);
+
+            // set invited player counters
+            bgInfo.IncreaseInvitedCount(queueInfo->groupTeam);
+
+            invite.players.push_back(itr->first);
+        }
+
+        invites.push_back(invite);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+  Method that invites the groups of both selection pools to battleground
+
+  @param    battleground queue data
+  @param    invites to send
+*/
+void BattleGroundQueueItem::InviteSelectionPools(BattleGroundInQueueInfo& bgInfo, std::vector<BattleGroundQueueInvite>& invites)
+{
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+        for (GroupsQueueType::const_iterator citr = m_selectionPools[TEAM_INDEX_ALLIANCE + i].selectedGroups.begin(); citr != m_selectionPools[TEAM_INDEX_ALLIANCE + i].selectedGroups.end(); ++citr)
+            InviteGroupToBg((*citr), bgInfo, (*citr)->groupTeam, invites);
+}
+
+/**
+  Method that invites players to an already running battleground
+  - invitation is based on config file
+  - large groups are disadvantageous, because they will be kicked first if invitation type = 1
+
+  @param    battleground queue data
+  @param    bracket id
+*/
+void BattleGroundQueueItem::FillPlayersToBg(BattleGroundInQueueInfo* bgInfo, BattleGroundBracketId bracketId)
+{
+    int32 hordeFree = bgInfo->GetFreeSlotsForTeam(HORDE);
+    int32 aliFree   = bgInfo->GetFreeSlotsForTeam(ALLIANCE);
+
+    // iterator for iterating through bg queue
+    GroupsQueueType::const_iterator Ali_itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin();
+    // count of groups in queue - used to stop cycles
+    uint32 aliCount = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].size();
+    // index to queue which group is current
+    uint32 aliIndex = 0;
+    for (; aliIndex < aliCount && m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), aliFree, bgInfo->clientInstanceId); ++aliIndex)
+        ++Ali_itr;
+
+    // the same thing for horde
+    GroupsQueueType::const_iterator Horde_itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin();
+    uint32 hordeCount = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].size();
+    uint32 hordeIndex = 0;
+    for (; hordeIndex < hordeCount && m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), hordeFree, bgInfo->clientInstanceId); ++hordeIndex)
+        ++Horde_itr;
+
+    // if ofc like BG queue invitation is set in config, then we are happy
+    if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) == 0)
+        return;
+
+    /*
+    if we reached this code, then we have to solve NP - complete problem called Subset sum problem
+    So one solution is to check all possible invitation subgroups, or we can use these conditions:
+    1. Last time when BattleGroundQueueItem::Update was executed we invited all possible players - so there is only small possibility
+        that we will invite now whole queue, because only 1 change has been made to queues from the last BattleGroundQueueItem::Update call
+    2. Other thing we should consider is group order in queue
+    */
+
+    // At first we need to compare free space in bg and our selection pool
+    int32 diffAli   = aliFree   - int32(m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
+    int32 diffHorde = hordeFree - int32(m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+    while (abs(diffAli - diffHorde) > 1 && (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() > 0 || m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() > 0))
+    {
+        // each cycle execution we need to kick at least 1 group
+        if (diffAli < diffHorde)
+        {
+            // kick alliance group, add to pool new group if needed
+            if (m_selectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffHorde - diffAli))
+            {
+                for (; aliIndex < aliCount && m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), (aliFree >= diffHorde) ? aliFree - diffHorde : 0, bgInfo->clientInstanceId); ++aliIndex)
+                    ++Ali_itr;
+            }
+            // if ali selection is already empty, then kick horde group, but if there are less horde than ali in bg - break;
+            if (!m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+            {
+                if (aliFree <= diffHorde + 1)
+                    break;
+                m_selectionPools[TEAM_INDEX_HORDE].KickGroup(diffHorde - diffAli);
+            }
+        }
+        else
+        {
+            // kick horde group, add to pool new group if needed
+            if (m_selectionPools[TEAM_INDEX_HORDE].KickGroup(diffAli - diffHorde))
+            {
+                for (; hordeIndex < hordeCount && m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), (hordeFree >= diffAli) ? hordeFree - diffAli : 0, bgInfo->clientInstanceId); ++hordeIndex)
+                    ++Horde_itr;
+            }
+            if (!m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
+            {
+                if (hordeFree <= diffAli + 1)
+                    break;
+                m_selectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffAli - diffHorde);
+            }
+        }
+
+        // count diffs after small update
+        diffAli   = aliFree   - int32(m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount());
+        diffHorde = hordeFree - int32(m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+    }
+}
+
+/**
+  Method that checks if (premade vs premade) battlegrouns is possible
+  - then after 30 mins (default) in queue it moves premade group to normal queue
+  - it tries to invite as much players as it can - to maxPlayersPerTeam, because premade groups have more than minPlayersPerTeam players
+
+  @param    bracket id
+  @param    min players per team
+  @param    max players per team
+*/
+bool BattleGroundQueueItem::CheckPremadeMatch(BattleGroundBracketId bracketId, uint32 minPlayersPerTeam, uint32 maxPlayersPerTeam)
+{
+    // check match
+    if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty())
+    {
+        // start premade match
+        // if groups aren't invited
+        GroupsQueueType::const_iterator ali_group, horde_group;
+        for (ali_group = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].begin(); ali_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end(); ++ali_group)
+            if (!(*ali_group)->isInvitedToBgInstanceGuid)
+                break;
+
+        for (horde_group = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].begin(); horde_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end(); ++horde_group)
+            if (!(*horde_group)->isInvitedToBgInstanceGuid)
+                break;
+
+        if (ali_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end() && horde_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end())
+        {
+            m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*ali_group), maxPlayersPerTeam, 0);
+            m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*horde_group), maxPlayersPerTeam, 0);
+
+            // add groups/players from normal queue to size of bigger group
+            uint32 maxPlayers = std::max(m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount(), m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
+            for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+            {
+                for (GroupsQueueType::const_iterator itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++itr)
+                {
+                    // if itr can join BG and player count is less that maxPlayers, then add group to selectionpool
+                    if (!(*itr)->isInvitedToBgInstanceGuid && !m_selectionPools[i].AddGroup((*itr), maxPlayers, 0))
+                        break;
+                }
+            }
+
+            // premade selection pools are set
+            return true;
+        }
+    }
+    // now check if we can move group from Premade queue to normal queue (timer has expired) or group size lowered!!
+    // this could be 2 cycles but i'm checking only first team in queue - it can cause problem -
+    // if first is invited to BG and seconds timer expired, but we can ignore it, because players have only 80 seconds to click to enter bg
+    // and when they click or after 80 seconds the queue info is removed from queue
+    uint32 time_before = WorldTimer::getMSTime() - sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH);
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+    {
+        if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
+        {
+            GroupsQueueType::iterator itr = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
+            if (!(*itr)->isInvitedToBgInstanceGuid && ((*itr)->joinTime < time_before || (*itr)->players.size() < minPlayersPerTeam))
+            {
+                // we must insert group to normal queue and erase pointer from premade queue
+                MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + i);
+            }
+        }
+    }
+
+    // selection pools are not set
+    return false;
+}
+
+/**
+  Method that tries to create battleground or arena with minPlayersPerTeam against maxPlayersPerTeam
+
+  @param    battleground queue
+  @param    battleground template
+  @param    bracket id
+  @param    min players
+  @param    max players
+*/
+bool BattleGroundQueueItem::CheckNormalMatch(BattleGroundQueue& queue, BattleGroundQueueTemplate const* bgTemplate, BattleGroundBracketId bracketId, uint32 minPlayers, uint32 maxPlayers)
+{
+    GroupsQueueType::const_iterator itr_team[PVP_TEAM_COUNT];
+    for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
+    {
+        itr_team[i] = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].begin();
+        for (; itr_team[i] != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++(itr_team[i]))
+        {
+            if (!(*(itr_team[i]))->isInvitedToBgInstanceGuid)
+            {
+                m_selectionPools[i].AddGroup(*(itr_team[i]), maxPlayers, 0);
+                if (m_selectionPools[i].GetPlayerCount() >= minPlayers)
+                    break;
+            }
+        }
+    }
+
+    // try to invite same number of players - this cycle may cause longer wait time even if there are enough players in queue, but we want ballanced bg
+    uint32 j = TEAM_INDEX_ALLIANCE;
+    if (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() < m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+        j = TEAM_INDEX_HORDE;
+
+    if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) != 0
+            && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= minPlayers && m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= minPlayers)
+    {
+        // we will try to invite more groups to team with less players indexed by j
+        ++(itr_team[j]);                                    // this will not cause a crash, because for cycle above reached break;
+        for (; itr_team[j] != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + j].end(); ++(itr_team[j]))
+        {
+            if (!(*(itr_team[j]))->isInvitedToBgInstanceGuid)
+                if (!m_selectionPools[j].AddGroup(*(itr_team[j]), m_selectionPools[(j + 1) % PVP_TEAM_COUNT].GetPlayerCount(), 0))
+                    break;
+        }
+        // do not allow to start bg with more than 2 players more on 1 faction
+        if (abs((int32)(m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() - m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())) > 2)
+            return false;
+    }
+
+    // allow 1v0 if debug bg
+    if (queue.IsTesting() && bgTemplate->IsBattleGround() && (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() || m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount()))
+        return true;
+
+    // return true if there are enough players in selection pools - enable to work .debug bg command correctly
+    return m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= minPlayers && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= minPlayers;
+}
+
+/**
+  Method that will check if we can invite players to same faction skirmish match
+
+  @param    bracket id
+  @param    min players
+*/
+bool BattleGroundQueueItem::CheckSkirmishForSameFaction(BattleGroundBracketId bracketId, uint32 minPlayersPerTeam)
+{
+    if (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() < minPlayersPerTeam && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() < minPlayersPerTeam)
+        return false;
+
+    PvpTeamIndex teamIdx = TEAM_INDEX_ALLIANCE;
+    PvpTeamIndex otherTeamIdx = TEAM_INDEX_HORDE;
+    Team otherTeamId = HORDE;
+
+    if (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() == minPlayersPerTeam)
+    {
+        teamIdx = TEAM_INDEX_HORDE;
+        otherTeamIdx = TEAM_INDEX_ALLIANCE;
+        otherTeamId = ALLIANCE;
+    }
+
+    // clear other team's selection
+    m_selectionPools[otherTeamIdx].Init();
+    // store last ginfo pointer
+    GroupQueueInfo* ginfo = m_selectionPools[teamIdx].selectedGroups.back();
+    // set itr_team to group that was added to selection pool latest
+    if (ginfo->queueIndex != BG_QUEUE_NORMAL_ALLIANCE + teamIdx)
+        return false;
+
+    GroupsQueueType::iterator itr_team = ginfo->queuePosition;
+
+    GroupsQueueType::iterator itr_team2 = itr_team;
+    ++itr_team2;
+    // invite players to other selection pool
+    for (; itr_team2 != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team2)
+    {
+        // if selection pool is full then break;
+        if (!(*itr_team2)->isInvitedToBgInstanceGuid && !m_selectionPools[otherTeamIdx].AddGroup(*itr_team2, minPlayersPerTeam, 0))
+            break;
+    }
+
+    if (m_selectionPools[otherTeamIdx].GetPlayerCount() != minPlayersPerTeam)
+        return false;
+
+    // here we have correct 2 selections and we need to change one teams team and move selection pool teams to other team's queue
+    for (GroupsQueueType::iterator itr = m_selectionPools[otherTeamIdx].selectedGroups.begin(); itr != m_selectionPools[otherTeamIdx].selectedGroups.end(); ++itr)
+    {
+        // set correct team
+        (*itr)->groupTeam = otherTeamId;
+
+        // move team to other queue
+        MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx);
+    }
+    return true;
+}
+
+/**
+  Method that is called when group is inserted, or player / group is removed from BG Queue - there is only one player's status changed, so we don't use while(true) cycles to invite whole queue
+  - it must be called after fully adding the members of a group to ensure group joining
+  - runs on the queue thread, the battlegrounds are created and the players invited on the world thread
+
+  @param    battleground queue
+  @param    bg type id
+  @param    bracket id
+  @param    arena type
+  @param    isRated
+  @param    arenaRating
+*/
+void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId, ArenaType arenaType, bool isRated, uint32 arenaRating)
+{
+    // if no players in queue - do nothing
+    if (m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
+            m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty() &&
+            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
+            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].empty())
+        return;
+
+    // battleground with free slot for player should be always in the beggining of the queue
+    // maybe it would be better to create bgfreeslotqueue for each bracket_id
+    BgFreeSlotQueueType& freeSlotQueue = queue.GetFreeSlotQueue(bgTypeId);
+    BgFreeSlotQueueType::iterator next;
+    for (BgFreeSlotQueueType::iterator itr = freeSlotQueue.begin(); itr != freeSlotQueue.end(); itr = next)
+    {
+        next = itr;
+        ++next;
+        // DO NOT allow queue manager to invite new player to arena
+        if ((*itr)->isBattleGround && (*itr)->typeId == bgTypeId && (*itr)->bracketId == bracketId &&
+                (*itr)->status > STATUS_WAIT_QUEUE && (*itr)->status < STATUS_WAIT_LEAVE)
+        {
+            BattleGroundInQueueInfo* bgInfo = *itr; // we have to store battleground pointer here, because when battleground is full, it is removed from free queue
+            // and iterator is invalid
+
+            // clear selection pools
+            m_selectionPools[TEAM_INDEX_ALLIANCE].Init();
+            m_selectionPools[TEAM_INDEX_HORDE].Init();
+
+            // call a function that does the job for us
+            FillPlayersToBg(bgInfo, bracketId);
+
+            // now everything is set, invite players
+            std::vector<BattleGroundQueueInvite> invites;
+            InviteSelectionPools(*bgInfo, invites);
+            if (!invites.empty())
+                queue.SendInvites(*bgInfo, nullptr, invites, false);
+
+            if (!bgInfo->HasFreeSlots())
+            {
+                // remove BG from BGFreeSlotQueue
+                queue.RemoveFromBgFreeSlotQueue(bgInfo->instanceId);
+            }
+        }
+    }
+
+    // finished iterating through the bgs with free slots, maybe we need to create a new bg
+
+    BattleGroundQueueTemplate const* bgTemplate = queue.GetBattleGroundTemplate(bgTypeId);
+    if (!bgTemplate)
+    {
+        sLog.outError("Battleground: Update: bg template not found for %u", bgTypeId);
+        return;
+    }
+
+    PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketById(bgTemplate->mapId, bracketId);
+    if (!bracketEntry)
+    {
+        sLog.outError("Battleground: Update: bg bracket entry not found for map %u bracket id %u", bgTemplate->mapId, bracketId);
+        return;
+    }
+
+    // get the min. players per team, properly for larger arenas as well. (must have full teams for arena matches!)
+    uint32 minPlayersPerTeam = bgTemplate->minPlayersPerTeam;
+    uint32 maxPlayersPerTeam = bgTemplate->maxPlayersPerTeam;
+
+    if (queue.IsTesting())
+        minPlayersPerTeam = 1;
+
+    if (bgTemplate->isArena)
+    {
+        if (queue.IsArenaTesting())
+        {
+            maxPlayersPerTeam = 1;
+            minPlayersPerTeam = 1;
+        }
+        else
+        {
+            // this switch can be much shorter
+            maxPlayersPerTeam = arenaType;
+            minPlayersPerTeam = arenaType;
+        }
+    }
+
+    m_selectionPools[TEAM_INDEX_ALLIANCE].Init();
+    m_selectionPools[TEAM_INDEX_HORDE].Init();
+
+    if (bgTemplate->IsBattleGround())
+    {
+        // check if there is premade against premade match
+        if (CheckPremadeMatch(bracketId, minPlayersPerTeam, maxPlayersPerTeam))
+        {
+            // create new battleground
+            BattleGroundInQueueInfo* bgInfo = queue.CreateBattleGroundInfo(bgTemplate, bracketId, ARENA_TYPE_NONE, false);
+            if (!bgInfo)
+            {
+                sLog.outError("BattleGroundQueue::Update - Cannot create battleground: %u", bgTypeId);
+                return;
+            }
+
+            // invite those selection pools
+            std::vector<BattleGroundQueueInvite> invites;
+            InviteSelectionPools(*bgInfo, invites);
+
+            // start bg
+            queue.SendInvites(*bgInfo, bracketEntry, invites, true);
+            // clear structures
+            m_selectionPools[TEAM_INDEX_ALLIANCE].Init();
+            m_selectionPools[TEAM_INDEX_HORDE].Init();
+        }
+    }
+
+    // now check if there are in queues enough players to start new game of (normal battleground, or non-rated arena)
+    if (!isRated)
+    {
+        // if there are enough players in pools, start new battleground or non rated arena
+        if (CheckNormalMatch(queue, bgTemplate, bracketId, minPlayersPerTeam, maxPlayersPerTeam)
+                || (bgTemplate->isArena && CheckSkirmishForSameFaction(bracketId, minPlayersPerTeam)))
+        {
+            // we successfully created a pool
+            BattleGroundInQueueInfo* bgInfo = queue.CreateBattleGroundInfo(bgTemplate, bracketId, arenaType, false);
+            if (!bgInfo)
+            {
+                sLog.outError("BattleGroundQueue::Update - Cannot create battleground: %u", bgTypeId);
+                return;
+            }
+
+            // invite those selection pools
+            std::vector<BattleGroundQueueInvite> invites;
+            InviteSelectionPools(*bgInfo, invites);
+
+            // start bg
+            queue.SendInvites(*bgInfo, bracketEntry, invites, true);
+        }
+    }
+    else if (bgTemplate->isArena)
+    {
+        // found out the minimum and maximum ratings the newly added team should battle against
+        // arenaRating is the rating of the latest joined team, or 0
+        // 0 is on (automatic update call) and we must set it to team's with longest wait time
+        if (!arenaRating)
+        {
+            GroupQueueInfo* front1 = nullptr;
+            GroupQueueInfo* front2 = nullptr;
+            if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty())
+            {
+                front1 = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].front();
+                arenaRating = front1->arenaTeamRating;
+            }
+
+            if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty())
+            {
+                front2 = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].front();
+                arenaRating = front2->arenaTeamRating;
+            }
+
+            if (front1 && front2)
+            {
+                if (front1->joinTime < front2->joinTime)
+                    arenaRating = front1->arenaTeamRating;
+            }
+            else if (!front1 && !front2)
+                return; // queues are empty
+        }
+
+        // set rating range
+        uint32 arenaMinRating = (arenaRating <= sBattleGroundMgr.GetMaxRatingDifference()) ? 0 : arenaRating - sBattleGroundMgr.GetMaxRatingDifference();
+        uint32 arenaMaxRating = arenaRating + sBattleGroundMgr.GetMaxRatingDifference();
+        // if max rating difference is set and the time past since server startup is greater than the rating discard time
+        // (after what time the ratings aren't taken into account when making teams) then
+        // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
+        // else leave the discard time on 0, this way all ratings will be discarded
+        uint32 discardTime = WorldTimer::getMSTime() - sBattleGroundMgr.GetRatingDiscardTimer();
+
+        // we need to find 2 teams which will play next game
+        GroupQueueInfo* teams[PVP_TEAM_COUNT];
+
+        // take the team that joined first in each faction queue
+        for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
+            teams[i] = SelectRatedArenaTeam(bracketId, i, arenaMinRating, arenaMaxRating, discardTime, nullptr);
+
+        // now we are done if we have 2 teams - ali vs horde!
+        // if we don't have, we must try to continue search in same faction queue
+        if (!teams[TEAM_INDEX_ALLIANCE] && teams[TEAM_INDEX_HORDE])
+            teams[TEAM_INDEX_ALLIANCE] = SelectRatedArenaTeam(bracketId, BG_QUEUE_PREMADE_HORDE, arenaMinRating, arenaMaxRating, discardTime, teams[TEAM_INDEX_HORDE]);
+
+        if (!teams[TEAM_INDEX_HORDE] && teams[TEAM_INDEX_ALLIANCE])
+            teams[TEAM_INDEX_HORDE] = SelectRatedArenaTeam(bracketId, BG_QUEUE_PREMADE_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, teams[TEAM_INDEX_ALLIANCE]);
+
+        // if we have 2 teams, then start new arena and invite players!
+        if (teams[TEAM_INDEX_ALLIANCE] && teams[TEAM_INDEX_HORDE])
+        {
+            BattleGroundInQueueInfo* bgInfo = queue.CreateBattleGroundInfo(bgTemplate, bracketId, arenaType, true);
+            if (!bgInfo)
+            {
+                sLog.outError("BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
+                return;
+            }
+
+            teams[TEAM_INDEX_ALLIANCE]->opponentsTeamRating = teams[TEAM_INDEX_HORDE]->arenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", teams[TEAM_INDEX_ALLIANCE]->arenaTeamId, teams[TEAM_INDEX_ALLIANCE]->opponentsTeamRating);
+            teams[TEAM_INDEX_HORDE]->opponentsTeamRating = teams[TEAM_INDEX_ALLIANCE]->arenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", teams[TEAM_INDEX_HORDE]->arenaTeamId, teams[TEAM_INDEX_HORDE]->opponentsTeamRating);
+
+            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+            if (teams[TEAM_INDEX_ALLIANCE]->queueIndex != BG_QUEUE_PREMADE_ALLIANCE)
+                MoveGroupToQueue(teams[TEAM_INDEX_ALLIANCE], BG_QUEUE_PREMADE_ALLIANCE);
+
+            if (teams[TEAM_INDEX_HORDE]->queueIndex != BG_QUEUE_PREMADE_HORDE)
+                MoveGroupToQueue(teams[TEAM_INDEX_HORDE], BG_QUEUE_PREMADE_HORDE);
+
+            std::vector<BattleGroundQueueInvite> invites;
+            InviteGroupToBg(teams[TEAM_INDEX_ALLIANCE], *bgInfo, ALLIANCE, invites);
+            InviteGroupToBg(teams[TEAM_INDEX_HORDE], *bgInfo, HORDE, invites);
+
+            DEBUG_LOG("Starting rated arena match!");
+
+            queue.SendInvites(*bgInfo, bracketEntry, invites, true);
+        }
+    }
+}
+
+/**
+  Method that moves group to front of another queue of its bracket
+
+  @param    group queue info
+  @param    queue index
+*/
+void BattleGroundQueueItem::MoveGroupToQueue(GroupQueueInfo* queueInfo, uint8 queueIndex)
+{
+    m_queuedGroups[queueInfo->bracketId][queueInfo->queueIndex].erase(queueInfo->queuePosition);
+    m_queuedGroups[queueInfo->bracketId][queueIndex].push_front(queueInfo);
+    queueInfo->queuePosition = m_queuedGroups[queueInfo->bracketId][queueIndex].begin();
+
+    if (queueInfo->isRated)
+    {
+        m_ratedTeamsByJoinTime[queueInfo->bracketId][queueInfo->queueIndex].erase(queueInfo->joinTimePosition);
+        queueInfo->joinTimePosition = m_ratedTeamsByJoinTime[queueInfo->bracketId][queueIndex].emplace(queueInfo->joinTime, queueInfo);
+    }
+
+    queueInfo->queueIndex = queueIndex;
+}
+
+/**
+  Method that selects the rated arena team which joined first, out of teams in the rating range or waiting longer than discard time
+
+  @param    bracket id
+  @param    queue index
+  @param    min rating
+  @param    max rating
+  @param    discard time
+  @param    team already selected
+*/
+GroupQueueInfo* BattleGroundQueueItem::SelectRatedArenaTeam(BattleGroundBracketId bracketId, uint8 queueIndex, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const
+{
+    // join time index is ordered, the first waiting team is the oldest one
+    GroupQueueInfo* oldest = nullptr;
+    for (JoinTimeIndex::value_type const& entry : m_ratedTeamsByJoinTime[bracketId][queueIndex])
+    {
+        if (entry.second->isInvitedToBgInstanceGuid || entry.second == exclude)
+            continue;
+
+        oldest = entry.second;
+        break;
+    }
+
+    // no team in the rating range can have waited longer than a team over the discard time
+    if (!oldest || oldest->joinTime < discardTime)
+        return oldest;
+
+    GroupQueueInfo* selected = nullptr;
+    RatedTeamsIndex::const_iterator end = m_ratedTeams[bracketId].upper_bound(maxRating);
+    for (RatedTeamsIndex::const_iterator itr = m_ratedTeams[bracketId].lower_bound(minRating); itr != end; ++itr)
+    {
+        GroupQueueInfo* queueInfo = itr->second;
+        if (queueInfo->queueIndex != queueIndex || queueInfo->isInvitedToBgInstanceGuid || queueInfo == exclude)
+            continue;
+
+        if (!selected || queueInfo->joinTime < selected->joinTime)
+            selected = queueInfo;
+    }
+    return selected;
+}
+
+/**
+  Method that reverts the invites of battleground the world thread could not create or find
+
+  @param    battleground queue
+  @param    battleground instance guid
+  @param    invites that were sent
+*/
+void BattleGroundQueueItem::CancelInvites(BattleGroundQueue& queue, uint32 bgInstanceGuid, std::vector<BattleGroundQueueInvite> const& invites)
+{
+    for (BattleGroundQueueInvite const& invite : invites)
+    {
+        for (ObjectGuid const& guid : invite.players)
+        {
+            QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
+            if (itr == m_queuedPlayers.end())
+                continue;
+
+            // group can be invited again already, only revert the invite that failed
+            GroupQueueInfo* queueInfo = itr->second.groupInfo;
+            if (queueInfo->isInvitedToBgInstanceGuid != bgInstanceGuid || queueInfo->removeInviteTime != invite.removeInviteTime)
+                continue;
+
+            queueInfo->isInvitedToBgInstanceGuid = 0;
+            queueInfo->removeInviteTime = 0;
+        }
+    }
+
+    queue.RemoveBattleGroundInfo(bgInstanceGuid);
+}
+
+/*********************************************************/
+/***            BATTLEGROUND QUEUE DATA                ***/
+/*********************************************************/
+
+/**
+  Function that returns the number of players that can join a battleground based on the provided team
+
+  @param    team
+*/
+uint32 BattleGroundInQueueInfo::GetFreeSlotsForTeam(Team team) const
+{
+    // return free slot count to MaxPlayerPerTeam
+    if (status == STATUS_WAIT_JOIN || status == STATUS_IN_PROGRESS)
+        return (GetInvitedCount(team) < maxPlayersPerTeam) ? maxPlayersPerTeam - GetInvitedCount(team) : 0;
+
+    return 0;
+}
+
+/*********************************************************/
+/***            BATTLEGROUND QUEUE THREAD              ***/
+/*********************************************************/
+
+BattleGroundQueue::BattleGroundQueue() : m_testing(false), m_arenaTesting(false)
+{
+}
+
+/**
+  Queue thread loop, runs until the world is stopped
+*/
+void BattleGroundQueue::Update()
+{
+    m_nextRatingDiscardUpdate = sWorld.GetCurrentClockTime() + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER));
+    while (!World::IsStopped())
+    {
+        GetMessager().Execute(this);
+
+        // update scheduled queues
+        if (!m_queueUpdateScheduler.empty())
+        {
+            std::vector<uint64> scheduled;
+            std::swap(scheduled, m_queueUpdateScheduler);
+
+            for (uint64 i : scheduled)
+            {
+                uint32 arenaRating = i >> 32;
+                ArenaType arenaType = ArenaType(i >> 24 & 255);
+                BattleGroundQueueTypeId bgQueueTypeId = BattleGroundQueueTypeId(i >> 16 & 255);
+                BattleGroundTypeId bgTypeId = BattleGroundTypeId((i >> 8) & 255);
+                BattleGroundBracketId bracketId = BattleGroundBracketId(i & 255);
+
+                m_queueItems[bgQueueTypeId].Update(*this, bgTypeId, bracketId, arenaType, arenaRating > 0, arenaRating);
+            }
+        }
+
+        // if rating difference counts, maybe force-update queues
+        if (sWorld.getConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE) && sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER))
+        {
+            TimePoint now = sWorld.GetCurrentClockTime();
+            // it's time to force update
+            if (m_nextRatingDiscardUpdate < now)
+            {
+                // forced update for rated arenas (scan all, but skipped non rated)
+                DEBUG_LOG("BattleGroundQueue: UPDATING ARENA QUEUES");
+                for (uint8 qtype = BATTLEGROUND_QUEUE_2v2; qtype <= BATTLEGROUND_QUEUE_5v5; ++qtype)
+                    for (uint8 bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
+                        m_queueItems[qtype].Update(*this,
+                            BATTLEGROUND_AA, BattleGroundBracketId(bracket),
+                            BattleGroundMgr::BgArenaType(BattleGroundQueueTypeId(qtype)), true, 0);
+
+                m_nextRatingDiscardUpdate = now + std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER));
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+/**
+  Method that schedules queue update
+
+  @param    arena rating
+  @param    arena type
+  @param    battleground queue type id
+  @param    battleground type id
+  @param    bracket id
+*/
+void BattleGroundQueue::ScheduleQueueUpdate(uint32 arenaRating, ArenaType arenaType, BattleGroundQueueTypeId bgQueueTypeId, BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId)
+{
+    // we will use only 1 number created of bgTypeId and bracket_id
+    uint64 schedule_id = ((uint64)arenaRating << 32) | (arenaType << 24) | (bgQueueTypeId << 16) | (bgTypeId << 8) | bracketId;
+    if (std::find(m_queueUpdateScheduler.begin(), m_queueUpdateScheduler.end(), schedule_id) == m_queueUpdateScheduler.end())
+        m_queueUpdateScheduler.push_back(schedule_id);
+}
+
+/**
+  Function that returns battleground template data from battleground type
+
+  @param    battleground type id
+*/
+BattleGroundQueueTemplate const* BattleGroundQueue::GetBattleGroundTemplate(BattleGroundTypeId bgTypeId) const
+{
+    auto itr = m_battleGroundTemplates.find(bgTypeId);
+    return itr != m_battleGroundTemplates.end() ? &itr->second : nullptr;
+}
+
+/**
+  Function that selects the battleground type of the map to be created, random for arenas and random battlegrounds
+
+  @param    battleground template
+*/
+BattleGroundTypeId BattleGroundQueue::SelectMapTypeId(BattleGroundQueueTemplate const* bgTemplate) const
+{
+    // for arenas there is random map used
+    if (bgTemplate->isArena)
+    {
+        BattleGroundTypeId arenas[] = { BATTLEGROUND_NA, BATTLEGROUND_BE, BATTLEGROUND_RL, BATTLEGROUND_DS, BATTLEGROUND_RV };
+        return arenas[urand(0, countof(arenas) - 1)];
+    }
+
+    if (bgTemplate->typeId == BATTLEGROUND_RB)
+    {
+        BattleGroundTypeId battlegrounds[] = { BATTLEGROUND_AV, BATTLEGROUND_WS, BATTLEGROUND_AB, BATTLEGROUND_EY, BATTLEGROUND_SA, BATTLEGROUND_IC };
+        return battlegrounds[urand(0, countof(battlegrounds) - 1)];
+    }
+
+    return bgTemplate->typeId;
+}
+
+/**
+  Function that returns client instance id from battleground type id and bracket id
+
+  @param    battleground type id
+  @param    bracket id
+*/
+uint32 BattleGroundQueue::CreateClientVisibleInstanceId(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId)
+{
+    if (BattleGroundMgr::IsArenaType(bgTypeId))
+        return 0;                                           // arenas don't have client-instanceids
+
+    // we create here an instanceid, which is just for
+    // displaying this to the client and without any other use..
+    // the client-instanceIds are unique for each battleground-type
+    // the instance-id just needs to be as low as possible, beginning with 1
+    // the following works, because std::set is default ordered with "<"
+    // the optimalization would be to use as bitmask std::vector<uint32> - but that would only make code unreadable
+
+    uint32 lastId = 0;
+    ClientBattleGroundIdSet& ids = m_clientBattleGroundIds[bgTypeId][bracketId];
+    for (ClientBattleGroundIdSet::const_iterator itr = ids.begin(); itr != ids.end();)
+    {
+        if ((++lastId) != *itr)                             // if there is a gap between the ids, we will break..
+            break;
+        lastId = *itr;
+    }
+    ids.insert(lastId + 1);
+
+    return lastId + 1;
+}
+
+/**
+  Function that creates the queue data of a new battleground, the battleground itself is created on the world thread
+
+  @param    battleground template
+  @param    bracket id
+  @param    arena type
+  @param    isRated
+*/
+BattleGroundInQueueInfo* BattleGroundQueue::CreateBattleGroundInfo(BattleGroundQueueTemplate const* bgTemplate, BattleGroundBracketId bracketId, ArenaType arenaType, bool isRated)
+{
+    BattleGroundTypeId mapTypeId = SelectMapTypeId(bgTemplate);
+    BattleGroundQueueTemplate const* mapTemplate = GetBattleGroundTemplate(mapTypeId);
+    if (!mapTemplate)
+    {
+        sLog.outError("BattleGroundQueue: CreateBattleGroundInfo - bg template not found for %u", mapTypeId);
+        return nullptr;
+    }
+
+    BattleGroundTypeId bgTypeId = bgTemplate->typeId == BATTLEGROUND_RB ? BATTLEGROUND_RB : mapTypeId;
+    uint32 instanceId = sObjectMgr.GenerateInstanceLowGuid();
+
+    BattleGroundInQueueInfo& bgInfo = m_battleGrounds[instanceId];
+    bgInfo.instanceId = instanceId;
+    bgInfo.clientInstanceId = CreateClientVisibleInstanceId(bgTypeId, bracketId);
+    bgInfo.typeId = bgTypeId;
+    bgInfo.mapTypeId = mapTypeId;
+    bgInfo.bracketId = bracketId;
+    bgInfo.status = STATUS_WAIT_JOIN;
+    bgInfo.arenaType = arenaType;
+    bgInfo.isRated = isRated;
+    bgInfo.isBattleGround = !mapTemplate->isArena;
+    bgInfo.hasBgFreeSlotQueue = false;
+    bgInfo.maxPlayersPerTeam = mapTemplate->maxPlayersPerTeam;
+    bgInfo.playersCount = 0;
+    bgInfo.invitedAlliance = 0;
+    bgInfo.invitedHorde = 0;
+
+    // add BG to free slot queue
+    AddToBgFreeSlotQueue(instanceId);
+
+    return &bgInfo;
+}
+
+/**
+  Function that returns battleground queue data from instance id
+
+  @param    instance id
+*/
+BattleGroundInQueueInfo* BattleGroundQueue::GetBattleGroundInfo(uint32 instanceId)
+{
+    auto itr = m_battleGrounds.find(instanceId);
+    return itr != m_battleGrounds.end() ? &itr->second : nullptr;
+}
+
+/**
+  Method that removes battleground queue data - called when the battleground is deleted
+
+  @param    instance id
+*/
+void BattleGroundQueue::RemoveBattleGroundInfo(uint32 instanceId)
+{
+    auto itr = m_battleGrounds.find(instanceId);
+    if (itr == m_battleGrounds.end())
+        return;
+
+    RemoveFromBgFreeSlotQueue(instanceId);
+    m_clientBattleGroundIds[itr->second.typeId][itr->second.bracketId].erase(itr->second.clientInstanceId);
+    m_battleGrounds.erase(itr);
+}
+
+/**
+  Method that marks battleground as ended, no more players are invited to it
+
+  @param    instance id
+*/
+void BattleGroundQueue::EndBattleGround(uint32 instanceId)
+{
+    if (BattleGroundInQueueInfo* bgInfo = GetBattleGroundInfo(instanceId))
+    {
+        bgInfo->status = STATUS_WAIT_LEAVE;
+        RemoveFromBgFreeSlotQueue(instanceId);
+    }
+}
+
+/**
+  Method that sends the invites to world thread, where the battleground is created if needed and the players are invited
+
+  @param    battleground queue data
+  @param    bracket entry
+  @param    invites
+  @param    isNew
+*/
+void BattleGroundQueue::SendInvites(BattleGroundInQueueInfo const& bgInfo, PvPDifficultyEntry const* bracketEntry, std::vector<BattleGroundQueueInvite> const& invites, bool isNew)
+{
+    sWorld.GetMessager().AddMessage([bgInfo, bracketEntry, invites, isNew](World* /*world*/)
+    {
+        sBattleGroundMgr.InviteGroupsToBattleGround(bgInfo, bracketEntry, invites, isNew);
+    });
+}
+
+/**
+  Method that adds battleground to free slot queue
+
+  @param    instance id
+*/
+void BattleGroundQueue::AddToBgFreeSlotQueue(uint32 instanceId)
+{
+    BattleGroundInQueueInfo* bgInfo = GetBattleGroundInfo(instanceId);
+    // make sure to add only once
+    if (!bgInfo || bgInfo->hasBgFreeSlotQueue || !bgInfo->isBattleGround || bgInfo->status == STATUS_WAIT_LEAVE)
+        return;
+
+    m_bgFreeSlotQueue[bgInfo->typeId].push_front(bgInfo);
+    bgInfo->hasBgFreeSlotQueue = true;
+}
+
+/**
+  Method that removes battleground from free slot queue
+
+  @param    instance id
+*/
+void BattleGroundQueue::RemoveFromBgFreeSlotQueue(uint32 instanceId)
+{
+    BattleGroundInQueueInfo* bgInfo = GetBattleGroundInfo(instanceId);
+    if (!bgInfo || !bgInfo->hasBgFreeSlotQueue)
+        return;
+
+    // set to be able to re-add if needed
+    bgInfo->hasBgFreeSlotQueue = false;
+    BgFreeSlotQueueType& bgFreeSlot = m_bgFreeSlotQueue[bgInfo->typeId];
+    bgFreeSlot.remove(bgInfo);
+}
+
+/**
+  Method that updates count of players in battleground
+
+  @param    instance id
+  @param    players count
+*/
+void BattleGroundQueue::SetPlayersCount(uint32 instanceId, uint32 count)
+{
+    if (BattleGroundInQueueInfo* bgInfo = GetBattleGroundInfo(instanceId))
+        bgInfo->playersCount = count;
+}
+
+/**
+  Method that decreases invited count of battleground - called when player leaves battleground
+
+  @param    instance id
+  @param    team
+*/
+void BattleGroundQueue::DecreaseInvitedCount(uint32 instanceId, Team team)
+{
+    if (BattleGroundInQueueInfo* bgInfo = GetBattleGroundInfo(instanceId))
+        bgInfo->DecreaseInvitedCount(team);
+}
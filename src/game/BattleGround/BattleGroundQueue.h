@@ -0,0 +1,260 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __BATTLEGROUNDQUEUE_H
+#define __BATTLEGROUNDQUEUE_H
+
+#include "Common.h"
+#include "Globals/SharedDefines.h"
+#include "Server/DBCEnums.h"
+#include "Entities/ObjectGuid.h"
+#include "BattleGround/BattleGround.h"
+#include "Multithreading/Messager.h"
+
+#include <string>
+
+struct PvPDifficultyEntry;
+class BattleGroundQueue;
+
+#define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
+
+struct GroupQueueInfo;                                      // type predefinition
+struct PlayerQueueInfo                                      // stores information for players in queue
+{
+    uint32  lastOnlineTime;                                 // for tracking and removing offline players from queue after 5 minutes
+    GroupQueueInfo* groupInfo;                              // pointer to the associated groupqueueinfo
+};
+
+typedef std::map<ObjectGuid, PlayerQueueInfo*> GroupQueueInfoPlayers;
+
+struct GroupQueueInfo                                       // stores information about the group in queue (also used when joined as solo!)
+{
+    GroupQueueInfoPlayers players;                          // player queue info map
+    Team  groupTeam;                                        // Player team (ALLIANCE/HORDE)
+    BattleGroundTypeId bgTypeId;                            // battleground type id
+    bool    isRated;                                        // rated
+    ArenaType arenaType;                                    // 2v2, 3v3, 5v5 or 0 when BG
+    uint32  arenaTeamId;                                    // team id if rated match
+    uint32  joinTime;                                       // time when group was added
+    uint32  removeInviteTime;                               // time when we will remove invite for players in group
+    uint32  isInvitedToBgInstanceGuid;                      // was invited to certain BG
+    uint32  desiredInstanceId;                              // queued for this instance specifically
+    uint32  arenaTeamRating;                                // if rated match, inited to the rating of the team
+    uint32  opponentsTeamRating;                            // for rated arena matches
+    BattleGroundBracketId bracketId;                        // position in BattleGroundQueue, for removal without search
+    uint8   queueIndex;                                     // BattleGroundQueueGroupTypes
+    std::list<GroupQueueInfo*>::iterator queuePosition;
+    std::multimap<uint32, GroupQueueInfo*>::iterator joinTimePosition; // position in rated arena join time index
+};
+
+enum BattleGroundQueueGroupTypes
+{
+    BG_QUEUE_PREMADE_ALLIANCE   = 0,
+    BG_QUEUE_PREMADE_HORDE      = 1,
+    BG_QUEUE_NORMAL_ALLIANCE    = 2,
+    BG_QUEUE_NORMAL_HORDE       = 3
+};
+
+#define BG_QUEUE_GROUP_TYPES_COUNT 4
+
+// battleground template data needed for matching, copied to the queue thread at startup
+struct BattleGroundQueueTemplate
+{
+    BattleGroundTypeId typeId;
+    uint32 mapId;
+    uint32 minPlayersPerTeam;
+    uint32 maxPlayersPerTeam;
+    bool isArena;
+    std::string name;
+
+    bool IsBattleGround() const { return !isArena; }
+};
+
+// queue thread side data of a battleground instance, the instance itself is owned by the world thread
+struct BattleGroundInQueueInfo
+{
+    uint32 instanceId;
+    uint32 clientInstanceId;
+    BattleGroundTypeId typeId;                              // type of the queue, BATTLEGROUND_RB for random battlegrounds
+    BattleGroundTypeId mapTypeId;                           // type selected for the map, differs for random battlegrounds and arenas
+    BattleGroundBracketId bracketId;
+    BattleGroundStatus status;                              // STATUS_WAIT_JOIN until the battleground ends, then STATUS_WAIT_LEAVE
+    ArenaType arenaType;
+    bool isRated;
+    bool isBattleGround;
+    bool hasBgFreeSlotQueue;
+    uint32 maxPlayersPerTeam;
+    uint32 playersCount;                                    // players that entered the battleground
+    uint32 invitedAlliance;
+    uint32 invitedHorde;
+
+    void DecreaseInvitedCount(Team team) { (team == ALLIANCE) ? --invitedAlliance : --invitedHorde; }
+    void IncreaseInvitedCount(Team team) { (team == ALLIANCE) ? ++invitedAlliance : ++invitedHorde; }
+    uint32 GetInvitedCount(Team team) const { return team == ALLIANCE ? invitedAlliance : invitedHorde; }
+    bool HasFreeSlots() const { return playersCount < maxPlayersPerTeam * 2; }
+    uint32 GetFreeSlotsForTeam(Team team) const;
+};
+
+// this container can't be deque, because deque doesn't like removing the last element - if you remove it, it invalidates next iterator and crash appears
+typedef std::list<BattleGroundInQueueInfo*> BgFreeSlotQueueType;
+
+// group invited by the queue thread, applied to the battleground on the world thread
+struct BattleGroundQueueInvite
+{
+    GuidVector players;
+    Team team;
+    ArenaType arenaType;
+    uint32 arenaTeamId;
+    uint32 removeInviteTime;
+};
+
+class BattleGroundQueueItem
+{
+    public:
+        BattleGroundQueueItem();
+        ~BattleGroundQueueItem();
+
+        void Update(BattleGroundQueue& /*queue*/, BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/, ArenaType arenaType = ARENA_TYPE_NONE, bool isRated = false, uint32 arenaRating = 0);
+
+        void FillPlayersToBg(BattleGroundInQueueInfo* /*bgInfo*/, BattleGroundBracketId /*bracketId*/);
+        bool CheckPremadeMatch(BattleGroundBracketId /*bracketId*/, uint32 /*minPlayersPerTeam*/, uint32 /*maxPlayersPerTeam*/);
+        bool CheckNormalMatch(BattleGroundQueue& /*queue*/, BattleGroundQueueTemplate const* /*bgTemplate*/, BattleGroundBracketId /*bracketId*/, uint32 /*minPlayers*/, uint32 /*maxPlayers*/);
+        bool CheckSkirmishForSameFaction(BattleGroundBracketId /*bracketId*/, uint32 /*minPlayersPerTeam*/);
+        GroupQueueInfo* AddGroup(BattleGroundQueue& /*queue*/, ObjectGuid /*leaderGuid*/, GuidVector const& /*members*/, Team /*team*/, BattleGroundTypeId /*bgTypeId*/, PvPDifficultyEntry const* /*bracketEntry*/, ArenaType /*arenaType*/, bool /*isRated*/, bool /*isPremade*/, uint32 /*instanceId*/, uint32 /*arenaRating*/, uint32 arenaTeamId = 0);
+        void RemovePlayer(BattleGroundQueue& /*queue*/, ObjectGuid /*guid*/, bool /*decreaseInvitedCount*/);
+        bool IsPlayerInvited(ObjectGuid /*playerGuid*/, const uint32 /*bgInstanceGuid*/, const uint32 /*removeTime*/);
+        bool GetPlayerGroupInfoData(ObjectGuid /*guid*/, GroupQueueInfo* /*groupInfo*/);
+        void PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
+        uint32 GetAverageQueueWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
+        void CancelInvites(BattleGroundQueue& /*queue*/, uint32 /*bgInstanceGuid*/, std::vector<BattleGroundQueueInvite> const& /*invites*/);
+
+    private:
+        typedef std::map<ObjectGuid, PlayerQueueInfo> QueuedPlayersMap;
+        QueuedPlayersMap m_queuedPlayers;
+
+        // we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
+        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+
+        /*
+        This two dimensional array is used to store All queued groups
+        First dimension specifies the bgTypeId
+        Second dimension specifies the player's group types -
+             BG_QUEUE_PREMADE_ALLIANCE  is used for premade alliance groups and alliance rated arena teams
+             BG_QUEUE_PREMADE_HORDE     is used for premade horde groups and horde rated arena teams
+             BG_QUEUE_NORMAL_ALLIANCE   is used for normal (or small) alliance groups or non-rated arena matches
+             BG_QUEUE_NORMAL_HORDE      is used for normal (or small) horde groups or non-rated arena matches
+        */
+        GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
+        // class to select and invite groups to bg
+        class SelectionPool
+        {
+            public:
+                SelectionPool() : playerCount(0) {}
+                void Init();
+                bool AddGroup(GroupQueueInfo* ginfo, uint32 desiredCount, uint32 bgInstanceId);
+                bool KickGroup(uint32 size);
+                uint32 GetPlayerCount() const {return playerCount;}
+                GroupsQueueType selectedGroups;
+            private:
+                uint32 playerCount;
+        };
+
+        // one selection pool for horde, other one for alliance
+        SelectionPool m_selectionPools[PVP_TEAM_COUNT];
+
+        bool InviteGroupToBg(GroupQueueInfo* /*groupInfo*/, BattleGroundInQueueInfo& /*bgInfo*/, Team /*side*/, std::vector<BattleGroundQueueInvite>& /*invites*/);
+        void InviteSelectionPools(BattleGroundInQueueInfo& /*bgInfo*/, std::vector<BattleGroundQueueInvite>& /*invites*/);
+
+        void MoveGroupToQueue(GroupQueueInfo* /*groupInfo*/, uint8 /*queueIndex*/);
+        GroupQueueInfo* SelectRatedArenaTeam(BattleGroundBracketId /*bracketId*/, uint8 /*queueIndex*/, uint32 /*minRating*/, uint32 /*maxRating*/, uint32 /*discardTime*/, GroupQueueInfo const* /*exclude*/) const;
+
+        // rated arena teams by rating, match search is limited to the rating window instead of whole queue
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedTeamsIndex;
+        RatedTeamsIndex m_ratedTeams[MAX_BATTLEGROUND_BRACKETS];
+        // rated arena teams by join time for each queue, moved teams go to the queue front so the queue itself is not ordered
+        typedef std::multimap<uint32, GroupQueueInfo*> JoinTimeIndex;
+        JoinTimeIndex m_ratedTeamsByJoinTime[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
+        uint32 m_waitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
+        uint32 m_waitTimeLastPlayer[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
+        uint32 m_sumOfWaitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS];
+};
+
+/*
+ * intended to live in its own thread - must not access anything from the outside that is mutable
+ * battlegrounds and players are changed only on the world thread, through the world messager
+ */
+class BattleGroundQueue
+{
+    public:
+        BattleGroundQueue();
+
+        void Update();
+
+        Messager<BattleGroundQueue>& GetMessager() { return m_messager; }
+
+        BattleGroundQueueItem& GetQueueItem(BattleGroundQueueTypeId bgQueueTypeId) { return m_queueItems[bgQueueTypeId]; }
+
+        void ScheduleQueueUpdate(uint32 /*arenaRating*/, ArenaType /*arenaType*/, BattleGroundQueueTypeId /*bgQueueTypeId*/, BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
+
+        /* Battleground templates */
+        void AddBattleGroundTemplate(BattleGroundQueueTemplate const& bgTemplate) { m_battleGroundTemplates[bgTemplate.typeId] = bgTemplate; }
+        BattleGroundQueueTemplate const* GetBattleGroundTemplate(BattleGroundTypeId /*bgTypeId*/) const;
+
+        /* Battlegrounds */
+        BattleGroundInQueueInfo* CreateBattleGroundInfo(BattleGroundQueueTemplate const* /*bgTemplate*/, BattleGroundBracketId /*bracketId*/, ArenaType /*arenaType*/, bool /*isRated*/);
+        BattleGroundInQueueInfo* GetBattleGroundInfo(uint32 /*instanceId*/);
+        void RemoveBattleGroundInfo(uint32 /*instanceId*/);
+        void EndBattleGround(uint32 /*instanceId*/);
+        void SendInvites(BattleGroundInQueueInfo const& /*bgInfo*/, PvPDifficultyEntry const* /*bracketEntry*/, std::vector<BattleGroundQueueInvite> const& /*invites*/, bool /*isNew*/);
+
+        BgFreeSlotQueueType& GetFreeSlotQueue(BattleGroundTypeId bgTypeId) { return m_bgFreeSlotQueue[bgTypeId]; }
+        void AddToBgFreeSlotQueue(uint32 /*instanceId*/);
+        void RemoveFromBgFreeSlotQueue(uint32 /*instanceId*/);
+
+        void SetPlayersCount(uint32 /*instanceId*/, uint32 /*count*/);
+        void DecreaseInvitedCount(uint32 /*instanceId*/, Team /*team*/);
+
+        void SetTesting(bool testing) { m_testing = testing; }
+        bool IsTesting() const { return m_testing; }
+        void SetArenaTesting(bool testing) { m_arenaTesting = testing; }
+        bool IsArenaTesting() const { return m_arenaTesting; }
+
+    private:
+        BattleGroundTypeId SelectMapTypeId(BattleGroundQueueTemplate const* /*bgTemplate*/) const;
+        uint32 CreateClientVisibleInstanceId(BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
+
+        Messager<BattleGroundQueue> m_messager;
+
+        // these queues are instantiated when creating the queue, one for each queue type
+        BattleGroundQueueItem m_queueItems[MAX_BATTLEGROUND_QUEUE_TYPES];
+        std::vector<uint64> m_queueUpdateScheduler;
+        TimePoint m_nextRatingDiscardUpdate;
+
+        std::map<BattleGroundTypeId, BattleGroundQueueTemplate> m_battleGroundTemplates;
+        std::map<uint32, BattleGroundInQueueInfo> m_battleGrounds;
+        BgFreeSlotQueueType m_bgFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID];
+        typedef std::set<uint32> ClientBattleGroundIdSet;
+        ClientBattleGroundIdSet m_clientBattleGroundIds[MAX_BATTLEGROUND_TYPE_ID][MAX_BATTLEGROUND_BRACKETS]; // the instanceids just visible for the client
+
+        bool m_testing;
+        bool m_arenaTesting;
+};
+
+#endif
@@ -33,6 +33,7 @@
 #include "Spells/SpellMgr.h"
 #include "Pools/PoolManager.h"
 #include "GameEvents/GameEventMgr.h"
+#include "Entities/PlayerLoginCache.h"
 
 // Supported shift-links (client generated and server side)
 // |color|Hachievement:achievement_id:player_guid_hex:completed_0_1:mm:dd:yy_from_2000:criteriaMask1:criteriaMask2:criteriaMask3:criteriaMask4|h[name]|h|r
@@ -840,13 +841,16 @@ ChatCommand* ChatHandler::getCommandTable()
 
     static ChatCommand serverCommandTable[] =
     {
+        { "bufferpool",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerBufferPoolCommand,    "", nullptr },
         { "corpses",        SEC_GAMEMASTER,     true,  &ChatHandler::HandleServerCorpsesCommand,       "", nullptr },
+        { "dbscriptstats",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerDBScriptStatsCommand, "", nullptr },
         { "exit",           SEC_CONSOLE,        true,  &ChatHandler::HandleServerExitCommand,          "", nullptr },
         { "idlerestart",    SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverIdleRestartCommandTable },
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverIdleShutdownCommandTable },
         { "info",           SEC_PLAYER,         true,  &ChatHandler::HandleServerInfoCommand,          "", nullptr },
         { "log",            SEC_CONSOLE,        true,  nullptr,                                           "", serverLogCommandTable },
         { "motd",           SEC_PLAYER,         true,  &ChatHandler::HandleServerMotdCommand,          "", nullptr },
+        { "opcodestats",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerOpcodeStatsCommand,   "", nullptr },
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", nullptr },
         { "resetallraid",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerResetAllRaidCommand,  "", nullptr },
         { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverRestartCommandTable },
@@ -3484,6 +3488,10 @@ bool ChatHandler::ExtractPlayerTarget(char** args, Player** player /*= nullptr*/
         // if need guid value from DB (in name case for check player existence)
         ObjectGuid guid = !pl && (player_guid || player_name) ? sObjectMgr.GetPlayerGuidByName(name) : ObjectGuid();
 
+        // command may change DB data of the offline character
+        if (guid)
+            sPlayerLoginCache.Invalidate(guid);
+
         // if allowed player guid (if no then only online players allowed)
         if (player_guid)
             *player_guid = pl ? pl->GetObjectGuid() : guid;
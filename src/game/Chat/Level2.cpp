@@ -24,6 +24,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Entities/Item.h"
 #include "Entities/Player.h"
+#include "Entities/PlayerLoginCache.h"
 #include "Entities/TemporarySpawn.h"
 #include "Entities/Totem.h"
 #include "Entities/Pet.h"
@@ -3852,6 +3853,7 @@ bool ChatHandler::HandleCharacterRenameCommand(char* args)
 
         PSendSysMessage(LANG_RENAME_PLAYER_GUID, oldNameLink.c_str(), target_guid.GetCounter());
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '1' WHERE guid = '%u'", target_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(target_guid);
     }
 
     return true;
@@ -3878,6 +3880,7 @@ bool ChatHandler::HandleCharacterCustomizeCommand(char* args)
 
         PSendSysMessage(LANG_CUSTOMIZE_PLAYER_GUID, oldNameLink.c_str(), target_guid.GetCounter());
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '8' WHERE guid = '%u'", target_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(target_guid);
     }
 
     return true;
@@ -19,12 +19,14 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 #include "Server/WorldSession.h"
+#include "Server/Opcodes.h"
 #include "World/World.h"
 #include "Globals/ObjectMgr.h"
 #include "Accounts/AccountMgr.h"
 #include "Tools/PlayerDump.h"
 #include "Spells/SpellMgr.h"
 #include "Entities/Player.h"
+#include "Entities/PlayerLoginCache.h"
 #include "Entities/GameObject.h"
 #include "Chat/Chat.h"
 #include "Log/Log.h"
@@ -4340,6 +4342,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, ObjectGuid player_guid, u
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, player_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(player_guid);
     }
 }
 
@@ -4999,6 +5002,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
 
     player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE);
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
+    player->UpdatePositionIndex();
 
     player->setFactionForRace(player->getRace());
 
@@ -5089,6 +5093,7 @@ bool ChatHandler::HandleResetSpellsCommand(char* args)
     else
     {
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", uint32(AT_LOGIN_RESET_SPELLS), target_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(target_guid);
         PSendSysMessage(LANG_RESET_SPELLS_OFFLINE, target_name.c_str());
     }
 
@@ -5122,6 +5127,7 @@ bool ChatHandler::HandleResetSpecsCommand(char* args)
     {
         uint32 at_flags = AT_LOGIN_RESET_TALENTS | AT_LOGIN_RESET_PET_TALENTS;
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", at_flags, target_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(target_guid);
         std::string nameLink = playerLink(target_name);
         PSendSysMessage(LANG_RESET_TALENTS_OFFLINE, nameLink.c_str());
         return true;
@@ -5201,6 +5207,7 @@ bool ChatHandler::HandleResetTaxiNodesCommand(char* args)
     {
         uint32 at_flags = AT_LOGIN_RESET_TAXINODES;
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", at_flags, target_guid.GetCounter());
+        sPlayerLoginCache.Invalidate(target_guid);
         std::string nameLink = playerLink(target_name);
         PSendSysMessage("Taxi nodes of %s will be reset at next login.", nameLink.c_str());
         return true;
@@ -5243,6 +5250,7 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
+    sPlayerLoginCache.InvalidateAll();
     HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
     for (const auto& itr : plist)
         itr.second->SetAtLoginFlag(atLogin);
@@ -6388,6 +6396,90 @@ bool ChatHandler::HandlePrintMovement(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleServerBufferPoolCommand(char* /*args*/)
+{
+    BufferPool::Stats stats = BufferPool::GetStats();
+    uint64 requests = stats.hits + stats.misses;
+    PSendSysMessage("Packet buffer pool: hits " UI64FMTD " misses " UI64FMTD " hit rate %.1f%% oversized " UI64FMTD " retained " SI64FMTD " KB",
+                    stats.hits, stats.misses, requests ? stats.hits * 100.0 / requests : 0.0, stats.oversized, stats.bytesRetained / 1024);
+    return true;
+}
+
+// .server dbscriptstats [#count] [reset]
+bool ChatHandler::HandleServerDBScriptStatsCommand(char* args)
+{
+    uint32 count = 10;
+    bool reset = ExtractLiteralArg(&args, "reset") != nullptr;
+    if (!reset && *args)
+    {
+        if (!ExtractUInt32(&args, count))
+            return false;
+
+        reset = ExtractLiteralArg(&args, "reset") != nullptr;
+    }
+
+    std::vector<DBScriptStats::Summary> stats = sWorld.GetDBScriptStats().GetSummary(reset);
+    SendSysMessage("DB scripts by total step time (us):");
+    for (uint32 i = 0; i < stats.size() && i < count; ++i)
+    {
+        DBScriptStats::Summary const& summary = stats[i];
+        PSendSysMessage("%s id %u: steps " UI64FMTD " total " UI64FMTD " avg " UI64FMTD " max %u",
+                        summary.table, summary.id, summary.count, summary.totalTime, summary.totalTime / summary.count, summary.maxTime);
+    }
+
+    if (reset)
+        SendSysMessage("DB script stats reset.");
+
+    return true;
+}
+
+// .server opcodestats [world|map|network] [#count] [reset]
+bool ChatHandler::HandleServerOpcodeStatsCommand(char* args)
+{
+    OpcodeHandlerThread thread = OPCODE_THREAD_WORLD;
+    char const* threadName = "world";
+    if (ExtractLiteralArg(&args, "map"))
+    {
+        thread = OPCODE_THREAD_MAP;
+        threadName = "map";
+    }
+    else if (ExtractLiteralArg(&args, "network"))
+    {
+        thread = OPCODE_THREAD_NETWORK;
+        threadName = "network";
+    }
+    else
+        ExtractLiteralArg(&args, "world");
+
+    uint32 count = 10;
+    bool reset = ExtractLiteralArg(&args, "reset") != nullptr;
+    if (!reset && *args)
+    {
+        if (!ExtractUInt32(&args, count))
+            return false;
+
+        reset = ExtractLiteralArg(&args, "reset") != nullptr;
+    }
+
+    if (!sWorld.getConfig(CONFIG_BOOL_PACKET_HANDLER_STATS))
+        SendSysMessage("Packet handler stats are disabled (PacketHandlerStats), showing old data.");
+
+    std::vector<OpcodeHandlerStats::Summary> stats = sWorld.GetOpcodeHandlerStats().GetSummary(thread, reset);
+    PSendSysMessage("Packet handlers in %s thread by total time (us):", threadName);
+    for (uint32 i = 0; i < stats.size() && i < count; ++i)
+    {
+        OpcodeHandlerStats::Summary const& summary = stats[i];
+        PSendSysMessage("%s (0x%.4X): count " UI64FMTD " total " UI64FMTD " avg " UI64FMTD " p50 %u p99 %u max %u",
+                        LookupOpcodeName(summary.opcode), summary.opcode, summary.count, summary.totalTime,
+                        summary.totalTime / summary.count, summary.p50, summary.p99, summary.maxTime);
+    }
+
+    if (reset)
+        PSendSysMessage("Packet handler stats of %s thread reset.", threadName);
+
+    return true;
+}
+
 bool ChatHandler::HandleServerPLimitCommand(char* args)
 {
     if (*args)
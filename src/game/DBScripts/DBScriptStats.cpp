@@ -0,0 +1,65 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "DBScripts/DBScriptStats.h"
+
+#include <algorithm>
+
+void DBScriptStats::Add(std::vector<Step> const& steps)
+{
+    if (steps.empty())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (Step const& step : steps)
+    {
+        Counter& counter = m_counters[std::make_pair(step.table, step.id)];
+        ++counter.count;
+        counter.totalTime += step.time;
+        counter.maxTime = std::max(counter.maxTime, step.time);
+    }
+}
+
+std::vector<DBScriptStats::Summary> DBScriptStats::GetSummary(bool reset)
+{
+    std::vector<Summary> result;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        result.reserve(m_counters.size());
+        for (auto const& itr : m_counters)
+        {
+            Summary summary;
+            summary.table = itr.first.first;
+            summary.id = itr.first.second;
+            summary.count = itr.second.count;
+            summary.totalTime = itr.second.totalTime;
+            summary.maxTime = itr.second.maxTime;
+            result.push_back(summary);
+        }
+
+        if (reset)
+            m_counters.clear();
+    }
+
+    // most total step time first, step count only breaks ties
+    std::sort(result.begin(), result.end(), [](Summary const& a, Summary const& b)
+    {
+        return a.totalTime != b.totalTime ? a.totalTime > b.totalTime : a.count > b.count;
+    });
+    return result;
+}
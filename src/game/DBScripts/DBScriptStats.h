@@ -0,0 +1,69 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_DBSCRIPTSTATS_H
+#define MANGOS_DBSCRIPTSTATS_H
+
+#include "Common.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * Executed steps and their time per db script (table and id), over all maps.
+ *
+ * Maps collect the steps of one ScriptsProcess call and add them at once, so the lock is taken once per map update.
+ */
+class DBScriptStats
+{
+    public:
+        struct Step
+        {
+            char const* table;                              // same static table name pointers as ScriptAction
+            uint32 id;
+            uint32 time;                                    // us, 0 if not timed
+        };
+
+        struct Summary
+        {
+            char const* table;
+            uint32 id;
+            uint64 count;
+            uint64 totalTime;                               // us
+            uint32 maxTime;                                 // us
+        };
+
+        void Add(std::vector<Step> const& steps);
+
+        // scripts with at least one step since last reset, sorted by total time, then step count
+        std::vector<Summary> GetSummary(bool reset);
+
+    private:
+        struct Counter
+        {
+            uint64 count = 0;
+            uint64 totalTime = 0;
+            uint32 maxTime = 0;
+        };
+
+        std::mutex m_lock;
+        std::map<std::pair<char const*, uint32>, Counter> m_counters;
+};
+
+#endif
@@ -136,6 +136,12 @@ bool CreatureCreatePos::Relocate(Creature* cr) const
     return true;
 }
 
+SlabPool& Creature::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("creature", 32);
+    return *pool;
+}
+
 Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_gossipMenuId(0), m_lootMoney(0), m_lootGroupRecipientId(0),
     m_lootStatus(CREATURE_LOOT_STATUS_NONE),
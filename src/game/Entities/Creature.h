@@ -24,6 +24,7 @@
 #include "Globals/SharedDefines.h"
 #include "Server/DBCEnums.h"
 #include "Util/Util.h"
+#include "Util/SlabPool.h"
 #include "Entities/CreatureSpellList.h"
 #include "Entities/CreatureSettings.h"
 
@@ -548,6 +549,11 @@ class Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        // pets, totems and summons share the pool, each size with own slabs
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
         virtual void CleanupsBeforeDelete() override;
@@ -23,6 +23,7 @@
 #include <memory>
 #include "ObjectGuid.h"
 #include "Util/Timer.h"
+#include "Util/FrameArena.h"
 
 
 #define TIMER_UPDATE_PLAYER_TIMELAPS 1000
@@ -41,7 +42,7 @@ struct GameObjectData;
 
 typedef std::list<WorldObject*> WorldObjectList;
 typedef std::set<WorldObject*> WorldObjectSet;
-typedef std::unordered_set<WorldObject*> WorldObjectUnSet;
+typedef FrameUnorderedSet<WorldObject*> WorldObjectUnSet;          // map update temporary, see FrameArena
 typedef std::list<Unit*> UnitList;
 typedef std::list<Creature*> CreatureList;
 typedef std::list<GameObject*> GameObjectList;
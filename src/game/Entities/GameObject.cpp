@@ -63,6 +63,12 @@ QuaternionData QuaternionData::fromEulerAnglesZYX(float Z, float Y, float X)
 
 #include <G3D/Quat.h>
 
+SlabPool& GameObject::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("gameobject", 64);
+    return *pool;
+}
+
 GameObject::GameObject() : WorldObject(),
     m_model(nullptr),
     m_captureSlider(0),
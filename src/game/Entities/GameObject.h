@@ -23,6 +23,7 @@
 #include "Globals/SharedDefines.h"
 #include "Entities/Object.h"
 #include "Util/Util.h"
+#include "Util/SlabPool.h"
 #include "AI/BaseAI/GameObjectAI.h"
 #include "Spells/SpellDefines.h"
 #include "Entities/GameObjectDefines.h"
@@ -743,6 +744,10 @@ class GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         static GameObject* CreateGameObject(uint32 entry);
 
         void AddToWorld() override;
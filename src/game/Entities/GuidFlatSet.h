@@ -0,0 +1,111 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GUIDFLATSET_H
+#define MANGOS_GUIDFLATSET_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Set of guids kept as a sorted array, used for the guids known by a client and the players seeing an object.
+ * Lookups are a binary search over contiguous memory and copies are a single memcpy.
+ *
+ * Unlike GuidSet, insert and erase invalidate all iterators: do not modify the set while iterating it,
+ * use EraseIf or EraseSorted instead of erasing in a loop.
+ */
+class GuidFlatSet
+{
+    public:
+        typedef GuidVector::const_iterator const_iterator;
+        typedef const_iterator iterator;
+
+        const_iterator begin() const { return m_guids.begin(); }
+        const_iterator end() const { return m_guids.end(); }
+        size_t size() const { return m_guids.size(); }
+        bool empty() const { return m_guids.empty(); }
+        void clear() { m_guids.clear(); }
+        void reserve(size_t size) { m_guids.reserve(size); }
+
+        bool insert(ObjectGuid guid)
+        {
+            // new guids are mostly the highest ones
+            if (m_guids.empty() || m_guids.back() < guid)
+            {
+                m_guids.push_back(guid);
+                return true;
+            }
+
+            auto itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr != m_guids.end() && *itr == guid)
+                return false;
+
+            m_guids.insert(itr, guid);
+            return true;
+        }
+
+        size_t erase(ObjectGuid guid)
+        {
+            auto itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr == m_guids.end() || !(*itr == guid))
+                return 0;
+
+            m_guids.erase(itr);
+            return 1;
+        }
+
+        const_iterator find(ObjectGuid guid) const
+        {
+            auto itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            return itr != m_guids.end() && *itr == guid ? itr : m_guids.end();
+        }
+
+        bool contains(ObjectGuid guid) const { return std::binary_search(m_guids.begin(), m_guids.end(), guid); }
+        size_t count(ObjectGuid guid) const { return contains(guid) ? 1 : 0; }
+
+        // removes all guids the predicate returns true for, called once per guid in order
+        template<typename Predicate>
+        void EraseIf(Predicate pred)
+        {
+            m_guids.erase(std::remove_if(m_guids.begin(), m_guids.end(), pred), m_guids.end());
+        }
+
+        // set difference in one pass, guids must be sorted and may contain guids not in the set
+        void EraseSorted(GuidVector const& guids)
+        {
+            auto out = m_guids.begin();
+            auto other = guids.begin();
+            for (auto itr = m_guids.begin(); itr != m_guids.end(); ++itr)
+            {
+                while (other != guids.end() && *other < *itr)
+                    ++other;
+
+                if (other == guids.end() || !(*other == *itr))
+                    *out++ = *itr;
+            }
+            m_guids.erase(out, m_guids.end());
+        }
+
+    private:
+        GuidVector m_guids;
+};
+
+#endif
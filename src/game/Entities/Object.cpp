@@ -45,8 +45,10 @@
 #include "Chat/Chat.h"
 #include "Loot/LootMgr.h"
 #include "Spells/SpellMgr.h"
+#include "MotionGenerators/MovementRelay.h"
 #include "MotionGenerators/PathFinder.h"
 #include "Movement/MoveSpline.h"
+#include "Vmap/IVMapManager.h"
 
 Object::Object(): m_updateFlag(0), m_itsNewObject(false), m_dbGuid(0)
 {
@@ -1332,11 +1334,17 @@ bool WorldObject::HasStringId(uint32 stringId) const
 WorldObject::WorldObject() :
     m_transport(nullptr), m_transportInfo(nullptr), m_isOnEventNotified(false),
     m_visibilityData(this), m_currMap(nullptr),
-    m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL),
+    m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_movementMessageCount(0),
     m_isActiveObject(false), m_debugFlags(0), m_destLocCounter(0), m_castCounter(0)
 {
 }
 
+WorldObject::~WorldObject()
+{
+    // objects deleted by grid unload never pass Map::RemoveFromGrid
+    MapPositionIndex::Remove(this);
+}
+
 void WorldObject::CleanupsBeforeDelete()
 {
     m_events.KillAllEvents(false);                      // non-delatable (currently casted spells) will not deleted now but it will deleted at call in Map::RemoveAllObjectsInRemoveList
@@ -1368,6 +1376,8 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
 
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, orientation);
+
+    UpdatePositionIndex();
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1378,6 +1388,8 @@ void WorldObject::Relocate(float x, float y, float z)
 
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+
+    UpdatePositionIndex();
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1549,6 +1561,32 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, bool ignoreM2Model) c
     return IsWithinLOS(x, y, z + obj->GetCollisionHeight(), ignoreM2Model);
 }
 
+void WorldObject::CheckWithinLOSInMap(std::vector<WorldObject const*> const& objects, std::vector<bool>& inLos, uint32 phaseMask, bool ignoreM2Model) const
+{
+    float x, y, z;
+    GetPosition(x, y, z);
+    z += GetCollisionHeight();
+
+    std::vector<VMAP::LineOfSightQuery> queries(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        VMAP::LineOfSightQuery& query = queries[i];
+        query.x1 = x;
+        query.y1 = y;
+        query.z1 = z;
+        objects[i]->GetPosition(query.x2, query.y2, query.z2);
+        query.z2 += objects[i]->GetCollisionHeight();
+        query.inLineOfSight = IsInMap(objects[i]);
+    }
+
+    if (!queries.empty())
+        GetMap()->IsInLineOfSight(queries.data(), queries.size(), phaseMask, ignoreM2Model);
+
+    inLos.resize(objects.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+        inLos[i] = queries[i].inLineOfSight;
+}
+
 bool WorldObject::IsWithinLOS(float ox, float oy, float oz, bool ignoreM2Model) const
 {
     float x, y, z;
@@ -2070,18 +2108,30 @@ void WorldObject::MonsterText(std::vector<std::string> content, uint32 type, Lan
     }
 }
 
+void WorldObject::CountMovementMessage(WorldPacket const& data) const
+{
+    if (MovementRelay::IsMovementOpcode(data.GetOpcode()))
+        ++m_movementMessageCount;
+}
+
 void WorldObject::SendMessageToSet(WorldPacket const& data, bool /*bToSelf*/) const
 {
     // if object is in world, map for it already created!
     if (IsInWorld())
+    {
+        CountMovementMessage(data);
         GetMap()->MessageBroadcast(this, data);
+    }
 }
 
 void WorldObject::SendMessageToSetInRange(WorldPacket const& data, float dist, bool /*bToSelf*/) const
 {
     // if object is in world, map for it already created!
     if (IsInWorld())
+    {
+        CountMovementMessage(data);
         GetMap()->MessageDistBroadcast(this, data, dist);
+    }
 }
 
 void WorldObject::SendMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const
@@ -2089,17 +2139,40 @@ void WorldObject::SendMessageToSetExcept(WorldPacket const& data, Player const*
     // if object is in world, map for it already created!
     if (IsInWorld())
     {
+        CountMovementMessage(data);
         MaNGOS::MessageDelivererExcept notifier(this, data, skipped_receiver);
         Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
     }
 }
 
-void WorldObject::SendMessageToAllWhoSeeMe(WorldPacket const& data, bool /*self*/) const
+void WorldObject::SendMovementMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const
 {
+    // if object is in world, map for it already created!
     if (IsInWorld())
-        for (ObjectGuid guid : m_clientGUIDsIAmAt)
-            if (Player* player = GetMap()->GetPlayer(guid))
-                player->GetSession()->SendPacket(data);
+    {
+        // every packet passed here carries a position of the object, held relay packets are older
+        ++m_movementMessageCount;
+        if (!GetMap()->HasReducedMovementRelay())
+        {
+            MaNGOS::MessageDelivererExcept notifier(this, data, skipped_receiver);
+            Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
+            return;
+        }
+
+        MaNGOS::MovementMessageDeliverer notifier(this, data, skipped_receiver);
+        Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
+    }
+}
+
+void WorldObject::SendMessageToAllWhoSeeMe(WorldPacket const& data, bool /*self*/) const
+{
+    if (!IsInWorld())
+        return;
+
+    CountMovementMessage(data);
+    for (ObjectGuid guid : m_clientGUIDsIAmAt)
+        if (Player* player = GetMap()->GetPlayer(guid))
+            player->GetSession()->SendPacket(data);
 }
 
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid) const
@@ -2571,6 +2644,7 @@ void WorldObject::GetNearPointAt(const float posX, const float posY, const float
 void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
+    UpdatePositionIndex();
 
     if (update && IsInWorld())
         UpdateVisibilityAndView();
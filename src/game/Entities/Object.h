@@ -25,6 +25,7 @@
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/GuidFlatSet.h"
 #include "Entities/EntitiesMgr.h"
 #include "Globals/SharedDefines.h"
 #include "Globals/Locales.h"
@@ -33,6 +34,7 @@
 #include "PlayerDefines.h"
 #include "Entities/ObjectVisibility.h"
 #include "Grids/Cell.h"
+#include "Maps/MapPositionIndex.h"
 #include "Utilities/EventProcessor.h"
 
 #include <set>
@@ -120,7 +122,7 @@ struct SpellEntry;
 class Spell;
 class GenericTransport;
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+typedef FrameUnorderedMap<Player*, UpdateData> UpdateDataMapType;   // local to one update, see FrameArena
 
 // Spell cooldown flags sent in SMSG_SPELL_COOLDOWN
 enum SpellCooldownFlags
@@ -946,9 +948,10 @@ inline ByteBuffer& operator>> (ByteBuffer& buf, MovementInfo& mi)
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class MapPositionIndex;
 
     public:
-        virtual ~WorldObject() {}
+        virtual ~WorldObject();
 
         virtual void Update(const uint32 /*diff*/);
         virtual void Heartbeat() {}
@@ -1045,6 +1048,9 @@ class WorldObject : public Object
 
         virtual void SetPhaseMask(uint32 newPhaseMask, bool update);
         uint32 GetPhaseMask() const { return m_phaseMask; }
+
+        // refreshes position, combat reach and phase in the map position index, done by Relocate and SetPhaseMask
+        void UpdatePositionIndex() { if (m_positionIndexEntry.cell) MapPositionIndex::Update(this); }
         bool InSamePhase(WorldObject const* obj) const { return InSamePhase(obj->GetPhaseMask()); }
         bool InSamePhase(uint32 phasemask) const { return (GetPhaseMask() & phasemask) != 0; }
 
@@ -1104,6 +1110,10 @@ class WorldObject : public Object
         bool IsWithinLOS(float ox, float oy, float oz, bool ignoreM2Model = false) const;
         bool IsWithinLOSForMe(float x, float y, float z, float collisionHeight, bool ignoreM2Model = false) const;
         bool IsWithinLOSInMap(const WorldObject* obj, bool ignoreM2Model = false) const;
+        // IsWithinLOSInMap for many objects at once, inLos[i] is the result for objects[i]
+        void CheckWithinLOSInMap(std::vector<WorldObject const*> const& objects, std::vector<bool>& inLos, bool ignoreM2Model = false) const { CheckWithinLOSInMap(objects, inLos, GetPhaseMask(), ignoreM2Model); }
+        // same, with dynamic objects of phaseMask blocking the lines
+        void CheckWithinLOSInMap(std::vector<WorldObject const*> const& objects, std::vector<bool>& inLos, uint32 phaseMask, bool ignoreM2Model) const;
         bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true, DistanceCalculation distcalc = DIST_CALC_NONE) const;
         bool IsInRange(WorldObject const* obj, float minRange, float maxRange, bool is3D = true, bool combat = false) const;
         bool IsInRange2d(float x, float y, float minRange, float maxRange, bool combat = false) const;
@@ -1129,7 +1139,10 @@ class WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket const& data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket const& data, float dist, bool self) const;
         void SendMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const;
+        void SendMovementMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const;
         virtual void SendMessageToAllWhoSeeMe(WorldPacket const& data, bool self) const;
+        // movement packets sent by the object, a packet held by the movement relay is older if this changed
+        uint32 GetMovementMessageCount() const { return m_movementMessageCount; }
 
         void MonsterSay(const char* text, uint32 language, Unit const* target = nullptr) const;
         void MonsterYell(const char* text, uint32 language, Unit const* target = nullptr) const;
@@ -1259,7 +1272,7 @@ class WorldObject : public Object
 
         void AddClientIAmAt(Player const* player);
         void RemoveClientIAmAt(Player const* player);
-        GuidSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
+        GuidFlatSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
 
         // Event handler
         EventProcessor m_events;
@@ -1309,19 +1322,23 @@ class WorldObject : public Object
         VisibilityData m_visibilityData;
 
         ShortTimeTracker m_heartBeatTimer;
+
+        void CountMovementMessage(WorldPacket const& data) const;
     private:
         Map* m_currMap;                                     // current object's Map location
 
         uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
+        mutable uint32 m_movementMessageCount;              // see GetMovementMessageCount
 
         Position m_position;
+        MapPositionIndex::Entry m_positionIndexEntry;       // set while the object is in a grid cell of its map
         ViewPoint m_viewPoint;
         bool m_isActiveObject;
         uint64 m_debugFlags;
 
-        GuidSet m_clientGUIDsIAmAt;
+        GuidFlatSet m_clientGUIDsIAmAt;
 
         // Spell System compliance
         uint8 m_destLocCounter;
@@ -58,6 +58,7 @@
 #include "Spells/Spell.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Social/SocialMgr.h"
+#include "Social/WhoListIndex.h"
 #include "Achievements/AchievementMgr.h"
 #include "Mails/Mail.h"
 #include "Spells/SpellAuras.h"
@@ -69,6 +70,7 @@
 #include "World/WorldStateDefines.h"
 #include "World/WorldState.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/PlayerLoginCache.h"
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
@@ -1520,6 +1522,9 @@ void Player::Update(const uint32 diff)
 
     UpdateMirrorTimers(diff);
 
+    // send movement of far units skipped since last update
+    m_movementRelay.Update(this);
+
     // Used to implement delayed far teleports
     SetCanDelayTeleport(true);
     Unit::Update(diff);
@@ -2388,6 +2393,7 @@ void Player::RemoveFromWorld()
         ///- Release charmed creatures, unsummon totems and remove pets/guardians
         sWorld.SetOnlinePlayer(GetTeam(), getRace(), getClass(), false);
         UnsummonAllTotems();
+        m_movementRelay.Clear();
     }
 
     for (int i = PLAYER_SLOT_START; i < PLAYER_SLOT_END; ++i)
@@ -3749,7 +3755,7 @@ bool Player::addSpell(uint32 spell_id, bool active, bool learning, bool dependen
     // learn dependent spells
     SpellLearnSpellMapBounds spell_bounds = sSpellMgr.GetSpellLearnSpellMapBounds(spell_id);
 
-    for (SpellLearnSpellMap::const_iterator itr2 = spell_bounds.first; itr2 != spell_bounds.second; ++itr2)
+    for (SpellLearnSpellTable::const_iterator itr2 = spell_bounds.first; itr2 != spell_bounds.second; ++itr2)
     {
         SpellLearnSpellNode const& spellLearn = itr2->second;
         if (!spellLearn.autoLearned)
@@ -3821,8 +3827,8 @@ void Player::learnSpell(uint32 spell_id, bool dependent, bool talent)
     // learn all disabled higher ranks (recursive) - skip for talent spells
     if (disabled || talent)
     {
-        SpellChainMapNext const& nextMap = sSpellMgr.GetSpellChainNext();
-        for (SpellChainMapNext::const_iterator i = nextMap.lower_bound(spell_id); i != nextMap.upper_bound(spell_id); ++i)
+        SpellChainMapNextBounds nextBounds = sSpellMgr.GetSpellChainNextBounds(spell_id);
+        for (SpellChainNextTable::const_iterator i = nextBounds.first; i != nextBounds.second; ++i)
         {
             PlayerSpellMap::iterator iter = m_spells.find(i->second);
             if (iter != m_spells.end() && iter->second.disabled)
@@ -3846,7 +3852,7 @@ void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank, bo
 
     // Always try to remove all dependent spells if present (needed to reset some talents properly)
     SpellLearnSpellMapBounds spell_bounds = sSpellMgr.GetSpellLearnSpellMapBounds(spell_id);
-    for (SpellLearnSpellMap::const_iterator child_itr = spell_bounds.first; child_itr != spell_bounds.second; ++child_itr)
+    for (SpellLearnSpellTable::const_iterator child_itr = spell_bounds.first; child_itr != spell_bounds.second; ++child_itr)
         removeSpell(child_itr->second.spell, !IsPassiveSpell(child_itr->second.spell), !IsPassiveSpell(child_itr->second.spell));
 
     // search again just in case
@@ -3863,8 +3869,8 @@ void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank, bo
         disabled = false; // talents should never be marked as disabled
 
     // unlearn non talent higher ranks (recursive)
-    SpellChainMapNext const& nextMap = sSpellMgr.GetSpellChainNext();
-    for (SpellChainMapNext::const_iterator itr2 = nextMap.lower_bound(spell_id); itr2 != nextMap.upper_bound(spell_id); ++itr2)
+    SpellChainMapNextBounds nextBounds = sSpellMgr.GetSpellChainNextBounds(spell_id);
+    for (SpellChainNextTable::const_iterator itr2 = nextBounds.first; itr2 != nextBounds.second; ++itr2)
         if (HasSpell(itr2->second) && !GetTalentSpellPos(itr2->second))
             removeSpell(itr2->second, !IsPassiveSpell(itr2->second), false, sendUpdate);
 
@@ -4492,6 +4498,8 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
  */
 void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
 {
+    sPlayerLoginCache.Invalidate(playerguid);
+
     // for nonexistent account avoid update realm
     if (accountId == 0)
         updateRealmChars = false;
@@ -6751,7 +6759,10 @@ void Player::SaveRecallPosition()
 void Player::SendMessageToSet(WorldPacket const& data, bool self) const
 {
     if (IsInWorld())
+    {
+        CountMovementMessage(data);
         GetMap()->MessageBroadcast(this, data, false);
+    }
 
     // if player is not in world and map in not created/already destroyed
     // no need to create one, just send packet for itself!
@@ -6762,7 +6773,10 @@ void Player::SendMessageToSet(WorldPacket const& data, bool self) const
 void Player::SendMessageToSetInRange(WorldPacket const& data, float dist, bool self) const
 {
     if (IsInWorld())
+    {
+        CountMovementMessage(data);
         GetMap()->MessageDistBroadcast(this, data, dist, false);
+    }
 
     if (self)
         GetSession()->SendPacket(data);
@@ -6771,7 +6785,10 @@ void Player::SendMessageToSetInRange(WorldPacket const& data, float dist, bool s
 void Player::SendMessageToSetInRange(WorldPacket const& data, float dist, bool self, bool own_team_only) const
 {
     if (IsInWorld())
+    {
+        CountMovementMessage(data);
         GetMap()->MessageDistBroadcast(this, data, dist, false, own_team_only);
+    }
 
     if (self)
         GetSession()->SendPacket(data);
@@ -7370,6 +7387,12 @@ void Player::ModifyArenaPoints(int32 value)
     SetArenaPoints(newValue);
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+    sWhoListIndex.UpdateGuild(this, GuildId);
+}
+
 uint32 Player::GetGuildIdFromDB(ObjectGuid guid)
 {
     uint32 lowguid = guid.GetCounter();
@@ -7427,7 +7450,10 @@ uint32 Player::GetZoneIdFromDB(ObjectGuid guid)
         zone = sTerrainMgr.GetZoneId(map, posx, posy, posz);
 
         if (zone > 0)
+        {
             CharacterDatabase.PExecute("UPDATE characters SET zone='%u' WHERE guid='%u'", zone, lowguid);
+            sPlayerLoginCache.Invalidate(guid);
+        }
     }
 
     return zone;
@@ -7542,6 +7568,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea, bool force)
         GetMap()->SendZoneDynamicInfo(this, updateZone, updateArea);
 
     m_zoneUpdateId    = newZone;
+    sWhoListIndex.UpdateZone(this, newZone);
     m_zoneUpdateTimer = ZONE_UPDATE_INTERVAL;
 
     // zone changed, so area changed as well, update it
@@ -14387,16 +14414,16 @@ void Player::AddQuest(Quest const* pQuest, Object* questGiver)
     uint32 zone, area;
     GetZoneAndAreaId(zone, area);
     SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(zone);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
     if (area != zone)
     {
         saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(area);
-        for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+        for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
             itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
     }
     saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(0);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
 
     UpdateForQuestWorldObjects();
@@ -14638,16 +14665,16 @@ void Player::RewardQuest(Quest const* pQuest, uint32 reward, Object* questGiver,
     uint32 zone, area;
     GetZoneAndAreaId(zone, area);
     SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(zone);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
     if (area != zone)
     {
         saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(area);
-        for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+        for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
             itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
     }
     saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(0);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
 
     // resend quests status directly
@@ -18060,7 +18087,10 @@ void Player::ConvertInstancesToGroup(Player* player, Group* group, ObjectGuid pl
 
     // the following should not get executed when changing leaders
     if (!player || has_solo)
+    {
         CharacterDatabase.PExecute("DELETE FROM character_instance WHERE guid = '%u' AND permanent = 0", player_lowguid);
+        sPlayerLoginCache.Invalidate(player_guid);
+    }
 }
 
 bool Player::_LoadHomeBind(std::unique_ptr<QueryResult> queryResult)
@@ -19015,6 +19045,7 @@ void Player::SavePositionInDB(ObjectGuid guid, uint32 mapid, float x, float y, f
        << "transguid='0',taxi_path='' WHERE guid='" << guid.GetCounter() << "'";
     DEBUG_LOG("%s", ss.str().c_str());
     CharacterDatabase.Execute(ss.str().c_str());
+    sPlayerLoginCache.Invalidate(guid);
 }
 
 void Player::SetUInt32ValueInArray(Tokens& tokens, uint16 index, uint32 value)
@@ -19042,6 +19073,7 @@ void Player::Customize(ObjectGuid guid, uint8 gender, uint8 skin, uint8 face, ui
     player_bytes2 |= facialHair;
 
     CharacterDatabase.PExecute("UPDATE characters SET gender = '%u', playerBytes = '%u', playerBytes2 = '%u' WHERE guid = '%u'", gender, skin | (face << 8) | (hairStyle << 16) | (hairColor << 24), player_bytes2, guid.GetCounter());
+    sPlayerLoginCache.Invalidate(guid);
 }
 
 void Player::SendAttackSwingDeadTarget() const
@@ -22335,7 +22367,7 @@ void Player::UpdateZoneDependentAuras()
 {
     // Some spells applied at enter into zone (with subzones), aura removed in UpdateAreaDependentAuras that called always at zone->area update
     SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(m_zoneUpdateId);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, 0, true);
 }
 
@@ -22356,7 +22388,7 @@ void Player::UpdateAreaDependentAuras()
 
     // some auras applied at subzone enter
     SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(m_areaUpdateId);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+    for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         itr->second->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, m_areaUpdateId, true);
 }
 
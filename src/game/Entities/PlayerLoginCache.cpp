@@ -0,0 +1,152 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/PlayerLoginCache.h"
+#include "Database/DatabaseImpl.h"
+#include "Log/Log.h"
+
+INSTANTIATE_SINGLETON_1(PlayerLoginCache);
+
+void PlayerLoginCache::Initialize(uint32 maxSize, uint32 lifetime, uint32 maxPending)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_maxSize = maxSize;
+    m_lifetime = lifetime;
+    m_maxPending = maxPending;
+    m_entries.clear();
+
+    if (m_maxSize)
+        sLog.outString("PlayerLoginCache: keeping login data of up to %u disconnected characters for %u seconds, reading up to %u at once", m_maxSize, m_lifetime, m_maxPending);
+}
+
+void PlayerLoginCache::Prefetch(ObjectGuid guid, uint32 accountId)
+{
+    LoginQueryHolder* holder;
+    uint32 generation;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_maxSize || !m_lifetime)
+            return;
+
+        // an older entry would miss the logout save, it is dropped even if no read is started
+        m_entries.erase(guid);
+        if (m_pending >= m_maxPending)
+            return;
+
+        time_t now = time(nullptr);
+        MakeRoom(now);
+        ++m_pending;
+
+        generation = ++m_generation;
+        Entry& entry = m_entries[guid];
+        entry.generation = generation;
+        entry.expireTime = now + m_lifetime;
+
+        holder = new LoginQueryHolder(accountId, guid);
+    }
+
+    // queued after the logout save, so the save is done when the queries run
+    if (!holder->Initialize() || !CharacterDatabase.DelayQueryHolder(this, &PlayerLoginCache::HandlePrefetchCallback, holder, generation))
+    {
+        delete holder;                                      // delete all unprocessed queries
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_entries.erase(guid);
+        --m_pending;
+    }
+}
+
+void PlayerLoginCache::HandlePrefetchCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder, uint32 generation)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    --m_pending;
+
+    if (!holder)
+        return;
+
+    LoginQueryHolder* loginHolder = static_cast<LoginQueryHolder*>(holder);
+
+    auto itr = m_entries.find(loginHolder->GetGuid());
+    // invalidated or logged in while reading
+    if (itr == m_entries.end() || itr->second.generation != generation)
+    {
+        delete loginHolder;
+        return;
+    }
+
+    itr->second.holder.reset(loginHolder);
+}
+
+LoginQueryHolder* PlayerLoginCache::Take(ObjectGuid guid, uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto itr = m_entries.find(guid);
+    if (itr == m_entries.end())
+        return nullptr;
+
+    // character is loaded now, an entry still being read is not of use anymore
+    LoginQueryHolder* holder = itr->second.holder.release();
+    bool expired = itr->second.expireTime <= time(nullptr);
+    m_entries.erase(itr);
+
+    if (holder && (expired || holder->GetAccountId() != accountId))
+    {
+        delete holder;
+        return nullptr;
+    }
+
+    return holder;
+}
+
+void PlayerLoginCache::Invalidate(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_entries.erase(guid);
+}
+
+void PlayerLoginCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_entries.clear();
+}
+
+void PlayerLoginCache::MakeRoom(time_t now)
+{
+    if (m_entries.size() < m_maxSize)
+        return;
+
+    for (auto itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.expireTime <= now)
+            itr = m_entries.erase(itr);
+        else
+            ++itr;
+    }
+
+    // drop the entry nearest to expire
+    while (m_entries.size() >= m_maxSize)
+    {
+        auto oldest = m_entries.begin();
+        for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+            if (itr->second.expireTime < oldest->second.expireTime)
+                oldest = itr;
+
+        m_entries.erase(oldest);
+    }
+}
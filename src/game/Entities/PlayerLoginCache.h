@@ -0,0 +1,98 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYERLOGINCACHE_H
+#define MANGOS_PLAYERLOGINCACHE_H
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Entities/ObjectGuid.h"
+#include "Policies/Singleton.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/// Queries loading a character at login, see PlayerLoginQueryIndex
+class LoginQueryHolder : public SqlQueryHolder
+{
+    private:
+        uint32 m_accountId;
+        ObjectGuid m_guid;
+    public:
+        LoginQueryHolder(uint32 accountId, ObjectGuid guid)
+            : m_accountId(accountId), m_guid(guid) { }
+        ObjectGuid GetGuid() const { return m_guid; }
+        uint32 GetAccountId() const { return m_accountId; }
+        bool Initialize();
+        // login waits for all of its queries, so they are executed in parallel
+        bool IsParallel() const override { return true; }
+};
+
+/**
+ * Keeps the login query results of recently logged out characters, read right after their logout save,
+ * so a relog of the character does not wait for the character DB.
+ *
+ * Anything changing DB data of an offline character must invalidate it, changes done to many characters
+ * at once (resets, instance unbinds) invalidate all. Entries also expire after the configured lifetime.
+ *
+ * The results are read from DB and not built from the logged out Player: Player::LoadFromDB only takes
+ * query results, and results made from memory could differ from what a normal login reads. Every read
+ * costs a full login query set, so it is only done where a relog is likely (after a lost connection),
+ * and only up to a limit of reads running at once, so a disconnect storm does not double the DB load.
+ */
+class PlayerLoginCache
+{
+    public:
+        PlayerLoginCache() : m_maxSize(0), m_lifetime(0), m_maxPending(0), m_pending(0), m_generation(0) {}
+
+        // 0 size disables the cache, lifetime in seconds, maxPending limits reads running at once
+        void Initialize(uint32 maxSize, uint32 lifetime, uint32 maxPending);
+
+        // starts reading the character, must be called after its logout save is queued
+        // skipped while maxPending reads are running
+        void Prefetch(ObjectGuid guid, uint32 accountId);
+        // cached login results of the character or nullptr, caller takes ownership
+        LoginQueryHolder* Take(ObjectGuid guid, uint32 accountId);
+
+        void Invalidate(ObjectGuid guid);
+        void InvalidateAll();
+
+    private:
+        struct Entry
+        {
+            uint32 generation;                              // to drop results of an invalidated read
+            time_t expireTime;
+            std::unique_ptr<LoginQueryHolder> holder;       // nullptr while the queries run
+        };
+
+        void HandlePrefetchCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder, uint32 generation);
+        void MakeRoom(time_t now);
+
+        std::mutex m_lock;
+        std::unordered_map<ObjectGuid, Entry> m_entries;
+        uint32 m_maxSize;
+        uint32 m_lifetime;
+        uint32 m_maxPending;
+        uint32 m_pending;                                   // reads queued or running, also of dropped entries
+        uint32 m_generation;
+};
+
+#define sPlayerLoginCache MaNGOS::Singleton<PlayerLoginCache>::Instance()
+
+#endif
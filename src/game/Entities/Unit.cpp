@@ -51,6 +51,7 @@
 #include "Tools/Formulas.h"
 #include "Entities/Transports.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Social/WhoListIndex.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -10346,9 +10347,14 @@ void Unit::SetLevel(uint32 lvl)
 {
     SetUInt32Value(UNIT_FIELD_LEVEL, lvl);
 
-    // group update
-    if ((GetTypeId() == TYPEID_PLAYER) && ((Player*)this)->GetGroup())
-        ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        sWhoListIndex.UpdateLevel((Player*)this, lvl);
+
+        // group update
+        if (((Player*)this)->GetGroup())
+            ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+    }
 }
 
 void Unit::SetHealth(float val)
@@ -11418,6 +11424,7 @@ void Unit::UpdateModelData()
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
 
         SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+        UpdatePositionIndex();
 
         SetBaseWalkSpeed(modelInfo->SpeedWalk);
         SetBaseRunSpeed(modelInfo->SpeedRun, false);
@@ -11489,6 +11496,27 @@ void Unit::UpdateReactives(uint32 p_time)
     }
 }
 
+// removes units not in line of sight of source, all lines are traced in one batch
+template<typename UnitContainer>
+static void RemoveUnitsNotInLOS(Unit const* source, UnitContainer& targets)
+{
+    if (targets.empty())
+        return;
+
+    std::vector<WorldObject const*> objects(targets.begin(), targets.end());
+    std::vector<bool> inLos;
+    source->CheckWithinLOSInMap(objects, inLos, true);
+
+    size_t i = 0;
+    for (auto itr = targets.begin(); itr != targets.end(); ++i)
+    {
+        if (inLos[i])
+            ++itr;
+        else
+            itr = targets.erase(itr);
+    }
+}
+
 Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= nullptr*/, float radius /*= ATTACK_DISTANCE*/) const
 {
     UnitList targets;
@@ -11501,26 +11529,21 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= nullptr*/, float radiu
     if (except)
         targets.remove(except);
 
-    // remove not LoS targets
+    // remove critters
     for (UnitList::iterator tIter = targets.begin(); tIter != targets.end();)
     {
         bool remove = false;
-        if (!IsWithinLOSInMap(*tIter, true))
-            remove = true;
-        else
+        // 2.4.2 - sweeping strikes no longer hits critters
+        switch ((*tIter)->GetTypeId())
         {
-            // 2.4.2 - sweeping strikes no longer hits critters
-            switch ((*tIter)->GetTypeId())
+            case TYPEID_UNIT:
             {
-                case TYPEID_UNIT:
-                {
-                    Creature* target = static_cast<Creature*>(*tIter);
-                    if (target->IsCritter())
-                        remove = true;
-                    break;
-                }
-                default: break;
+                Creature* target = static_cast<Creature*>(*tIter);
+                if (target->IsCritter())
+                    remove = true;
+                break;
             }
+            default: break;
         }
 
         if (remove)
@@ -11533,6 +11556,9 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= nullptr*/, float radiu
             ++tIter;
     }
 
+    // remove not LoS targets
+    RemoveUnitsNotInLOS(this, targets);
+
     // no appropriate targets
     if (targets.empty())
         return nullptr;
@@ -11560,17 +11586,7 @@ Unit* Unit::SelectRandomFriendlyTarget(Unit* except /*= nullptr*/, float radius
         targets.remove(except);
 
     // remove not LoS targets
-    for (UnitList::iterator tIter = targets.begin(); tIter != targets.end();)
-    {
-        if (!IsWithinLOSInMap(*tIter, true))
-        {
-            UnitList::iterator tIter2 = tIter;
-            ++tIter;
-            targets.erase(tIter2);
-        }
-        else
-            ++tIter;
-    }
+    RemoveUnitsNotInLOS(this, targets);
 
     // no appropriate targets
     if (targets.empty())
@@ -11835,7 +11851,7 @@ void Unit::SendTeleportPacket(float x, float y, float z, float ori, GenericTrans
     WorldPacket moveUpdateTeleport(MSG_MOVE_TELEPORT, 38);
     moveUpdateTeleport << GetPackGUID();
     teleportMovementInfo.Write(moveUpdateTeleport);
-    SendMessageToSetExcept(moveUpdateTeleport, player);
+    SendMovementMessageToSetExcept(moveUpdateTeleport, player);
 }
 
 void Unit::MonsterMoveWithSpeed(float x, float y, float z, float speed, bool generatePath, bool forceDestination)
@@ -13566,7 +13582,7 @@ void Unit::DespawnSummonsOnDeath()
     m_summonsForOnDeathDespawn.clear();
 }
 
-bool Unit::MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spellInfo, uint32 selectFlags, SelectAttackingTargetParams params, int32 unitConditionId) const
+bool Unit::MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spellInfo, uint32 selectFlags, SelectAttackingTargetParams params, int32 unitConditionId, bool checkLos) const
 {
     if (selectFlags)
     {
@@ -13588,7 +13604,7 @@ bool Unit::MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spell
         if ((selectFlags & SELECT_FLAG_NOT_IN_MELEE_RANGE) && CanReachWithMeleeAttack(target))
             return false;
 
-        if ((selectFlags & SELECT_FLAG_IN_LOS) && !IsWithinLOSInMap(target, true))
+        if (checkLos && (selectFlags & SELECT_FLAG_IN_LOS) && !IsWithinLOSInMap(target, true))
             return false;
 
         if (!target->IsAlive())
@@ -13654,7 +13670,7 @@ bool Unit::MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spell
         if (spellInfo->HasAttribute(SPELL_ATTR_EX5_NOT_ON_PLAYER_CONTROLLED_NPC) && target->IsPlayerControlled() && target->GetTypeId() != TYPEID_PLAYER)
             return false;
 
-        if (!IsIgnoreLosSpellCast(spellInfo) && !IsWithinLOSInMap(target, true))
+        if (checkLos && !IsIgnoreLosSpellCast(spellInfo) && !IsWithinLOSInMap(target, true))
             return false;
 
         switch (spellInfo->rangeIndex)
@@ -13689,6 +13705,11 @@ bool Unit::MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spell
     return true;
 }
 
+bool Unit::IsSelectAttackingLOSRequired(SpellEntry const* spellInfo, uint32 selectFlags)
+{
+    return (selectFlags & SELECT_FLAG_IN_LOS) || (spellInfo && !IsIgnoreLosSpellCast(spellInfo));
+}
+
 Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, uint32 spellId, uint32 selectFlags, SelectAttackingTargetParams params /*= SelectAttackingTargetParams()*/, int32 unitConditionId/* = 0*/) const
 {
     return SelectAttackingTarget(target, position, sSpellTemplate.LookupEntry<SpellEntry>(spellId), selectFlags, params, unitConditionId);
@@ -13715,15 +13736,20 @@ Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, Spell
             if (position)
                 advance(itr, position);
 
+            // line of sight is checked last for all suitable units at once
+            bool checkLos = IsSelectAttackingLOSRequired(spellInfo, selectFlags);
             for (; itr != threatlist.end(); ++itr)
             {
                 if (Unit* pTarget = GetMap()->GetUnit((*itr)->getUnitGuid()))
                 {
-                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId))
+                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId, false))
                         suitableUnits.push_back(pTarget);
                 }
             }
 
+            if (checkLos)
+                RemoveUnitsNotInLOS(this, suitableUnits);
+
             if (!suitableUnits.empty())
                 return suitableUnits[urand(0, suitableUnits.size() - 1)];
 
@@ -13768,15 +13794,19 @@ Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, Spell
         {
             UnitList suitableUnits;
 
+            bool checkLos = IsSelectAttackingLOSRequired(spellInfo, selectFlags);
             for (; itr != threatlist.end(); ++itr)
             {
                 if (Unit* pTarget = GetMap()->GetUnit((*itr)->getUnitGuid()))
                 {
-                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId))
+                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId, false))
                         suitableUnits.push_back(pTarget);
                 }
             }
 
+            if (checkLos)
+                RemoveUnitsNotInLOS(this, suitableUnits);
+
             if (suitableUnits.empty() || position >= suitableUnits.size())
                 return nullptr;
 
@@ -13827,14 +13857,20 @@ void Unit::SelectAttackingTargets(std::vector<Unit*>& selectedTargets, Attacking
             if (position)
                 advance(itr, position);
 
+            std::vector<Unit*> suitableUnits;
+            bool checkLos = IsSelectAttackingLOSRequired(spellInfo, selectFlags);
             for (; itr != threatlist.end(); ++itr)
             {
                 if (Unit* pTarget = GetMap()->GetUnit((*itr)->getUnitGuid()))
                 {
-                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId))
-                        selectedTargets.push_back(pTarget);
+                    if ((!selectFlags && !spellInfo) || MeetsSelectAttackingRequirement(pTarget, spellInfo, selectFlags, params, unitConditionId, false))
+                        suitableUnits.push_back(pTarget);
                 }
             }
+
+            if (checkLos)
+                RemoveUnitsNotInLOS(this, suitableUnits);
+            selectedTargets.insert(selectedTargets.end(), suitableUnits.begin(), suitableUnits.end());
             break;
         }
         case ATTACKING_TARGET_RANDOM:
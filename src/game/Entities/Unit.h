@@ -2627,7 +2627,8 @@ class Unit : public WorldObject
         const ObjectGuid& GetRootVehicle() const { return m_rootVehicle; }
 
     protected:
-        bool MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spellInfo, uint32 selectFlags, SelectAttackingTargetParams params, int32 unitConditionId) const;
+        bool MeetsSelectAttackingRequirement(Unit* target, SpellEntry const* spellInfo, uint32 selectFlags, SelectAttackingTargetParams params, int32 unitConditionId, bool checkLos = true) const;
+        static bool IsSelectAttackingLOSRequired(SpellEntry const* spellInfo, uint32 selectFlags);
 
         struct WeaponDamageInfo
         {
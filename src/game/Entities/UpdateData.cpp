@@ -32,7 +32,7 @@ UpdateData::UpdateData() : m_data(1, {ByteBuffer(0), 0}), m_currentIndex(0)
 {
 }
 
-void UpdateData::AddOutOfRangeGUID(GuidSet& guids)
+void UpdateData::AddOutOfRangeGUID(GuidFlatSet const& guids)
 {
     m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
 }
@@ -28,6 +28,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Entities/ObjectGuid.h"
 #include "World/World.h"
+#include "Social/WhoListIndex.h"
 
 #include <mutex>
 
@@ -312,12 +313,14 @@ void ObjectAccessor::AddObject(Player* player)
 {
     HashMapHolder<Player>::Insert(player);
     PlayerNameMapHolder::Insert(player);
+    sWhoListIndex.AddPlayer(player);
 }
 
 void ObjectAccessor::RemoveObject(Player* player)
 {
     HashMapHolder<Player>::Remove(player);
     PlayerNameMapHolder::Remove(player);
+    sWhoListIndex.RemovePlayer(player);
 }
 
 /// Define the static member of HashMapHolder
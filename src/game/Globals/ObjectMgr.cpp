@@ -51,6 +51,7 @@
 #include <limits>
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Loot/LootMgr.h"
+#include "Entities/PlayerLoginCache.h"
 
 #include "Globals/UnitCondition.h"
 #include "Globals/CombatCondition.h"
@@ -2083,11 +2084,12 @@ void ObjectMgr::LoadCreatureSpawnEntry()
     sLog.outString();
 }
 
-void ObjectMgr::LoadCreatures()
+bool ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                             0                       1   2
-    auto queryResult = WorldDatabase.Query("SELECT creature.guid, creature.id, map,"
+    // rows are read from a dedicated connection while the previous ones are processed
+    //                                                     0                       1   2
+    auto queryResult = WorldDatabase.QueryStreamed("SELECT creature.guid, creature.id, map,"
                           //        3           4           5            6                 7                 8          9
                           "position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist,"
                           //   10         11        12         13
@@ -2100,7 +2102,7 @@ void ObjectMgr::LoadCreatures()
                           "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
                           "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
                           "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id "
-                          "LEFT OUTER JOIN creature_spawn_data ON creature.guid = creature_spawn_data.guid ");
+                          "LEFT OUTER JOIN creature_spawn_data ON creature.guid = creature_spawn_data.guid ", true);
 
     if (!queryResult)
     {
@@ -2108,7 +2110,13 @@ void ObjectMgr::LoadCreatures()
         bar.step();
         sLog.outErrorDb(">> Loaded 0 creature. DB table `creature` is empty.");
         sLog.outString();
-        return;
+        return true;
+    }
+
+    if (queryResult->IsFailed())
+    {
+        sLog.outError("Loading of table `creature` failed by a DB error.");
+        return false;
     }
 
     // build single time for check creature data
@@ -2305,8 +2313,16 @@ void ObjectMgr::LoadCreatures()
     }
     while (queryResult->NextRow());
 
+    // spawns read so far are already in grids, a partial world must not be started
+    if (queryResult->IsFailed())
+    {
+        sLog.outError("Loading of table `creature` was interrupted by a DB error after %u spawns.", count);
+        return false;
+    }
+
     sLog.outString(">> Loaded " SIZEFMTD " creatures", mCreatureDataMap.size());
     sLog.outString();
+    return true;
 }
 
 void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
@@ -2341,12 +2357,13 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
     }
 }
 
-void ObjectMgr::LoadGameObjects()
+bool ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                             0                           1   2    3           4           5           6
-    auto queryResult = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    // rows are read from a dedicated connection while the previous ones are processed
+    //                                                     0                           1   2    3           4           5           6
+    auto queryResult = WorldDatabase.QueryStreamed("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           // 7        8          9          10         11                12                13         14         15
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecsmin, spawntimesecsmax, spawnMask, phaseMask, event,"
                           //   16                          17
@@ -2354,7 +2371,7 @@ void ObjectMgr::LoadGameObjects()
                           "FROM gameobject "
                           "LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
                           "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid "
-                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id");
+                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id", true);
 
     if (!queryResult)
     {
@@ -2362,7 +2379,13 @@ void ObjectMgr::LoadGameObjects()
         bar.step();
         sLog.outErrorDb(">> Loaded 0 gameobjects. DB table `gameobject` is empty.");
         sLog.outString();
-        return;
+        return true;
+    }
+
+    if (queryResult->IsFailed())
+    {
+        sLog.outError("Loading of table `gameobject` failed by a DB error.");
+        return false;
     }
 
     // build single time for check spawnmask
@@ -2543,6 +2566,13 @@ void ObjectMgr::LoadGameObjects()
     }
     while (queryResult->NextRow());
 
+    // spawns read so far are already in grids, a partial world must not be started
+    if (queryResult->IsFailed())
+    {
+        sLog.outError("Loading of table `gameobject` was interrupted by a DB error after %u spawns.", count);
+        return false;
+    }
+
     sLog.outString(">> Loaded " SIZEFMTD " gameobjects", mGameObjectDataMap.size());
     sLog.outString();
 
@@ -2590,6 +2620,8 @@ void ObjectMgr::LoadGameObjects()
         data.goState = state;
     }
     while (queryResult->NextRow());
+
+    return true;
 }
 
 void ObjectMgr::LoadGameObjectSpawnEntry()
@@ -6467,6 +6499,8 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
     time_t basetime = time(nullptr);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+    // mails of offline characters are returned or deleted
+    sPlayerLoginCache.InvalidateAll();
     // delete all old mails without item and without body immediately, if starting server
     if (!serverUp)
         CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
@@ -730,7 +730,8 @@ class ObjectMgr
         bool LoadMangosStrings() { return LoadMangosStrings(WorldDatabase, "mangos_string", MIN_MANGOS_STRING_ID, MAX_MANGOS_STRING_ID, false); }
         void LoadCreatureLocales();
         void LoadCreatureTemplates();
-        void LoadCreatures();
+        // false if the spawns could not be read completely
+        bool LoadCreatures();
         void LoadCreatureAddons();
         void LoadCreatureClassLvlStats();
         void LoadCreatureConditionalSpawn();
@@ -740,7 +741,7 @@ class ObjectMgr
         void LoadCreatureModelRace();
         void LoadEquipmentTemplates();
         void LoadGameObjectLocales();
-        void LoadGameObjects();
+        bool LoadGameObjects();
         void LoadGameObjectSpawnEntry();
         void LoadGameObjectTemplateAddons();
         void LoadItemPrototypes();
@@ -34,20 +34,32 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
     for (auto& iter : m)
     {
         iter.getSource()->UpdateVisibilityOf(&i_object);
-        m_unvisitedGuids.erase(iter.getSource()->GetOwner()->GetObjectGuid());
+        m_visitedGuids.push_back(iter.getSource()->GetOwner()->GetObjectGuid());
     }
 }
 
+GuidFlatSet& VisibleChangesNotifier::GetUnvisitedGuids()
+{
+    std::sort(m_visitedGuids.begin(), m_visitedGuids.end());
+    m_unvisitedGuids.EraseSorted(m_visitedGuids);
+    m_visitedGuids.clear();
+    return m_unvisitedGuids;
+}
+
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
+
+    std::sort(i_visitedGuids.begin(), i_visitedGuids.end());
+    i_clientGUIDs.EraseSorted(i_visitedGuids);
+
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (GenericTransport* transport = player.GetTransport())
     {
         for (auto itr : transport->GetPassengers())
         {
-            if (i_clientGUIDs.find(itr->GetObjectGuid()) != i_clientGUIDs.end())
+            if (i_clientGUIDs.contains(itr->GetObjectGuid()))
             {
                 // ignore far sight case
                 if (itr->IsPlayer())
@@ -59,32 +71,21 @@ void VisibleNotifier::Notify()
     }
 
     // Far objects update on player notify
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    i_clientGUIDs.EraseIf([&player](ObjectGuid const& guid)
     {
-        GuidSet::iterator current = itr++;
-        if (WorldObject* obj = player.GetMap()->GetWorldObject(*current))
-        {
-            if (!obj->GetVisibilityData().IsVisibilityOverridden())
-                continue;
+        WorldObject* obj = player.GetMap()->GetWorldObject(guid);
+        if (!obj || !obj->GetVisibilityData().IsVisibilityOverridden())
+            return false;
 
-            player.UpdateVisibilityOf(&player, obj);
-            i_clientGUIDs.erase(current);
-        }
-    }
+        player.UpdateVisibilityOf(&player, obj);
+        return true;
+    });
 
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
-    {
-        if ((*itr).IsMOTransport())
-        {
-            itr = i_clientGUIDs.erase(itr);
-            continue;
-        }
-        ++itr;
-    }
+    i_clientGUIDs.EraseIf([](ObjectGuid const& guid) { return guid.IsMOTransport(); });
 
     // generate outOfRange for not iterate objects
     i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    for (GuidFlatSet::const_iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
     {
         if (WorldObject* target = player.GetMap()->GetWorldObject(*itr))
         {
@@ -163,6 +164,19 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
     }
 }
 
+void MovementMessageDeliverer::Visit(CameraMapType& m)
+{
+    for (auto& iter : m)
+    {
+        Player* owner = iter.getSource()->GetOwner();
+
+        if (!owner->InSamePhase(i_phaseMask) || owner == i_skipped_receiver)
+            continue;
+
+        owner->GetMovementRelay().Relay(owner, iter.getSource()->GetBody(), i_mover, i_message);
+    }
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (auto& iter : m)
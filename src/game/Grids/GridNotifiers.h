@@ -37,10 +37,14 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        GuidFlatSet i_clientGUIDs;
+        GuidVector i_visitedGuids;                          // removed from i_clientGUIDs at Notify in one pass
         WorldObjectSet i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids())
+        {
+            i_visitedGuids.reserve(i_clientGUIDs.size());
+        }
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
@@ -50,13 +54,18 @@ namespace MaNGOS
     {
         WorldObject& i_object;
 
-        explicit VisibleChangesNotifier(WorldObject& object) : i_object(object), m_unvisitedGuids(i_object.GetClientGuidsIAmAt()) {}
+        explicit VisibleChangesNotifier(WorldObject& object) : i_object(object), m_unvisitedGuids(i_object.GetClientGuidsIAmAt())
+        {
+            m_visitedGuids.reserve(m_unvisitedGuids.size());
+        }
         template<class T> void Visit(GridRefManager<T>&) {}
         void Visit(CameraMapType&);
 
-        GuidSet& GetUnvisitedGuids() { return m_unvisitedGuids; }
+        // to call after the visit
+        GuidFlatSet& GetUnvisitedGuids();
 
-        GuidSet m_unvisitedGuids;
+        GuidFlatSet m_unvisitedGuids;
+        GuidVector m_visitedGuids;                          // removed from m_unvisitedGuids in one pass
     };
 
     struct MessageDeliverer
@@ -82,6 +91,20 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    struct MovementMessageDeliverer
+    {
+        WorldObject const* i_mover;
+        uint32        i_phaseMask;
+        WorldPacket const& i_message;
+        Player const* i_skipped_receiver;
+
+        MovementMessageDeliverer(WorldObject const* mover, WorldPacket const& msg, Player const* skipped)
+            : i_mover(mover), i_phaseMask(mover->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    };
+
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
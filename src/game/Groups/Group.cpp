@@ -33,6 +33,7 @@
 #include "Maps/MapManager.h"
 #include "Maps/MapPersistentStateMgr.h"
 #include "Spells/SpellAuras.h"
+#include "Entities/PlayerLoginCache.h"
 #ifdef BUILD_DEPRECATED_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
 #include "Config/Config.h"
@@ -501,7 +502,10 @@ void Group::Disband(bool hideDestroy)
     {
         Player* player = sObjectMgr.GetPlayer(citr->guid);
         if (!player)
+        {
+            sPlayerLoginCache.Invalidate(citr->guid);
             continue;
+        }
 
         // we cannot call _removeMember because it would invalidate member iterator
         // if we are removing player from battleground raid
@@ -927,6 +931,7 @@ bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant, uint
         // insert into group table
         CharacterDatabase.PExecute("INSERT INTO group_member(groupId,memberGuid,assistant,subgroup) VALUES('%u','%u','%u','%u')",
                                    m_Id, member.guid.GetCounter(), ((member.assistant == 1) ? 1 : 0), member.group);
+        sPlayerLoginCache.Invalidate(member.guid);
     }
 
     return true;
@@ -959,7 +964,10 @@ bool Group::_removeMember(ObjectGuid guid)
     }
 
     if (!IsBattleGroup())
+    {
         CharacterDatabase.PExecute("DELETE FROM group_member WHERE memberGuid='%u'", guid.GetCounter());
+        sPlayerLoginCache.Invalidate(guid);
+    }
 
     if (m_leaderGuid == guid)                               // leader was removed
     {
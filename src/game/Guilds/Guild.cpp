@@ -31,6 +31,7 @@
 #include "World/World.h"
 #include "Calendar/Calendar.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/PlayerLoginCache.h"
 
 //// MemberSlot ////////////////////////////////////////////
 void MemberSlot::SetMemberStats(Player* player)
@@ -75,6 +76,8 @@ void MemberSlot::ChangeRank(uint32 newRank)
         player->SetRank(newRank);
 
     CharacterDatabase.PExecute("UPDATE guild_member SET `rank`='%u' WHERE guid='%u'", newRank, guid.GetCounter());
+    if (!player)
+        sPlayerLoginCache.Invalidate(guid);
 }
 
 //// Guild /////////////////////////////////////////////////
@@ -241,6 +244,8 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 
     CharacterDatabase.PExecute("INSERT INTO guild_member (guildid,guid,`rank`,pnote,offnote) VALUES ('%u', '%u', '%u','%s','%s')",
                                m_Id, lowguid, newmember.RankId, dbPnote.c_str(), dbOFFnote.c_str());
+    if (!pl)
+        sPlayerLoginCache.Invalidate(plGuid);
 
     // If player not in game data in data field will be loaded from guild tables, no need to update it!!
     if (pl)
@@ -562,6 +567,8 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     CharacterDatabase.PExecute("DELETE FROM guild_member WHERE guid = '%u'", lowguid);
+    if (!player)
+        sPlayerLoginCache.Invalidate(guid);
 
     if (!isDisbanding)
         UpdateAccountsNumber();
@@ -24,6 +24,7 @@
 #include "Policies/Singleton.h"
 #include "Util/ProgressBar.h"
 #include "World/World.h"
+#include "Social/WhoListIndex.h"
 
 INSTANTIATE_SINGLETON_1(GuildMgr);
 
@@ -40,11 +41,13 @@ GuildMgr::~GuildMgr()
 void GuildMgr::AddGuild(Guild* guild)
 {
     m_GuildMap[guild->GetId()] = guild;
+    sWhoListIndex.InvalidateGuildName(guild->GetId());
 }
 
 void GuildMgr::RemoveGuild(uint32 guildId)
 {
     m_GuildMap.erase(guildId);
+    sWhoListIndex.InvalidateGuildName(guildId);
 }
 
 Guild* GuildMgr::GetGuildById(uint32 guildId) const
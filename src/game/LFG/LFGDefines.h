@@ -123,6 +123,7 @@ enum LfgTimers
     LFG_TIME_ROLECHECK  = 45,
     LFG_TIME_BOOT       = 120,
     LFG_TIME_PROPOSAL   = 45,
+    LFG_TIME_QUEUE_STATUS = 15,
 };
 
 // Role check states
@@ -217,6 +218,16 @@ struct LfgInstanceSave
 
 typedef std::map<uint32, LfgInstanceSave> LfgInstanceSaveMap;
 
+struct LFGQueuePlayer
+{
+    uint32 m_level;
+    uint32 m_class;
+    uint32 m_race;
+    uint32 m_roles;
+};
+
+typedef std::map<ObjectGuid, LFGQueuePlayer> LfgPlayerInfoMap;
+
 struct LfgJoinResultData
 {
     LfgJoinResultData(LfgJoinResult result = LFG_JOIN_OK, LfgRoleCheckState state = LFG_ROLECHECK_DEFAULT) :
@@ -242,6 +253,22 @@ struct LfgUpdateData
     uint8 m_roles[ROLE_INDEX_COUNT];
 };
 
+struct LfgQueueStatusData
+{
+    LfgQueueStatusData(uint32 dungeonId = 0) : dungeonId(dungeonId), waitTimeAvg(-1), waitTime(-1), waitTimeTank(-1), waitTimeHealer(-1), waitTimeDps(-1),
+        tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), queuedTime(0) { }
+    uint32 dungeonId;
+    int32 waitTimeAvg;                                     // in seconds, -1 when unknown
+    int32 waitTime;
+    int32 waitTimeTank;
+    int32 waitTimeHealer;
+    int32 waitTimeDps;
+    uint8 tanks;                                           // still needed
+    uint8 healers;
+    uint8 dps;
+    uint32 queuedTime;                                     // in seconds
+};
+
 struct LfgPlayerRewardData
 {
     LfgPlayerRewardData(uint32 random, uint32 current, bool done, Quest const* quest) :
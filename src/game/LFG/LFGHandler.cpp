@@ -485,6 +485,22 @@ WorldPacket WorldSession::BuildLfgUpdateProposal(LfgProposal const& proposal, ui
     return data;
 }
 
+WorldPacket WorldSession::BuildLfgQueueStatus(LfgQueueStatusData const& statusData)
+{
+    WorldPacket data(SMSG_LFG_QUEUE_STATUS, 4 + 4 + 4 + 4 + 4 + 4 + 1 + 1 + 1 + 4);
+    data << uint32(statusData.dungeonId);                  // Dungeon
+    data << int32(statusData.waitTimeAvg);                 // Average Wait time
+    data << int32(statusData.waitTime);                    // Wait Time
+    data << int32(statusData.waitTimeTank);                // Wait Tanks
+    data << int32(statusData.waitTimeHealer);              // Wait Healers
+    data << int32(statusData.waitTimeDps);                 // Wait Dps
+    data << uint8(statusData.tanks);                       // Tanks needed
+    data << uint8(statusData.healers);                     // Healers needed
+    data << uint8(statusData.dps);                         // Dps needed
+    data << uint32(statusData.queuedTime);                 // Player wait time in queue
+    return data;
+}
+
 void WorldSession::SendLfgPlayerReward(LfgPlayerRewardData const& rewardData)
 {
     if (!rewardData.rdungeonEntry || !rewardData.sdungeonEntry || !rewardData.quest)
@@ -0,0 +1,201 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LFG/LFGMatchmaker.h"
+#include "LFG/LFGMgr.h"
+#include "LFG/LFGQueue.h"
+
+#include <algorithm>
+
+static uint8 const roleFlags[ROLE_INDEX_COUNT] = { PLAYER_ROLE_TANK, PLAYER_ROLE_HEALER, PLAYER_ROLE_DAMAGE };
+static uint32 const rolesNeeded[ROLE_INDEX_COUNT] = { LFG_TANKS_NEEDED, LFG_HEALERS_NEEDED, LFG_DPS_NEEDED };
+static uint32 const groupSize = LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED;
+
+void LfgMatchmaker::Add(LFGQueueData const& data)
+{
+    if (IsQueued(data.m_ownerGuid))
+        return;
+
+    Entry& entry = m_entries[data.m_ownerGuid];
+    entry.owner = data.m_ownerGuid;
+    entry.queueTime = data.m_queueTime;
+    entry.team = data.m_team;
+    entry.dungeons = data.m_dungeons;
+    entry.players = data.m_playerInfoPerGuid;
+    entry.roleMask = 0;
+    for (auto const& playerInfo : entry.players)
+        entry.roleMask |= playerInfo.second.m_roles & ~PLAYER_ROLE_LEADER;
+
+    LinkEntry(entry, 1);
+}
+
+void LfgMatchmaker::Remove(ObjectGuid owner)
+{
+    auto itr = m_entries.find(owner);
+    if (itr == m_entries.end())
+        return;
+
+    LinkEntry(itr->second, -1);
+    m_entries.erase(itr);
+}
+
+void LfgMatchmaker::LinkEntry(Entry const& entry, int32 sign)
+{
+    QueueOrder order(entry.queueTime, entry.owner);
+
+    uint32 playersPerRole[ROLE_INDEX_COUNT] = {};
+    for (auto const& playerInfo : entry.players)
+        for (uint32 i = 0; i < ROLE_INDEX_COUNT; ++i)
+            if (playerInfo.second.m_roles & roleFlags[i])
+                ++playersPerRole[i];
+
+    for (uint32 dungeonId : entry.dungeons)
+    {
+        BucketKey key(entry.team, dungeonId);
+        Bucket& bucket = m_buckets[key];
+
+        if (sign > 0)
+        {
+            bucket.queues.insert(order);
+            bucket.players += entry.players.size();
+        }
+        else
+        {
+            bucket.queues.erase(order);
+            bucket.players -= entry.players.size();
+        }
+
+        for (uint32 i = 0; i < ROLE_INDEX_COUNT; ++i)
+        {
+            if (!(entry.roleMask & roleFlags[i]))
+                continue;
+
+            if (sign > 0)
+                bucket.roles[i].insert(order);
+            else
+                bucket.roles[i].erase(order);
+            bucket.playersPerRole[i] += sign * int32(playersPerRole[i]);
+        }
+
+        if (bucket.queues.empty())
+        {
+            m_buckets.erase(key);
+            m_changedBuckets.erase(key);
+        }
+        else
+            m_changedBuckets.insert(key);
+    }
+}
+
+bool LfgMatchmaker::FindMatch(LfgMatch& match)
+{
+    while (!m_changedBuckets.empty())
+    {
+        BucketKey key = *m_changedBuckets.begin();
+        auto itr = m_buckets.find(key);
+        if (itr != m_buckets.end() && SearchBucket(key, itr->second, match))
+            return true;                                    // stays changed, next call continues with rest of the bucket
+
+        m_changedBuckets.erase(key);
+    }
+    return false;
+}
+
+bool LfgMatchmaker::SearchBucket(BucketKey const& key, Bucket const& bucket, LfgMatch& match) const
+{
+    // cheap reject, most buckets wait for a tank or healer
+    if (bucket.players < groupSize)
+        return false;
+
+    for (uint32 i = 0; i < ROLE_INDEX_COUNT; ++i)
+        if (bucket.playersPerRole[i] < rolesNeeded[i])
+            return false;
+
+    uint32 anchors = 0;
+    for (QueueOrder const& anchorOrder : bucket.queues)
+    {
+        if (++anchors > LFG_MATCHMAKER_MAX_ANCHORS)
+            break;
+
+        // oldest queue first, then fill missing roles by oldest queue able to fill them
+        LfgPlayerInfoMap players = m_entries.at(anchorOrder.second).players;
+        LfgPlayerInfoMap assigned = players;
+        if (!LFGMgr::CheckGroupRoles(assigned))
+            continue;
+
+        GuidVector picked;
+        picked.push_back(anchorOrder.second);
+
+        while (players.size() < groupSize)
+        {
+            uint32 filled[ROLE_INDEX_COUNT] = {};
+            for (auto const& playerInfo : assigned)
+                for (uint32 i = 0; i < ROLE_INDEX_COUNT; ++i)
+                    if (playerInfo.second.m_roles & roleFlags[i])
+                        ++filled[i];
+
+            bool added = false;
+            for (uint32 i = 0; i < ROLE_INDEX_COUNT && !added; ++i)
+            {
+                if (filled[i] >= rolesNeeded[i])
+                    continue;
+
+                uint32 probes = 0;
+                for (QueueOrder const& order : bucket.roles[i])
+                {
+                    if (++probes > LFG_MATCHMAKER_MAX_PROBES)
+                        break;
+
+                    if (std::find(picked.begin(), picked.end(), order.second) != picked.end())
+                        continue;
+
+                    Entry const& candidate = m_entries.at(order.second);
+                    if (players.size() + candidate.players.size() > groupSize)
+                        continue;
+
+                    LfgPlayerInfoMap testPlayers = players;
+                    testPlayers.insert(candidate.players.begin(), candidate.players.end());
+                    LfgPlayerInfoMap testAssigned = testPlayers;
+                    if (!LFGMgr::CheckGroupRoles(testAssigned))
+                        continue;
+
+                    players.swap(testPlayers);
+                    assigned.swap(testAssigned);
+                    picked.push_back(order.second);
+                    added = true;
+                    break;
+                }
+            }
+
+            if (!added)
+                break;
+        }
+
+        if (players.size() != groupSize)
+            continue;
+
+        match.dungeonId = key.second;
+        match.queues = picked;
+        match.roles.clear();
+        for (auto const& playerInfo : assigned)
+            match.roles[playerInfo.first] = playerInfo.second.m_roles & ~PLAYER_ROLE_LEADER;
+        return true;
+    }
+
+    return false;
+}
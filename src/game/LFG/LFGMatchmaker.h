@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _LFG_MATCHMAKER_H
+#define _LFG_MATCHMAKER_H
+
+#include "Common.h"
+#include "LFG/LFGDefines.h"
+
+#include <set>
+#include <unordered_map>
+
+struct LFGQueueData;
+
+enum LfgMatchmakerLimits
+{
+    LFG_MATCHMAKER_MAX_ANCHORS  = 10,                       // oldest queues tried as base of a group per bucket update
+    LFG_MATCHMAKER_MAX_PROBES   = 25,                       // candidates tried per missing role
+};
+
+/// Queues chosen for one dungeon proposal
+struct LfgMatch
+{
+    uint32 dungeonId = 0;
+    GuidVector queues;                                      // first is the oldest queue of the dungeon
+    std::map<ObjectGuid, uint8> roles;                      // single role assigned to each player
+};
+
+/*
+ * Forms 5 player tank/healer/3 dps groups out of queued players and pre-formed groups.
+ *
+ * Queues are kept in buckets per team and dungeon, and inside a bucket in one list
+ * per role the queue can fill, ordered by queue time. Only buckets changed since the
+ * last search are searched, and a bucket is skipped without looking at its queues
+ * when it does not have enough players for each role.
+ */
+class LfgMatchmaker
+{
+    public:
+        void Add(LFGQueueData const& data);
+        void Remove(ObjectGuid owner);
+        bool IsQueued(ObjectGuid owner) const { return m_entries.find(owner) != m_entries.end(); }
+
+        // returns true and fills match while groups can be formed, queues of the match must be removed before next call
+        bool FindMatch(LfgMatch& match);
+
+        uint32 GetQueuedCount() const { return m_entries.size(); }
+
+    private:
+        typedef std::pair<TimePoint, ObjectGuid> QueueOrder;
+        typedef std::pair<uint32, uint32> BucketKey;        // team, dungeon
+
+        struct Entry
+        {
+            ObjectGuid owner;
+            TimePoint queueTime;
+            uint32 team;
+            uint8 roleMask;                                 // roles any member can fill
+            LfgDungeonSet dungeons;
+            LfgPlayerInfoMap players;
+        };
+
+        struct Bucket
+        {
+            std::set<QueueOrder> queues;
+            std::set<QueueOrder> roles[ROLE_INDEX_COUNT];
+            uint32 players = 0;
+            uint32 playersPerRole[ROLE_INDEX_COUNT] = {};
+        };
+
+        void LinkEntry(Entry const& entry, int32 sign);
+        bool SearchBucket(BucketKey const& key, Bucket const& bucket, LfgMatch& match) const;
+
+        std::unordered_map<ObjectGuid, Entry> m_entries;
+        std::map<BucketKey, Bucket> m_buckets;
+        std::set<BucketKey> m_changedBuckets;
+};
+
+#endif
@@ -31,9 +31,6 @@
 
 struct LFGDungeonEntry;
 
-struct LFGQueuePlayer;
-typedef std::map<ObjectGuid, LFGQueuePlayer> LfgPlayerInfoMap;
-
  /// Reward info
 struct LfgReward
 {
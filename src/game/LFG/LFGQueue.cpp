@@ -26,10 +26,15 @@ void LFGQueue::AddToQueue(LFGQueueData const& data)
     LFGQueueData& queueData = result.first->second;
     if (data.m_roleCheckState == LFG_ROLECHECK_INITIALITING)
         queueData.UpdateRoleCheck(queueData.m_leaderGuid, queueData.m_playerInfoPerGuid[queueData.m_leaderGuid].m_roles, false, false);
+    else if (queueData.GetState() == LFG_STATE_QUEUED)
+        queueData.m_queueTime = queueData.m_joinTime;
+
+    UpdateMatchmaking(queueData);
 }
 
 void LFGQueue::RemoveFromQueue(ObjectGuid owner)
 {
+    m_matchmaker.Remove(owner);
     m_queueData.erase(owner);
 }
 
@@ -41,6 +46,8 @@ void LFGQueue::SetPlayerRoles(ObjectGuid group, ObjectGuid player, uint8 roles)
         itr->second.UpdateRoleCheck(player, roles, false, false);
         if (itr->second.GetState() == LFG_STATE_FAILED)
             m_queueData.erase(itr);
+        else
+            UpdateMatchmaking(itr->second);
     }
 }
 
@@ -95,6 +102,7 @@ void LFGQueue::OnPlayerLogout(ObjectGuid guid, ObjectGuid groupGuid)
                 world->BroadcastPersonalized(personalizedPackets);
             });
         }
+        m_matchmaker.Remove(searchGuid);
         m_queueData.erase(itr);
     }
 }
@@ -130,24 +138,15 @@ void LFGQueue::Update()
                     proposal.id = counter++;
                     queueData.PopQueue(proposal);
                     m_proposals[proposal.id] = proposal;
+                    m_matchmaker.Remove(queueData.m_ownerGuid);
                 }
             }
         }
         else
         {
-            // no actual matchmaking for now - enable entering for full groups - TODO: matchmaking
-            for (auto& queuedGroupData : m_queueData)
-            {
-                LFGQueueData& queueData = queuedGroupData.second;
-                // rolecheck makes sure integrity of correct group is held
-                if (queueData.GetState() == LFG_STATE_QUEUED && queueData.m_playerInfoPerGuid.size() == 5)
-                {
-                    LfgProposal proposal;
-                    proposal.id = counter++;
-                    queueData.PopQueue(proposal);
-                    m_proposals[proposal.id] = proposal;
-                }
-            }
+            LfgMatch match;
+            while (m_matchmaker.FindMatch(match))
+                CreateProposal(match, counter++);
         }
 
         for (auto& proposalData : m_proposals)
@@ -156,13 +155,23 @@ void LFGQueue::Update()
         for (auto itr = m_queueData.begin(); itr != m_queueData.end();)
         {
             if (itr->second.GetState() == LFG_STATE_FAILED)
+            {
+                m_matchmaker.Remove(itr->first);
                 itr = m_queueData.erase(itr);
+            }
             else
                 ++itr;
         }
 
         for (uint32 proposalId : m_proposalsForRemoval)
             m_proposals.erase(proposalId);
+        m_proposalsForRemoval.clear();
+
+        if (m_nextQueueStatus < now)
+        {
+            SendQueueStatus();
+            m_nextQueueStatus = now + std::chrono::seconds(LFG_TIME_QUEUE_STATUS);
+        }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
@@ -182,24 +191,164 @@ uint32 LFGQueue::GetPartyMemberCountAtJoin(ObjectGuid guid) const
     return itr->second;
 }
 
+void LfgWaitTime::Add(int32 waitTime)
+{
+    // recent groups weigh more, queues change during the day
+    if (count < 10)
+        ++count;
+    time = time < 0 ? waitTime : int32((int64(time) * (count - 1) + waitTime) / count);
+}
+
 void LFGQueue::UpdateWaitTimeDps(int32 time, uint32 dungeonId)
 {
-    // TODO
+    LfgDungeonWaitTimes& waitTimes = m_waitTimes[dungeonId];
+    waitTimes.dps.Add(time);
+    waitTimes.avg.Add(time);
 }
 
 void LFGQueue::UpdateWaitTimeHealer(int32 time, uint32 dungeonId)
 {
-    // TODO
+    LfgDungeonWaitTimes& waitTimes = m_waitTimes[dungeonId];
+    waitTimes.healer.Add(time);
+    waitTimes.avg.Add(time);
 }
 
 void LFGQueue::UpdateWaitTimeTank(int32 time, uint32 dungeonId)
 {
-    // TODO
+    LfgDungeonWaitTimes& waitTimes = m_waitTimes[dungeonId];
+    waitTimes.tank.Add(time);
+    waitTimes.avg.Add(time);
 }
 
 void LFGQueue::UpdateWaitTimeAvg(int32 time, uint32 dungeonId)
 {
-    // TODO
+    m_waitTimes[dungeonId].avg.Add(time);
+}
+
+void LFGQueue::UpdateMatchmaking(LFGQueueData const& data)
+{
+    if (data.GetState() == LFG_STATE_QUEUED && !data.m_raid)
+        m_matchmaker.Add(data);
+    else
+        m_matchmaker.Remove(data.m_ownerGuid);
+}
+
+void LFGQueue::CreateProposal(LfgMatch const& match, uint32 id)
+{
+    LfgProposal& proposal = m_proposals[id];
+    proposal.id = id;
+    proposal.dungeonId = match.dungeonId;
+    proposal.state = LFG_PROPOSAL_INITIATING;
+    proposal.group = ObjectGuid(); // only filled when already lfg group
+    proposal.cancelTime = sWorld.GetCurrentClockTime() + std::chrono::seconds(LFG_TIME_PROPOSAL);
+    proposal.encounters = 0;
+    proposal.isNew = true;
+
+    // leader of a premade group leads, otherwise the longest waiting player
+    proposal.leader = match.queues.front();
+    for (ObjectGuid owner : match.queues)
+    {
+        if (owner.IsGroup())
+        {
+            proposal.leader = m_queueData[owner].m_leaderGuid;
+            break;
+        }
+    }
+
+    for (ObjectGuid owner : match.queues)
+    {
+        LFGQueueData& queueData = m_queueData[owner];
+        queueData.SetState(LFG_STATE_PROPOSAL);
+        m_matchmaker.Remove(owner);
+
+        proposal.queues.push_back(owner);
+        for (auto& playerData : queueData.m_playerInfoPerGuid)
+            proposal.players[playerData.first] = LfgProposalPlayer(match.roles.at(playerData.first), LFG_ANSWER_PENDING, owner.IsGroup() ? owner : ObjectGuid(), queueData.m_randomDungeonId);
+    }
+
+    std::map<ObjectGuid, std::vector<WorldPacket>> personalizedPackets;
+    for (ObjectGuid owner : match.queues)
+    {
+        LFGQueueData& queueData = m_queueData[owner];
+        WorldPacket proposalBegin = WorldSession::BuildLfgUpdate(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, queueData.GetDungeons(), ""), owner.IsGroup());
+        for (auto& playerData : queueData.m_playerInfoPerGuid)
+        {
+            std::vector<WorldPacket>& packets = personalizedPackets[playerData.first];
+            packets.push_back(proposalBegin);
+            packets.emplace_back(WorldSession::BuildLfgUpdateProposal(proposal, queueData.m_randomDungeonId, playerData.first));
+        }
+    }
+
+    sWorld.GetMessager().AddMessage([personalizedPackets](World* world)
+    {
+        world->BroadcastPersonalized(personalizedPackets);
+    });
+}
+
+void LFGQueue::SendQueueStatus()
+{
+    TimePoint now = sWorld.GetCurrentClockTime();
+    std::map<ObjectGuid, std::vector<WorldPacket>> personalizedPackets;
+
+    for (auto& queuedData : m_queueData)
+    {
+        LFGQueueData& queueData = queuedData.second;
+        if (queueData.GetState() != LFG_STATE_QUEUED || queueData.m_raid || queueData.m_dungeons.empty())
+            continue;
+
+        uint32 dungeonId = queueData.m_randomDungeonId ? queueData.m_randomDungeonId : *queueData.m_dungeons.begin();
+        LfgQueueStatusData status(dungeonId);
+        status.queuedTime = uint32(std::chrono::duration_cast<std::chrono::seconds>(now - queueData.GetJoinTime()).count());
+
+        auto waitItr = m_waitTimes.find(dungeonId);
+        if (waitItr != m_waitTimes.end())
+        {
+            status.waitTimeAvg = waitItr->second.avg.time;
+            status.waitTimeTank = waitItr->second.tank.time;
+            status.waitTimeHealer = waitItr->second.healer.time;
+            status.waitTimeDps = waitItr->second.dps.time;
+        }
+
+        // roles still missing, assigned like the matchmaker would
+        LfgPlayerInfoMap assigned = queueData.m_playerInfoPerGuid;
+        if (LFGMgr::CheckGroupRoles(assigned))
+        {
+            for (auto const& playerInfo : assigned)
+            {
+                switch (playerInfo.second.m_roles & ~PLAYER_ROLE_LEADER)
+                {
+                    case PLAYER_ROLE_TANK: --status.tanks; break;
+                    case PLAYER_ROLE_HEALER: --status.healers; break;
+                    case PLAYER_ROLE_DAMAGE: --status.dps; break;
+                    default: break;
+                }
+            }
+        }
+
+        status.waitTime = status.waitTimeAvg;
+        if (!queueData.m_ownerGuid.IsGroup() && !assigned.empty())
+        {
+            switch (queueData.m_playerInfoPerGuid.begin()->second.m_roles & ~PLAYER_ROLE_LEADER)
+            {
+                case PLAYER_ROLE_TANK: status.waitTime = status.waitTimeTank; break;
+                case PLAYER_ROLE_HEALER: status.waitTime = status.waitTimeHealer; break;
+                case PLAYER_ROLE_DAMAGE: status.waitTime = status.waitTimeDps; break;
+                default: break;
+            }
+        }
+
+        WorldPacket data = WorldSession::BuildLfgQueueStatus(status);
+        for (auto& playerInfo : queueData.m_playerInfoPerGuid)
+            personalizedPackets[playerInfo.first].push_back(data);
+    }
+
+    if (personalizedPackets.empty())
+        return;
+
+    sWorld.GetMessager().AddMessage([personalizedPackets](World* world)
+    {
+        world->BroadcastPersonalized(personalizedPackets);
+    });
 }
 
 void LFGQueueData::UpdateRoleCheck(ObjectGuid guid, uint8 roles, bool abort, bool timeout)
@@ -393,6 +542,7 @@ void LfgProposal::FailProposal(LFGQueue& queue)
         {
             // continue being queued - did nothing wrong
             queueData.SetState(LFG_STATE_QUEUED);
+            queue.UpdateMatchmaking(queueData);
         }
     }
 
@@ -420,7 +570,7 @@ void LfgProposal::AcceptProposal(LFGQueue& queue)
     {
         ObjectGuid pguid = itr->first;
         ObjectGuid gguid = itr->second.group;
-        uint32 randomDungeonId = itr->second.group;
+        uint32 randomDungeonId = itr->second.randomDungeonId;
         int32 waitTime = -1;
 
         std::vector<WorldPacket>& packets = personalizedPackets[pguid];
@@ -428,29 +578,30 @@ void LfgProposal::AcceptProposal(LFGQueue& queue)
         packets.emplace_back(WorldSession::BuildLfgUpdateProposal(*this, randomDungeonId, pguid));
 
         LFGQueueData& queueData = queue.GetQueueData(gguid ? gguid : pguid);
-        waitTime = int32((joinTime - queueData.GetJoinTime()).count());
+        waitTime = int32(std::chrono::duration_cast<std::chrono::seconds>(joinTime - queueData.GetJoinTime()).count());
         packets.emplace_back(WorldSession::BuildLfgUpdate(updateData, true));
         updateData.updateType = LFG_UPDATETYPE_REMOVED_FROM_QUEUE;
         packets.emplace_back(WorldSession::BuildLfgUpdate(updateData, true));
         packets.emplace_back(WorldSession::BuildLfgUpdate(updateData, false));
 
         LFGQueuePlayer& playerInfo = queueData.m_playerInfoPerGuid[pguid];
-        // Update timers
-        uint8 role = playerInfo.m_roles;
+        // Update timers, of the dungeon queued for as queue status shows those
+        uint32 queuedDungeonId = randomDungeonId ? randomDungeonId : dungeonId;
+        uint8 role = itr->second.role;
         role &= ~PLAYER_ROLE_LEADER;
         switch (role)
         {
             case PLAYER_ROLE_DAMAGE:
-                queue.UpdateWaitTimeDps(waitTime, dungeonId);
+                queue.UpdateWaitTimeDps(waitTime, queuedDungeonId);
                 break;
             case PLAYER_ROLE_HEALER:
-                queue.UpdateWaitTimeHealer(waitTime, dungeonId);
+                queue.UpdateWaitTimeHealer(waitTime, queuedDungeonId);
                 break;
             case PLAYER_ROLE_TANK:
-                queue.UpdateWaitTimeTank(waitTime, dungeonId);
+                queue.UpdateWaitTimeTank(waitTime, queuedDungeonId);
                 break;
             default:
-                queue.UpdateWaitTimeAvg(waitTime, dungeonId);
+                queue.UpdateWaitTimeAvg(waitTime, queuedDungeonId);
                 break;
         }
 
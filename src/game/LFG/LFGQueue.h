@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "LFG/LFGDefines.h"
+#include "LFG/LFGMatchmaker.h"
 #include "Multithreading/Messager.h"
 #include "Server/WorldPacket.h"
 
@@ -29,16 +30,6 @@
 class World;
 class LFGQueue;
 
-struct LFGQueuePlayer
-{
-    uint32 m_level;
-    uint32 m_class;
-    uint32 m_race;
-    uint32 m_roles;
-};
-
-typedef std::map<ObjectGuid, LFGQueuePlayer> LfgPlayerInfoMap;
-
 struct LfgProposalPlayer
 {
     LfgProposalPlayer() : role(0), answer(LFG_ANSWER_PENDING), group() { }
@@ -107,6 +98,23 @@ struct LFGQueueData
     TimePoint GetJoinTime() const { return m_joinTime; }
 };
 
+/// Running average of waits in queue until a group was found, in seconds
+struct LfgWaitTime
+{
+    int32 time = -1;
+    uint32 count = 0;
+
+    void Add(int32 waitTime);
+};
+
+struct LfgDungeonWaitTimes
+{
+    LfgWaitTime tank;
+    LfgWaitTime healer;
+    LfgWaitTime dps;
+    LfgWaitTime avg;
+};
+
 /*
  * intended to live in its own thread - must not access anything from the outside that is mutable
  * prototyping for being able to separate certain processes from world thread context entirely
@@ -140,10 +148,14 @@ class LFGQueue
         void UpdateWaitTimeHealer(int32 time, uint32 dungeonId);
         void UpdateWaitTimeTank(int32 time, uint32 dungeonId);
         void UpdateWaitTimeAvg(int32 time, uint32 dungeonId);
+
+        // adds queue in LFG_STATE_QUEUED to matchmaking, removes it in other states
+        void UpdateMatchmaking(LFGQueueData const& data);
     private:
+        void CreateProposal(LfgMatch const& match, uint32 id);
+        void SendQueueStatus();
 
         std::map<ObjectGuid, LFGQueueData> m_queueData;
-        std::vector<LFGQueueData*> m_sortedQueue; // sorted by time
 
         Messager<LFGQueue> m_messager;
 
@@ -153,6 +165,10 @@ class LFGQueue
         std::vector<uint32> m_proposalsForRemoval;
 
         std::map<ObjectGuid, uint32> m_numberOfPartyMembersAtJoin;
+
+        LfgMatchmaker m_matchmaker;
+        std::map<uint32, LfgDungeonWaitTimes> m_waitTimes;
+        TimePoint m_nextQueueStatus;
 };
 
 struct ListedContainer
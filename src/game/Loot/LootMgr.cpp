@@ -133,8 +133,18 @@ void LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
-    //                                                 0      1     2                    3        4              5         6
-    auto queryResult = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    // rows are read from a dedicated connection while the previous ones are processed
+    //                                  0      1     2                    3        4              5         6
+    std::string query = "SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM ";
+    query += GetName();
+    auto queryResult = WorldDatabase.QueryStreamed(query.c_str(), true);
+
+    if (queryResult && queryResult->IsFailed())
+    {
+        sLog.outString();
+        sLog.outError(">> Loading of table `%s` failed by a DB error, no loot loaded from it.", GetName());
+        return;
+    }
 
     if (queryResult)
     {
@@ -186,8 +196,20 @@ void LootStore::LoadLootTable()
         }
         while (queryResult->NextRow());
 
+        // same as a failed query, no partial loot is kept
+        if (queryResult->IsFailed())
+        {
+            Clear();
+            sLog.outString();
+            sLog.outError(">> Loading of table `%s` was interrupted by a DB error, no loot loaded from it.", GetName());
+            return;
+        }
+
         Verify();                                           // Checks validity of the loot store
 
+        for (auto& lootTemplate : m_LootTemplates)
+            lootTemplate.second.BuildAliasTables();
+
         sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
         sLog.outString();
     }
@@ -1100,6 +1122,23 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
     return true;
 }
 
+// Rolls the items of a corpse loot which creation was only deferred to its first opening
+void Loot::FillPendingLoot(Player* looter)
+{
+    if (!m_pendingLootId)
+        return;
+
+    uint32 lootId = m_pendingLootId;
+    m_pendingLootId = 0;
+
+    // only solo loot is deferred, roll for its killer who is also its only allowed looter
+    Player* lootOwner = looter->GetMap()->GetPlayer(m_pendingLootOwnerGuid);
+    if (!lootOwner)
+        lootOwner = looter;
+
+    FillLoot(lootId, LootTemplates_Creature, lootOwner, false);
+}
+
 // Get loot status for a specified player
 uint32 Loot::GetLootStatusFor(Player const* player) const
 {
@@ -1563,13 +1602,15 @@ void Loot::ShowContentTo(Player* plr)
     if (!m_isChest)
     {
         // for item loot that might be empty we should not display error but instead send empty loot window
-        if (!m_lootItems.empty() && !CanLoot(plr))
+        if ((!m_lootItems.empty() || m_pendingLootId) && !CanLoot(plr))
         {
             SendReleaseFor(plr);
             sLog.outError("Loot::ShowContentTo()> %s is trying to open a loot without credential", plr->GetGuidStr().c_str());
             return;
         }
 
+        FillPendingLoot(plr);
+
         // add this player to the the openers list of this loot
         m_playersOpened.emplace(plr->GetObjectGuid());
     }
@@ -1766,7 +1807,7 @@ void Loot::SetGroupLootRight(Player* player)
 Loot::Loot(Player* player, Creature* creature, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1793,9 +1834,25 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
             SetGroupLootRight(player);
             m_clientLootType = CLIENT_LOOT_CORPSE;
 
-            if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+            GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+
+            // corpse holding money is lootable for all owners whatever its items are, so most of these corpses
+            // (aoe farmed, never looted) do not need their items rolled before someone opens the loot.
+            // Only done for solo loot: its single allowed looter and loot method are set above and cannot change,
+            // while group loot item rights depend on which members are around when the items are rolled
+            bool hasLoot;
+            if (creatureInfo->LootId && m_gold && m_lootMethod == NOT_GROUP_TYPE_LOOT && m_ownerSet.size() == 1 &&
+                LootTemplates_Creature.HaveLootFor(creatureInfo->LootId))
+            {
+                m_pendingLootId = creatureInfo->LootId;
+                m_pendingLootOwnerGuid = *m_ownerSet.begin();
+                hasLoot = true;
+            }
+            else
+                hasLoot = (creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0;
+
+            if (hasLoot)
             {
-                GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
                 // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
                 bool isLootedForAll = IsLootedForAll();
                 if (isLootedForAll)
@@ -1865,7 +1922,7 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
 Loot::Loot(Player* player, GameObject* gameObject, LootType type, bool lootSnapshot) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1956,7 +2013,7 @@ Loot::Loot(Player* player, GameObject* gameObject, LootType type, bool lootSnaps
 Loot::Loot(Player* player, Corpse* corpse, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -2005,7 +2062,7 @@ Loot::Loot(Player* player, Corpse* corpse, LootType type) :
 Loot::Loot(Player* player, Item* item, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -2052,7 +2109,7 @@ Loot::Loot(Player* player, Item* item, LootType type) :
 Loot::Loot(Unit* unit, Item* item) :
     m_lootTarget(nullptr), m_itemTarget(item), m_gold(0), m_maxSlot(0),
     m_lootType(LOOT_SKINNING), m_clientLootType(CLIENT_LOOT_PICKPOCKETING), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0),
-    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(unit->GetObjectGuid());
     m_guidTarget = item->GetObjectGuid();
@@ -2061,7 +2118,7 @@ Loot::Loot(Unit* unit, Item* item) :
 Loot::Loot(Player* player, uint32 id, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(player->GetObjectGuid());
     switch (type)
@@ -2091,7 +2148,7 @@ Loot::Loot(Player* player, uint32 id, LootType type) :
 Loot::Loot(LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0), m_createTime(World::GetCurrentClockTime())
 {
 
 }
@@ -2318,6 +2375,7 @@ void Loot::Clear()
     m_lootItems.clear();
     m_playersLooting.clear();
     m_gold = 0;
+    m_pendingLootId = 0;
     m_ownerSet.clear();
     m_masterOwnerGuid.Clear();
     m_currentLooterGuid.Clear();
@@ -2412,6 +2470,12 @@ void Loot::PrintLootList(ChatHandler& chat, WorldSession* session) const
     else
         chat.PSendSysMessage("Loot have (%u)coppers", m_gold);
 
+    if (m_pendingLootId)
+    {
+        chat.PSendSysMessage("Loot items (loot id %u) will be rolled at first opening", m_pendingLootId);
+        return;
+    }
+
     if (m_lootItems.empty())
     {
         chat.PSendSysMessage("Loot have no item.");
@@ -2493,7 +2557,16 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem const& item)
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner) const
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    if (!AliasChance.empty())                               // Explicitly chanced entries are drawn directly from the alias table
+    {
+        uint32 index = urand(0, AliasChance.size() - 1);
+        if (rand_norm_f() >= AliasChance[index])
+            index = Alias[index];
+
+        if (index < ExplicitlyChanced.size())
+            return &ExplicitlyChanced[index];
+    }
+    else if (!ExplicitlyChanced.empty())                    // First explicitly chanced entries are checked
     {
         std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
 
@@ -2528,37 +2601,37 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
 
     if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
-
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : EqualChanced)
-            lootStoreItemVector.push_back(&itr);
-
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
-
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        // check if the entry can be taken, an item already in the loot list only has 50% chance to be taken again
+        auto canTake = [&loot, lootOwner](LootStoreItem const* lsi)
         {
-            LootStoreItem const* lsi = *itr;
-
-            //check if we already have that item in the loot list
-            if (loot.IsItemAlreadyIn(lsi->itemid))
-            {
-                // the item is already looted, let's give a 50%  chance to pick another one
-                uint32 chance = urand(0, 1);
-
-                if (chance)
-                    continue;                               // pass this item
-            }
+            if (loot.IsItemAlreadyIn(lsi->itemid) && urand(0, 1))
+                return false;
 
             if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
             {
                 sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
+                return false;
             }
-            return lsi;
-        }
+            return true;
+        };
+
+        // usually the first uniformly picked entry is taken, no need to randomize the whole list for it
+        uint32 first = urand(0, EqualChanced.size() - 1);
+        if (canTake(&EqualChanced[first]))
+            return &EqualChanced[first];
+
+        // rest of the entries are tried in random order, same as if the whole list was randomized at once
+        std::vector <LootStoreItem const*> lootStoreItemVector;
+        lootStoreItemVector.reserve(EqualChanced.size() - 1);
+        for (uint32 i = 0; i < EqualChanced.size(); ++i)
+            if (i != first)
+                lootStoreItemVector.push_back(&EqualChanced[i]);
+
+        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+
+        for (auto lsi : lootStoreItemVector)
+            if (canTake(lsi))
+                return lsi;
     }
 
     return nullptr;                                            // Empty drop from the group
@@ -2686,6 +2759,68 @@ bool LootTemplate::LootGroup::CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevR
     return true;
 }
 
+// Builds the alias table (Vose) used to roll explicitly chanced entries with one draw
+// Only done when the entries have no condition and sum up to 100% at most, else the order of the checks matters and they are rolled one by one
+void LootTemplate::LootGroup::BuildAliasTable()
+{
+    AliasChance.clear();
+    Alias.clear();
+
+    if (ExplicitlyChanced.empty())
+        return;
+
+    float total = 0.0f;
+    for (auto const& lsi : ExplicitlyChanced)
+    {
+        if (lsi.conditionId || lsi.chance >= 100.0f)
+            return;
+        total += lsi.chance;
+    }
+
+    if (total > 100.0f)
+        return;
+
+    // last outcome is 'no drop' from the explicitly chanced entries
+    uint32 count = ExplicitlyChanced.size() + 1;
+    AliasChance.resize(count);
+    Alias.resize(count);
+
+    std::vector<float> scaled(count);
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        scaled[i] = ExplicitlyChanced[i].chance * count / 100.0f;
+    scaled[count - 1] = (100.0f - total) * count / 100.0f;
+
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < count; ++i)
+        (scaled[i] < 1.0f ? small : large).push_back(i);
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+        large.pop_back();
+
+        AliasChance[less] = scaled[less];
+        Alias[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0f;
+        (scaled[more] < 1.0f ? small : large).push_back(more);
+    }
+
+    // left over entries are 1.0 up to float rounding
+    for (uint32 i : large)
+    {
+        AliasChance[i] = 1.0f;
+        Alias[i] = i;
+    }
+    for (uint32 i : small)
+    {
+        AliasChance[i] = 1.0f;
+        Alias[i] = i;
+    }
+}
+
 //
 // --------- LootTemplate ---------
 //
@@ -2866,6 +3001,12 @@ bool LootTemplate::CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs)
     return true;
 }
 
+void LootTemplate::BuildAliasTables()
+{
+    for (auto& Group : Groups)
+        Group.BuildAliasTable();
+}
+
 void LoadLootTemplates_Creature()
 {
     LootIdSet ids_set, ids_setUsed;
@@ -275,11 +275,16 @@ class LootTemplate
 
                 void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
                 bool CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs);
+                void BuildAliasTable();                             // Precomputes the explicitly chanced roll (at loading stage)
 
             private:
                 LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
                 LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+                // Alias table over ExplicitlyChanced and a last 'no drop' outcome, empty when the entries can not be rolled with it
+                std::vector<float> AliasChance;
+                std::vector<uint32> Alias;
+
                 // Rolls an item from the group, returns nullptr if all miss their chances
                 LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const;
         };
@@ -301,6 +306,8 @@ class LootTemplate
         // Checks integrity of the template
         void Verify(LootStore const& lootstore, uint32 id) const;
         bool CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs);
+        // Precomputes group rolls once all entries are added
+        void BuildAliasTables();
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimized) processing, grouped entries go there
@@ -397,7 +404,7 @@ class Loot
     private:
         Loot(): m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(),
             m_clientLootType(), m_lootMethod(), m_threshold(), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false)
+            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootId(0)
         {}
         void Clear();
         bool IsLootedFor(Player const* player) const;
@@ -413,6 +420,7 @@ class Loot
         void SetGroupLootRight(Player* player);
         void GenerateMoneyLoot(uint32 minAmount, uint32 maxAmount);
         bool FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool personal, bool noEmptyError = false);
+        void FillPendingLoot(Player* looter);
         void ForceLootAnimationClientUpdate() const;
         void SetPlayerIsLooting(Player* player);
         void SetPlayerIsNotLooting(Player* player);
@@ -441,6 +449,8 @@ class Loot
         bool             m_isChest;                       // chest type object have special loot right
         bool             m_isChanged;                     // true if at least one item is looted
         bool             m_isFakeLoot;                    // nothing to loot but will sparkle for empty windows
+        uint32           m_pendingLootId;                 // creature loot id whose items are not rolled yet, rolled at first opening
+        ObjectGuid       m_pendingLootOwnerGuid;          // only allowed looter at death, pending items are rolled for this player
         GroupLootRollMap m_roll;                          // used if an item is under rolling
         GuidSet          m_playersLooting;                // player who opened loot windows
         GuidSet          m_playersOpened;                 // players that have released the corpse
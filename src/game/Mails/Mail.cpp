@@ -34,6 +34,7 @@
 #include "World/World.h"
 #include "Calendar/Calendar.h"
 #include "Loot/LootMgr.h"
+#include "Entities/PlayerLoginCache.h"
 
 /**
  * Creates a new MailSender object.
@@ -290,6 +291,9 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
     std::string safe_body = GetBody();
     CharacterDatabase.escape_string(safe_body);
 
+    if (!pReceiver)
+        sPlayerLoginCache.Invalidate(receiver.GetPlayerGuid());
+
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,body,has_items,expire_time,deliver_time,money,cod,checked) "
                                "VALUES ('%u', '%u', '%u', '%u', '%u', '%u', '%s', '%s', '%u', '" UI64FMTD "','" UI64FMTD "', '%u', '%u', '%u')",
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/CollisionQueryLog.h"
+#include "Log/Log.h"
+
+INSTANTIATE_SINGLETON_1(CollisionQueryLog);
+
+void CollisionQueryLog::Initialize(std::string const& fileName, uint32 rate)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_rate = rate ? rate : 1;
+
+    // keep recording into same file at config reload
+    if (fileName == m_fileName)
+        return;
+
+    m_enabled = false;
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+
+    m_fileName = fileName;
+    if (m_fileName.empty())
+        return;
+
+    m_file = fopen(m_fileName.c_str(), "wb");
+    if (!m_file)
+    {
+        sLog.outError("CollisionQueryLog: can not open %s for writing, queries are not recorded", m_fileName.c_str());
+        return;
+    }
+
+    uint32 magic = COLLISION_QUERY_LOG_MAGIC;
+    fwrite(&magic, sizeof(magic), 1, m_file);
+
+    sLog.outString("CollisionQueryLog: recording every %u. terrain, vmap and mmap query to %s", m_rate.load(), m_fileName.c_str());
+    m_enabled = true;
+}
+
+void CollisionQueryLog::Close()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_enabled = false;
+    m_fileName.clear();
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void CollisionQueryLog::Record(CollisionQueryType type, uint32 mapId, uint8 flags, float x1, float y1, float z1, float x2, float y2, float z2)
+{
+    if (m_counter.fetch_add(1, std::memory_order_relaxed) % m_rate.load(std::memory_order_relaxed))
+        return;
+
+    CollisionQueryRecord record;
+    record.type = uint8(type);
+    record.flags = flags;
+    record.unused = 0;
+    record.mapId = mapId;
+    record.start[0] = x1;
+    record.start[1] = y1;
+    record.start[2] = z1;
+    record.end[0] = x2;
+    record.end[1] = y2;
+    record.end[2] = z2;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_file)
+        fwrite(&record, sizeof(record), 1, m_file);
+}
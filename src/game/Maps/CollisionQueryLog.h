@@ -0,0 +1,80 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_COLLISIONQUERYLOG_H
+#define MANGOS_COLLISIONQUERYLOG_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <mutex>
+
+#define COLLISION_QUERY_LOG_MAGIC   0x314C5143              // "CQL1"
+
+enum CollisionQueryType
+{
+    COLLISION_QUERY_LOS         = 0,                        // start to end, flags: ignoreM2Model
+    COLLISION_QUERY_HEIGHT      = 1,                        // start, end.x: max search distance, flags: useVmaps
+    COLLISION_QUERY_LIQUID      = 2,                        // start, end.x: collision height, flags: required liquid type
+    COLLISION_QUERY_PATH        = 3,                        // start to end
+    MAX_COLLISION_QUERY_TYPE
+};
+
+#pragma pack(push, 1)
+/// One recorded query, file is a uint32 magic followed by records
+struct CollisionQueryRecord
+{
+    uint8 type;
+    uint8 flags;
+    uint16 unused;
+    uint32 mapId;
+    float start[3];
+    float end[3];
+};
+#pragma pack(pop)
+
+/**
+ * Records a sample of the terrain, vmap and mmap queries done by the maps, to be
+ * replayed by the collisionbench tool against the same extracted data.
+ */
+class CollisionQueryLog
+{
+    public:
+        CollisionQueryLog() : m_enabled(false), m_rate(1), m_counter(0), m_file(nullptr) {}
+        ~CollisionQueryLog() { Close(); }
+
+        // empty file name disables recording, every rate-th query is recorded
+        void Initialize(std::string const& fileName, uint32 rate);
+        void Close();
+
+        bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+        void Record(CollisionQueryType type, uint32 mapId, uint8 flags, float x1, float y1, float z1, float x2 = 0.0f, float y2 = 0.0f, float z2 = 0.0f);
+
+    private:
+        std::atomic<bool> m_enabled;
+        std::atomic<uint32> m_rate;
+        std::atomic<uint32> m_counter;
+        std::string m_fileName;
+        FILE* m_file;
+        std::mutex m_lock;
+};
+
+#define sCollisionQueryLog MaNGOS::Singleton<CollisionQueryLog>::Instance()
+
+#endif
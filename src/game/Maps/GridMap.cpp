@@ -23,6 +23,7 @@
 #include "Server/DBCEnums.h"
 #include "Server/DBCStores.h"
 #include "Maps/GridMap.h"
+#include "Maps/CollisionQueryLog.h"
 #include "Vmap/VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
 #include "World/World.h"
@@ -847,6 +848,9 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
+    if (sCollisionQueryLog.IsEnabled())
+        sCollisionQueryLog.Record(COLLISION_QUERY_HEIGHT, GetMapId(), useVmaps, x, y, z, maxSearchDist);
+
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
 
@@ -1103,6 +1107,9 @@ void TerrainInfo::GetZoneAndAreaId(uint32& zoneid, uint32& areaid, float x, floa
 
 GridMapLiquidStatus TerrainInfo::getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data, float collisionHeight) const
 {
+    if (sCollisionQueryLog.IsEnabled())
+        sCollisionQueryLog.Record(COLLISION_QUERY_LIQUID, GetMapId(), ReqLiquidType, x, y, z, collisionHeight);
+
     GridMapLiquidStatus result = LIQUID_MAP_NO_WATER;
     uint32 liquid_type = 0;
     float liquid_level = INVALID_HEIGHT_VALUE;
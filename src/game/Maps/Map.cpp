@@ -36,6 +36,8 @@
 #include "Server/DBCEnums.h"
 #include "Maps/MapPersistentStateMgr.h"
 #include "Vmap/VMapFactory.h"
+#include "Vmap/IVMapManager.h"
+#include "Maps/CollisionQueryLog.h"
 #include "MotionGenerators/MoveMap.h"
 #include "Calendar/Calendar.h"
 #include "Chat/Chat.h"
@@ -216,7 +218,7 @@ void Map::LoadMapAndVMap(int gx, int gy)
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_clientUpdateTimer(0),
-      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
+      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_reducedMovementRelay(false), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_defaultLight(GetDefaultMapLight(id)), m_spawnManager(*this),
@@ -270,6 +272,7 @@ void Map::InitVisibilityDistance()
 {
     // init visibility for continents
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
+    m_reducedMovementRelay = sWorld.getConfig(CONFIG_BOOL_MOVEMENT_RELAY_CONTINENTS);
 }
 
 // Template specialization of utility methods
@@ -290,6 +293,7 @@ template<>
 void Map::AddToGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    m_positionIndex.Add(obj, cell);
 }
 
 template<>
@@ -322,6 +326,7 @@ void Map::AddToGrid(Creature* obj, NGridType* grid, Cell const& cell)
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
         obj->SetCurrentCell(cell);
     }
+    m_positionIndex.Add(obj, cell);
 }
 
 template<class T>
@@ -334,6 +339,7 @@ template<>
 void Map::RemoveFromGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+    MapPositionIndex::Remove(obj);
 }
 
 template<>
@@ -364,6 +370,29 @@ void Map::RemoveFromGrid(Creature* obj, NGridType* grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<Creature>(obj);
     }
+    MapPositionIndex::Remove(obj);
+}
+
+void Map::GetUnitsInRange(float x, float y, float radius, uint32 typeMask, uint32 phaseMask, std::vector<WorldObject*>& result) const
+{
+    CellPair standing = MaNGOS::ComputeCellPair(x, y);
+    if (standing.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    // same cell range as Cell::Visit, grids not loaded are skipped like a no create visit does
+    float cellRadius = std::min(radius, MAX_VISIBILITY_DISTANCE);
+    CellArea area = Cell::CalculateCellArea(x, y, cellRadius);
+
+    for (uint32 cellX = area.low_bound.x_coord; cellX <= area.high_bound.x_coord; ++cellX)
+    {
+        for (uint32 cellY = area.low_bound.y_coord; cellY <= area.high_bound.y_coord; ++cellY)
+        {
+            if (!loaded(GridPair(cellX / MAX_NUMBER_OF_CELLS, cellY / MAX_NUMBER_OF_CELLS)))
+                continue;
+
+            m_positionIndex.FindInCell(cellX, cellY, x, y, radius, typeMask, phaseMask, result);
+        }
+    }
 }
 
 void Map::DeleteFromWorld(Player* pl)
@@ -733,6 +762,8 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
 
 void Map::Update(const uint32& t_diff)
 {
+    // per update temporaries (objects to update, client update data) are taken from the frame arena of this thread
+    FrameArenaScope frameScope;
 
 #ifdef BUILD_METRICS
     metric::duration<std::chrono::milliseconds> meas("map.update", {
@@ -1827,6 +1858,7 @@ void DungeonMap::InitVisibilityDistance()
 {
     // init visibility distance for instances
     m_VisibleDistance = World::GetMaxVisibleDistanceInInstances();
+    m_reducedMovementRelay = sWorld.getConfig(CONFIG_BOOL_MOVEMENT_RELAY_INSTANCES);
 }
 
 /*
@@ -2139,6 +2171,7 @@ void BattleGroundMap::InitVisibilityDistance()
 {
     // init visibility distance for BG/Arenas
     m_VisibleDistance = World::GetMaxVisibleDistanceInBGArenas();
+    m_reducedMovementRelay = sWorld.getConfig(CONFIG_BOOL_MOVEMENT_RELAY_BGARENAS);
 }
 
 bool BattleGroundMap::CanEnter(Player* player)
@@ -2269,22 +2302,36 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
         sa.HandleScriptStep();
 }
 
-/// Process queued scripts
+/// Process queued scripts, up to the configured time budget
 void Map::ScriptsProcess()
 {
     if (m_scriptSchedule.empty())
         return;
 
+    // steps are always timed for the stats, the budget only limits how many run
+    std::chrono::milliseconds budget(sWorld.getConfig(CONFIG_UINT32_MAP_SCRIPT_BUDGET));
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::vector<DBScriptStats::Step> steps;
+
     ///- Process overdue queued scripts
     ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
     // ok as multimap is a *sorted* associative container
     while (!m_scriptSchedule.empty() && (iter->first <= GetCurrentClockTime()))
     {
-        if (iter->second.HandleScriptStep())
+        const char* tableName = iter->second.GetTableName();
+        uint32 id = iter->second.GetId();
+
+        std::chrono::steady_clock::time_point stepStartTime = std::chrono::steady_clock::now();
+
+        bool terminated = iter->second.HandleScriptStep();
+
+        std::chrono::steady_clock::time_point stepEndTime = std::chrono::steady_clock::now();
+        uint32 stepTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(stepEndTime - stepStartTime).count());
+        steps.push_back({ tableName, id, stepTime });
+
+        if (terminated)
         {
             // Terminate following script steps of this script
-            const char* tableName = iter->second.GetTableName();
-            uint32 id = iter->second.GetId();
             ObjectGuid sourceGuid = iter->second.GetSourceGuid();
             ObjectGuid targetGuid = iter->second.GetTargetGuid();
             ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
@@ -2301,7 +2348,17 @@ void Map::ScriptsProcess()
             m_scriptSchedule.erase(iter);
 
         iter = m_scriptSchedule.begin();
+
+        // steps left are overdue at next update, so they run before the ones becoming due then
+        if (budget.count() && stepEndTime - startTime >= budget)
+        {
+            if (!m_scriptSchedule.empty() && iter->first <= GetCurrentClockTime())
+                DEBUG_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Map %u instance %u used up its script budget after %u steps, continuing next update", i_id, i_InstanceId, uint32(steps.size()));
+            break;
+        }
     }
+
+    sWorld.GetDBScriptStats().Add(steps);
 }
 
 /**
@@ -2697,10 +2754,26 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const
 {
+    if (sCollisionQueryLog.IsEnabled())
+        sCollisionQueryLog.Record(COLLISION_QUERY_LOS, GetId(), ignoreM2Model, srcX, srcY, srcZ, destX, destY, destZ);
+
     return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
            && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
 }
 
+/**
+ * Batched version of the line of sight check, queries already out of sight are not checked again
+ */
+void Map::IsInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count, uint32 phasemask, bool ignoreM2Model) const
+{
+    if (sCollisionQueryLog.IsEnabled())
+        for (uint32 i = 0; i < count; ++i)
+            sCollisionQueryLog.Record(COLLISION_QUERY_LOS, GetId(), ignoreM2Model, queries[i].x1, queries[i].y1, queries[i].z1, queries[i].x2, queries[i].y2, queries[i].z2);
+
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), queries, count, ignoreM2Model);
+    m_dyn_tree.isInLineOfSight(queries, count, phasemask, ignoreM2Model);
+}
+
 /**
  * get the hit position and return true if we hit something (in this case the dest position will hold the hit-position)
  * otherwise the result pos will be the dest pos
@@ -38,6 +38,7 @@
 #include "Globals/GraveyardManager.h"
 #include "Maps/SpawnManager.h"
 #include "Maps/MapDataContainer.h"
+#include "Maps/MapPositionIndex.h"
 #include "World/WorldStateVariableManager.h"
 
 #include <bitset>
@@ -172,6 +173,8 @@ class Map : public GridRefManager<NGridType>
         float GetVisibilityDistance() const { return m_VisibleDistance; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
+        // movement of far units is relayed to players at reduced rate
+        bool HasReducedMovementRelay() const { return m_reducedMovementRelay; }
 
         void PlayerRelocation(Player*, float x, float y, float z, float orientation);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float ang);
@@ -180,6 +183,9 @@ class Map : public GridRefManager<NGridType>
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
+        // units of loaded grids within radius (2d, plus their combat reach) of x, y, visiting the cells Cell::VisitAllObjects does
+        void GetUnitsInRange(float x, float y, float radius, uint32 typeMask, uint32 phaseMask, std::vector<WorldObject*>& result) const;
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridPair p = MaNGOS::ComputeGridPair(x, y);
@@ -354,6 +360,7 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(uint32 phasemask, float x, float y, float z, bool swim = false) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const;
+        void IsInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count, uint32 phasemask, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -482,6 +489,7 @@ class Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         uint32 m_clientUpdateTimer;
         float m_VisibleDistance;
+        bool m_reducedMovementRelay;
         MapPersistentState* m_persistentState;
 
         MapRefManager m_mapRefManager;
@@ -514,6 +522,8 @@ class Map : public GridRefManager<NGridType>
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
+        MapPositionIndex m_positionIndex;                   // players and creatures of the grid cells
+
         WorldObjectSet i_objectsToRemove;
 
         typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
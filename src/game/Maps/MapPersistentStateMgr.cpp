@@ -34,6 +34,7 @@
 #include "Maps/InstanceData.h"
 #include "Util/ProgressBar.h"
 #include "Util/Util.h"
+#include "Entities/PlayerLoginCache.h"
 
 INSTANTIATE_SINGLETON_1(MapPersistentStateManager);
 
@@ -738,6 +739,9 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
         CharacterDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instanceid);
         CharacterDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instanceid);
         CharacterDatabase.CommitTransaction();
+
+        // binds of offline characters are deleted too
+        sPlayerLoginCache.InvalidateAll();
     }
 }
 
@@ -1024,6 +1028,7 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficu
         CharacterDatabase.PExecute("UPDATE instance_reset SET resettime = '" UI64FMTD "' WHERE mapid = '%u' AND difficulty = '%u'", (uint64)next_reset, mapid, difficulty);
         // decrement extension state
         CharacterDatabase.PExecute("UPDATE character_instance LEFT JOIN instance ON character_instance.instance = id SET ExtendState=ExtendState-1 WHERE map = '%u'", mapid);
+        sPlayerLoginCache.InvalidateAll();
         return;
     }
 
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapPositionIndex.h"
+#include "Maps/GridDefines.h"
+#include "Grids/Cell.h"
+#include "Entities/Object.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAP_POSITION_INDEX_SSE
+#include <emmintrin.h>
+#endif
+
+MapPositionIndex::~MapPositionIndex()
+{
+    // objects outliving the map must not point into it anymore
+    for (auto& itr : m_cells)
+        for (WorldObject* obj : itr.second.objects)
+            obj->m_positionIndexEntry.cell = nullptr;
+}
+
+void MapPositionIndex::Add(WorldObject* obj, Cell const& cell)
+{
+    Remove(obj);
+
+    uint32 x, y;
+    cell.Compute(x, y);
+    CellData& data = m_cells[y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x];
+
+    Entry& entry = obj->m_positionIndexEntry;
+    entry.cell = &data;
+    entry.slot = data.objects.size();
+
+    data.x.push_back(obj->GetPositionX());
+    data.y.push_back(obj->GetPositionY());
+    data.reach.push_back(obj->GetCombatReach());
+    data.typeMask.push_back(obj->GetTypeMask());
+    data.phaseMask.push_back(obj->GetPhaseMask());
+    data.objects.push_back(obj);
+}
+
+void MapPositionIndex::Remove(WorldObject* obj)
+{
+    Entry& entry = obj->m_positionIndexEntry;
+    if (!entry.cell)
+        return;
+
+    CellData& data = *entry.cell;
+    uint32 last = data.objects.size() - 1;
+    if (entry.slot != last)
+    {
+        // move the last object into the freed slot
+        uint32 slot = entry.slot;
+        data.x[slot] = data.x[last];
+        data.y[slot] = data.y[last];
+        data.reach[slot] = data.reach[last];
+        data.typeMask[slot] = data.typeMask[last];
+        data.phaseMask[slot] = data.phaseMask[last];
+        data.objects[slot] = data.objects[last];
+        data.objects[slot]->m_positionIndexEntry.slot = slot;
+    }
+
+    data.x.pop_back();
+    data.y.pop_back();
+    data.reach.pop_back();
+    data.typeMask.pop_back();
+    data.phaseMask.pop_back();
+    data.objects.pop_back();
+
+    entry.cell = nullptr;
+    entry.slot = 0;
+}
+
+void MapPositionIndex::Update(WorldObject* obj)
+{
+    Entry const& entry = obj->m_positionIndexEntry;
+    if (!entry.cell)
+        return;
+
+    CellData& data = *entry.cell;
+    data.x[entry.slot] = obj->GetPositionX();
+    data.y[entry.slot] = obj->GetPositionY();
+    data.reach[entry.slot] = obj->GetCombatReach();
+    data.phaseMask[entry.slot] = obj->GetPhaseMask();
+}
+
+void MapPositionIndex::FindInCell(uint32 cellX, uint32 cellY, float x, float y, float radius, uint32 typeMask, uint32 phaseMask, std::vector<WorldObject*>& result) const
+{
+    auto itr = m_cells.find(cellY * TOTAL_NUMBER_OF_CELLS_PER_MAP + cellX);
+    if (itr == m_cells.end())
+        return;
+
+    CellData const& data = itr->second;
+    uint32 count = data.objects.size();
+    uint32 i = 0;
+
+#ifdef MAP_POSITION_INDEX_SSE
+    __m128 const centerX = _mm_set1_ps(x);
+    __m128 const centerY = _mm_set1_ps(y);
+    __m128 const range = _mm_set1_ps(radius);
+    __m128i const types = _mm_set1_epi32(int32(typeMask));
+    __m128i const phases = _mm_set1_epi32(int32(phaseMask));
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const anyPhase = phaseMask ? zero : _mm_set1_epi32(-1);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&data.x[i]), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&data.y[i]), centerY);
+        __m128 dist = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 maxDist = _mm_add_ps(range, _mm_loadu_ps(&data.reach[i]));
+        __m128 inRange = _mm_cmple_ps(dist, _mm_mul_ps(maxDist, maxDist));
+
+        // lanes with no common type or phase bit compare equal to zero
+        __m128i typeMiss = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&data.typeMask[i])), types), zero);
+        __m128i phaseMiss = _mm_andnot_si128(anyPhase, _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&data.phaseMask[i])), phases), zero));
+        __m128 miss = _mm_castsi128_ps(_mm_or_si128(typeMiss, phaseMiss));
+
+        uint32 bits = uint32(_mm_movemask_ps(_mm_andnot_ps(miss, inRange)));
+        for (uint32 lane = 0; bits; ++lane, bits >>= 1)
+            if (bits & 1)
+                result.push_back(data.objects[i + lane]);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (!(data.typeMask[i] & typeMask) || (phaseMask && !(data.phaseMask[i] & phaseMask)))
+            continue;
+
+        float dx = data.x[i] - x;
+        float dy = data.y[i] - y;
+        float maxDist = radius + data.reach[i];
+        if (dx * dx + dy * dy <= maxDist * maxDist)
+            result.push_back(data.objects[i]);
+    }
+}
@@ -67,6 +67,7 @@ class GridCrawler : public Worker
 
         void execute() override
         {
+            FrameArenaScope frameScope;
             WorldObjectUnSet objToUpdate;
             MaNGOS::ObjectUpdater obj_updater(objToUpdate, m_diff);
             TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
@@ -91,7 +92,7 @@ class GridCrawler : public Worker
 class ObjectUpdateWorker : public Worker
 {
     public:
-        ObjectUpdateWorker(std::unordered_set<WorldObject*>& objects, uint32 diff, MapUpdater& updater) :
+        ObjectUpdateWorker(WorldObjectUnSet& objects, uint32 diff, MapUpdater& updater) :
             Worker(updater), m_objects(objects), m_diff(diff)
         {}
 
@@ -104,7 +105,7 @@ class ObjectUpdateWorker : public Worker
         }
 
     private:
-        std::unordered_set<WorldObject*>& m_objects;
+        WorldObjectUnSet& m_objects;
         uint32 m_diff;
 };
 
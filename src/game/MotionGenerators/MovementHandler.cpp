@@ -379,7 +379,7 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
     WorldPacket data(opcode, recv_data.size());
     data << mover->GetPackGUID();             // write guid
     movementInfo.Write(data);                               // write data
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
@@ -411,7 +411,7 @@ void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
         data << guid.WriteAsPacked();
         data << movementInfo;
         data << newspeed; // new collision height
-        mover->SendMessageToSetExcept(data, _player);
+        mover->SendMovementMessageToSetExcept(data, _player);
         return;
     }
 
@@ -449,7 +449,7 @@ void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
     data << guid.WriteAsPacked();
     data << movementInfo;
     data << newspeed;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 
     // skip all forced speed changes except last and unexpected
     // in run/mounted case used one ACK and it must be skipped.m_forced_speed_changes[MOVE_RUN} store both.
@@ -565,7 +565,7 @@ void WorldSession::HandleMoveKnockBackAck(WorldPacket& recv_data)
     data << movementInfo.jump.sinAngle;
     data << movementInfo.jump.xyspeed;
     data << movementInfo.jump.zspeed;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::SendKnockBack(Unit* who, float angle, float horizontalSpeed, float verticalSpeed)
@@ -622,7 +622,7 @@ void WorldSession::HandleMoveFlagChangeOpcode(WorldPacket& recv_data)
     WorldPacket data(response, 8);
     data << guid.WriteAsPacked();
     data << movementInfo;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleMoveRootAck(WorldPacket& recv_data)
@@ -660,7 +660,7 @@ void WorldSession::HandleMoveRootAck(WorldPacket& recv_data)
     WorldPacket data(recv_data.GetOpcode() == CMSG_FORCE_MOVE_UNROOT_ACK ? MSG_MOVE_UNROOT : MSG_MOVE_ROOT);
     data << guid.WriteAsPacked();
     data << movementInfo;
-    mover->SendMessageToSetExcept(data, _player);
+    mover->SendMovementMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleSummonResponseOpcode(WorldPacket& recv_data)
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/MovementRelay.h"
+#include "Entities/Player.h"
+#include "Server/Opcodes.h"
+#include "World/World.h"
+
+bool MovementRelay::IsCoalescable(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case MSG_MOVE_HEARTBEAT:
+        case MSG_MOVE_SET_FACING:
+        case MSG_MOVE_SET_PITCH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MovementRelay::IsMovementOpcode(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case MSG_MOVE_HEARTBEAT:
+        case MSG_MOVE_SET_FACING:
+        case MSG_MOVE_SET_PITCH:
+        case MSG_MOVE_STOP:
+        case MSG_MOVE_TELEPORT:
+        case MSG_MOVE_KNOCK_BACK:
+        case SMSG_MONSTER_MOVE:
+        case SMSG_MONSTER_MOVE_TRANSPORT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32 MovementRelay::GetRelayInterval(WorldObject const* viewPoint, WorldObject const* mover)
+{
+    float dx = viewPoint->GetPositionX() - mover->GetPositionX();
+    float dy = viewPoint->GetPositionY() - mover->GetPositionY();
+    float distSq = dx * dx + dy * dy;
+
+    float nearDist = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_RELAY_NEAR_DISTANCE);
+    if (distSq <= nearDist * nearDist)
+        return 0;
+
+    float farDist = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_RELAY_FAR_DISTANCE);
+    if (distSq <= farDist * farDist)
+        return sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_MID_INTERVAL);
+
+    return sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_FAR_INTERVAL);
+}
+
+void MovementRelay::Relay(Player* observer, WorldObject const* viewPoint, WorldObject const* mover, WorldPacket const& data)
+{
+    WorldSession* session = observer->GetSession();
+    if (!session)
+        return;
+
+    // near units are checked first, they need no lookup of the mover
+    // a kept packet of the mover is older than this one, Update drops it as the mover message count changed
+    uint32 interval = IsCoalescable(data.GetOpcode()) ? GetRelayInterval(viewPoint, mover) : 0;
+    if (!interval)
+    {
+        session->SendPacket(data);
+        return;
+    }
+
+    uint32 now = WorldTimer::getMSTime();
+    auto itr = m_movers.find(mover->GetObjectGuid());
+    if (itr == m_movers.end())
+    {
+        MoverState& state = m_movers[mover->GetObjectGuid()];
+        state.lastSentTime = now;
+        state.interval = interval;
+        state.pending = false;
+        session->SendPacket(data);
+        return;
+    }
+
+    MoverState& state = itr->second;
+    state.interval = interval;
+    if (WorldTimer::getMSTimeDiff(state.lastSentTime, now) >= interval)
+    {
+        state.lastSentTime = now;
+        state.pending = false;
+        session->SendPacket(data);
+    }
+    else
+    {
+        state.packet = data;
+        state.pending = true;
+        state.moverMessageCount = mover->GetMovementMessageCount();
+    }
+}
+
+void MovementRelay::Update(Player* observer)
+{
+    if (m_movers.empty())
+        return;
+
+    uint32 now = WorldTimer::getMSTime();
+    for (auto itr = m_movers.begin(); itr != m_movers.end();)
+    {
+        MoverState& state = itr->second;
+        if (WorldTimer::getMSTimeDiff(state.lastSentTime, now) < state.interval)
+        {
+            ++itr;
+            continue;
+        }
+
+        // nothing relayed within interval, next packet of the unit is sent at once
+        if (!state.pending)
+        {
+            itr = m_movers.erase(itr);
+            continue;
+        }
+
+        // not sent if the unit sent another movement packet since, that position is newer
+        if (observer->HasAtClient(itr->first))
+        {
+            WorldObject const* mover = observer->GetMap()->GetWorldObject(itr->first);
+            if (mover && mover->GetMovementMessageCount() == state.moverMessageCount)
+                observer->GetSession()->SendPacket(state.packet);
+        }
+
+        state.lastSentTime = now;
+        state.pending = false;
+        ++itr;
+    }
+}
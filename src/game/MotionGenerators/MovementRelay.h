@@ -0,0 +1,68 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MOVEMENTRELAY_H
+#define MANGOS_MOVEMENTRELAY_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+#include "Server/WorldPacket.h"
+
+#include <unordered_map>
+
+class Player;
+class WorldObject;
+
+/**
+ * Relay of movement packets of other units to one player.
+ *
+ * Heartbeat, facing and pitch packets of units farther than the near distance
+ * from the player view point are sent at most once per mid/far interval; the
+ * latest skipped one is kept and sent from player update once the interval passed.
+ * Any other movement packet is sent at once without looking up the unit. The kept one
+ * is then not sent, as every packet relayed through SendMovementMessageToSetExcept and
+ * every other movement packet of the unit (spline, knock back, teleport) is counted by
+ * WorldObject::GetMovementMessageCount.
+ */
+class MovementRelay
+{
+    public:
+        void Relay(Player* observer, WorldObject const* viewPoint, WorldObject const* mover, WorldPacket const& data);
+        void Update(Player* observer);
+        void Clear() { m_movers.clear(); }
+
+        // packets carrying a position of the unit sent outside of the relay
+        static bool IsMovementOpcode(uint16 opcode);
+
+    private:
+        struct MoverState
+        {
+            uint32 lastSentTime;
+            uint32 interval;
+            bool pending;
+            uint32 moverMessageCount;                       // of the mover when packet was kept
+            WorldPacket packet;
+        };
+
+        static bool IsCoalescable(uint16 opcode);
+        static uint32 GetRelayInterval(WorldObject const* viewPoint, WorldObject const* mover);
+
+        std::unordered_map<ObjectGuid, MoverState> m_movers;    // only units with far movement relayed recently
+};
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "MotionGenerators/MoveMap.h"
 #include "Maps/GridMap.h"
+#include "Maps/CollisionQueryLog.h"
 #include "Entities/Creature.h"
 #include "MotionGenerators/PathFinder.h"
 #include "Log/Log.h"
@@ -106,6 +107,10 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
     //if (GenericTransport* transport = m_sourceUnit->GetTransport())
     //    transport->CalculatePassengerOffset(dest.x, dest.y, dest.z, nullptr);
 
+    // paths on transport use the transport model navmesh, not replayable from map data
+    if (sCollisionQueryLog.IsEnabled() && !m_sourceUnit->GetTransport())
+        sCollisionQueryLog.Record(COLLISION_QUERY_PATH, m_sourceUnit->GetMapId(), 0, start.x, start.y, start.z, dest.x, dest.y, dest.z);
+
     setStartPosition(start);
 
     setEndPosition(dest);
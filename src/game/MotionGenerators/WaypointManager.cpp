@@ -195,77 +195,92 @@ void WaypointManager::Load()
         }
         while (result->NextRow());
 
-        //                                   0   1      2          3          4          5            6         7
-        result = WorldDatabase.Query("SELECT Id, Point, PositionX, PositionY, PositionZ, Orientation, WaitTime, ScriptId FROM creature_movement");
+        // streamed, node count is already known from the query above
+        //                                           0   1      2          3          4          5            6         7
+        result = WorldDatabase.QueryStreamed("SELECT Id, Point, PositionX, PositionY, PositionZ, Orientation, WaitTime, ScriptId FROM creature_movement", true);
 
-        BarGoLink bar(result->GetRowCount());
+        BarGoLink bar(total_nodes);
 
         // error after load, we check if creature guid corresponding to the path id has proper MovementType
         std::set<uint32> creatureNoMoveType;
         std::set<uint32> blacklistWaypoints;
 
-        do
+        // rows can be gone since the count query
+        if (result && !result->IsFailed())
         {
-            bar.step();
-            Field* fields = result->Fetch();
-
-            uint32 id           = fields[0].GetUInt32();
-            uint32 point        = fields[1].GetUInt32();
-
-            // sanitize waypoints
-            if (point == 0)
+            do
             {
-                blacklistWaypoints.insert(id);
-                sLog.outErrorDb("Table `creature_movement` has invalid point 0 for id %u. Skipping.", id);
-            }
+                bar.step();
+                Field* fields = result->Fetch();
 
-            const CreatureData* cData = sObjectMgr.GetCreatureData(id);
+                uint32 id           = fields[0].GetUInt32();
+                uint32 point        = fields[1].GetUInt32();
 
-            if (!cData)
-            {
-                sLog.outErrorDb("Table creature_movement contain path for creature guid %u, but this creature guid does not exist. Skipping.", id);
-                continue;
-            }
+                // sanitize waypoints
+                if (point == 0)
+                {
+                    blacklistWaypoints.insert(id);
+                    sLog.outErrorDb("Table `creature_movement` has invalid point 0 for id %u. Skipping.", id);
+                }
 
-            if (cData->movementType != WAYPOINT_MOTION_TYPE && cData->movementType != LINEAR_WP_MOTION_TYPE)
-                creatureNoMoveType.insert(id);
+                const CreatureData* cData = sObjectMgr.GetCreatureData(id);
 
-            WaypointPath& path  = m_pathMap[id];
-            WaypointNode& node  = path[point];
+                if (!cData)
+                {
+                    sLog.outErrorDb("Table creature_movement contain path for creature guid %u, but this creature guid does not exist. Skipping.", id);
+                    continue;
+                }
 
-            node.x              = fields[2].GetFloat();
-            node.y              = fields[3].GetFloat();
-            node.z              = fields[4].GetFloat();
-            node.orientation    = fields[5].GetFloat();
-            node.delay          = fields[6].GetUInt32();
-            node.script_id      = fields[7].GetUInt32();
+                if (cData->movementType != WAYPOINT_MOTION_TYPE && cData->movementType != LINEAR_WP_MOTION_TYPE)
+                    creatureNoMoveType.insert(id);
 
-            // prevent using invalid coordinates
-            if (!MaNGOS::IsValidMapCoord(node.x, node.y, node.z, node.orientation))
-            {
-                auto queryResult1 = WorldDatabase.PQuery("SELECT id, map FROM creature WHERE guid = '%u'", id);
-                if (queryResult1)
-                    sLog.outErrorDb("Creature (guidlow %d, entry %d) have invalid coordinates in his waypoint %d (X: %f, Y: %f).",
-                                    id, queryResult1->Fetch()[0].GetUInt32(), point, node.x, node.y);
-                else
-                    sLog.outErrorDb("Waypoint path %d, have invalid coordinates in his waypoint %d (X: %f, Y: %f).",
-                                    id, point, node.x, node.y);
+                WaypointPath& path  = m_pathMap[id];
+                WaypointNode& node  = path[point];
 
-                MaNGOS::NormalizeMapCoord(node.x);
-                MaNGOS::NormalizeMapCoord(node.y);
+                node.x              = fields[2].GetFloat();
+                node.y              = fields[3].GetFloat();
+                node.z              = fields[4].GetFloat();
+                node.orientation    = fields[5].GetFloat();
+                node.delay          = fields[6].GetUInt32();
+                node.script_id      = fields[7].GetUInt32();
 
-                if (queryResult1)
+                // prevent using invalid coordinates
+                if (!MaNGOS::IsValidMapCoord(node.x, node.y, node.z, node.orientation))
                 {
-                    node.z = sTerrainMgr.LoadTerrain(queryResult1->Fetch()[1].GetUInt32())->GetHeightStatic(node.x, node.y, node.z);
+                    auto queryResult1 = WorldDatabase.PQuery("SELECT id, map FROM creature WHERE guid = '%u'", id);
+                    if (queryResult1)
+                        sLog.outErrorDb("Creature (guidlow %d, entry %d) have invalid coordinates in his waypoint %d (X: %f, Y: %f).",
+                                        id, queryResult1->Fetch()[0].GetUInt32(), point, node.x, node.y);
+                    else
+                        sLog.outErrorDb("Waypoint path %d, have invalid coordinates in his waypoint %d (X: %f, Y: %f).",
+                                        id, point, node.x, node.y);
+
+                    MaNGOS::NormalizeMapCoord(node.x);
+                    MaNGOS::NormalizeMapCoord(node.y);
+
+                    if (queryResult1)
+                    {
+                        node.z = sTerrainMgr.LoadTerrain(queryResult1->Fetch()[1].GetUInt32())->GetHeightStatic(node.x, node.y, node.z);
+                    }
+
+                    WorldDatabase.PExecute("UPDATE creature_movement SET PositionX = '%f', PositionY = '%f', PositionZ = '%f' WHERE Id = '%u' AND Point = '%u'", node.x, node.y, node.z, id, point);
                 }
 
-                WorldDatabase.PExecute("UPDATE creature_movement SET PositionX = '%f', PositionY = '%f', PositionZ = '%f' WHERE Id = '%u' AND Point = '%u'", node.x, node.y, node.z, id, point);
+                if (node.script_id)
+                    CheckDbscript(node, id, point, movementScriptSet, "creature_movement");
             }
+            while (result->NextRow());
+        }
 
-            if (node.script_id)
-                CheckDbscript(node, id, point, movementScriptSet, "creature_movement");
+        // no partial paths are kept
+        if (result && result->IsFailed())
+        {
+            sLog.outError("Loading of table `creature_movement` was interrupted by a DB error, no paths loaded from it.");
+            m_pathMap.clear();
+            creatureNoMoveType.clear();
+            total_paths = 0;
+            total_nodes = 0;
         }
-        while (result->NextRow());
 
         // sanitize waypoints
         for (uint32 itr : blacklistWaypoints)
@@ -347,8 +347,8 @@ uint32 PlayerbotAI::initSpell(uint32 spellId)
         return 0;
 
     uint32 next = 0;
-    SpellChainMapNext const& nextMap = sSpellMgr.GetSpellChainNext();
-    for (SpellChainMapNext::const_iterator itr = nextMap.lower_bound(spellId); itr != nextMap.upper_bound(spellId); ++itr)
+    SpellChainMapNextBounds nextBounds = sSpellMgr.GetSpellChainNextBounds(spellId);
+    for (SpellChainNextTable::const_iterator itr = nextBounds.first; itr != nextBounds.second; ++itr)
     {
         SpellChainNode const* node = sSpellMgr.GetSpellChainNode(itr->second);
         // If next spell is a requirement for this one then skip it
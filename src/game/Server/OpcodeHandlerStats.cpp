@@ -0,0 +1,121 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/OpcodeHandlerStats.h"
+#include "Server/Opcodes.h"
+
+#include <algorithm>
+
+OpcodeHandlerStats::OpcodeHandlerStats()
+{
+    for (auto& histograms : m_histograms)
+    {
+        histograms.reset(new Histogram[NUM_MSG_TYPES]);
+        for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        {
+            for (auto& bucket : histograms[i].buckets)
+                bucket.store(0, std::memory_order_relaxed);
+            histograms[i].totalTime.store(0, std::memory_order_relaxed);
+            histograms[i].maxTime.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint32 OpcodeHandlerStats::GetBucket(uint32 time)
+{
+    // bucket n holds [2^(n-1), 2^n) us, bucket 0 holds 0 us
+    uint32 bucket = 0;
+    while (time && bucket < BUCKET_COUNT - 1)
+    {
+        time >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint32 OpcodeHandlerStats::GetBucketLimit(uint32 bucket)
+{
+    return bucket ? (1u << bucket) - 1 : 0;
+}
+
+void OpcodeHandlerStats::Add(uint16 opcode, OpcodeHandlerThread thread, uint32 time)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    Histogram& histogram = m_histograms[thread][opcode];
+    histogram.buckets[GetBucket(time)].fetch_add(1, std::memory_order_relaxed);
+    histogram.totalTime.fetch_add(time, std::memory_order_relaxed);
+
+    uint32 maxTime = histogram.maxTime.load(std::memory_order_relaxed);
+    while (time > maxTime && !histogram.maxTime.compare_exchange_weak(maxTime, time, std::memory_order_relaxed)) {}
+}
+
+std::vector<OpcodeHandlerStats::Summary> OpcodeHandlerStats::GetSummary(OpcodeHandlerThread thread, bool reset)
+{
+    std::vector<Summary> result;
+
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        Histogram& histogram = m_histograms[thread][opcode];
+
+        uint32 buckets[BUCKET_COUNT];
+        uint64 count = 0;
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+        {
+            buckets[i] = reset ? histogram.buckets[i].exchange(0, std::memory_order_relaxed) : histogram.buckets[i].load(std::memory_order_relaxed);
+            count += buckets[i];
+        }
+
+        uint64 totalTime = reset ? histogram.totalTime.exchange(0, std::memory_order_relaxed) : histogram.totalTime.load(std::memory_order_relaxed);
+        uint32 maxTime = reset ? histogram.maxTime.exchange(0, std::memory_order_relaxed) : histogram.maxTime.load(std::memory_order_relaxed);
+
+        if (!count)
+            continue;
+
+        Summary summary;
+        summary.opcode = uint16(opcode);
+        summary.count = count;
+        summary.totalTime = totalTime;
+        summary.maxTime = maxTime;
+        summary.p50 = 0;
+        summary.p99 = 0;
+
+        uint64 seen = 0;
+        bool p50Done = false;
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+        {
+            seen += buckets[i];
+            if (!p50Done && seen * 2 >= count)
+            {
+                summary.p50 = std::min(GetBucketLimit(i), maxTime);
+                p50Done = true;
+            }
+            if (seen * 100 >= count * 99)
+            {
+                summary.p99 = std::min(GetBucketLimit(i), maxTime);
+                break;
+            }
+        }
+
+        result.push_back(summary);
+    }
+
+    std::sort(result.begin(), result.end(), [](Summary const& a, Summary const& b) { return a.totalTime > b.totalTime; });
+    return result;
+}
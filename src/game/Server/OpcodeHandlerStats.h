@@ -0,0 +1,80 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OPCODEHANDLERSTATS_H
+#define MANGOS_OPCODEHANDLERSTATS_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// Thread a packet handler was executed in
+enum OpcodeHandlerThread
+{
+    OPCODE_THREAD_WORLD     = 0,                            // WorldSession::Update, world update
+    OPCODE_THREAD_MAP       = 1,                            // WorldSession::UpdateMap, map update threads
+    OPCODE_THREAD_NETWORK   = 2,                            // PROCESS_IMMEDIATE handlers in network threads
+};
+
+#define MAX_OPCODE_HANDLER_THREAD 3
+
+/**
+ * Execution time histograms of packet handlers per opcode and dispatching thread.
+ *
+ * Buckets are powers of two of microseconds, updated with relaxed atomics so map
+ * threads can record without locking. Percentiles are upper bounds of their bucket.
+ */
+class OpcodeHandlerStats
+{
+    public:
+        static uint32 const BUCKET_COUNT = 25;              // last bucket holds everything >= 2^23 us (~8s)
+
+        struct Summary
+        {
+            uint16 opcode;
+            uint64 count;
+            uint64 totalTime;                               // us
+            uint32 maxTime;                                 // us
+            uint32 p50;                                     // us
+            uint32 p99;                                     // us
+        };
+
+        OpcodeHandlerStats();
+
+        void Add(uint16 opcode, OpcodeHandlerThread thread, uint32 time);
+
+        // opcodes with at least one handler call since last reset, sorted by total time
+        std::vector<Summary> GetSummary(OpcodeHandlerThread thread, bool reset);
+
+    private:
+        struct Histogram
+        {
+            std::atomic<uint32> buckets[BUCKET_COUNT];
+            std::atomic<uint64> totalTime;
+            std::atomic<uint32> maxTime;
+        };
+
+        static uint32 GetBucket(uint32 time);
+        static uint32 GetBucketLimit(uint32 bucket);
+
+        std::unique_ptr<Histogram[]> m_histograms[MAX_OPCODE_HANDLER_THREAD];
+};
+
+#endif
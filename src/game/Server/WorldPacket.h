@@ -49,6 +49,10 @@ class WorldPacket : public ByteBuffer
         std::chrono::steady_clock::time_point GetReceivedTime() const { return m_receivedTime; }
         void SetReceivedTime(std::chrono::steady_clock::time_point receivedTime) { m_receivedTime = receivedTime; }
 
+        // queued packets are allocated and freed by the million, take them from the packet buffer pool too
+        static void* operator new(size_t size) { return BufferPool::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { BufferPool::Deallocate(ptr, size); }
+
     private:
         Opcodes m_opcode;
         std::chrono::steady_clock::time_point m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
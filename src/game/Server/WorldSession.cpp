@@ -41,11 +41,13 @@
 #include "GMTickets/GMTicketMgr.h"
 #include "Loot/LootMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/PlayerLoginCache.h"
 
 #include <boost/asio/ip/address_v4.hpp>
 
 #include <mutex>
 #include <deque>
+#include <chrono>
 #include <cstdarg>
 #include <iostream>
 
@@ -261,14 +263,7 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
     OpcodeHandler const& opHandle = opcodeTable[new_packet->GetOpcode()];
     if (opHandle.packetProcessing == PROCESS_IMMEDIATE)
     {
-        try
-        {
-            (this->*opHandle.handler)(*new_packet);
-        }
-        catch (const ByteBufferException&)
-        {
-            ProcessByteBufferException(*new_packet);
-        }
+        CallOpcodeHandler(opHandle, *new_packet, OPCODE_THREAD_NETWORK);
 
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
@@ -568,7 +563,7 @@ void WorldSession::UpdateMap(uint32 diff)
         
         if (opHandle.status == STATUS_LOGGEDIN)
         {
-            ExecuteOpcode(opHandle, *packet);
+            ExecuteOpcode(opHandle, *packet, OPCODE_THREAD_MAP);
         }
     }
 }
@@ -644,7 +639,10 @@ void WorldSession::LogoutPlayer()
             if (BattleGroundQueueTypeId bgQueueTypeId = _player->GetBattleGroundQueueTypeId(i))
             {
                 _player->RemoveBattleGroundQueueId(bgQueueTypeId);
-                sBattleGroundMgr.m_battleGroundQueues[ bgQueueTypeId ].RemovePlayer(_player->GetObjectGuid(), true);
+                sWorld.GetBGQueue().GetMessager().AddMessage([guid = _player->GetObjectGuid(), bgQueueTypeId](BattleGroundQueue* queue)
+                {
+                    queue->GetQueueItem(bgQueueTypeId).RemovePlayer(*queue, guid, true);
+                });
             }
         }
 
@@ -724,6 +722,10 @@ void WorldSession::LogoutPlayer()
         uint32 guid = _player->GetGUIDLow();
 #endif
 
+        ObjectGuid playerGuid = _player->GetObjectGuid();
+        // not a logout request of the client or a kick
+        bool connectionLost = !m_Socket || m_Socket->IsClosed();
+
         ///- Remove the player from the world
         // the player may not be in the world when logging out
         // e.g if he got disconnected during a transfer to another map
@@ -763,6 +765,10 @@ void WorldSession::LogoutPlayer()
         stmt.PExecute(GetAccountId());
 #endif
 
+        // read back after all queued saves, only after a lost connection where a reconnect is likely
+        if (m_playerSave && connectionLost)
+            sPlayerLoginCache.Prefetch(playerGuid, GetAccountId());
+
         DEBUG_LOG("SESSION: Sent SMSG_LOGOUT_COMPLETE Message");
     }
 
@@ -1160,12 +1166,14 @@ void WorldSession::SendRedirectClient(std::string& ip, uint16 port) const
     SendPacket(pkt);
 }
 
-void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
+void WorldSession::CallOpcodeHandler(OpcodeHandler const& opHandle, WorldPacket& packet, OpcodeHandlerThread thread)
 {
-    // need prevent do internal far teleports in handlers because some handlers do lot steps
-    // or call code that can do far teleports in some conditions unexpectedly for generic way work code
-    if (_player)
-        _player->SetCanDelayTeleport(true);
+    uint32 const slowTime = sWorld.getConfig(CONFIG_UINT32_SLOW_PACKET_HANDLER_TIME);
+    bool const collectStats = sWorld.getConfig(CONFIG_BOOL_PACKET_HANDLER_STATS);
+
+    std::chrono::steady_clock::time_point start;
+    if (collectStats || slowTime)
+        start = std::chrono::steady_clock::now();
 
     try
     {
@@ -1176,6 +1184,32 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
         ProcessByteBufferException(packet);
     }
 
+    if (!collectStats && !slowTime)
+        return;
+
+    uint32 const time = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    if (collectStats)
+        sWorld.GetOpcodeHandlerStats().Add(packet.GetOpcode(), thread, time);
+
+    if (slowTime && time >= slowTime * IN_MILLISECONDS)
+    {
+        static char const* threadNames[MAX_OPCODE_HANDLER_THREAD] = { "world", "map", "network" };
+        sLog.outString("SESSION: Slow handler of opcode %s (0x%.4X) took %u us in %s thread, packet size %u, account %u, player %s, address %s",
+                       packet.GetOpcodeName(), packet.GetOpcode(), time, threadNames[thread], uint32(packet.size()),
+                       GetAccountId(), GetPlayerName(), GetRemoteAddress().c_str());
+    }
+}
+
+void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet, OpcodeHandlerThread thread)
+{
+    // need prevent do internal far teleports in handlers because some handlers do lot steps
+    // or call code that can do far teleports in some conditions unexpectedly for generic way work code
+    if (_player)
+        _player->SetCanDelayTeleport(true);
+
+    CallOpcodeHandler(opHandle, packet, thread);
+
     if (_player)
     {
         // can be not set in fact for login opcode, but this not create porblems.
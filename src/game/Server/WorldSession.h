@@ -32,6 +32,7 @@
 #include "Server/WorldSocket.h"
 #include "Multithreading/Messager.h"
 #include "LFG/LFGDefines.h"
+#include "Server/OpcodeHandlerStats.h"
 
 #include <atomic>
 #include <map>
@@ -48,6 +49,7 @@ struct DeclinedName;
 struct TradeStatusInfo;
 struct LFGQueueData;
 struct LfgProposal;
+struct GroupQueueInfo;
 
 class ObjectGuid;
 class Creature;
@@ -278,6 +280,7 @@ class WorldSession
         static WorldPacket BuildLfgRoleChosen(ObjectGuid guid, uint8 roles);
         static WorldPacket BuildLfgRoleCheckUpdate(LFGQueueData const& data);
         static WorldPacket BuildLfgUpdateProposal(LfgProposal const& proposal, uint32 randomDungeonId, ObjectGuid guid);
+        static WorldPacket BuildLfgQueueStatus(LfgQueueStatusData const& statusData);
         void SendLfgPlayerReward(LfgPlayerRewardData const& rewardData);
         void SendPartyResult(PartyOperation operation, const std::string& member, PartyResult res) const;
         void SendGroupInvite(Player* player, bool alreadyInGroup = false) const;
@@ -865,6 +868,7 @@ class WorldSession
         void HandlePVPLogDataOpcode(WorldPacket& recv_data);
         void HandleBattlefieldStatusOpcode(WorldPacket& recv_data);
         void HandleBattlefieldPortOpcode(WorldPacket& recv_data);
+        void HandleBattlefieldPort(GroupQueueInfo const& queueInfo, BattleGroundTypeId bgTypeId, uint8 action);
         void HandleBattlefieldListOpcode(WorldPacket& recv_data);
         void HandleLeaveBattlefieldOpcode(WorldPacket& recv_data);
         void HandleBattlemasterJoinArena(WorldPacket& recv_data);
@@ -1022,7 +1026,8 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo, Unit* mover, bool unroot) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
-        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
+        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet, OpcodeHandlerThread thread = OPCODE_THREAD_WORLD);
+        void CallOpcodeHandler(OpcodeHandler const& opHandle, WorldPacket& packet, OpcodeHandlerThread thread);
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Social/WhoListIndex.h"
+#include "Entities/Player.h"
+#include "Guilds/Guild.h"
+#include "Guilds/GuildMgr.h"
+#include "Server/DBCStores.h"
+#include "World/World.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(WhoListIndex);
+
+void WhoListIndex::AddPlayer(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (m_slotByGuid.find(player->GetGUIDLow()) != m_slotByGuid.end())
+        return;
+
+    uint32 slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = m_entries.size();
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[slot];
+    entry.player = player;
+    entry.guidLow = player->GetGUIDLow();
+    entry.teamIndex = GetTeamIndexByTeamId(player->GetTeam());
+    entry.race = player->getRace();
+    entry.class_ = player->getClass();
+    entry.gender = player->getGender();
+    entry.level = player->GetLevel();
+    entry.zoneId = player->GetCachedZoneId();
+    entry.guildId = player->GetGuildId();
+    entry.name = player->GetName();
+    entry.lowerName.clear();
+    if (Utf8toWStr(entry.name, entry.lowerName))
+        wstrToLower(entry.lowerName);
+
+    m_slotByGuid[entry.guidLow] = slot;
+    LinkEntry(slot);
+}
+
+void WhoListIndex::RemovePlayer(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_slotByGuid.find(player->GetGUIDLow());
+    if (itr == m_slotByGuid.end())
+        return;
+
+    uint32 slot = itr->second;
+    UnlinkEntry(slot);
+    m_entries[slot].player = nullptr;
+    m_entries[slot].name.clear();
+    m_entries[slot].lowerName.clear();
+    m_freeSlots.push_back(slot);
+    m_slotByGuid.erase(itr);
+}
+
+void WhoListIndex::UpdateLevel(Player* player, uint32 level)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    Entry* entry = FindEntry(player);
+    if (!entry || entry->level == level)
+        return;
+
+    uint32 slot = m_slotByGuid[entry->guidLow];
+    UnlinkEntry(slot);
+    entry->level = level;
+    LinkEntry(slot);
+}
+
+void WhoListIndex::UpdateZone(Player* player, uint32 zoneId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    Entry* entry = FindEntry(player);
+    if (!entry || entry->zoneId == zoneId)
+        return;
+
+    uint32 slot = m_slotByGuid[entry->guidLow];
+    UnlinkEntry(slot);
+    entry->zoneId = zoneId;
+    LinkEntry(slot);
+}
+
+void WhoListIndex::UpdateGuild(Player* player, uint32 guildId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (Entry* entry = FindEntry(player))
+        entry->guildId = guildId;
+}
+
+void WhoListIndex::InvalidateGuildName(uint32 guildId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_guildNames.erase(guildId);
+}
+
+WhoListIndex::Entry* WhoListIndex::FindEntry(Player* player)
+{
+    auto itr = m_slotByGuid.find(player->GetGUIDLow());
+    return itr != m_slotByGuid.end() ? &m_entries[itr->second] : nullptr;
+}
+
+void WhoListIndex::LinkEntry(uint32 slot)
+{
+    Entry& entry = m_entries[slot];
+
+    SlotList& band = m_levelBands[entry.teamIndex][GetLevelBand(entry.level)];
+    entry.bandPos = band.size();
+    band.push_back(slot);
+
+    SlotList& zone = m_zones[entry.zoneId];
+    entry.zonePos = zone.size();
+    zone.push_back(slot);
+}
+
+void WhoListIndex::UnlinkEntry(uint32 slot)
+{
+    Entry& entry = m_entries[slot];
+    RemoveFromList(m_levelBands[entry.teamIndex][GetLevelBand(entry.level)], entry.bandPos, false);
+    RemoveFromList(m_zones[entry.zoneId], entry.zonePos, true);
+}
+
+void WhoListIndex::RemoveFromList(SlotList& list, uint32 pos, bool zoneList)
+{
+    // swap with last, order of a bucket does not matter
+    uint32 moved = list.back();
+    list[pos] = moved;
+    list.pop_back();
+
+    if (pos < list.size())
+    {
+        if (zoneList)
+            m_entries[moved].zonePos = pos;
+        else
+            m_entries[moved].bandPos = pos;
+    }
+}
+
+WhoListIndex::GuildName const& WhoListIndex::GetGuildName(uint32 guildId)
+{
+    static GuildName const noGuild;
+    if (!guildId)
+        return noGuild;
+
+    auto itr = m_guildNames.find(guildId);
+    if (itr != m_guildNames.end())
+        return itr->second;
+
+    // not cached while unknown, guild can be created later with this id
+    Guild* guild = sGuildMgr.GetGuildById(guildId);
+    if (!guild)
+        return noGuild;
+
+    GuildName& guildName = m_guildNames[guildId];
+    guildName.name = guild->GetName();
+    if (Utf8toWStr(guildName.name, guildName.lowerName))
+        wstrToLower(guildName.lowerName);
+    return guildName;
+}
+
+bool WhoListIndex::Matches(Entry const& entry, Player* viewer, WhoListQuery const& query, LocaleConstant locale, GuildName const& guild) const
+{
+    if (entry.level < query.levelMin || entry.level > query.levelMax)
+        return false;
+
+    if (!(query.classMask & (1 << entry.class_)) || !(query.raceMask & (1 << entry.race)))
+        return false;
+
+    if (!query.playerName.empty() && entry.lowerName.find(query.playerName) == std::wstring::npos)
+        return false;
+
+    if (!query.guildName.empty() && guild.lowerName.find(query.guildName) == std::wstring::npos)
+        return false;
+
+    if (!query.strings.empty())
+    {
+        bool found = false;
+        for (std::wstring const& str : query.strings)
+        {
+            if (guild.lowerName.find(str) != std::wstring::npos || entry.lowerName.find(str) != std::wstring::npos)
+            {
+                found = true;
+                break;
+            }
+
+            AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId);
+            if (areaEntry && Utf8FitTo(areaEntry->area_name[locale], str))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return false;
+    }
+
+    // last as most expensive, check if target is globally visible for player
+    return entry.player->IsInWorld() && entry.player->IsVisibleGloballyFor(viewer);
+}
+
+uint32 WhoListIndex::Query(Player* viewer, WhoListQuery const& query, LocaleConstant locale, uint32 maxMatches, std::vector<WhoListResult>& results)
+{
+    uint32 security = viewer->GetSession()->GetSecurity();
+    bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
+    uint32 gmLevelInWhoList = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
+    uint8 viewerTeamIndex = GetTeamIndexByTeamId(viewer->GetTeam());
+
+    uint32 matchCount = 0;
+
+    // returns false when no more matches need to be counted
+    auto process = [&](Entry const& entry) -> bool
+    {
+        if (security == SEC_PLAYER)
+        {
+            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+            if (entry.teamIndex != viewerTeamIndex && !allowTwoSideWhoList)
+                return true;
+
+            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+            // not cached in entry, security can be changed by .account set gmlevel while in world
+            if (entry.player->GetSession()->GetSecurity() > gmLevelInWhoList)
+                return true;
+        }
+
+        GuildName const& guild = GetGuildName(entry.guildId);
+        if (!Matches(entry, viewer, query, locale, guild))
+            return true;
+
+        ++matchCount;
+        if (results.size() < WHO_LIST_MAX_DISPLAYED)
+        {
+            WhoListResult result;
+            result.name = entry.name;
+            result.guildName = guild.name;
+            result.level = entry.level;
+            result.race = entry.race;
+            result.class_ = entry.class_;
+            result.gender = entry.gender;
+            result.zoneId = entry.zoneId;
+            results.push_back(std::move(result));
+        }
+
+        // count reported to client is capped, no need to search for more once list is full
+        return !maxMatches || matchCount < maxMatches || results.size() < WHO_LIST_MAX_DISPLAYED;
+    };
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (!query.zones.empty())
+    {
+        // client can send same zone multiple times
+        std::vector<uint32> zones = query.zones;
+        std::sort(zones.begin(), zones.end());
+        zones.erase(std::unique(zones.begin(), zones.end()), zones.end());
+
+        for (uint32 zoneId : zones)
+        {
+            auto itr = m_zones.find(zoneId);
+            if (itr == m_zones.end())
+                continue;
+
+            for (uint32 slot : itr->second)
+                if (!process(m_entries[slot]))
+                    return std::min(matchCount, maxMatches);
+        }
+    }
+    else if (query.levelMin <= query.levelMax)
+    {
+        uint32 firstBand = GetLevelBand(query.levelMin);
+        uint32 lastBand = GetLevelBand(query.levelMax);
+
+        for (uint8 teamIndex = 0; teamIndex < PVP_TEAM_COUNT; ++teamIndex)
+        {
+            if (security == SEC_PLAYER && teamIndex != viewerTeamIndex && !allowTwoSideWhoList)
+                continue;
+
+            for (uint32 band = firstBand; band <= lastBand; ++band)
+                for (uint32 slot : m_levelBands[teamIndex][band])
+                    if (!process(m_entries[slot]))
+                        return std::min(matchCount, maxMatches);
+        }
+    }
+
+    return (maxMatches && matchCount > maxMatches) ? maxMatches : matchCount;
+}
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WHOLISTINDEX_H
+#define MANGOS_WHOLISTINDEX_H
+
+#include "Common.h"
+#include "Globals/SharedDefines.h"
+#include "Globals/Locales.h"
+#include "Policies/Singleton.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+#define WHO_LIST_LEVEL_BAND_SIZE    10
+#define WHO_LIST_LEVEL_BAND_COUNT   (255 / WHO_LIST_LEVEL_BAND_SIZE + 1)
+#define WHO_LIST_MAX_DISPLAYED      49                      // maximum player count sent to client
+
+/// Parsed CMSG_WHO filter, names and search strings already lower-cased
+struct WhoListQuery
+{
+    uint32 levelMin = 0;
+    uint32 levelMax = 0;
+    uint32 raceMask = 0;
+    uint32 classMask = 0;
+    std::vector<uint32> zones;                              // empty for any zone
+    std::wstring playerName;
+    std::wstring guildName;
+    std::vector<std::wstring> strings;                      // match player name, guild name or zone name
+};
+
+struct WhoListResult
+{
+    std::string name;
+    std::string guildName;
+    uint32 level;
+    uint8 race;
+    uint8 class_;
+    uint8 gender;
+    uint32 zoneId;
+};
+
+/**
+ * Index of the in-world players answering /who requests.
+ *
+ * Players are bucketed by team and level band and by zone, with their name
+ * lower-cased once at login. Security is read from the session at query time. The index is kept up to date from player add/remove
+ * to world, level, zone and guild changes, which may come from map threads.
+ */
+class WhoListIndex
+{
+    public:
+        WhoListIndex() {}
+
+        // hooks, player not in index are ignored by the Update* calls
+        void AddPlayer(Player* player);
+        void RemovePlayer(Player* player);
+        void UpdateLevel(Player* player, uint32 level);
+        void UpdateZone(Player* player, uint32 zoneId);
+        void UpdateGuild(Player* player, uint32 guildId);
+        void InvalidateGuildName(uint32 guildId);           // guild created, loaded or disbanded
+
+        // returns count of matches, at most maxMatches if not 0, fills at most WHO_LIST_MAX_DISPLAYED results
+        uint32 Query(Player* viewer, WhoListQuery const& query, LocaleConstant locale, uint32 maxMatches, std::vector<WhoListResult>& results);
+
+    private:
+        struct Entry
+        {
+            Player* player;                                 // nullptr for free slot
+            uint32 guidLow;
+            uint8 teamIndex;
+            uint8 race;
+            uint8 class_;
+            uint8 gender;
+            uint32 level;
+            uint32 zoneId;
+            uint32 guildId;
+            std::string name;
+            std::wstring lowerName;
+            uint32 bandPos;                                 // position in its level band
+            uint32 zonePos;                                 // position in its zone bucket
+        };
+
+        struct GuildName
+        {
+            std::string name;
+            std::wstring lowerName;
+        };
+
+        typedef std::vector<uint32> SlotList;
+
+        static uint32 GetLevelBand(uint32 level) { return std::min(level, uint32(255)) / WHO_LIST_LEVEL_BAND_SIZE; }
+
+        void LinkEntry(uint32 slot);
+        void UnlinkEntry(uint32 slot);
+        void RemoveFromList(SlotList& list, uint32 pos, bool zoneList);
+        Entry* FindEntry(Player* player);
+        GuildName const& GetGuildName(uint32 guildId);
+
+        bool Matches(Entry const& entry, Player* viewer, WhoListQuery const& query, LocaleConstant locale, GuildName const& guild) const;
+
+        std::vector<Entry> m_entries;
+        SlotList m_freeSlots;
+        std::unordered_map<uint32, uint32> m_slotByGuid;
+        SlotList m_levelBands[PVP_TEAM_COUNT][WHO_LIST_LEVEL_BAND_COUNT];
+        std::unordered_map<uint32, SlotList> m_zones;
+        std::unordered_map<uint32, GuildName> m_guildNames; // lower-cased names by guild id, see InvalidateGuildName
+
+        std::mutex m_lock;
+};
+
+#define sWhoListIndex MaNGOS::Singleton<WhoListIndex>::Instance()
+
+#endif
@@ -424,6 +424,12 @@ void SpellLog::SendToSet()
 // Spell class
 // ***********
 
+SlabPool& Spell::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("spell", 64);
+    return *pool;
+}
+
 Spell::Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags, ObjectGuid originalCasterGUID, SpellEntry const* triggeredBy) :
     m_partialApplicationMask(0), m_spellScript(SpellScriptMgr::GetSpellScript(info->Id)), m_auraScript(SpellScriptMgr::GetAuraScript(info->Id)),
     m_effectSkipMask(0),
@@ -538,6 +544,7 @@ Spell::Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags,
 
     m_jumpRadius = SpellTargetMgr::GetJumpRadius(m_spellInfo->Id);
     memcpy(m_filteringScheme, SpellTargetMgr::GetSpellTargetingData(m_spellInfo->Id).filteringScheme, sizeof(m_filteringScheme));
+    m_batchedLOSObject = nullptr;
 
     m_scriptValue = 0;
 
@@ -819,6 +826,7 @@ bool Spell::FillUnitTargets(TempTargetingData& targetingData, SpellTargetingData
         SpellTargetImplicitType type = SpellTargetInfoTable[target].type;
         if (!unitTargetList.empty()) // Unit case
         {
+            DeferTargetsLOSToBatch(SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet));
             for (auto itr = unitTargetList.begin(); itr != unitTargetList.end();)
             {
                 if (!CheckTarget(*itr, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet)))
@@ -826,6 +834,7 @@ bool Spell::FillUnitTargets(TempTargetingData& targetingData, SpellTargetingData
                 else
                     ++itr;
             }
+            CheckTargetsLOSInBatch(unitTargetList);
 
             // Special target filter before adding targets to list
             FilterTargetMap(unitTargetList, scheme, targetingData.chainTargetCount[i]);
@@ -8284,6 +8293,85 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return (CURRENT_GENERIC_SPELL);
 }
 
+WorldObject* Spell::GetCasterLOSObject(SpellEffectIndex eff) const
+{
+    if (m_spellInfo->EffectImplicitTargetA[eff] == TARGET_LOCATION_CHANNEL_TARGET_DEST)
+        return m_caster->GetDynObject(m_triggeredByAuraSpell ? m_triggeredByAuraSpell->Id : m_spellInfo->Id);
+
+    return GetCastingObject();
+}
+
+bool Spell::IsTargetWithinLOSOf(Unit* target, WorldObject const* losObject) const
+{
+    // checked by CheckTargetsLOSInBatch for the targets passing all other checks
+    if (losObject == m_batchedLOSObject)
+        return true;
+
+    return target->IsWithinLOSInMap(losObject, true);
+}
+
+/**
+ * Makes CheckTarget skip line of sight of area targets to caster, for CheckTargetsLOSInBatch to trace it at once
+ * for the targets passing all other checks. Conditions are the ones CheckTarget checks it under.
+ */
+void Spell::DeferTargetsLOSToBatch(SpellEffectIndex eff, bool targetB, CheckException exception)
+{
+    m_batchedLOSObject = nullptr;
+
+    SpellTargetInfo const& info = SpellTargetInfoTable[targetB ? m_spellInfo->EffectImplicitTargetB[eff] : m_spellInfo->EffectImplicitTargetA[eff]];
+    if (info.type == TARGET_TYPE_UNIT && info.filter == TARGET_SCRIPT)
+        return;
+
+    if (m_spellInfo->Effect[eff] == SPELL_EFFECT_SUMMON_PLAYER || m_spellInfo->Effect[eff] == SPELL_EFFECT_RESURRECT_NEW)
+        return;
+
+    if (exception == EXCEPTION_MAGNET || IsIgnoreLosSpellEffect(m_spellInfo, eff, targetB))
+        return;
+
+    if (info.los != TARGET_LOS_CASTER || info.enumerator == TARGET_ENUMERATOR_CHAIN)
+        return;
+
+    m_batchedLOSObject = GetCasterLOSObject(eff);
+}
+
+/**
+ * Removes targets not in line of sight of caster, tracing all lines at once.
+ * Lines are traced from caster to targets, vmap collision is two sided so result is the same,
+ * but each line uses the phase mask of its target as target->IsWithinLOSInMap does.
+ */
+void Spell::CheckTargetsLOSInBatch(UnitList& targets)
+{
+    WorldObject const* losObject = m_batchedLOSObject;
+    m_batchedLOSObject = nullptr;
+
+    if (!losObject || targets.empty())
+        return;
+
+    std::vector<uint32> phaseMasks;
+    for (Unit* target : targets)
+        if (target != m_trueCaster && std::find(phaseMasks.begin(), phaseMasks.end(), target->GetPhaseMask()) == phaseMasks.end())
+            phaseMasks.push_back(target->GetPhaseMask());
+
+    std::unordered_set<Unit const*> notInLos;
+    std::vector<WorldObject const*> objects;
+    std::vector<bool> inLos;
+    for (uint32 phaseMask : phaseMasks)
+    {
+        objects.clear();
+        for (Unit* target : targets)
+            if (target != m_trueCaster && target->GetPhaseMask() == phaseMask)
+                objects.push_back(target);
+
+        losObject->CheckWithinLOSInMap(objects, inLos, phaseMask, true);
+        for (size_t i = 0; i < objects.size(); ++i)
+            if (!inLos[i])
+                notInLos.insert(static_cast<Unit const*>(objects[i]));
+    }
+
+    if (!notInLos.empty())
+        targets.remove_if([&notInLos](Unit* target) { return notInLos.find(target) != notInLos.end(); });
+}
+
 bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception) const
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
@@ -8382,17 +8470,9 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckE
                         case TARGET_LOS_CASTER:
                             if (target != m_trueCaster && info.enumerator != TARGET_ENUMERATOR_CHAIN) // chain is checked on FilterTargetMap
                             {
-                                if (m_spellInfo->EffectImplicitTargetA[eff] == TARGET_LOCATION_CHANNEL_TARGET_DEST)
-                                {
-                                    if (DynamicObject* dynObj = m_caster->GetDynObject(m_triggeredByAuraSpell ? m_triggeredByAuraSpell->Id : m_spellInfo->Id))
-                                        if (!target->IsWithinLOSInMap(dynObj, true))
-                                            return false;
-                                }
-                                else if (WorldObject* caster = GetCastingObject())
-                                {
-                                    if (!target->IsWithinLOSInMap(caster, true))
+                                if (WorldObject* losObject = GetCasterLOSObject(eff))
+                                    if (!IsTargetWithinLOSOf(target, losObject))
                                         return false;
-                                }
                             }
                             break;
                     }
@@ -8704,7 +8784,12 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, float cone, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=nullptr*/)
 {
     MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, cone, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_trueCaster->GetMap(), notifier, radius);
+
+    // map position index instead of a grid visit, only units in reach of the area are passed to the notifier
+    std::vector<WorldObject*> candidates;
+    m_trueCaster->GetMap()->GetUnitsInRange(notifier.GetCenterX(), notifier.GetCenterY(), radius, TYPEMASK_UNIT, notifier.GetPhaseMask(), candidates);
+    for (WorldObject* candidate : candidates)
+        notifier.VisitUnit(static_cast<Unit*>(candidate));
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster) const
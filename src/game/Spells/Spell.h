@@ -28,6 +28,7 @@
 #include "Entities/Player.h"
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
+#include "Util/SlabPool.h"
 
 class WorldSession;
 class WorldPacket;
@@ -402,6 +403,10 @@ class Spell
         friend struct MaNGOS::SpellNotifierCreatureAndPlayer;
         friend void Unit::SetCurrentCastedSpell(Spell* pSpell);
     public:
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         void EffectEmpty(SpellEffectIndex eff_idx);
         void EffectNULL(SpellEffectIndex eff_idx);
         void EffectUnused(SpellEffectIndex eff_idx);
@@ -610,6 +615,10 @@ class Spell
         template<typename T> WorldObject* FindCorpseUsing();
 
         bool CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception = EXCEPTION_NONE) const;
+        void DeferTargetsLOSToBatch(SpellEffectIndex eff, bool targetB, CheckException exception);
+        void CheckTargetsLOSInBatch(UnitList& targets);
+        WorldObject* GetCasterLOSObject(SpellEffectIndex eff) const;
+        bool IsTargetWithinLOSOf(Unit* target, WorldObject const* losObject) const;
         bool CanAutoCast(Unit* target);
 
         static void SendCastResult(Player const* caster, SpellEntry const* spellInfo, uint8 cast_count, SpellCastResult result, bool isPetCastResult = false, uint32 param1 = 0, uint32 param2 = 0);
@@ -1072,6 +1081,9 @@ class Spell
         float m_jumpRadius;
         SpellTargetFilterScheme m_filteringScheme[MAX_EFFECT_INDEX][2];
 
+        // line of sight of unit targets to this object is skipped by CheckTarget and traced in one batch after it
+        WorldObject const* m_batchedLOSObject;
+
         std::set<Aura*> m_procOnceHolder;
 
         struct EffectSkillInfo
@@ -1172,7 +1184,7 @@ namespace MaNGOS
         SpellNotifierCreatureAndPlayer(Spell& spell, UnitList& data, float radius, float cone, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_AOE_ATTACKABLE, WorldObject* originalCaster = nullptr)
             : i_data(data), i_spell(spell), i_push_type(type), i_radius(radius), i_cone(cone), i_TargetType(TargetType),
-              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject()), i_centerX(0), i_centerY(0), i_centerZ(0)
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
@@ -1211,96 +1223,107 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>& m)
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                VisitUnit(itr->getSource());
+        }
+
+        // phase mask for Map::GetUnitsInRange, candidates are checked by VisitUnit again
+        uint32 GetPhaseMask() const
+        {
+            if (!i_originalCaster || i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT))
+                return 0;
+            return i_originalCaster->GetPhaseMask();
+        }
+
+        void VisitUnit(Unit* target)
         {
             if (!i_originalCaster || !i_castingObject)
                 return;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            // mostly phase check
+            if (i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT))
             {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                // mostly phase check
-                if (i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT))
-                {
-                    if (!itr->getSource()->IsInMapIgnorePhase(i_originalCaster))
-                        continue;
-                }
-                else if (!itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+                if (!target->IsInMapIgnorePhase(i_originalCaster))
+                    return;
+            }
+            else if (!target->IsInMap(i_originalCaster))
+                return;
 
-                if (itr->getSource()->IsTaxiFlying())
-                    continue;
+            if (target->IsTaxiFlying())
+                return;
+
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_CHAIN_ATTACKABLE:
+                    if (target->IsChainImmune())
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_ATTACKABLE:
+                    if (target->IsAOEImmune())
+                        return;
+                    break;
+            }
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_ASSISTABLE:
+                    if (!i_originalCaster->CanAssistSpell(target, i_spell.m_spellInfo))
+                        return;
+                    break;
+                case SPELL_TARGETS_CHAIN_ATTACKABLE:
+                case SPELL_TARGETS_AOE_ATTACKABLE:
                 {
-                    case SPELL_TARGETS_CHAIN_ATTACKABLE:
-                        if (itr->getSource()->IsChainImmune())
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_ATTACKABLE:
-                        if (itr->getSource()->IsAOEImmune())
-                            continue;
-                        break;
+                    if (!i_originalCaster->CanAttackSpell(target, i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK)))
+                        return;
+                    break;
                 }
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                switch (i_TargetType)
+            // we don't need to check InMap here, it's already done some lines above
+            switch (i_push_type)
+            {
+                case PUSH_CONE:
                 {
-                    case SPELL_TARGETS_ASSISTABLE:
-                        if (!i_originalCaster->CanAssistSpell(itr->getSource(), i_spell.m_spellInfo))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_CHAIN_ATTACKABLE:
-                    case SPELL_TARGETS_AOE_ATTACKABLE:
+                    float heightDifference = std::abs(target->GetPositionZ() - i_centerZ);
+                    float maxHeight = i_radius / 2;
+                    float distance = std::min(sqrtf(target->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
+                    float ratio = distance / i_radius;
+                    float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
+                    if (!i_originalCaster->IsControlledByPlayer() && target->IsControlledByPlayer())
+                        conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
+                    if (i_cone >= 0.f)
                     {
-                        if (!i_originalCaster->CanAttackSpell(itr->getSource(), i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK)))
-                            continue;
-                        break;
+                        if (i_castingObject->isInFront(target, i_radius, i_cone) &&
+                            std::abs(target->GetPositionZ() - i_centerZ) - target->GetCombatReach() <= conalMaxHeight)
+                            i_data.push_back(target);
                     }
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
-                }
-
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
-                {
-                    case PUSH_CONE:
+                    else
                     {
-                        float heightDifference = std::abs(itr->getSource()->GetPositionZ() - i_centerZ);
-                        float maxHeight = i_radius / 2;
-                        float distance = std::min(sqrtf(itr->getSource()->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
-                        float ratio = distance / i_radius;
-                        float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
-                        if (!i_originalCaster->IsControlledByPlayer() && itr->getSource()->IsControlledByPlayer())
-                            conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
-                        if (i_cone >= 0.f)
-                        {
-                            if (i_castingObject->isInFront(itr->getSource(), i_radius, i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        else
-                        {
-                            if (i_castingObject->isInBack(itr->getSource(), i_radius, -i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        break;
+                        if (i_castingObject->isInBack(target, i_radius, -i_cone) &&
+                            std::abs(target->GetPositionZ() - i_centerZ) - target->GetCombatReach() <= conalMaxHeight)
+                            i_data.push_back(target);
                     }
-                    case PUSH_SELF_CENTER:
-                        if (itr->getSource()->GetDistance2d(i_centerX, i_centerY, DIST_CALC_COMBAT_REACH) <= i_radius)
-                            i_data.push_back(itr->getSource());
-                        break;
-                    case PUSH_SRC_CENTER:
-                    case PUSH_DEST_CENTER:
-                    case PUSH_TARGET_CENTER:
-                        float radius = i_radius;
-                        if (i_originalCaster->IsControlledByPlayer() && !itr->getSource()->IsControlledByPlayer())
-                            radius += itr->getSource()->GetCombatReach();
-                        if (itr->getSource()->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius)
-                            i_data.push_back(itr->getSource());
-                        break;
+                    break;
                 }
+                case PUSH_SELF_CENTER:
+                    if (target->GetDistance2d(i_centerX, i_centerY, DIST_CALC_COMBAT_REACH) <= i_radius)
+                        i_data.push_back(target);
+                    break;
+                case PUSH_SRC_CENTER:
+                case PUSH_DEST_CENTER:
+                case PUSH_TARGET_CENTER:
+                    float radius = i_radius;
+                    if (i_originalCaster->IsControlledByPlayer() && !target->IsControlledByPlayer())
+                        radius += target->GetCombatReach();
+                    if (target->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius)
+                        i_data.push_back(target);
+                    break;
             }
         }
 
@@ -381,6 +381,12 @@ pAuraHandler AuraHandler[TOTAL_AURAS] =
 
 static AuraType const frozenAuraTypes[] = { SPELL_AURA_MOD_ROOT, SPELL_AURA_MOD_STUN, SPELL_AURA_NONE };
 
+SlabPool& Aura::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("aura", 128);
+    return *pool;
+}
+
 Aura::Aura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, Unit* caster, Item* castItem) :
     m_spellmod(nullptr), m_periodicTimer(0), m_periodicTick(0), m_removeMode(AURA_REMOVE_BY_DEFAULT),
     m_effIndex(eff), m_positive(false), m_isPeriodic(false), m_isAreaAura(false),
@@ -3801,7 +3807,7 @@ void Aura::HandleAuraDummy(bool apply, bool Real)
             Player* player = static_cast<Player*>(target);
 
             // custom loop for evaluation reasons
-            for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+            for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
             {
                 auto data = (*itr).second;
                 uint32 spellId = data->spellId;
@@ -9518,7 +9524,7 @@ void Aura::HandlePhase(bool apply, bool Real)
             uint32 zone, area;
             target->GetZoneAndAreaId(zone, area);
 
-            for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+            for (SpellAreaForAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
                 itr->second->ApplyOrRemoveSpellIfCan((Player*)target, zone, area, false);
         }
     }
@@ -9733,6 +9739,12 @@ inline bool IsRemovedOnShapeshiftLost(SpellEntry const* spellproto, ObjectGuid c
     /*TODO: investigate spellid 24864  or (SpellFamilyName = 7 and EffectApplyAuraName_1 = 49 and stances = 0)*/
 }
 
+SlabPool& SpellAuraHolder::GetSlabPool()
+{
+    static SlabPool* pool = new SlabPool("spellauraholder", 128);
+    return *pool;
+}
+
 SpellAuraHolder::SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy) :
     m_spellProto(spellproto), m_target(target),
     m_castItemGuid(castItem ? castItem->GetObjectGuid() : ObjectGuid()), m_triggeredBy(triggeredBy),
@@ -22,6 +22,7 @@
 #include "Server/DBCEnums.h"
 #include "Entities/ObjectGuid.h"
 #include "Spells/Scripts/SpellScript.h"
+#include "Util/SlabPool.h"
 
 /**
  * Used to modify what an Aura does to a player/npc.
@@ -94,6 +95,11 @@ class SpellAuraHolder
     public:
         SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy);
         ~SpellAuraHolder();
+
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         Aura* m_auras[MAX_EFFECT_INDEX];
 
         void AddAura(Aura* aura, SpellEffectIndex index);
@@ -280,6 +286,11 @@ class Aura
         friend Aura* CreateAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, Unit* caster, Item* castItem, uint64 scriptValue);
 
     public:
+        // area and persistent auras share the pool
+        static void* operator new(size_t size) { return GetSlabPool().Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { GetSlabPool().Deallocate(ptr, size); }
+        static SlabPool& GetSlabPool();
+
         // aura handlers
         void HandleNULL(bool, bool)
         {
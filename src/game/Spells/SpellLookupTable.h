@@ -0,0 +1,125 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SPELL_LOOKUP_TABLE_H
+#define _SPELL_LOOKUP_TABLE_H
+
+#include "Common.h"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Read only copy of a map keyed by spell (or area) id, built after the map is loaded.
+ * Lookup is an index into an array over all ids up to the highest key, instead of a tree or hash walk.
+ */
+template<typename T>
+class SpellLookupTable
+{
+    public:
+        template<typename Map>
+        void Build(Map const& map)
+        {
+            uint32 maxKey = 0;
+            for (auto const& itr : map)
+                maxKey = std::max(maxKey, uint32(itr.first));
+
+            m_index.assign(map.empty() ? 0 : maxKey + 1, 0);
+            m_values.clear();
+            m_values.reserve(map.size());
+            for (auto const& itr : map)
+            {
+                m_values.push_back(itr.second);
+                m_index[itr.first] = m_values.size();
+            }
+        }
+
+        void Clear()
+        {
+            m_index.clear();
+            m_values.clear();
+        }
+
+        T const* Find(uint32 id) const
+        {
+            if (id >= m_index.size() || !m_index[id])
+                return nullptr;
+
+            return &m_values[m_index[id] - 1];
+        }
+
+    private:
+        std::vector<uint32> m_index;                        // position in m_values + 1, 0 for ids not in the map
+        std::vector<T> m_values;
+};
+
+/**
+ * Read only copy of a multimap keyed by spell (or area) id, built after the multimap is loaded.
+ * Values of all keys are stored in one array in key order, values of one key are the range between
+ * its offset and the offset of the next key. Bounds are used the same way as multimap equal_range.
+ */
+template<typename T>
+class SpellLookupRangeTable
+{
+    public:
+        typedef std::pair<uint32, T> value_type;
+        typedef value_type const* const_iterator;
+        typedef std::pair<const_iterator, const_iterator> Bounds;
+
+        template<typename MultiMap>
+        void Build(MultiMap const& map)
+        {
+            m_values.assign(map.begin(), map.end());        // multimap is already in key order
+            m_offsets.assign(m_values.empty() ? 0 : m_values.back().first + 2, 0);
+
+            uint32 key = 0;
+            for (uint32 i = 0; i < m_values.size(); ++i)
+                for (; key <= m_values[i].first; ++key)
+                    m_offsets[key] = i;
+
+            for (; key < m_offsets.size(); ++key)
+                m_offsets[key] = m_values.size();
+        }
+
+        void Clear()
+        {
+            m_offsets.clear();
+            m_values.clear();
+        }
+
+        Bounds Find(uint32 id) const
+        {
+            if (id >= GetKeyCount())
+                return Bounds(nullptr, nullptr);
+
+            return Bounds(m_values.data() + m_offsets[id], m_values.data() + m_offsets[id + 1]);
+        }
+
+        bool Contains(uint32 id) const
+        {
+            return id < GetKeyCount() && m_offsets[id] != m_offsets[id + 1];
+        }
+
+    private:
+        uint32 GetKeyCount() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+        std::vector<uint32> m_offsets;                      // first value of each id, one past the highest key is the end
+        std::vector<value_type> m_values;
+};
+
+#endif
@@ -830,6 +830,7 @@ struct DoSpellProcEvent
 void SpellMgr::LoadSpellProcEvents()
 {
     mSpellProcEventMap.clear();                             // need for reload case
+    mSpellProcEventTable.Clear();
 
     //                                             0      1           2                3                  4                  5                  6                  7                  8                  9                  10                 11                 12         13      14       15            16
     auto queryResult = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMaskA0, SpellFamilyMaskA1, SpellFamilyMaskA2, SpellFamilyMaskB0, SpellFamilyMaskB1, SpellFamilyMaskB2, SpellFamilyMaskC0, SpellFamilyMaskC1, SpellFamilyMaskC2, procFlags, procEx, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -876,6 +877,8 @@ void SpellMgr::LoadSpellProcEvents()
 
     rankHelper.FillHigherRanks();
 
+    mSpellProcEventTable.Build(mSpellProcEventMap);
+
     sLog.outString(">> Loaded %u extra spell proc event conditions +%u custom proc (inc. +%u custom ranks)",  rankHelper.worker.count, rankHelper.worker.customProc, rankHelper.customRank);
     sLog.outString();
 }
@@ -892,6 +895,7 @@ struct DoSpellProcItemEnchant
 void SpellMgr::LoadSpellProcItemEnchant()
 {
     mSpellProcItemEnchantMap.clear();                       // need for reload case
+    mSpellProcItemEnchantTable.Clear();
 
     uint32 count = 0;
 
@@ -944,6 +948,8 @@ void SpellMgr::LoadSpellProcItemEnchant()
     }
     while (queryResult->NextRow());
 
+    mSpellProcItemEnchantTable.Build(mSpellProcItemEnchantMap);
+
     sLog.outString(">> Loaded %u proc item enchant definitions", count);
     sLog.outString();
 }
@@ -1083,6 +1089,7 @@ bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellPr
 void SpellMgr::LoadSpellElixirs()
 {
     mSpellElixirs.clear();                                  // need for reload case
+    mSpellElixirTable.Clear();
 
     uint32 count = 0;
 
@@ -1124,6 +1131,8 @@ void SpellMgr::LoadSpellElixirs()
     }
     while (queryResult->NextRow());
 
+    mSpellElixirTable.Build(mSpellElixirs);
+
     sLog.outString(">> Loaded %u spell elixir definitions", count);
     sLog.outString();
 }
@@ -1196,6 +1205,7 @@ struct DoSpellThreat
 void SpellMgr::LoadSpellThreats()
 {
     mSpellThreatMap.clear();                                // need for reload case
+    mSpellThreatTable.Clear();
 
     //                                             0      1       2           3
     auto queryResult = WorldDatabase.Query("SELECT entry, Threat, multiplier, ap_bonus FROM spell_threat");
@@ -1231,6 +1241,8 @@ void SpellMgr::LoadSpellThreats()
 
     rankHelper.FillHigherRanks();
 
+    mSpellThreatTable.Build(mSpellThreatMap);
+
     sLog.outString(">> Loaded %u spell threat entries", rankHelper.worker.count);
     sLog.outString();
 }
@@ -1468,6 +1480,8 @@ void SpellMgr::LoadSpellChains()
 {
     mSpellChains.clear();                                   // need for reload case
     mSpellChainsNext.clear();                               // need for reload case
+    mSpellChainTable.Clear();
+    mSpellChainNextTable.Clear();
 
     // load known data for talents
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -1585,6 +1599,8 @@ void SpellMgr::LoadSpellChains()
         BarGoLink bar(1);
         bar.step();
 
+        mSpellChainTable.Build(mSpellChains);
+
         sLog.outString(">> Loaded 0 spell chain records");
         sLog.outErrorDb("`spell_chains` table is empty!");
         sLog.outString();
@@ -1827,6 +1843,9 @@ void SpellMgr::LoadSpellChains()
         }
     }
 
+    mSpellChainTable.Build(mSpellChains);
+    mSpellChainNextTable.Build(mSpellChainsNext);
+
     sLog.outString(">> Loaded %u spell chain records (%u from DBC data with %u req field updates, and %u loaded from table)", dbc_count + new_count, dbc_count, req_count, new_count);
     sLog.outString();
 }
@@ -1872,6 +1891,7 @@ void SpellMgr::LoadSpellLearnSkills()
 void SpellMgr::LoadSpellLearnSpells()
 {
     mSpellLearnSpells.clear();                              // need for reload case
+    mSpellLearnSpellTable.Clear();
 
     //                                             0      1        2
     auto queryResult = WorldDatabase.Query("SELECT entry, SpellID, Active FROM spell_learn_spell");
@@ -1951,7 +1971,7 @@ void SpellMgr::LoadSpellLearnSpells()
                 // other required explicit dependent learning
                 dbc_node.autoLearned = entry->EffectImplicitTargetA[i] == TARGET_UNIT_CASTER_PET || GetTalentSpellCost(spell) > 0 || IsPassiveSpell(entry) || IsSpellHaveEffect(entry, SPELL_EFFECT_SKILL_STEP);
 
-                SpellLearnSpellMapBounds db_node_bounds = GetSpellLearnSpellMapBounds(spell);
+                std::pair<SpellLearnSpellMap::const_iterator, SpellLearnSpellMap::const_iterator> db_node_bounds = mSpellLearnSpells.equal_range(spell);
 
                 bool found = false;
                 for (SpellLearnSpellMap::const_iterator itr = db_node_bounds.first; itr != db_node_bounds.second; ++itr)
@@ -1974,6 +1994,8 @@ void SpellMgr::LoadSpellLearnSpells()
         }
     }
 
+    mSpellLearnSpellTable.Build(mSpellLearnSpells);
+
     sLog.outString(">> Loaded %u spell learn spells + %u found in DBC", count, dbc_count);
     sLog.outString();
 }
@@ -2473,6 +2495,10 @@ void SpellMgr::LoadSpellAreas()
 {
     mSpellAreaMap.clear();                                  // need for reload case
     mSpellAreaForAuraMap.clear();
+    mSpellAreaForAreaMap.clear();
+    mSpellAreaTable.Clear();
+    mSpellAreaForAuraTable.Clear();
+    mSpellAreaForAreaTable.Clear();
 
     uint32 count = 0;
 
@@ -2517,7 +2543,7 @@ void SpellMgr::LoadSpellAreas()
 
         {
             bool ok = true;
-            SpellAreaMapBounds sa_bounds = GetSpellAreaMapBounds(spellArea.spellId);
+            std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> sa_bounds = mSpellAreaMap.equal_range(spellArea.spellId);
             for (SpellAreaMap::const_iterator itr = sa_bounds.first; itr != sa_bounds.second; ++itr)
             {
                 if (spellArea.spellId != itr->second.spellId)
@@ -2630,7 +2656,7 @@ void SpellMgr::LoadSpellAreas()
             if (spellArea.autocast && spellArea.auraSpell > 0)
             {
                 bool chain = false;
-                SpellAreaForAuraMapBounds saBound = GetSpellAreaForAuraMapBounds(spellArea.spellId);
+                std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator> saBound = mSpellAreaForAuraMap.equal_range(spellArea.spellId);
                 for (SpellAreaForAuraMap::const_iterator itr = saBound.first; itr != saBound.second; ++itr)
                 {
                     if (itr->second->autocast && itr->second->auraSpell > 0)
@@ -2646,7 +2672,7 @@ void SpellMgr::LoadSpellAreas()
                     continue;
                 }
 
-                SpellAreaMapBounds saBound2 = GetSpellAreaMapBounds(spellArea.auraSpell);
+                std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> saBound2 = mSpellAreaMap.equal_range(spellArea.auraSpell);
                 for (SpellAreaMap::const_iterator itr2 = saBound2.first; itr2 != saBound2.second; ++itr2)
                 {
                     if (itr2->second.autocast && itr2->second.auraSpell > 0)
@@ -2678,6 +2704,10 @@ void SpellMgr::LoadSpellAreas()
     }
     while (queryResult->NextRow());
 
+    mSpellAreaTable.Build(mSpellAreaMap);
+    mSpellAreaForAuraTable.Build(mSpellAreaForAuraMap);
+    mSpellAreaForAreaTable.Build(mSpellAreaForAreaMap);
+
     sLog.outString(">> Loaded %u spell area requirements", count);
     sLog.outString();
 }
@@ -2726,7 +2756,7 @@ SpellCastResult SpellMgr::GetSpellAllowedInLocationError(SpellEntry const* spell
     SpellAreaMapBounds saBounds = GetSpellAreaMapBounds(spellInfo->Id);
     if (saBounds.first != saBounds.second)
     {
-        for (SpellAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
+        for (SpellAreaTable::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
         {
             if (itr->second.IsFitToRequirements(player, zone_id, area_id))
                 return SPELL_CAST_OK;
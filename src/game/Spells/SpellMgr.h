@@ -26,6 +26,7 @@
 #include "Globals/SharedDefines.h"
 #include "Spells/SpellAuraDefines.h"
 #include "Spells/SpellTargets.h"
+#include "Spells/SpellLookupTable.h"
 #include "Server/DBCStructure.h"
 #include "Server/DBCStores.h"
 #include "Entities/DynamicObject.h"
@@ -2669,9 +2670,12 @@ struct SpellArea
 typedef std::multimap<uint32 /*applySpellId*/, SpellArea> SpellAreaMap;
 typedef std::multimap<uint32 /*auraSpellId*/, SpellArea const*> SpellAreaForAuraMap;
 typedef std::multimap<uint32 /*areaOrZoneId*/, SpellArea const*> SpellAreaForAreaMap;
-typedef std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> SpellAreaMapBounds;
-typedef std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator>  SpellAreaForAuraMapBounds;
-typedef std::pair<SpellAreaForAreaMap::const_iterator, SpellAreaForAreaMap::const_iterator>  SpellAreaForAreaMapBounds;
+typedef SpellLookupRangeTable<SpellArea> SpellAreaTable;
+typedef SpellLookupRangeTable<SpellArea const*> SpellAreaForAuraTable;
+typedef SpellLookupRangeTable<SpellArea const*> SpellAreaForAreaTable;
+typedef SpellAreaTable::Bounds SpellAreaMapBounds;
+typedef SpellAreaForAuraTable::Bounds SpellAreaForAuraMapBounds;
+typedef SpellAreaForAreaTable::Bounds SpellAreaForAreaMapBounds;
 
 // Spell rank chain  (accessed using SpellMgr functions)
 struct SpellChainNode
@@ -2684,6 +2688,8 @@ struct SpellChainNode
 
 typedef std::unordered_map<uint32, SpellChainNode> SpellChainMap;
 typedef std::multimap<uint32, uint32> SpellChainMapNext;
+typedef SpellLookupRangeTable<uint32> SpellChainNextTable;
+typedef SpellChainNextTable::Bounds SpellChainMapNextBounds;
 
 // Spell learning properties (accessed using SpellMgr functions)
 struct SpellLearnSkillNode
@@ -2703,7 +2709,8 @@ struct SpellLearnSpellNode
 };
 
 typedef std::multimap<uint32, SpellLearnSpellNode> SpellLearnSpellMap;
-typedef std::pair<SpellLearnSpellMap::const_iterator, SpellLearnSpellMap::const_iterator> SpellLearnSpellMapBounds;
+typedef SpellLookupRangeTable<SpellLearnSpellNode> SpellLearnSpellTable;
+typedef SpellLearnSpellTable::Bounds SpellLearnSpellMapBounds;
 
 typedef std::multimap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
 typedef std::pair<SkillLineAbilityMap::const_iterator, SkillLineAbilityMap::const_iterator> SkillLineAbilityMapBounds;
@@ -2756,11 +2763,10 @@ class SpellMgr
 
         uint32 GetSpellElixirMask(uint32 spellid) const
         {
-            SpellElixirMap::const_iterator itr = mSpellElixirs.find(spellid);
-            if (itr == mSpellElixirs.end())
-                return 0x0;
+            if (uint8 const* mask = mSpellElixirTable.Find(spellid))
+                return *mask;
 
-            return itr->second;
+            return 0x0;
         }
 
         SpellSpecific GetSpellElixirSpecific(uint32 spellid) const
@@ -2962,11 +2968,7 @@ class SpellMgr
 
         SpellThreatEntry const* GetSpellThreatEntry(uint32 spellid) const
         {
-            SpellThreatMap::const_iterator itr = mSpellThreatMap.find(spellid);
-            if (itr != mSpellThreatMap.end())
-                return &itr->second;
-
-            return nullptr;
+            return mSpellThreatTable.Find(spellid);
         }
 
         float GetSpellThreatMultiplier(SpellEntry const* spellInfo) const
@@ -2983,20 +2985,16 @@ class SpellMgr
         // Spell proc events
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const
         {
-            SpellProcEventMap::const_iterator itr = mSpellProcEventMap.find(spellId);
-            if (itr != mSpellProcEventMap.end())
-                return &itr->second;
-            return nullptr;
+            return mSpellProcEventTable.Find(spellId);
         }
 
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
-            SpellProcItemEnchantMap::const_iterator itr = mSpellProcItemEnchantMap.find(spellid);
-            if (itr == mSpellProcItemEnchantMap.end())
-                return 0.0f;
+            if (float const* chance = mSpellProcItemEnchantTable.Find(spellid))
+                return *chance;
 
-            return itr->second;
+            return 0.0f;
         }
 
         static bool IsSpellProcEventCanTriggeredBy(SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellEntry const* spellInfo, uint32 procFlags, uint32 procExtra);
@@ -3013,11 +3011,7 @@ class SpellMgr
         // Spell ranks chains
         SpellChainNode const* GetSpellChainNode(uint32 spell_id) const
         {
-            SpellChainMap::const_iterator itr = mSpellChains.find(spell_id);
-            if (itr == mSpellChains.end())
-                return nullptr;
-
-            return &itr->second;
+            return mSpellChainTable.Find(spell_id);
         }
 
         uint32 GetFirstSpellInChain(uint32 spell_id) const
@@ -3038,9 +3032,9 @@ class SpellMgr
 
         uint32 GetNextSpellInChain(uint32 spell_id) const
         {
-            SpellChainMapNext const& nextMap = GetSpellChainNext();
+            SpellChainMapNextBounds bounds = GetSpellChainNextBounds(spell_id);
 
-            for (SpellChainMapNext::const_iterator itr = nextMap.lower_bound(spell_id); itr != nextMap.upper_bound(spell_id); ++itr)
+            for (SpellChainNextTable::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
             {
                 SpellChainNode const* node = GetSpellChainNode(itr->second);
 
@@ -3055,13 +3049,14 @@ class SpellMgr
             return 0;
         }
 
-        SpellChainMapNext const& GetSpellChainNext() const { return mSpellChainsNext; }
+        // spells having this spell as prev rank or as req spell
+        SpellChainMapNextBounds GetSpellChainNextBounds(uint32 spell_id) const { return mSpellChainNextTable.Find(spell_id); }
 
         template<typename Worker>
         void doForHighRanks(uint32 spellid, Worker& worker)
         {
-            SpellChainMapNext const& nextMap = GetSpellChainNext();
-            for (SpellChainMapNext::const_iterator itr = nextMap.lower_bound(spellid); itr != nextMap.upper_bound(spellid); ++itr)
+            SpellChainMapNextBounds bounds = GetSpellChainNextBounds(spellid);
+            for (SpellChainNextTable::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
             {
                 worker(itr->second);
                 doForHighRanks(itr->second, worker);
@@ -3083,17 +3078,17 @@ class SpellMgr
             if (spellId1 == spellId2)
                 return false;
 
-            SpellChainMap::const_iterator itr = mSpellChains.find(spellId1);
+            SpellChainNode const* node = GetSpellChainNode(spellId1);
 
             uint32 rank2 = GetSpellRank(spellId2);
 
             // not ordered correctly by rank value
-            if (itr == mSpellChains.end() || !rank2 || itr->second.rank <= rank2)
+            if (!node || !rank2 || node->rank <= rank2)
                 return false;
 
             // check present in same rank chain
-            for (; itr != mSpellChains.end(); itr = mSpellChains.find(itr->second.prev))
-                if (itr->second.prev == spellId2)
+            for (; node; node = GetSpellChainNode(node->prev))
+                if (node->prev == spellId2)
                     return true;
 
             return false;
@@ -3211,18 +3206,18 @@ class SpellMgr
 
         bool IsSpellLearnSpell(uint32 spell_id) const
         {
-            return mSpellLearnSpells.find(spell_id) != mSpellLearnSpells.end();
+            return mSpellLearnSpellTable.Contains(spell_id);
         }
 
         SpellLearnSpellMapBounds GetSpellLearnSpellMapBounds(uint32 spell_id) const
         {
-            return mSpellLearnSpells.equal_range(spell_id);
+            return mSpellLearnSpellTable.Find(spell_id);
         }
 
         bool IsSpellLearnToSpell(uint32 parent, uint32 child) const
         {
             SpellLearnSpellMapBounds bounds = GetSpellLearnSpellMapBounds(parent);
-            for (SpellLearnSpellMap::const_iterator i = bounds.first; i != bounds.second; ++i)
+            for (SpellLearnSpellTable::const_iterator i = bounds.first; i != bounds.second; ++i)
                 if (i->second.spell == child)
                     return true;
             return false;
@@ -3283,17 +3278,17 @@ class SpellMgr
 
         SpellAreaMapBounds GetSpellAreaMapBounds(uint32 spell_id) const
         {
-            return mSpellAreaMap.equal_range(spell_id);
+            return mSpellAreaTable.Find(spell_id);
         }
 
         SpellAreaForAuraMapBounds GetSpellAreaForAuraMapBounds(uint32 spell_id) const
         {
-            return mSpellAreaForAuraMap.equal_range(spell_id);
+            return mSpellAreaForAuraTable.Find(spell_id);
         }
 
         SpellAreaForAreaMapBounds GetSpellAreaForAreaMapBounds(uint32 area_id) const
         {
-            return mSpellAreaForAreaMap.equal_range(area_id);
+            return mSpellAreaForAreaTable.Find(area_id);
         }
 
         // Modifiers
@@ -3340,6 +3335,18 @@ class SpellMgr
         SpellAreaMap         mSpellAreaMap;
         SpellAreaForAuraMap  mSpellAreaForAuraMap;
         SpellAreaForAreaMap  mSpellAreaForAreaMap;
+
+        // read only copies of the maps above used by the accessors, rebuilt at the end of each loader
+        SpellLookupTable<SpellChainNode> mSpellChainTable;
+        SpellChainNextTable mSpellChainNextTable;
+        SpellLearnSpellTable mSpellLearnSpellTable;
+        SpellLookupTable<uint8> mSpellElixirTable;
+        SpellLookupTable<SpellThreatEntry> mSpellThreatTable;
+        SpellLookupTable<SpellProcEventEntry> mSpellProcEventTable;
+        SpellLookupTable<float> mSpellProcItemEnchantTable;
+        SpellAreaTable mSpellAreaTable;
+        SpellAreaForAuraTable mSpellAreaForAuraTable;
+        SpellAreaForAreaTable mSpellAreaForAreaTable;
 };
 
 #define sSpellMgr SpellMgr::Instance()
@@ -25,6 +25,8 @@
 
 #include <Platform/Define.h>
 
+#include "RayPacket.h"
+
 #include <vector>
 #include <algorithm>
 
@@ -259,6 +261,138 @@ class BIH
             }
         }
 
+        /**
+            Packet version of intersectRay, traces the rays of activeMask lanes together.
+            intersectCallback(rays, entry, maxDist, laneMask, stopAtFirst, ignoreM2Model) returns lanes hit by the entry.
+            With stopAtFirst a lane is no more traced after its first hit.
+        */
+        template<typename RayPacketCallback>
+        void intersectRayPacket(const RayPacket& rays, RayPacketCallback& intersectCallback, float* maxDist, uint32 activeMask, bool stopAtFirst = false, bool ignoreM2Model = false) const
+        {
+            PacketFloat intervalMin, intervalMax;
+            uint32 mask = rays.IntersectBox(bounds, maxDist, activeMask, intervalMin, intervalMax);
+            if (!mask)
+                return;
+
+            uint32 const tracedMask = mask;
+            uint32 doneMask = 0;
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true)
+            {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    const bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, left child holds [.., tree[node + 1]], right child [tree[node + 2], ..]
+                            PacketFloat org = PacketFloat::Load(rays.org[axis]);
+                            PacketFloat invDir = PacketFloat::Load(rays.invDir[axis]);
+                            PacketFloat tl = (PacketFloat(intBitsToFloat(tree[node + 1])) - org) * invDir;
+                            PacketFloat tr = (PacketFloat(intBitsToFloat(tree[node + 2])) - org) * invDir;
+                            PacketMask neg = PacketFloat::Load(rays.dir[axis]).SignMask();
+
+                            PacketFloat leftMin = PacketFloat::Select(neg, PacketFloat::Max(tl, intervalMin), intervalMin);
+                            PacketFloat leftMax = PacketFloat::Select(neg, intervalMax, PacketFloat::Min(tl, intervalMax));
+                            PacketFloat rightMin = PacketFloat::Select(neg, intervalMin, PacketFloat::Max(tr, intervalMin));
+                            PacketFloat rightMax = PacketFloat::Select(neg, PacketFloat::Min(tr, intervalMax), intervalMax);
+                            uint32 leftMask = (leftMin <= leftMax).Bits() & mask;
+                            uint32 rightMask = (rightMin <= rightMax).Bits() & mask;
+
+                            // rays pass between clip zones
+                            if (!leftMask && !rightMask)
+                                break;
+                            if (!rightMask)
+                            {
+                                node = offset;
+                                mask = leftMask;
+                                intervalMin = leftMin;
+                                intervalMax = leftMax;
+                                continue;
+                            }
+                            if (!leftMask)
+                            {
+                                node = offset + 3;
+                                mask = rightMask;
+                                intervalMin = rightMin;
+                                intervalMax = rightMax;
+                                continue;
+                            }
+
+                            // both nodes, push back node of the first active ray direction
+                            bool leftFirst = !(rays.negDir[axis] & mask & -mask);
+                            PacketStackNode& back = stack[stackPos++];
+                            back.node = leftFirst ? offset + 3 : offset;
+                            back.mask = leftFirst ? rightMask : leftMask;
+                            back.tnear = leftFirst ? rightMin : leftMin;
+                            back.tfar = leftFirst ? rightMax : leftMax;
+
+                            node = leftFirst ? offset : offset + 3;
+                            mask = leftFirst ? leftMask : rightMask;
+                            intervalMin = leftFirst ? leftMin : rightMin;
+                            intervalMax = leftFirst ? leftMax : rightMax;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0 && mask)
+                            {
+                                uint32 hitMask = intersectCallback(rays, objects[offset], maxDist, mask, stopAtFirst, ignoreM2Model);
+                                if (stopAtFirst)
+                                {
+                                    doneMask |= hitMask;
+                                    mask &= ~hitMask;
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            if (doneMask == tracedMask)
+                                return;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis > 2)
+                            return; // should not happen
+                        PacketFloat org = PacketFloat::Load(rays.org[axis]);
+                        PacketFloat invDir = PacketFloat::Load(rays.invDir[axis]);
+                        PacketFloat tl = (PacketFloat(intBitsToFloat(tree[node + 1])) - org) * invDir;
+                        PacketFloat tr = (PacketFloat(intBitsToFloat(tree[node + 2])) - org) * invDir;
+                        node = offset;
+                        intervalMin = PacketFloat::Max(PacketFloat::Min(tl, tr), intervalMin);
+                        intervalMax = PacketFloat::Min(PacketFloat::Max(tl, tr), intervalMax);
+                        mask &= (intervalMin <= intervalMax).Bits();
+                        if (!mask)
+                            break;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack
+                    --stackPos;
+                    intervalMin = stack[stackPos].tnear;
+                    mask = stack[stackPos].mask & ~doneMask & (intervalMin <= PacketFloat::Load(maxDist)).Bits();
+                    if (!mask)
+                        continue;
+                    node = stack[stackPos].node;
+                    intervalMax = stack[stackPos].tfar;
+                    break;
+                } while (true);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3& p, IsectCallback& intersectCallback) const
         {
@@ -360,6 +494,13 @@ class BIH
             float tnear;
             float tfar;
         };
+        struct PacketStackNode
+        {
+            PacketFloat tnear;
+            PacketFloat tfar;
+            uint32 node;
+            uint32 mask;
+        };
 
         class BuildStats
         {
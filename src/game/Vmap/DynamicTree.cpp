@@ -22,6 +22,7 @@
 #include "BIHWrap.h"
 #include "RegularGrid.h"
 #include "Vmap/GameObjectModel.h"
+#include "Vmap/IVMapManager.h"
 
 template<> struct HashTrait< GameObjectModel>
 {
@@ -261,6 +262,20 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count, uint32 phasemask, bool ignoreM2Model) const
+{
+    // nothing to hit, skip per query setup
+    if (!size())
+        return;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        VMAP::LineOfSightQuery& query = queries[i];
+        if (query.inLineOfSight)
+            query.inLineOfSight = isInLineOfSight(query.x1, query.y1, query.z1, query.x2, query.y2, query.z2, phasemask, ignoreM2Model);
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     Vector3 v(x, y, z);
@@ -48,6 +48,22 @@ namespace VMAP
             ModelInstance* prims;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val): hitMask(0), prims(val) {}
+            uint32 operator()(RayPacket const& rays, uint32 entry, float* distance, uint32 mask, bool pStopAtFirstHit, bool ignoreM2Model)
+            {
+                uint32 result = prims[entry].intersectRayPacket(rays, distance, mask, pStopAtFirstHit, ignoreM2Model);
+                hitMask |= result;
+                return result;
+            }
+            uint32 hitMask;
+
+        protected:
+            ModelInstance* prims;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -163,6 +179,46 @@ namespace VMAP
         G3D::Ray ray = G3D::Ray::fromOriginAndDirection(pos1, (pos2 - pos1) / maxDist);
         return !getIntersectionTime(ray, maxDist, true, ignoreM2Model);
     }
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, bool* results, uint32 count, bool ignoreM2Model) const
+    {
+        RayPacket rays;
+        float maxDist[RAY_PACKET_SIZE];
+        uint32 lanes = 0;
+        uint32 lanesIndex[RAY_PACKET_SIZE];
+
+        auto trace = [&]()
+        {
+            rays.Prepare(lanes);
+            for (uint32 lane = lanes; lane < RAY_PACKET_SIZE; ++lane)
+                maxDist[lane] = 0.f;
+            MapRayPacketCallback intersectionCallBack(iTreeValues);
+            iTree.intersectRayPacket(rays, intersectionCallBack, maxDist, (1 << lanes) - 1, true, ignoreM2Model);
+            for (uint32 lane = 0; lane < lanes; ++lane)
+                results[lanesIndex[lane]] = !(intersectionCallBack.hitMask & (1 << lane));
+            lanes = 0;
+        };
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too:
+            MANGOS_ASSERT(dist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist < 1e-10f)
+                continue;
+
+            rays.SetRay(lanes, pos1[i], (pos2[i] - pos1[i]) / dist);
+            maxDist[lanes] = dist;
+            lanesIndex[lanes] = i;
+            if (++lanes == RAY_PACKET_SIZE)
+                trace();
+        }
+
+        if (lanes)
+            trace();
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -62,6 +62,32 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRayPacket(const RayPacket& pRays, float* pMaxDist, uint32 pMask, bool pStopAtFirstHit, bool ignoreM2Model) const
+    {
+        if (!iModel)
+            return 0;
+
+        pMask = pRays.IntersectBox(iBound, pMaxDist, pMask);
+        if (!pMask)
+            return 0;
+
+        // child bounds are defined in object space, same transform for all rays
+        RayPacket modRays;
+        float distance[RAY_PACKET_SIZE];
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            modRays.SetRay(lane, iInvRot * (pRays.GetOrigin(lane) - iPos) * iInvScale, iInvRot * pRays.GetDirection(lane));
+            distance[lane] = pMaxDist[lane] * iInvScale;
+        }
+        modRays.Prepare(RAY_PACKET_SIZE);
+
+        uint32 hitMask = iModel->IntersectRayPacket(modRays, distance, pMask, pStopAtFirstHit, ignoreM2Model);
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            if (hitMask & (1 << lane))
+                pMaxDist[lane] = distance[lane] * iScale;
+        return hitMask;
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo& info) const
     {
         if (!iModel)
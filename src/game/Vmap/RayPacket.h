@@ -0,0 +1,173 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _RAYPACKET_H
+#define _RAYPACKET_H
+
+#include <G3D/Vector3.h>
+#include <G3D/AABox.h>
+#include <G3D/Ray.h>
+
+#include <Platform/Define.h>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_RAY_PACKET_SSE
+#include <emmintrin.h>
+#endif
+
+#define RAY_PACKET_SIZE 4
+#define RAY_PACKET_FULL_MASK ((1 << RAY_PACKET_SIZE) - 1)
+
+/** Lane mask of a packet comparison */
+struct PacketMask
+{
+#ifdef VMAP_RAY_PACKET_SSE
+    __m128 v;
+    PacketMask(__m128 val) : v(val) {}
+    uint32 Bits() const { return uint32(_mm_movemask_ps(v)); }
+    PacketMask operator&(PacketMask const& o) const { return _mm_and_ps(v, o.v); }
+    PacketMask operator|(PacketMask const& o) const { return _mm_or_ps(v, o.v); }
+#else
+    uint32 bits;
+    explicit PacketMask(uint32 val) : bits(val) {}
+    uint32 Bits() const { return bits; }
+    PacketMask operator&(PacketMask const& o) const { return PacketMask(bits & o.bits); }
+    PacketMask operator|(PacketMask const& o) const { return PacketMask(bits | o.bits); }
+#endif
+};
+
+/** One float per ray of a packet, SSE register when available */
+struct PacketFloat
+{
+#ifdef VMAP_RAY_PACKET_SSE
+    __m128 v;
+    PacketFloat() {}
+    PacketFloat(__m128 val) : v(val) {}
+    explicit PacketFloat(float f) : v(_mm_set1_ps(f)) {}
+    static PacketFloat Load(float const* p) { return _mm_loadu_ps(p); }
+    void Store(float* p) const { _mm_storeu_ps(p, v); }
+
+    PacketFloat operator+(PacketFloat const& o) const { return _mm_add_ps(v, o.v); }
+    PacketFloat operator-(PacketFloat const& o) const { return _mm_sub_ps(v, o.v); }
+    PacketFloat operator*(PacketFloat const& o) const { return _mm_mul_ps(v, o.v); }
+    PacketFloat operator/(PacketFloat const& o) const { return _mm_div_ps(v, o.v); }
+    PacketMask operator<(PacketFloat const& o) const { return _mm_cmplt_ps(v, o.v); }
+    PacketMask operator<=(PacketFloat const& o) const { return _mm_cmple_ps(v, o.v); }
+    PacketMask operator>(PacketFloat const& o) const { return _mm_cmpgt_ps(v, o.v); }
+    PacketMask operator>=(PacketFloat const& o) const { return _mm_cmpge_ps(v, o.v); }
+    // lanes with the sign bit set, so -0.f counts as negative like in the scalar BIH traversal
+    PacketMask SignMask() const { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(v), 31)); }
+
+    // second argument is returned for NaN lanes, like the scalar (a > b) ? a : b
+    static PacketFloat Min(PacketFloat const& a, PacketFloat const& b) { return _mm_min_ps(a.v, b.v); }
+    static PacketFloat Max(PacketFloat const& a, PacketFloat const& b) { return _mm_max_ps(a.v, b.v); }
+    static PacketFloat Abs(PacketFloat const& a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+    static PacketFloat Select(PacketMask const& m, PacketFloat const& a, PacketFloat const& b) { return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)); }
+#else
+    float v[RAY_PACKET_SIZE];
+    PacketFloat() {}
+    explicit PacketFloat(float f) { for (float& l : v) l = f; }
+    static PacketFloat Load(float const* p) { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = p[i]; return r; }
+    void Store(float* p) const { for (int i = 0; i < RAY_PACKET_SIZE; ++i) p[i] = v[i]; }
+
+    PacketFloat operator+(PacketFloat const& o) const { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+    PacketFloat operator-(PacketFloat const& o) const { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+    PacketFloat operator*(PacketFloat const& o) const { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+    PacketFloat operator/(PacketFloat const& o) const { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = v[i] / o.v[i]; return r; }
+    PacketMask operator<(PacketFloat const& o) const { uint32 m = 0; for (int i = 0; i < RAY_PACKET_SIZE; ++i) if (v[i] < o.v[i]) m |= 1 << i; return PacketMask(m); }
+    PacketMask operator<=(PacketFloat const& o) const { uint32 m = 0; for (int i = 0; i < RAY_PACKET_SIZE; ++i) if (v[i] <= o.v[i]) m |= 1 << i; return PacketMask(m); }
+    PacketMask operator>(PacketFloat const& o) const { uint32 m = 0; for (int i = 0; i < RAY_PACKET_SIZE; ++i) if (v[i] > o.v[i]) m |= 1 << i; return PacketMask(m); }
+    PacketMask operator>=(PacketFloat const& o) const { uint32 m = 0; for (int i = 0; i < RAY_PACKET_SIZE; ++i) if (v[i] >= o.v[i]) m |= 1 << i; return PacketMask(m); }
+    PacketMask SignMask() const { uint32 m = 0; for (int i = 0; i < RAY_PACKET_SIZE; ++i) if (std::signbit(v[i])) m |= 1 << i; return PacketMask(m); }
+
+    static PacketFloat Min(PacketFloat const& a, PacketFloat const& b) { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return r; }
+    static PacketFloat Max(PacketFloat const& a, PacketFloat const& b) { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return r; }
+    static PacketFloat Abs(PacketFloat const& a) { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = fabs(a.v[i]); return r; }
+    static PacketFloat Select(PacketMask const& m, PacketFloat const& a, PacketFloat const& b) { PacketFloat r; for (int i = 0; i < RAY_PACKET_SIZE; ++i) r.v[i] = (m.bits & (1 << i)) ? a.v[i] : b.v[i]; return r; }
+#endif
+};
+
+/**
+    Up to RAY_PACKET_SIZE rays traced together, stored per axis so one axis of
+    all rays can be loaded at once. Unused lanes are copies of the first ray
+    and must be left out of the active lane mask passed to the intersections.
+*/
+struct RayPacket
+{
+    alignas(16) float org[3][RAY_PACKET_SIZE];
+    alignas(16) float dir[3][RAY_PACKET_SIZE];
+    alignas(16) float invDir[3][RAY_PACKET_SIZE];
+    uint32 negDir[3];                                       // lane mask of rays with negative direction per axis
+
+    void SetRay(uint32 lane, G3D::Vector3 const& origin, G3D::Vector3 const& direction)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            org[axis][lane] = origin[axis];
+            dir[axis][lane] = direction[axis];
+        }
+    }
+
+    //! fill unused lanes and precompute inverse directions, call after all SetRay
+    void Prepare(uint32 count)
+    {
+        for (uint32 lane = count; lane < RAY_PACKET_SIZE; ++lane)
+            SetRay(lane, GetOrigin(0), GetDirection(0));
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            negDir[axis] = 0;
+            for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            {
+                invDir[axis][lane] = 1.f / dir[axis][lane];
+                if (std::signbit(dir[axis][lane]))
+                    negDir[axis] |= 1 << lane;
+            }
+        }
+    }
+
+    G3D::Vector3 GetOrigin(uint32 lane) const { return G3D::Vector3(org[0][lane], org[1][lane], org[2][lane]); }
+    G3D::Vector3 GetDirection(uint32 lane) const { return G3D::Vector3(dir[0][lane], dir[1][lane], dir[2][lane]); }
+
+    //! lanes of mask hitting box within [0, maxDist], tNear/tFar get the clipped interval
+    uint32 IntersectBox(G3D::AABox const& box, float const* maxDist, uint32 mask, PacketFloat& tNear, PacketFloat& tFar) const
+    {
+        tNear = PacketFloat(0.f);
+        tFar = PacketFloat::Load(maxDist);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            PacketFloat o = PacketFloat::Load(org[axis]);
+            PacketFloat inv = PacketFloat::Load(invDir[axis]);
+            PacketFloat t1 = (PacketFloat(box.low()[axis]) - o) * inv;
+            PacketFloat t2 = (PacketFloat(box.high()[axis]) - o) * inv;
+            tNear = PacketFloat::Max(PacketFloat::Min(t1, t2), tNear);
+            tFar = PacketFloat::Min(PacketFloat::Max(t1, t2), tFar);
+        }
+        return (tNear <= tFar).Bits() & mask;
+    }
+
+    uint32 IntersectBox(G3D::AABox const& box, float const* maxDist, uint32 mask) const
+    {
+        PacketFloat tNear, tFar;
+        return IntersectBox(box, maxDist, mask, tNear, tFar);
+    }
+};
+
+#endif // _RAYPACKET_H
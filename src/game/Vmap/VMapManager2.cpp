@@ -17,6 +17,7 @@
  */
 
 #include <iomanip>
+#include <memory>
 #include <string>
 #include <sstream>
 #include "VMapManager2.h"
@@ -171,6 +172,47 @@ namespace VMAP
         }
         return result;
     }
+    //=========================================================
+
+    void VMapManager2::isInLineOfSight(unsigned int pMapId, LineOfSightQuery* queries, unsigned int count, bool ignoreM2Model)
+    {
+        if (!isLineOfSightCalcEnabled())
+            return;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos1, pos2;
+        std::vector<unsigned int> index;
+        pos1.reserve(count);
+        pos2.reserve(count);
+        index.reserve(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            LineOfSightQuery const& query = queries[i];
+            if (!query.inLineOfSight)
+                continue;
+
+            Vector3 start = convertPositionToInternalRep(query.x1, query.y1, query.z1);
+            Vector3 end = convertPositionToInternalRep(query.x2, query.y2, query.z2);
+            if (start == end)
+                continue;
+
+            pos1.push_back(start);
+            pos2.push_back(end);
+            index.push_back(i);
+        }
+
+        if (index.empty())
+            return;
+
+        std::unique_ptr<bool[]> results(new bool[index.size()]);
+        instanceTree->second->isInLineOfSight(pos1.data(), pos2.data(), results.get(), index.size(), ignoreM2Model);
+        for (size_t i = 0; i < index.size(); ++i)
+            queries[index[i]].inLineOfSight = results[i];
+    }
+
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -86,6 +86,66 @@ namespace VMAP
         return false;
     }
 
+    // IntersectTriangle for the rays of mask, returns lanes with a new closer hit
+    uint32 IntersectTrianglePacket(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, RayPacket const& rays, float* distance, uint32 mask)
+    {
+        Vector3 const& idx0 = points[tri.idx0];
+        Vector3 const& idx1 = points[tri.idx1];
+        Vector3 const& idx2 = points[tri.idx2];
+        Vector3 const e1 = idx1 - idx0;
+        Vector3 const e2 = idx2 - idx0;
+
+        PacketFloat const dx = PacketFloat::Load(rays.dir[0]);
+        PacketFloat const dy = PacketFloat::Load(rays.dir[1]);
+        PacketFloat const dz = PacketFloat::Load(rays.dir[2]);
+        PacketFloat const e1x(e1.x), e1y(e1.y), e1z(e1.z);
+        PacketFloat const e2x(e2.x), e2y(e2.y), e2z(e2.z);
+
+        // p = dir x e2
+        PacketFloat const px = dy * e2z - dz * e2y;
+        PacketFloat const py = dz * e2x - dx * e2z;
+        PacketFloat const pz = dx * e2y - dy * e2x;
+        PacketFloat const a = e1x * px + e1y * py + e1z * pz;
+
+        // Determinant is ill-conditioned
+        mask &= (PacketFloat::Abs(a) >= PacketFloat(EPS)).Bits();
+        if (!mask)
+            return 0;
+
+        PacketFloat const f = PacketFloat(1.0f) / a;
+        PacketFloat const sx = PacketFloat::Load(rays.org[0]) - PacketFloat(idx0.x);
+        PacketFloat const sy = PacketFloat::Load(rays.org[1]) - PacketFloat(idx0.y);
+        PacketFloat const sz = PacketFloat::Load(rays.org[2]) - PacketFloat(idx0.z);
+        PacketFloat const u = f * (sx * px + sy * py + sz * pz);
+
+        mask &= ((u >= PacketFloat(0.0f)) & (u <= PacketFloat(1.0f))).Bits();
+        if (!mask)
+            return 0;
+
+        // q = s x e1
+        PacketFloat const qx = sy * e1z - sz * e1y;
+        PacketFloat const qy = sz * e1x - sx * e1z;
+        PacketFloat const qz = sx * e1y - sy * e1x;
+        PacketFloat const v = f * (dx * qx + dy * qy + dz * qz);
+
+        mask &= ((v >= PacketFloat(0.0f)) & (u + v <= PacketFloat(1.0f))).Bits();
+        if (!mask)
+            return 0;
+
+        PacketFloat const t = f * (e2x * qx + e2y * qy + e2z * qz);
+        PacketFloat const dist = PacketFloat::Load(distance);
+        mask &= ((t > PacketFloat(0.0f)) & (t < dist)).Bits();
+        if (!mask)
+            return 0;
+
+        float tLanes[RAY_PACKET_SIZE];
+        t.Store(tLanes);
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+            if (mask & (1 << lane))
+                distance[lane] = tLanes[lane];
+        return mask;
+    }
+
     class TriBoundFunc
     {
         public:
@@ -396,6 +456,31 @@ namespace VMAP
         return callback.hit;
     }
 
+    struct GModelRayPacketCallback
+    {
+        GModelRayPacketCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
+            vertices(vert.begin()), triangles(tris.begin()), hitMask(0) {}
+        uint32 operator()(const RayPacket& rays, uint32 entry, float* distance, uint32 mask, bool /*pStopAtFirstHit*/, bool /*ignoreM2Model*/)
+        {
+            uint32 result = IntersectTrianglePacket(triangles[entry], vertices, rays, distance, mask);
+            hitMask |= result;
+            return result;
+        }
+        std::vector<Vector3>::const_iterator vertices;
+        std::vector<MeshTriangle>::const_iterator triangles;
+        uint32 hitMask;
+    };
+
+    uint32 GroupModel::IntersectRayPacket(const RayPacket& rays, float* distance, uint32 mask, bool stopAtFirstHit) const
+    {
+        if (triangles.empty())
+            return 0;
+
+        GModelRayPacketCallback callback(triangles, vertices);
+        meshTree.intersectRayPacket(rays, callback, distance, mask, stopAtFirstHit);
+        return callback.hitMask;
+    }
+
     bool GroupModel::IsInsideObject(Vector3 const& pos, Vector3 const& down, float& z_dist) const
     {
         if (triangles.empty() || !iBound.contains(pos))
@@ -460,6 +545,32 @@ namespace VMAP
         return isc.hit;
     }
 
+    struct WModelRayPacketCallBack
+    {
+        WModelRayPacketCallBack(const std::vector<GroupModel>& mod): models(mod.begin()), hitMask(0) {}
+        uint32 operator()(const RayPacket& rays, uint32 entry, float* distance, uint32 mask, bool pStopAtFirstHit, bool /*ignoreM2Model*/)
+        {
+            uint32 result = models[entry].IntersectRayPacket(rays, distance, mask, pStopAtFirstHit);
+            hitMask |= result;
+            return result;
+        }
+        std::vector<GroupModel>::const_iterator models;
+        uint32 hitMask;
+    };
+
+    uint32 WorldModel::IntersectRayPacket(const RayPacket& rays, float* distance, uint32 mask, bool stopAtFirstHit, bool ignoreM2Model) const
+    {
+        if (ignoreM2Model && (modelFlags & MOD_M2))
+            return 0;
+
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRayPacket(rays, distance, mask, stopAtFirstHit);
+
+        WModelRayPacketCallBack isc(groupModels);
+        groupTree.intersectRayPacket(rays, isc, distance, mask, stopAtFirstHit, ignoreM2Model);
+        return isc.hitMask;
+    }
+
     class WModelAreaCallback
     {
         public:
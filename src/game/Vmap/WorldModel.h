@@ -87,6 +87,7 @@ namespace VMAP
             void setMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri);
             void setLiquidData(WmoLiquid*& liquid) { iLiquid = liquid; liquid = nullptr; }
             bool IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit, bool ignoreM2Model = false) const;
+            uint32 IntersectRayPacket(const RayPacket& rays, float* distance, uint32 mask, bool stopAtFirstHit) const;
             bool IsInsideObject(const Vector3& pos, const Vector3& down, float& z_dist) const;
             bool GetLiquidLevel(const Vector3& pos, float& liqHeight) const;
             uint32 GetLiquidType() const;
@@ -119,6 +120,7 @@ namespace VMAP
             void setGroupModels(std::vector<GroupModel>& models);
             void setRootWmoID(uint32 id) { RootWMOID = id; }
             bool IntersectRay(const G3D::Ray& ray, float& distance, bool stopAtFirstHit, bool ignoreM2Model = false) const;
+            uint32 IntersectRayPacket(const RayPacket& rays, float* distance, uint32 mask, bool stopAtFirstHit, bool ignoreM2Model = false) const;
             bool IntersectPoint(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, AreaInfo& info) const;
             bool GetLocationInfo(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, GroupLocationInfo& info) const;
             bool writeFile(const std::string& filename);
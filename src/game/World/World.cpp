@@ -22,6 +22,8 @@
 
 #include "World/World.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorageSnapshot.h"
+#include "Maps/CollisionQueryLog.h"
 #include "Config/Config.h"
 #include "Models/M2Stores.h"
 #include "Platform/Define.h"
@@ -73,6 +75,7 @@
 #include "Anticheat/Anticheat.hpp"
 #include "LFG/LFGMgr.h"
 #include "Vmap/GameObjectModel.h"
+#include "Entities/PlayerLoginCache.h"
 
 #ifdef BUILD_AHBOT
  #include "AuctionHouseBot/AuctionHouseBot.h"
@@ -149,6 +152,7 @@ World::~World()
     MMAP::MMapFactory::clear();
 
     m_lfgQueueThread.join();
+    m_bgQueueThread.join();
 }
 
 /// Cleanups before world stop
@@ -645,6 +649,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_MAP_SCRIPT_BUDGET, "MapUpdate.ScriptBudget", 0);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -775,6 +780,9 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
 
+    setConfig(CONFIG_BOOL_PACKET_HANDLER_STATS, "PacketHandlerStats", true);
+    setConfig(CONFIG_UINT32_SLOW_PACKET_HANDLER_TIME, "LogSlowPacketHandlerTime", 0);
+
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
     if (int clientCacheId = sConfig.GetIntDefault("ClientCacheVersion", 0))
@@ -852,6 +860,14 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInBGArenas = MAX_VISIBILITY_DISTANCE;
     }
 
+    setConfig(CONFIG_BOOL_MOVEMENT_RELAY_CONTINENTS, "Visibility.MovementRelay.Continents", false);
+    setConfig(CONFIG_BOOL_MOVEMENT_RELAY_INSTANCES, "Visibility.MovementRelay.Instances", false);
+    setConfig(CONFIG_BOOL_MOVEMENT_RELAY_BGARENAS, "Visibility.MovementRelay.BGArenas", false);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_RELAY_NEAR_DISTANCE, "Visibility.MovementRelay.NearDistance", 40.0f);
+    setConfigMinMax(CONFIG_FLOAT_MOVEMENT_RELAY_FAR_DISTANCE, "Visibility.MovementRelay.FarDistance", 80.0f, getConfig(CONFIG_FLOAT_MOVEMENT_RELAY_NEAR_DISTANCE), MAX_VISIBILITY_DISTANCE);
+    setConfigMinMax(CONFIG_UINT32_MOVEMENT_RELAY_MID_INTERVAL, "Visibility.MovementRelay.MidInterval", 1000, 0, 10000);
+    setConfigMinMax(CONFIG_UINT32_MOVEMENT_RELAY_FAR_INTERVAL, "Visibility.MovementRelay.FarInterval", 2000, getConfig(CONFIG_UINT32_MOVEMENT_RELAY_MID_INTERVAL), 10000);
+
     ///- Load the CharDelete related config options
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_METHOD, "CharDelete.Method", 0, 0, 1);
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0, 0, getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL));
@@ -885,6 +901,9 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the world DB snapshot directory, empty disables snapshots
+    SQLStorageSnapshot::SetDirectory(sConfig.GetStringDefault("WorldDataSnapshotDir", ""));
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -903,6 +922,13 @@ void World::LoadConfigSettings(bool reload)
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
 
+    ///- Record terrain/vmap/mmap queries for collisionbench, empty file name disables recording
+    sCollisionQueryLog.Initialize(sConfig.GetStringDefault("CollisionQueryLog.File", ""), sConfig.GetIntDefault("CollisionQueryLog.Rate", 100));
+
+    ///- Login data of logged out characters kept for relog, 0 size disables
+    sPlayerLoginCache.Initialize(sConfig.GetIntDefault("PlayerLoginCache.Size", 0), sConfig.GetIntDefault("PlayerLoginCache.Lifetime", 300),
+                                 sConfig.GetIntDefault("PlayerLoginCache.MaxPending", 8));
+
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
 
@@ -1136,13 +1162,21 @@ void World::SetInitialWorldSettings()
     sObjectMgr.LoadCreatureSpawnEntry();
 
     sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
+    if (!sObjectMgr.LoadCreatures())
+    {
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Error message displayed in function already
+    }
 
     sLog.outString("Loading Gameobject Spawn Entry Data..."); // must be before LoadGameObjects
     sObjectMgr.LoadGameObjectSpawnEntry();
 
     sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
+    if (!sObjectMgr.LoadGameObjects())
+    {
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Error message displayed in function already
+    }
 
     sLog.outString("Loading SpellsScriptTarget...");
     sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates, LoadCreatures and LoadGameobjectInfo
@@ -2116,6 +2150,14 @@ void World::StartLFGQueueThread()
     });
 }
 
+void World::StartBGQueueThread()
+{
+    m_bgQueueThread = std::thread([&]()
+    {
+        m_bgQueue.Update();
+    });
+}
+
 void World::BroadcastToGroup(ObjectGuid groupGuid, std::vector<WorldPacket> const& packets)
 {
     if (Group* group = sObjectMgr.GetGroupById(groupGuid.GetCounter()))
@@ -2524,6 +2566,7 @@ void World::ResetDailyQuests()
 {
     DETAIL_LOG("Daily quests reset for all characters.");
     CharacterDatabase.Execute("DELETE FROM character_queststatus_daily");
+    sPlayerLoginCache.InvalidateAll();
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
             itr->second->GetPlayer()->ResetDailyQuestStatus();
@@ -2538,6 +2581,7 @@ void World::ResetWeeklyQuests()
 {
     DETAIL_LOG("Weekly quests reset for all characters.");
     CharacterDatabase.Execute("DELETE FROM character_queststatus_weekly");
+    sPlayerLoginCache.InvalidateAll();
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
             itr->second->GetPlayer()->ResetWeeklyQuestStatus();
@@ -2554,6 +2598,7 @@ void World::ResetMonthlyQuests()
     DETAIL_LOG("Monthly quests reset for all characters.");
 
     CharacterDatabase.Execute(_TRUNCATE_ " character_queststatus_monthly");
+    sPlayerLoginCache.InvalidateAll();
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2567,6 +2612,7 @@ void World::ResetRandomBattleground()
     DETAIL_LOG("Random battleground reset for all characters.");
 
     CharacterDatabase.Execute("DELETE FROM character_battleground_random");
+    sPlayerLoginCache.InvalidateAll();
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2835,6 +2881,39 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    // handler times are cumulative, reset only by .server opcodestats reset
+    if (getConfig(CONFIG_BOOL_PACKET_HANDLER_STATS))
+    {
+        static char const* threadNames[MAX_OPCODE_HANDLER_THREAD] = { "world", "map", "network" };
+        for (uint32 thread = 0; thread < MAX_OPCODE_HANDLER_THREAD; ++thread)
+        {
+            for (auto const& summary : m_opcodeHandlerStats.GetSummary(OpcodeHandlerThread(thread), false))
+            {
+                metric::measurement meas("world.metrics.packets.handler", { {"opcode", opcodeTable[summary.opcode].name}, {"thread", threadNames[thread]} });
+                meas.add_field("count", std::to_string(summary.count));
+                meas.add_field("total", std::to_string(summary.totalTime));
+                meas.add_field("max", std::to_string(summary.maxTime));
+                meas.add_field("p50", std::to_string(summary.p50));
+                meas.add_field("p99", std::to_string(summary.p99));
+            }
+        }
+    }
+
+    BufferPool::Stats poolStats = BufferPool::GetStats();
+    metric::measurement meas_pool("world.metrics.bufferpool");
+    meas_pool.add_field("hits", std::to_string(poolStats.hits));
+    meas_pool.add_field("misses", std::to_string(poolStats.misses));
+    meas_pool.add_field("oversized", std::to_string(poolStats.oversized));
+    meas_pool.add_field("retained", std::to_string(poolStats.bytesRetained));
+
+    for (auto const& slabStats : SlabPool::GetAllStats())
+    {
+        metric::measurement meas_slab("world.metrics.slabpool", { {"pool", slabStats.name} });
+        meas_slab.add_field("live", std::to_string(slabStats.live));
+        meas_slab.add_field("free", std::to_string(slabStats.free));
+        meas_slab.add_field("bytes", std::to_string(slabStats.bytes));
+    }
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
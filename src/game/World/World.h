@@ -32,6 +32,9 @@
 #include "Globals/GraveyardManager.h"
 #include "LFG/LFG.h"
 #include "LFG/LFGQueue.h"
+#include "BattleGround/BattleGroundQueue.h"
+#include "Server/OpcodeHandlerStats.h"
+#include "DBScripts/DBScriptStats.h"
 
 #include <set>
 #include <list>
@@ -224,6 +227,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE,
     CONFIG_UINT32_SUNSREACH_COUNTER,
+    CONFIG_UINT32_SLOW_PACKET_HANDLER_TIME,
+    CONFIG_UINT32_MAP_SCRIPT_BUDGET,
+    CONFIG_UINT32_MOVEMENT_RELAY_MID_INTERVAL,
+    CONFIG_UINT32_MOVEMENT_RELAY_FAR_INTERVAL,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -331,6 +338,8 @@ enum eConfigFloatValues
     CONFIG_FLOAT_MOD_INCREASED_XP,
     CONFIG_FLOAT_MOD_INCREASED_GOLD,
     CONFIG_FLOAT_MAX_RECRUIT_A_FRIEND_DISTANCE,
+    CONFIG_FLOAT_MOVEMENT_RELAY_NEAR_DISTANCE,
+    CONFIG_FLOAT_MOVEMENT_RELAY_FAR_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -414,6 +423,10 @@ enum eConfigBoolValues
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
+    CONFIG_BOOL_PACKET_HANDLER_STATS,
+    CONFIG_BOOL_MOVEMENT_RELAY_CONTINENTS,
+    CONFIG_BOOL_MOVEMENT_RELAY_INSTANCES,
+    CONFIG_BOOL_MOVEMENT_RELAY_BGARENAS,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -563,6 +576,8 @@ class World
 
         /// Get the path where data (dbc, maps) are stored on disk
         std::string GetDataPath() const { return m_dataPath; }
+        /// Set data path for tools using terrain data without loading the config, must end with a path separator
+        void SetDataPath(std::string const& dataPath) { m_dataPath = dataPath; }
 
         /// When server started?
         time_t const& GetStartTime() const { return m_startTime; }
@@ -696,6 +711,8 @@ class World
         Messager<World>& GetMessager() { return m_messager; }
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
+        OpcodeHandlerStats& GetOpcodeHandlerStats() { return m_opcodeHandlerStats; } // thread safe due to atomics
+        DBScriptStats& GetDBScriptStats() { return m_dbScriptStats; } // thread safe due to lock
 
         void LoadWorldSafeLocs() const;
         void LoadGraveyardZones();
@@ -707,6 +724,8 @@ class World
         LFGQueue& GetLFGQueue() { return m_lfgQueue; }
 
         void StartLFGQueueThread();
+        BattleGroundQueue& GetBGQueue() { return m_bgQueue; }
+        void StartBGQueueThread();
         void BroadcastToGroup(ObjectGuid groupGuid, std::vector<WorldPacket> const& packets);
         void BroadcastPersonalized(std::map<ObjectGuid, std::vector<WorldPacket>> const& personalizedPackets);
     protected:
@@ -827,6 +846,8 @@ class World
 
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
+        OpcodeHandlerStats m_opcodeHandlerStats;
+        DBScriptStats m_dbScriptStats;
         // online count logging
         std::array<std::atomic<uint32>, 2> m_onlineTeams;
         std::array<std::atomic<uint32>, MAX_RACES> m_onlineRaces;
@@ -839,6 +860,8 @@ class World
         // Housing this here but logically it is completely asynchronous - TODO: Separate this and unify with BG queue
         LFGQueue m_lfgQueue;
         std::thread m_lfgQueueThread;
+        BattleGroundQueue m_bgQueue;
+        std::thread m_bgQueueThread;
 };
 
 extern uint32 realmID;
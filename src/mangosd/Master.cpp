@@ -148,6 +148,7 @@ int Master::Run()
     }
 
     sWorld.StartLFGQueueThread();
+    sWorld.StartBGQueueThread();
 
     MaNGOS::Thread* cliThread = nullptr;
 
@@ -363,6 +364,21 @@ bool Master::_StartDB()
         return false;
     }
 
+    ///- Connections executing the queries of character login in parallel
+    nConnections = sConfig.GetIntDefault("CharacterDatabaseLoginConnections", 0);
+    if (nConnections > 0)
+        sLog.outString("Character Database login query connections: %i", nConnections);
+
+    if (!CharacterDatabase.InitQueryWorkers(nConnections))
+    {
+        sLog.outError("Cannot create login query connections to Character database %s", dbstring.c_str());
+
+        ///- Wait for already started DB delay threads to end
+        WorldDatabase.HaltDelayThread();
+        CharacterDatabase.HaltDelayThread();
+        return false;
+    }
+
     ///- Get login database info from configuration file
     dbstring = sConfig.GetStringDefault("LoginDatabaseInfo");
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
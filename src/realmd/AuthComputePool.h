@@ -0,0 +1,59 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _AUTHCOMPUTEPOOL_H
+#define _AUTHCOMPUTEPOOL_H
+
+#include "Common.h"
+
+#include <boost/asio.hpp>
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Threads running the blocking part of auth commands: account lookups with synchronous login DB
+ * queries and SRP6 big number math. The socket handler posts the work here and returns, the work
+ * posts its continuation back to the network thread of the socket, so listener threads never wait.
+ */
+class AuthComputePool
+{
+    public:
+        static AuthComputePool& Instance();
+
+        void Start(uint32 threads);
+        // executes the already posted tasks before returning
+        void Stop();
+
+        void Post(std::function<void()>&& task) { m_service.post(std::move(task)); }
+
+    private:
+        boost::asio::io_service m_service;
+        std::unique_ptr<boost::asio::io_service::work> m_work;
+        std::vector<std::thread> m_threads;
+};
+
+#define sAuthComputePool AuthComputePool::Instance()
+#endif
+/// @}
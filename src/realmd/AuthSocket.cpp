@@ -29,6 +29,7 @@
 #include "RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthComputePool.h"
 #include "Auth/SRP6.h"
 #include "Util/CommonDefines.h"
 
@@ -179,10 +180,25 @@ std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B,
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), m_timeoutTimer(service)
+    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountId(0), _accountSecurityLevel(SEC_PLAYER),
+      m_service(service), m_timeoutTimer(service)
 {
 }
 
+void AuthSocket::Defer(std::function<void()>&& work, std::function<void()>&& continuation)
+{
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    sAuthComputePool.Post([self, work = std::move(work), continuation = std::move(continuation)]()
+    {
+        work();
+        self->m_service.post([self, continuation]()
+        {
+            if (!self->IsClosed())
+                continuation();
+        });
+    });
+}
+
 bool AuthSocket::Open()
 {
     m_timeoutTimer.expires_from_now(boost::posix_time::seconds(30));
@@ -348,8 +364,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -374,7 +388,23 @@ bool AuthSocket::_HandleLogonChallenge()
     LoginDatabase.escape_string(_safelogin);
     _safelocale = m_locale;
     LoginDatabase.escape_string(_safelocale);
-    LoginDatabase.escape_string(m_os);
+
+    ///- Account lookup and SRP6 math block, so they run on the compute pool and the reply is sent once done
+    std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+    std::shared_ptr<eStatus> status = std::make_shared<eStatus>(STATUS_CLOSED);
+    Defer([this, pkt, status]() { *status = LookupLogonChallenge(*pkt); },
+          [this, pkt, status]()
+    {
+        Write((const char*)pkt->contents(), pkt->size());
+        _status = *status;
+    });
+    return true;
+}
+
+/// Look up the account of a logon challenge and fill the reply, returns the status awaiting the next command
+AuthSocket::eStatus AuthSocket::LookupLogonChallenge(ByteBuffer& pkt)
+{
+    eStatus status = STATUS_CLOSED;
 
     pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
     pkt << uint8(0x00);
@@ -391,9 +421,11 @@ bool AuthSocket::_HandleLogonChallenge()
     }
     else
     {
-        ///- Get the account details from the account table
+        ///- Get the account details from the account table, together with active ban (if any) in same round trip
         // No SQL injection (escaped user name)
-        auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
+        auto queryResult = LoginDatabase.PQuery("SELECT a.id,a.locked,a.lockedIp,a.gmlevel,a.v,a.s,a.token,b.banned_at,b.expires_at FROM account a "
+                                                "LEFT JOIN account_banned b ON b.account_id = a.id AND b.active = 1 AND (b.expires_at > " _UNIXTIME_ " OR b.expires_at = b.banned_at) "
+                                                "WHERE a.username = '%s'", _safelogin.c_str());
         if (queryResult)
         {
             Field* fields = queryResult->Fetch();
@@ -430,11 +462,9 @@ bool AuthSocket::_HandleLogonChallenge()
             if (!locked && !broken)
             {
                 ///- If the account is banned, reject the logon attempt
-                auto banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                                         "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", fields[0].GetUInt32());
-                if (banresult)
+                if (!fields[7].IsNULL())
                 {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
+                    if (fields[7].GetUInt64() == fields[8].GetUInt64())
                     {
                         pkt << uint8(AUTH_LOGON_FAILED_BANNED);
                         BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
@@ -494,9 +524,10 @@ bool AuthSocket::_HandleLogonChallenge()
 
                     uint8 secLevel = fields[3].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                    _accountId = fields[0].GetUInt32();
 
                     ///- All good, await client's proof
-                    _status = STATUS_LOGON_PROOF;
+                    status = STATUS_LOGON_PROOF;
                 }
             }
         }
@@ -504,8 +535,7 @@ bool AuthSocket::_HandleLogonChallenge()
             pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
     }
 
-    Write((const char*)pkt.contents(), pkt.size());
-    return true;
+    return status;
 }
 
 /// Logon Proof command handler
@@ -535,133 +565,176 @@ bool AuthSocket::_HandleLogonProof()
     }
     /// </ul>
 
-    ///- Continue the SRP6 calculation based on data received from the client
-    if(!srp.CalculateSessionKey(lp.A, 32))
+    ///- Read the authenticator pin following the proof now, the proof is checked on the compute pool
+    bool hasPin = (lp.securityFlags & SECURITY_FLAG_AUTHENTICATOR) || !_token.empty();
+    bool pinRead = false;
+    uint8 pinCount = 0;
+    std::vector<uint8> keys;
+    if (hasPin && Read((char*)&pinCount, sizeof(uint8)))
     {
-        BASIC_LOG("[AuthChallenge] Session calculation failed for account %s!", _login.c_str());
-        return false;
+        keys.resize(pinCount + 1);
+        pinRead = Read((char*)keys.data(), sizeof(uint8) * pinCount);
+        keys[pinCount] = '\0';
     }
 
-    srp.HashSessionKey();
-    srp.CalculateProof(_login);
+    ///- Continue the SRP6 calculation based on data received from the client
+    std::shared_ptr<bool> sessionValid = std::make_shared<bool>(false);
+    std::shared_ptr<bool> passwordValid = std::make_shared<bool>(false);
+    Defer([this, lp, sessionValid, passwordValid]() mutable
+    {
+        *sessionValid = srp.CalculateSessionKey(lp.A, 32);
+        if (!*sessionValid)
+            return;
+
+        srp.HashSessionKey();
+        srp.CalculateProof(_login);
 
-    ///- Check if SRP6 results match (password is correct), else send an error
-    if (!srp.Proof(lp.M1, 20))
+        // Proof is false if the SRP6 results match
+        *passwordValid = !srp.Proof(lp.M1, 20);
+    },
+    [this, lp, sessionValid, passwordValid, hasPin, pinRead, pinCount, keys]()
     {
-        if (lp.securityFlags & SECURITY_FLAG_AUTHENTICATOR || !_token.empty())
+        if (!*sessionValid)
         {
-            uint8 pinCount;
-            if (!Read((char*)&pinCount, sizeof(uint8)))
-            {
-                const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 3, 0 };
-                Write(data, sizeof(data));
-                return true;
-            }
-            std::vector<uint8> keys(pinCount + 1);
-            if (!Read((char*)keys.data(), sizeof(uint8) * pinCount))
+            BASIC_LOG("[AuthChallenge] Session calculation failed for account %s!", _login.c_str());
+            Close();
+            return;
+        }
+
+        ///- Check if SRP6 results match (password is correct), else send an error
+        if (*passwordValid)
+        {
+            if (hasPin)
             {
-                const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 3, 0 };
-                Write(data, sizeof(data));
-                return true;
+                if (!pinRead)
+                {
+                    const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 3, 0 };
+                    Write(data, sizeof(data));
+                    return;
+                }
+
+                auto ServerToken = generateToken(_token.c_str());
+                auto clientToken = atoi((const char*)keys.data());
+                if (ServerToken != clientToken)
+                {
+                    BASIC_LOG("[AuthChallenge] Account %s tried to login with wrong pincode! Given %u Expected %u Pin Count: %u", _login.c_str(), clientToken, ServerToken, pinCount);
+
+                    const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
+                    Write(data, sizeof(data));
+                    return;
+                }
             }
 
-            keys[pinCount] = '\0';
-            auto ServerToken = generateToken(_token.c_str());
-            auto clientToken = atoi((const char*)keys.data());
-            if (ServerToken != clientToken)
+            if (!VerifyVersion(lp.A, sizeof(lp.A), lp.crc_hash, false))
             {
-                BASIC_LOG("[AuthChallenge] Account %s tried to login with wrong pincode! Given %u Expected %u Pin Count: %u", _login.c_str(), clientToken, ServerToken, pinCount);
+                BASIC_LOG("[AuthChallenge] Account %s tried to login with modified client!", _login.c_str());
 
-                const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
+                const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_VERSION_INVALID };
                 Write(data, sizeof(data));
-                return true;
+                return;
             }
-        }
 
-        if (!VerifyVersion(lp.A, sizeof(lp.A), lp.crc_hash, false))
-        {
-            BASIC_LOG("[AuthChallenge] Account %s tried to login with modified client!", _login.c_str());
+            BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
-            const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_VERSION_INVALID };
-            Write(data, sizeof(data));
-            return true;
-        }
+            ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
+            // No SQL injection (user input bound as statement parameters) and IP address as received by socket
+            // account id is known since challenge, so both writes go to the async queue without a lookup
+            static SqlStatementID updAccount;
+            static SqlStatementID insLogon;
 
-        BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
+            const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
+            SqlStatement stmt = LoginDatabase.CreateStatement(updAccount, "UPDATE account SET sessionkey = ?, locale = ?, failed_logins = 0, os = ?, platform = ? WHERE id = ?");
+            stmt.addString(K_hex);
+            stmt.addString(m_locale);
+            stmt.addString(m_os);
+            stmt.addString(m_platform);
+            stmt.addUInt32(_accountId);
+            stmt.Execute();
+            OPENSSL_free((void*)K_hex);
 
-        ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
-        // No SQL injection (escaped user input) and IP address as received by socket
-        const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
-        LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-        std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-        if (loginfail)
-            LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s'," _NOW_ ",'%u')", loginfail->Fetch()[0].GetUInt32(), m_address.c_str(), LOGIN_TYPE_REALMD);
-        OPENSSL_free((void*)K_hex);
+            stmt = LoginDatabase.CreateStatement(insLogon, "INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES(?,?," _NOW_ ",?)");
+            stmt.PExecute(_accountId, m_address.c_str(), uint32(LOGIN_TYPE_REALMD));
 
-        ///- Finish SRP6 and send the final result to the client
-        Sha1Hash sha;
-        srp.Finalize(sha);
+            ///- Finish SRP6 and send the final result to the client
+            Sha1Hash sha;
+            srp.Finalize(sha);
 
-        SendProof(sha);
+            SendProof(sha);
 
-        ///- Set _status to authed!
-        _status = STATUS_AUTHED;
-    }
-    else
-    {
-        if (_build > 6005)                                  // > 1.12.2
-        {
-            const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
-            Write(data, sizeof(data));
+            ///- Characters may have been created or deleted since the last login of the account
+            sRealmList.InvalidateRealmCharacters(_accountId);
+
+            ///- Set _status to authed!
+            _status = STATUS_AUTHED;
         }
         else
         {
-            // 1.x not react incorrectly at 4-byte message use 3 as real error
-            const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT };
-            Write(data, sizeof(data));
+            if (_build > 6005)                              // > 1.12.2
+            {
+                const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
+                Write(data, sizeof(data));
+            }
+            else
+            {
+                // 1.x not react incorrectly at 4-byte message use 3 as real error
+                const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT };
+                Write(data, sizeof(data));
+            }
+
+            BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
+
+            ///- Failed logins are counted with synchronous queries, so on the compute pool
+            if (sConfig.GetIntDefault("WrongPass.MaxCount", 0) > 0)
+            {
+                std::string login = _login;
+                std::string safeLogin = _safelogin;
+                std::string address = m_address;
+                sAuthComputePool.Post([login, safeLogin, address]() { CountFailedLogin(login, safeLogin, address); });
+            }
         }
+    });
+    return true;
+}
 
-        BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
+/// Count a failed login of the account and ban the account or IP once the configured limit is reached
+void AuthSocket::CountFailedLogin(std::string const& login, std::string const& safeLogin, std::string const& address)
+{
+    uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
 
-        uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
-        if (MaxWrongPassCount > 0)
-        {
-            // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-            LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
+    // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+    // executed directly, the count read below must include it
+    LoginDatabase.DirectPExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", safeLogin.c_str());
 
-            if (auto loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+    if (auto loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", safeLogin.c_str()))
+    {
+        Field* fields = loginfail->Fetch();
+        uint32 failed_logins = fields[1].GetUInt32();
 
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+        if (failed_logins >= MaxWrongPassCount)
+        {
+            uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+            bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
 
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
-                                               "VALUES ('%u'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
+            if (WrongPassBanType)
+            {
+                uint32 acc_id = fields[0].GetUInt32();
+                LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
+                                       "VALUES ('%u'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                       acc_id, WrongPassBanTime);
+                BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                          login.c_str(), WrongPassBanTime, failed_logins);
+            }
+            else
+            {
+                std::string current_ip = address;
+                LoginDatabase.escape_string(current_ip);
+                LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban')",
+                                       current_ip.c_str(), WrongPassBanTime);
+                BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                          current_ip.c_str(), WrongPassBanTime, login.c_str(), failed_logins);
             }
         }
     }
-    return true;
 }
 
 /// Reconnect Challenge command handler
@@ -707,30 +780,44 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
-
-    // Stop if the account is not found
-    if (!queryResult)
+    ///- The session key is looked up on the compute pool
+    std::shared_ptr<bool> found = std::make_shared<bool>(false);
+    Defer([this, found]()
     {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
-        Close();
-        return false;
-    }
+        auto queryResult = LoginDatabase.PQuery("SELECT sessionkey, id, gmlevel FROM account WHERE username = '%s'", _safelogin.c_str());
+        if (!queryResult)
+            return;
+
+        Field* fields = queryResult->Fetch();
+        srp.SetStrongSessionKey(fields[0].GetString());
+        _accountId = fields[1].GetUInt32();
 
-    Field* fields = queryResult->Fetch();
-    srp.SetStrongSessionKey(fields[0].GetString());
+        uint8 secLevel = fields[2].GetUInt8();
+        _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+        *found = true;
+    },
+    [this, found]()
+    {
+        // Stop if the account is not found
+        if (!*found)
+        {
+            sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
+            Close();
+            return;
+        }
 
-    ///- All good, await client's proof
-    _status = STATUS_RECON_PROOF;
+        ///- All good, await client's proof
+        _status = STATUS_RECON_PROOF;
 
-    ///- Sending response
-    ByteBuffer pkt;
-    pkt << (uint8)  CMD_AUTH_RECONNECT_CHALLENGE;
-    pkt << (uint8)  0x00;
-    _reconnectProof.SetRand(16 * 8);
-    pkt.append(_reconnectProof.AsByteArray(16));        // 16 bytes random
-    pkt.append(VersionChallenge.data(), VersionChallenge.size());
-    Write((const char*)pkt.contents(), pkt.size());
+        ///- Sending response
+        ByteBuffer pkt;
+        pkt << (uint8)  CMD_AUTH_RECONNECT_CHALLENGE;
+        pkt << (uint8)  0x00;
+        _reconnectProof.SetRand(16 * 8);
+        pkt.append(_reconnectProof.AsByteArray(16));    // 16 bytes random
+        pkt.append(VersionChallenge.data(), VersionChallenge.size());
+        Write((const char*)pkt.contents(), pkt.size());
+    });
     return true;
 }
 
@@ -776,6 +863,9 @@ bool AuthSocket::_HandleReconnectProof()
         pkt << uint16(0x00);                                // 2 bytes zeros
         Write((const char*)pkt.contents(), pkt.size());
 
+        ///- Characters may have been created or deleted since the account was looked up at reconnect challenge
+        sRealmList.InvalidateRealmCharacters(_accountId);
+
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
 
@@ -795,37 +885,37 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
-
-    auto queryResult = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!queryResult)
+    ///- Account id and security level are known since (reconnect) challenge
+    if (!_accountId)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
         Close();
         return false;
     }
 
-    uint32 id = (*queryResult)[0].GetUInt32();
-    uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
-
-    ///- Update realm list if need
-    sRealmList.UpdateIfNeed();
+    ///- Character amounts not cached yet are queried on the compute pool
+    std::shared_ptr<RealmList::RealmCharacters> realmCharacters = std::make_shared<RealmList::RealmCharacters>();
+    Defer([this, realmCharacters]() { sRealmList.GetRealmCharacters(_accountId, *realmCharacters); },
+          [this, realmCharacters]()
+    {
+        ///- Update realm list if need
+        sRealmList.UpdateIfNeed();
 
-    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-    ByteBuffer pkt;
-    LoadRealmlist(pkt, id, accountSecurityLevel);
+        ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+        ByteBuffer pkt;
+        LoadRealmlist(pkt, *realmCharacters, _accountSecurityLevel);
 
-    ByteBuffer hdr;
-    hdr << (uint8) CMD_REALM_LIST;
-    hdr << (uint16)pkt.size();
-    hdr.append(pkt);
+        ByteBuffer hdr;
+        hdr << (uint8) CMD_REALM_LIST;
+        hdr << (uint16)pkt.size();
+        hdr.append(pkt);
 
-    Write((const char*)hdr.contents(), hdr.size());
+        Write((const char*)hdr.contents(), hdr.size());
+    });
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, RealmList::RealmCharacters const& realmCharacters, uint8 securityLevel)
 {
     switch (_build)
     {
@@ -838,17 +928,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto numChars = realmCharacters.find(i.second.m_ID);
+                uint8 AmountOfCharacters = numChars != realmCharacters.end() ? numChars->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -902,17 +983,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto numChars = realmCharacters.find(i.second.m_ID);
+                uint8 AmountOfCharacters = numChars != realmCharacters.end() ? numChars->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
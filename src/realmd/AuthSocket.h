@@ -28,6 +28,7 @@
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
 #include "Util/ByteBuffer.h"
+#include "RealmList.h"
 
 #include "Network/Socket.hpp"
 
@@ -47,7 +48,7 @@ class AuthSocket : public MaNGOS::Socket
         bool Open() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void LoadRealmlist(ByteBuffer& pkt, RealmList::RealmCharacters const& realmCharacters, uint8 accountSecurityLevel = 0);
         int32 generateToken(char const* b32key);
 
         uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
@@ -75,6 +76,12 @@ class AuthSocket : public MaNGOS::Socket
             STATUS_CLOSED
         };
 
+        // runs work on the compute pool, then continuation on the network thread of the socket unless it got closed meanwhile
+        void Defer(std::function<void()>&& work, std::function<void()>&& continuation);
+
+        eStatus LookupLogonChallenge(ByteBuffer& pkt);
+        static void CountFailedLogin(std::string const& login, std::string const& safeLogin, std::string const& address);
+
         SRP6 srp;
         BigNumber _reconnectProof;
 
@@ -88,8 +95,10 @@ class AuthSocket : public MaNGOS::Socket
         std::string m_locale;
         std::string _safelocale;
         uint16 _build;
+        uint32 _accountId;
         AccountTypes _accountSecurityLevel;
 
+        boost::asio::io_service& m_service;
         boost::asio::deadline_timer m_timeoutTimer;
 
         virtual bool ProcessIncomingData() override;
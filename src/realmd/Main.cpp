@@ -27,6 +27,7 @@
 #include "Config/Config.h"
 #include "Log/Log.h"
 #include "AuthSocket.h"
+#include "AuthComputePool.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "revision_sql.h"
@@ -231,6 +232,12 @@ int main(int argc, char* argv[])
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE expires_at<=" _UNIXTIME_ " AND expires_at<>banned_at");
     LoginDatabase.CommitTransaction();
 
+    ///- Start the threads running account lookups and SRP6 math of the connections
+    int authThreads = sConfig.GetIntDefault("AuthThreads", 2);
+    if (authThreads < 1)
+        authThreads = 1;
+    sAuthComputePool.Start(authThreads);
+
     // FIXME - more intelligent selection of thread count is needed here.  config option?
     MaNGOS::Listener<AuthSocket> listener(
             sConfig.GetStringDefault("BindIP", "0.0.0.0"),
@@ -310,6 +317,9 @@ int main(int argc, char* argv[])
 #endif
     }
 
+    ///- Finish pending auth work, it may still queue login DB writes
+    sAuthComputePool.Stop();
+
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -350,9 +360,11 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    // several auth threads would serialize on a single query connection
+    int nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
@@ -147,6 +147,19 @@ void RealmList::UpdateIfNeed()
 
     m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
 
+    // Drop expired character amounts, they would be reloaded at next request anyway
+    {
+        std::lock_guard<std::mutex> guard(m_realmCharactersLock);
+        time_t expireTime = time(nullptr) - m_UpdateInterval;
+        for (auto itr = m_realmCharacters.begin(); itr != m_realmCharacters.end();)
+        {
+            if (itr->second.loadTime <= expireTime)
+                itr = m_realmCharacters.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
     // Clears Realm list
     m_realms.clear();
 
@@ -154,6 +167,54 @@ void RealmList::UpdateIfNeed()
     UpdateRealms(false);
 }
 
+void RealmList::GetRealmCharacters(uint32 accountId, RealmCharacters& realmCharacters)
+{
+    // client repeats realm list request while on realm selection screen, reuse amounts until realm list update delay expires
+    time_t now = time(nullptr);
+    {
+        std::lock_guard<std::mutex> guard(m_realmCharactersLock);
+        auto itr = m_realmCharacters.find(accountId);
+        if (itr != m_realmCharacters.end())
+        {
+            if (now < itr->second.loadTime + time_t(m_UpdateInterval))
+            {
+                realmCharacters = itr->second.realmCharacters;
+                return;
+            }
+            m_realmCharacters.erase(itr);
+        }
+    }
+
+    realmCharacters.clear();
+
+    // all realms in one query instead of one query per realm
+    auto queryResult = LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", accountId);
+    if (queryResult)
+    {
+        do
+        {
+            Field* fields = queryResult->Fetch();
+            realmCharacters[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        }
+        while (queryResult->NextRow());
+    }
+
+    // nothing to share if realm list is reloaded at each request
+    if (!m_UpdateInterval)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_realmCharactersLock);
+    RealmCharactersEntry& entry = m_realmCharacters[accountId];
+    entry.realmCharacters = realmCharacters;
+    entry.loadTime = now;
+}
+
+void RealmList::InvalidateRealmCharacters(uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(m_realmCharactersLock);
+    m_realmCharacters.erase(accountId);
+}
+
 void RealmList::UpdateRealms(bool init)
 {
     DETAIL_LOG("Updating Realm List...");
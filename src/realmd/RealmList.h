@@ -25,6 +25,8 @@
 
 #include "Common.h"
 #include <array>
+#include <mutex>
+#include <unordered_map>
 
 struct RealmBuildInfo
 {
@@ -60,6 +62,7 @@ class RealmList
 {
     public:
         typedef std::map<std::string, Realm> RealmMap;
+        typedef std::map<uint32, uint8> RealmCharacters;    // character amount by realm id
 
         static RealmList& Instance();
 
@@ -73,6 +76,10 @@ class RealmList
         RealmMap::const_iterator begin() const { return m_realms.begin(); }
         RealmMap::const_iterator end() const { return m_realms.end(); }
         uint32 size() const { return m_realms.size(); }
+
+        // character amounts of an account, shared by all listener threads and reloaded after the realm list update delay
+        void GetRealmCharacters(uint32 accountId, RealmCharacters& realmCharacters);
+        void InvalidateRealmCharacters(uint32 accountId);
     private:
         void UpdateRealms(bool init);
         void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
@@ -80,6 +87,16 @@ class RealmList
         RealmMap m_realms;                                  ///< Internal map of realms
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        struct RealmCharactersEntry
+        {
+            RealmCharacters realmCharacters;
+            time_t loadTime;
+        };
+        typedef std::unordered_map<uint32, RealmCharactersEntry> RealmCharactersCache;
+
+        RealmCharactersCache m_realmCharacters;             ///< by account id
+        std::mutex m_realmCharactersLock;
 };
 
 #define sRealmList RealmList::Instance()
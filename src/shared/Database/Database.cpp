@@ -91,6 +91,26 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+std::unique_ptr<QueryResult> SqlConnection::QueryStreamed(const char* sql, bool /*readAhead*/)
+{
+    std::unique_ptr<QueryResult> queryResult = Query(sql);
+    m_db.ReleaseStreamConnection(this);
+    return queryResult;
+}
+
+std::unique_ptr<QueryResult> SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+        return nullptr;
+
+    // get prepared statement object
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    // bind parameters
+    pStmt->bind(id);
+    // execute statement and read its result
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
@@ -112,6 +132,7 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
 
     // create DB connections
+    m_connectionInfo = infoString;
 
     // setup connection pool size
     if (nConns < MIN_CONNECTION_POOL_SIZE)
@@ -159,6 +180,17 @@ void Database::StopServer()
         delete m_pQueryConnection;
 
     m_pQueryConnections.clear();
+
+    for (auto& m_pWorkerConnection : m_pWorkerConnections)
+        delete m_pWorkerConnection;
+
+    m_pWorkerConnections.clear();
+
+    std::lock_guard<std::mutex> guard(m_streamConnGuard);
+    for (auto& m_pStreamConnection : m_pStreamConnections)
+        delete m_pStreamConnection;
+
+    m_pStreamConnections.clear();
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -185,6 +217,36 @@ void Database::HaltDelayThread()
     delete m_delayThread;                                   // This also deletes m_threadBody
     m_delayThread = nullptr;
     m_threadBody = nullptr;
+
+    // after the delay thread, holders flushed by it are still executed
+    delete m_queryWorkers;
+    m_queryWorkers = nullptr;
+}
+
+bool Database::InitQueryWorkers(int nConns)
+{
+    assert(!m_queryWorkers);
+
+    if (nConns <= 0)
+        return true;
+
+    if (nConns > MAX_CONNECTION_POOL_SIZE)
+        nConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(m_connectionInfo.c_str()))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pWorkerConnections.push_back(pConn);
+    }
+
+    m_queryWorkers = new SqlQueryWorkers(this, m_pWorkerConnections);
+    return true;
 }
 
 void Database::ThreadStart()
@@ -239,6 +301,57 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         guard->Query(sql);
     }
+
+    for (auto& m_pWorkerConnection : m_pWorkerConnections)
+    {
+        SqlConnection::Lock guard(m_pWorkerConnection);
+        guard->Query(sql);
+    }
+
+    // connections of running streamed results are busy anyway
+    std::lock_guard<std::mutex> guard(m_streamConnGuard);
+    for (auto& m_pStreamConnection : m_pStreamConnections)
+        m_pStreamConnection->Query(sql);
+}
+
+SqlConnection* Database::getStreamConnection()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_streamConnGuard);
+        if (!m_pStreamConnections.empty())
+        {
+            SqlConnection* pConn = m_pStreamConnections.back();
+            m_pStreamConnections.pop_back();
+            return pConn;
+        }
+    }
+
+    SqlConnection* pConn = CreateConnection();
+    if (!pConn->Initialize(m_connectionInfo.c_str()))
+    {
+        delete pConn;
+        return nullptr;
+    }
+
+    return pConn;
+}
+
+void Database::ReleaseStreamConnection(SqlConnection* conn)
+{
+    std::lock_guard<std::mutex> guard(m_streamConnGuard);
+    m_pStreamConnections.push_back(conn);
+}
+
+std::unique_ptr<QueryResult> Database::QueryStreamed(const char* sql, bool readAhead /*= false*/)
+{
+    SqlConnection* pConn = getStreamConnection();
+    if (!pConn)
+    {
+        sLog.outError("SQL: no connection for streamed query, result is buffered");
+        return Query(sql);
+    }
+
+    return pConn->QueryStreamed(sql, readAhead);
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -444,6 +557,22 @@ bool Database::RollbackTransaction()
     return true;
 }
 
+bool Database::GetTableSignature(char const* table_name, char const* key_field, uint64& signature)
+{
+    uint64 stamp;
+    if (!GetTableChangeStamp(table_name, stamp))
+        return false;
+
+    // highest key is read from the index, it catches a TRUNCATE that the change stamps do not count
+    auto queryResult = PQuery("SELECT MAX(%s) FROM %s", key_field, table_name);
+    if (!queryResult)
+        return false;
+
+    uint64 const prime = 0x100000001B3ULL;
+    signature = (stamp * prime) ^ queryResult->Fetch()[0].GetUInt64();
+    return true;
+}
+
 bool Database::CheckRequiredField(char const* table_name, char const* required_name)
 {
     // check required field
@@ -578,6 +707,15 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+std::unique_ptr<QueryResult> Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::unique_ptr<SqlStmtParameters> p(params);
+    // query connections, same as plain sync queries
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
@@ -50,6 +50,9 @@ class SqlConnection
         // public methods for making queries
         virtual std::unique_ptr<QueryResult> Query(const char* sql) = 0;
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        // rows are read as they arrive, connection is given back to DB when the result is done with it
+        // DB backends without streaming support return a buffered result
+        virtual std::unique_ptr<QueryResult> QueryStreamed(const char* sql, bool readAhead);
 
         // public methods for making requests
         virtual bool Execute(const char* sql) = 0;
@@ -65,6 +68,7 @@ class SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        std::unique_ptr<QueryResult> QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         // SqlConnection object lock
         class Lock
@@ -111,6 +115,9 @@ class Database
         virtual void InitDelayThread();
         // stop worker thread
         virtual void HaltDelayThread();
+        // start threads with own connections executing the queries of parallel query holders (character login)
+        // without them queries of a holder are executed one after another by the delay thread
+        bool InitQueryWorkers(int nConns);
 
         /// Synchronous DB queries
         inline std::unique_ptr<QueryResult> Query(const char* sql)
@@ -128,6 +135,16 @@ class Database
         std::unique_ptr<QueryResult> PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        // for large results: rows are processed while they arrive instead of buffering the whole result first
+        // done on a connection of its own, so other queries can be used while the result is read
+        // row count is not known in advance, GetRowCount() returns 0
+        // an error while reading ends the rows early, check IsFailed() of the result after the last row
+        // an error before the first row gives a result with IsFailed() set and no row to Fetch()
+        // readAhead: next rows are received by a separate thread while the current ones are processed
+        std::unique_ptr<QueryResult> QueryStreamed(const char* sql, bool readAhead = false);
+        // called by streamed results when done with their connection
+        void ReleaseStreamConnection(SqlConnection* conn);
+
         bool DirectExecute(const char* sql) const
         {
             if (!m_pAsyncConn)
@@ -212,6 +229,9 @@ class Database
         void ProcessResultQueue();
 
         bool CheckRequiredField(char const* table_name, char const* required_name);
+
+        // content signature of a table from its change counter and highest key, false if not supported by DB backend
+        bool GetTableSignature(char const* table_name, char const* key_field, uint64& signature);
         uint32 GetPingIntervall() const { return m_pingIntervallms; }
 
         // function to ping database connections
@@ -223,9 +243,12 @@ class Database
         void AllowAsyncTransactions() { m_allowAsyncTransactions = true; }
 
     protected:
+        // counter of changed rows of a table kept by the DB server, false if not supported by DB backend
+        virtual bool GetTableChangeStamp(char const* /*table_name*/, uint64& /*stamp*/) { return false; }
+
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_threadBody(nullptr), m_delayThread(nullptr), m_queryWorkers(nullptr), m_allowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -247,12 +270,15 @@ class Database
         SqlConnection* getQueryConnection();
         // for now return one single connection for async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // free or new connection for streamed results
+        SqlConnection* getStreamConnection();
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
         // query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        std::unique_ptr<QueryResult> QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                           // current size of query connection pool
@@ -265,9 +291,16 @@ class Database
         // only one single DB connection for transactions
         SqlConnection* m_pAsyncConn;
 
+        // connections of finished streamed results, created on demand
+        SqlConnectionContainer m_pStreamConnections;
+        std::mutex m_streamConnGuard;
+        std::string m_connectionInfo;
+
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        SqlQueryWorkers*    m_queryWorkers;                 ///< Executers of query holder queries, nullptr if not used
+        SqlConnectionContainer m_pWorkerConnections;        ///< Connections of m_queryWorkers
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
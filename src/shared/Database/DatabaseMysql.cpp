@@ -69,6 +69,31 @@ SqlConnection* DatabaseMysql::CreateConnection()
     return new MySQLConnection(*this);
 }
 
+bool DatabaseMysql::GetTableChangeStamp(char const* table_name, uint64& stamp)
+{
+    // row change counter kept by the tcc_<table>_ins/upd/del triggers in table_change_counter, see sql/base/mangos.sql
+    // trigger creation time is added, so recreating the table (which drops its triggers) and the triggers is noticed
+    auto queryResult = PQuery("SELECT COUNT(*), FLOOR(UNIX_TIMESTAMP(MAX(CREATED)) * 100), "
+                              "(SELECT COALESCE(MAX(counter), 0) FROM table_change_counter WHERE table_name = '%s') "
+                              "FROM information_schema.TRIGGERS WHERE TRIGGER_SCHEMA = DATABASE() AND EVENT_OBJECT_TABLE = '%s' "
+                              "AND TRIGGER_NAME IN ('tcc_%s_ins', 'tcc_%s_upd', 'tcc_%s_del')",
+                              table_name, table_name, table_name, table_name, table_name);
+    if (!queryResult)
+        return false;
+
+    Field* fields = queryResult->Fetch();
+    // without all three triggers changes are not counted
+    if (fields[0].GetUInt32() != 3)
+    {
+        sLog.outError("Table `%s` misses its tcc_%s_ins/upd/del change counter triggers, snapshot is not used. Apply sql/updates/mangos/14086_01_mangos_table_change_counter.sql to recreate them.",
+                      table_name, table_name);
+        return false;
+    }
+
+    stamp = (fields[1].GetUInt64() * 0x100000001B3ULL) ^ fields[2].GetUInt64();
+    return true;
+}
+
 MySQLConnection::~MySQLConnection()
 {
     FreePreparedStatements();
@@ -241,6 +266,42 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+std::unique_ptr<QueryResult> MySQLConnection::QueryStreamed(const char* sql, bool readAhead)
+{
+    uint32 _s = WorldTimer::getMSTime();
+
+    if (!mMysql || mysql_query(mMysql, sql))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        if (mMysql)
+            sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+        m_db.ReleaseStreamConnection(this);
+        return nullptr;
+    }
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    // rows stay on server side until fetched
+    MYSQL_RES* result = mysql_use_result(mMysql);
+    if (!result)
+    {
+        m_db.ReleaseStreamConnection(this);
+        return nullptr;
+    }
+
+    auto queryResult = std::make_unique<QueryResultMysqlStream>(this, mMysql, result, mysql_fetch_fields(result), mysql_num_fields(result), readAhead);
+
+    // empty result gives back the connection at once
+    // an error before the first row is not an empty result, the caller gets it without a current row
+    if (!queryResult->NextRow())
+    {
+        if (queryResult->IsFailed())
+            return queryResult;
+        return nullptr;
+    }
+
+    return queryResult;
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!mMysql)
@@ -365,8 +426,6 @@ bool MySqlPreparedStatement::prepare()
         m_bIsQuery = true;
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
-
-        // bind output buffers
     }
 
     m_bPrepared = true;
@@ -462,6 +521,32 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+std::unique_ptr<QueryResult> MySqlPreparedStatement::query()
+{
+    if (!isPrepared() || !isQuery())
+        return nullptr;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if (mysql_stmt_execute(m_stmt))
+    {
+        sLog.outErrorDb("SQL: cannot execute '%s'", m_szFmt.c_str());
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(m_stmt));
+        return nullptr;
+    }
+
+    auto queryResult = std::make_unique<QueryResultMysqlStmt>(m_stmt, mysql_fetch_fields(m_pResultMetadata), m_nColumns);
+    mysql_stmt_free_result(m_stmt);
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), m_szFmt.c_str());
+
+    // a failed read is given back even without rows, so it is not taken for an empty result
+    if (!queryResult->GetRowCount() && !queryResult->IsFailed())
+        return nullptr;
+
+    queryResult->NextRow();
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned)
 {
     bUnsigned = 0;
@@ -44,6 +44,9 @@ class MySqlPreparedStatement : public SqlPreparedStatement
         // execute DML statement
         virtual bool execute() override;
 
+        // execute SELECT statement, result is read with typed output buffers
+        virtual std::unique_ptr<QueryResult> query() override;
+
     protected:
         // bind parameters
         void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
@@ -72,6 +75,7 @@ class MySQLConnection : public SqlConnection
 
         std::unique_ptr<QueryResult> Query(const char* sql) override;
         QueryNamedResult* QueryNamed(const char* sql) override;
+        std::unique_ptr<QueryResult> QueryStreamed(const char* sql, bool readAhead) override;
         bool Execute(const char* sql) override;
 
         unsigned long escape_string(char* to, const char* from, unsigned long length);
@@ -105,6 +109,7 @@ class DatabaseMysql : public Database
 
     protected:
         virtual SqlConnection* CreateConnection() override;
+        bool GetTableChangeStamp(char const* table_name, uint64& stamp) override;
 
     private:
         static size_t db_count;
@@ -50,6 +50,36 @@ SqlConnection* DatabasePostgre::CreateConnection()
     return new PostgreSQLConnection(*this);
 }
 
+bool DatabasePostgre::GetTableChangeStamp(char const* table_name, uint64& stamp)
+{
+    // pg_stat_user_tables counters are not usable here: they are reported with a delay and are lost on
+    // pg_stat_reset or a crash, both would give a stale snapshot. Same as for MySQL a row change counter
+    // in table_change_counter kept by tcc_<table>_ins/upd/del triggers is required.
+    // trigger oids are added, so recreating the table (which drops its triggers) and the triggers is noticed
+    auto queryResult = PQuery("SELECT COUNT(*), COALESCE(SUM(t.oid::bigint), 0) FROM pg_trigger t JOIN pg_class c ON c.oid = t.tgrelid "
+                              "WHERE c.relname = '%s' AND pg_table_is_visible(c.oid) AND NOT t.tgisinternal "
+                              "AND t.tgname IN ('tcc_%s_ins', 'tcc_%s_upd', 'tcc_%s_del')",
+                              table_name, table_name, table_name, table_name);
+    if (!queryResult)
+        return false;
+
+    Field* fields = queryResult->Fetch();
+    if (fields[0].GetUInt32() != 3)
+    {
+        sLog.outError("Table `%s` misses its tcc_%s_ins/upd/del change counter triggers, snapshot is not used.", table_name, table_name);
+        return false;
+    }
+
+    uint64 triggers = fields[1].GetUInt64();
+
+    queryResult = PQuery("SELECT COALESCE(MAX(counter), 0) FROM table_change_counter WHERE table_name = '%s'", table_name);
+    if (!queryResult)
+        return false;
+
+    stamp = (triggers * 0x100000001B3ULL) ^ queryResult->Fetch()[0].GetUInt64();
+    return true;
+}
+
 PostgreSQLConnection::~PostgreSQLConnection()
 {
     PQfinish(mPGconn);
@@ -70,6 +70,7 @@ class DatabasePostgre : public Database
 
     protected:
         virtual SqlConnection* CreateConnection() override;
+        bool GetTableChangeStamp(char const* table_name, uint64& stamp) override;
 
     private:
         static size_t db_count;
@@ -81,11 +81,11 @@ bool SQLiteConnection::_Query(const char* sql, sqlite3_stmt** pStmt)
 
 std::unique_ptr<QueryResult> SQLiteConnection::Query(const char* sql)
 {
-    sqlite3_stmt** pStmt = new(sqlite3_stmt*);
-    if (!_Query(sql, pStmt))
+    sqlite3_stmt* stmt = nullptr;
+    if (!_Query(sql, &stmt))
         return nullptr;
 
-    auto queryResult = std::make_unique<QueryResultSqlite>(pStmt);
+    auto queryResult = std::make_unique<QueryResultSqlite>(stmt);
 
     if (queryResult->NextRow())
         return queryResult;
@@ -97,18 +97,18 @@ QueryNamedResult* SQLiteConnection::QueryNamed(const char* sql)
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
 
-    sqlite3_stmt** pStmt = new(sqlite3_stmt*);
+    sqlite3_stmt* stmt = nullptr;
 
-    if (!_Query(sql, pStmt))
+    if (!_Query(sql, &stmt))
         return nullptr;
 
-    fieldCount = sqlite3_column_count(*pStmt);
+    fieldCount = sqlite3_column_count(stmt);
 
     QueryFieldNames names(fieldCount);
     for (uint32 i = 0; i < fieldCount; ++i)
-        names[i] = sqlite3_column_name(*pStmt, i);
+        names[i] = sqlite3_column_name(stmt, i);
 
-    QueryResultSqlite* queryResult = new QueryResultSqlite(pStmt);
+    QueryResultSqlite* queryResult = new QueryResultSqlite(stmt);
 
     queryResult->NextRow();
     return new QueryNamedResult(queryResult, names);
@@ -121,24 +121,25 @@ bool SQLiteConnection::Execute(const char* sql)
 
     {
         uint32 _s = WorldTimer::getMSTime();
-        sqlite3_stmt** pStmt = new(sqlite3_stmt*);
+        sqlite3_stmt* stmt = nullptr;
 
         int result;
-        result = sqlite3_prepare_v2(mSqlite, sql, -1, pStmt, NULL);
+        result = sqlite3_prepare_v2(mSqlite, sql, -1, &stmt, NULL);
         if (result != SQLITE_OK)
         {
             sLog.outErrorDb("SQL: %s", sql);
             sLog.outErrorDb("SQL ERROR: %s", sqlite3_errmsg(mSqlite));
             return false;
         }
-        result = sqlite3_step(*pStmt);
+        result = sqlite3_step(stmt);
         if (result != SQLITE_DONE && result != SQLITE_OK)
         {
             sLog.outErrorDb("SQL: %s", sql);
             sLog.outErrorDb("SQL ERROR: %s", sqlite3_errmsg(mSqlite));
+            sqlite3_finalize(stmt);
             return false;
         }
-        sqlite3_finalize(*pStmt);
+        sqlite3_finalize(stmt);
         DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
         // end guarded block
     }
@@ -148,17 +149,18 @@ bool SQLiteConnection::Execute(const char* sql)
 
 bool SQLiteConnection::_TransactionCmd(const char* sql)
 {
-    sqlite3_stmt** pStmt = new(sqlite3_stmt*);
+    sqlite3_stmt* stmt = nullptr;
 
     int result;
-    result = sqlite3_prepare_v2(mSqlite, sql, -1, pStmt, NULL);
+    result = sqlite3_prepare_v2(mSqlite, sql, -1, &stmt, NULL);
     if (result != SQLITE_OK)
     {
         sLog.outErrorDb("SQL: %s", sql);
         sLog.outErrorDb("SQL ERROR: %s", sqlite3_errmsg(mSqlite));
         return false;
     }
-    result = sqlite3_step(*pStmt);
+    result = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
     if (result != SQLITE_DONE && result != SQLITE_OK)
     {
         sLog.outErrorDb("SQL: %s", sql);
@@ -230,23 +232,20 @@ bool SqlitePreparedStatement::prepare()
     // remove old binds
     RemoveBinds();
 
-    if (!m_stmt)
-        m_stmt = new(sqlite3_stmt*);
-
     // Create statement object
-    int result = sqlite3_prepare_v2(m_pSqliteConn, m_szFmt.c_str(), m_szFmt.length(), m_stmt, nullptr);
+    int result = sqlite3_prepare_v2(m_pSqliteConn, m_szFmt.c_str(), m_szFmt.length(), &m_stmt, nullptr);
     if (result != SQLITE_OK) {
         sLog.outError("SQL: sqlite3_prepare_v2() failed: %s", sqlite3_errmsg(m_pSqliteConn));
         return false;
     }
     // Get the parameter count from the statement
-    m_nParams = sqlite3_bind_parameter_count(*m_stmt);
+    m_nParams = sqlite3_bind_parameter_count(m_stmt);
 
     // Check if we have a statement which returns result sets
-    if (sqlite3_stmt_readonly(*m_stmt) == 0) {
+    if (sqlite3_stmt_readonly(m_stmt) == 0) {
         // Our statement is a query
         m_bIsQuery = true;
-        m_nColumns = sqlite3_column_count(*m_stmt);  // Get the number of columns in the result set
+        m_nColumns = sqlite3_column_count(m_stmt);  // Get the number of columns in the result set
     }
 
     m_bPrepared = true;
@@ -289,40 +288,40 @@ void SqlitePreparedStatement::addParam(unsigned int nIndex, const SqlStmtFieldDa
     switch (data.type()) {
         case FIELD_BOOL:
         case FIELD_UI8:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const uint8*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const uint8*>(data.buff()));
             break;
         case FIELD_UI16:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const uint16*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const uint16*>(data.buff()));
             break;
         case FIELD_UI32:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const uint32*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const uint32*>(data.buff()));
             break;
         case FIELD_UI64:
-            result = sqlite3_bind_int64(*m_stmt, nIndex + 1, *static_cast<const uint64*>(data.buff()));
+            result = sqlite3_bind_int64(m_stmt, nIndex + 1, *static_cast<const uint64*>(data.buff()));
             break;
         case FIELD_I8:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const int8*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const int8*>(data.buff()));
             break;
         case FIELD_I16:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const int16*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const int16*>(data.buff()));
             break;
         case FIELD_I32:
-            result = sqlite3_bind_int(*m_stmt, nIndex + 1, *static_cast<const int32*>(data.buff()));
+            result = sqlite3_bind_int(m_stmt, nIndex + 1, *static_cast<const int32*>(data.buff()));
             break;
         case FIELD_I64:
-            result = sqlite3_bind_int64(*m_stmt, nIndex + 1, *static_cast<const int64*>(data.buff()));
+            result = sqlite3_bind_int64(m_stmt, nIndex + 1, *static_cast<const int64*>(data.buff()));
             break;
         case FIELD_FLOAT:
-            result = sqlite3_bind_double(*m_stmt, nIndex + 1, *static_cast<const float*>(data.buff()));
+            result = sqlite3_bind_double(m_stmt, nIndex + 1, *static_cast<const float*>(data.buff()));
             break;
         case FIELD_DOUBLE:
-            result = sqlite3_bind_double(*m_stmt, nIndex + 1, *static_cast<const double*>(data.buff()));
+            result = sqlite3_bind_double(m_stmt, nIndex + 1, *static_cast<const double*>(data.buff()));
             break;
         case FIELD_STRING:
-            result = sqlite3_bind_text(*m_stmt, nIndex + 1, static_cast<const char*>(data.buff()), -1, SQLITE_STATIC);
+            result = sqlite3_bind_text(m_stmt, nIndex + 1, static_cast<const char*>(data.buff()), -1, SQLITE_STATIC);
             break;
         case FIELD_NONE:
-            result = sqlite3_bind_null(*m_stmt, nIndex + 1);
+            result = sqlite3_bind_null(m_stmt, nIndex + 1);
             break;
         // Handle other data types as needed
 
@@ -342,8 +341,8 @@ void SqlitePreparedStatement::RemoveBinds()
         return;
 
     // Finalize the prepared statement
-    sqlite3_finalize(*m_stmt);
-    *m_stmt = nullptr;
+    sqlite3_finalize(m_stmt);
+    m_stmt = nullptr;
 
     m_bPrepared = false;
 }
@@ -353,18 +352,34 @@ bool SqlitePreparedStatement::execute()
     if (!isPrepared())
         return false;
 
-    int result = sqlite3_step(*m_stmt);
+    int result = sqlite3_step(m_stmt);
 
     if (result != SQLITE_DONE)
     {
         sLog.outErrorDb("SQL: cannot execute '%s'", m_szFmt.c_str());
         sLog.outErrorDb("SQL ERROR: %s", sqlite3_errmsg(m_pSqliteConn));
-        return false;
     }
 
-    // Reset the prepared statement to be executed again if needed
-    sqlite3_reset(*m_stmt);
+    // Reset the prepared statement to be executed again, parameters are bound anew each time
+    sqlite3_reset(m_stmt);
+    sqlite3_clear_bindings(m_stmt);
 
-    return true;
+    return result == SQLITE_DONE;
+}
+
+std::unique_ptr<QueryResult> SqlitePreparedStatement::query()
+{
+    if (!isPrepared())
+        return nullptr;
+
+    // rows are copied by the result, so the statement is reset for next use at once
+    auto queryResult = std::make_unique<QueryResultSqliteStmt>(m_stmt);
+    sqlite3_reset(m_stmt);
+    sqlite3_clear_bindings(m_stmt);
+
+    // a failed read is given back even without rows, so it is not taken for an empty result
+    if (queryResult->NextRow() || queryResult->IsFailed())
+        return queryResult;
+    return nullptr;
 }
 #endif
@@ -44,6 +44,9 @@ class SqlitePreparedStatement : public SqlPreparedStatement
         // execute DML statement
         virtual bool execute() override;
 
+        // execute SELECT statement
+        virtual std::unique_ptr<QueryResult> query() override;
+
     protected:
         // bind parameters
         void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
@@ -52,7 +55,7 @@ class SqlitePreparedStatement : public SqlPreparedStatement
         void RemoveBinds();
 
         sqlite3* m_pSqliteConn;
-        sqlite3_stmt** m_stmt;
+        sqlite3_stmt* m_stmt;
         sqlite3_value* m_pResult;
 };
 
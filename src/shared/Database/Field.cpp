@@ -29,3 +29,35 @@ time_t Field::GetTime() const
     ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
     return std::mktime(&tm);
 }
+
+const char* Field::FormatBinaryValue() const
+{
+    if (mIsFormatted)
+        return mFormatted;
+
+    switch (mStorage)
+    {
+        case STORAGE_INT:
+            snprintf(mFormatted, sizeof(mFormatted), SI64FMTD, mBinaryValue.i);
+            break;
+        case STORAGE_UINT:
+            snprintf(mFormatted, sizeof(mFormatted), UI64FMTD, mBinaryValue.u);
+            break;
+        default:
+        {
+            // shortest form that reads back to the same value, as the text protocol sends it
+            bool isFloat = mStorage == STORAGE_FLOAT;
+            for (int precision = isFloat ? 6 : 15; precision <= (isFloat ? 9 : 17); ++precision)
+            {
+                snprintf(mFormatted, sizeof(mFormatted), "%.*g", precision, mBinaryValue.d);
+                double value = atof(mFormatted);
+                if (isFloat ? float(value) == float(mBinaryValue.d) : value == mBinaryValue.d)
+                    break;
+            }
+            break;
+        }
+    }
+
+    mIsFormatted = true;
+    return mFormatted;
+}
@@ -21,6 +21,8 @@
 
 #include "Common.h"
 
+#include <type_traits>
+
 class Field
 {
     public:
@@ -34,31 +36,49 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mStorage(STORAGE_TEXT), mIsFormatted(false) { mBinaryValue.u = 0; }
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mStorage(STORAGE_TEXT), mIsFormatted(false) { mBinaryValue.u = 0; }
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == nullptr; }
+        bool IsNULL() const { return mStorage == STORAGE_TEXT && mValue == nullptr; }
 
         const char* GetString() const
         {
+            if (mStorage != STORAGE_TEXT)
+                return FormatBinaryValue();
+
             return mValue ? mValue : ""; // We need this null check as we do not always null check what we get back from the database everywhere
         }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            return GetString();                             // std::string s = 0 have undefine result in C++
+        }
+        float GetFloat() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return GetBinaryValue<float>();
+
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
+        bool GetBool() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return mStorage == STORAGE_UINT ? mBinaryValue.u > 0 : GetBinaryValue<int64>() > 0;
+
+            return mValue ? atoi(mValue) > 0 : false;
+        }
+        int32 GetInt32() const { return mStorage != STORAGE_TEXT ? GetBinaryValue<int32>() : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        uint8 GetUInt8() const { return mStorage != STORAGE_TEXT ? GetBinaryValue<uint8>() : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint16 GetUInt16() const { return mStorage != STORAGE_TEXT ? GetBinaryValue<uint16>() : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        int16 GetInt16() const { return mStorage != STORAGE_TEXT ? GetBinaryValue<int16>() : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        uint32 GetUInt32() const { return mStorage != STORAGE_TEXT ? GetBinaryValue<uint32>() : mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mStorage != STORAGE_TEXT)
+                return GetBinaryValue<uint64>();
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -70,13 +90,56 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mStorage = STORAGE_TEXT; }
+
+        // values of prepared statement results (binary protocol) are kept typed, no string conversion at access
+        void SetInt64(int64 value) { mBinaryValue.i = value; mStorage = STORAGE_INT; mIsFormatted = false; }
+        void SetUInt64(uint64 value) { mBinaryValue.u = value; mStorage = STORAGE_UINT; mIsFormatted = false; }
+        void SetFloat(float value) { mBinaryValue.d = value; mStorage = STORAGE_FLOAT; mIsFormatted = false; }
+        void SetDouble(double value) { mBinaryValue.d = value; mStorage = STORAGE_DOUBLE; mIsFormatted = false; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        enum Storage
+        {
+            STORAGE_TEXT,                                   // mValue, NULL when not set
+            STORAGE_INT,
+            STORAGE_UINT,
+            STORAGE_FLOAT,
+            STORAGE_DOUBLE
+        };
+
+        template<typename T>
+        T GetBinaryValue() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT:   return static_cast<T>(mBinaryValue.i);
+                case STORAGE_UINT:  return static_cast<T>(mBinaryValue.u);
+                default:
+                    // truncated like the text conversion, negative values wrap around for unsigned types
+                    if constexpr (std::is_integral<T>::value)
+                        return static_cast<T>(static_cast<int64>(mBinaryValue.d));
+                    else
+                        return static_cast<T>(mBinaryValue.d);
+            }
+        }
+
+        // string form of a typed value, formatted once into the field and valid until its value is set again
+        const char* FormatBinaryValue() const;
+
         const char* mValue;
         enum DataTypes mType;
+        Storage mStorage;
+        union
+        {
+            int64 i;
+            uint64 u;
+            double d;
+        } mBinaryValue;
+        mutable char mFormatted[32];
+        mutable bool mIsFormatted;
 };
 #endif
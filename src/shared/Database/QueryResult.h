@@ -27,7 +27,7 @@ class QueryResult
 {
     public:
         QueryResult(uint64 rowCount, uint32 fieldCount)
-            : mCurrentRow(nullptr), mFieldCount(fieldCount), mRowCount(rowCount) {}
+            : mCurrentRow(nullptr), mFieldCount(fieldCount), mRowCount(rowCount), mFailed(false) {}
 
         virtual ~QueryResult() {}
 
@@ -39,11 +39,14 @@ class QueryResult
 
         uint32 GetFieldCount() const { return mFieldCount; }
         uint64 GetRowCount() const { return mRowCount; }
+        // true if reading the rows ended on an error instead of the last row (streamed and prepared statement results)
+        bool IsFailed() const { return mFailed; }
 
     protected:
         Field* mCurrentRow;
         uint32 mFieldCount;
         uint64 mRowCount;
+        bool mFailed;
 };
 
 typedef std::vector<std::string> QueryFieldNames;
@@ -67,7 +67,359 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_FIELD* fields, uint32 fieldCount) :
+    QueryResult(0, fieldCount), mNextRow(0)
+{
+    // bool or my_bool, depending on client library version
+    typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type NullFlag;
+
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    mColumns.resize(mFieldCount);
+
+    // output buffers of one row
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<SqlStmtField> numbers(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::unique_ptr<NullFlag[]> nulls(new NullFlag[mFieldCount]);
+    std::vector<size_t> textOffsets(mFieldCount);
+    size_t textSize = 0;
+
+    memset(binds.data(), 0, sizeof(MYSQL_BIND) * mFieldCount);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+        MYSQL_BIND& bind = binds[i];
+        bind.is_null = &nulls[i];
+        bind.length = &lengths[i];
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+            {
+                bool isUnsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                mColumns[i] = isUnsigned ? COLUMN_UINT : COLUMN_INT;
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = isUnsigned;
+                bind.buffer = &numbers[i].i64;
+                break;
+            }
+            case MYSQL_TYPE_FLOAT:
+                mColumns[i] = COLUMN_FLOAT;
+                bind.buffer_type = MYSQL_TYPE_FLOAT;
+                bind.buffer = &numbers[i].f;
+                break;
+            case MYSQL_TYPE_DOUBLE:
+                mColumns[i] = COLUMN_DOUBLE;
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &numbers[i].d;
+                break;
+            default:
+                // strings, blobs, decimals and dates are read in the same text form as by plain queries
+                // longer values than the buffer are fetched again on their own
+                mColumns[i] = COLUMN_TEXT;
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer_length = std::min<unsigned long>(fields[i].length, TEXT_BUFFER_SIZE) + 1;
+                textOffsets[i] = textSize;
+                textSize += bind.buffer_length;
+                break;
+        }
+    }
+
+    std::vector<char> textBuffer(textSize);
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        if (mColumns[i] == COLUMN_TEXT)
+            binds[i].buffer = textBuffer.data() + textOffsets[i];
+
+    if (mysql_stmt_bind_result(stmt, binds.data()))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mFailed = true;
+        return;
+    }
+
+    // rows are fetched from the server one by one, the client library does not keep a copy of the result
+    std::vector<char> longText;
+    int fetchResult;
+    while ((fetchResult = mysql_stmt_fetch(stmt)) == 0 || fetchResult == MYSQL_DATA_TRUNCATED)
+    {
+        size_t rowOffset = mCells.size();
+        mCells.resize(rowOffset + mFieldCount);
+        Cell* cells = &mCells[rowOffset];
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Cell& cell = cells[i];
+            cell.isNull = nulls[i] != 0;
+            if (cell.isNull)
+                continue;
+
+            switch (mColumns[i])
+            {
+                case COLUMN_INT:    cell.i = numbers[i].i64;    break;
+                case COLUMN_UINT:   cell.u = numbers[i].ui64;   break;
+                case COLUMN_FLOAT:  cell.d = numbers[i].f;      break;
+                case COLUMN_DOUBLE: cell.d = numbers[i].d;      break;
+                case COLUMN_TEXT:
+                {
+                    char const* text = textBuffer.data() + textOffsets[i];
+                    size_t length = std::min<size_t>(lengths[i], binds[i].buffer_length - 1);
+                    if (lengths[i] >= binds[i].buffer_length)
+                    {
+                        longText.resize(lengths[i] + 1);
+
+                        MYSQL_BIND columnBind;
+                        memset(&columnBind, 0, sizeof(MYSQL_BIND));
+                        columnBind.buffer_type = MYSQL_TYPE_STRING;
+                        columnBind.buffer = longText.data();
+                        columnBind.buffer_length = longText.size();
+                        if (mysql_stmt_fetch_column(stmt, &columnBind, i, 0))
+                        {
+                            sLog.outError("SQL ERROR: mysql_stmt_fetch_column() failed");
+                            sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+                            mFailed = true;
+                        }
+                        else
+                        {
+                            text = longText.data();
+                            length = lengths[i];
+                        }
+                    }
+
+                    cell.textOffset = mText.size();
+                    mText.insert(mText.end(), text, text + length);
+                    mText.push_back('\0');
+                    break;
+                }
+            }
+        }
+
+        // a row with a value that could not be read completely is not kept
+        if (mFailed)
+        {
+            mCells.resize(rowOffset);
+            return;
+        }
+
+        ++mRowCount;
+    }
+
+    if (fetchResult != MYSQL_NO_DATA)
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_fetch() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mFailed = true;
+    }
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (!mCurrentRow)
+        return false;
+
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    Cell const* cells = &mCells[mNextRow * mFieldCount];
+    ++mNextRow;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Cell const& cell = cells[i];
+        if (cell.isNull)
+        {
+            mCurrentRow[i].SetValue(nullptr);
+            continue;
+        }
+
+        switch (mColumns[i])
+        {
+            case COLUMN_INT:    mCurrentRow[i].SetInt64(cell.i);                    break;
+            case COLUMN_UINT:   mCurrentRow[i].SetUInt64(cell.u);                   break;
+            case COLUMN_FLOAT:  mCurrentRow[i].SetFloat(float(cell.d));             break;
+            case COLUMN_DOUBLE: mCurrentRow[i].SetDouble(cell.d);                   break;
+            case COLUMN_TEXT:   mCurrentRow[i].SetValue(&mText[cell.textOffset]);   break;
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+}
+
+QueryResultMysqlStream::QueryResultMysqlStream(SqlConnection* conn, MYSQL* mysql, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, bool readAhead) :
+    QueryResult(0, fieldCount), mConn(conn), mMysql(mysql), mResult(result), mReaderDone(false), mStopReader(false), mBatchRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+    if (readAhead)
+        mReader = std::thread(&QueryResultMysqlStream::ReadAhead, this);
+}
+
+QueryResultMysqlStream::~QueryResultMysqlStream()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlStream::NextRow()
+{
+    if (!mResult)
+        return false;
+
+    if (!mReader.joinable())
+    {
+        MYSQL_ROW row = mysql_fetch_row(mResult);
+        if (!row)
+        {
+            if (mysql_errno(mMysql))
+            {
+                sLog.outErrorDb("SQL ERROR: streamed result interrupted: %s", mysql_error(mMysql));
+                mFailed = true;
+            }
+
+            EndQuery();
+            return false;
+        }
+
+        for (uint32 i = 0; i < mFieldCount; ++i)
+            mCurrentRow[i].SetValue(row[i]);
+
+        return true;
+    }
+
+    if (mBatchRow >= mBatch.rows)
+    {
+        std::unique_lock<std::mutex> lock(mBatchLock);
+        mBatchCondition.wait(lock, [this] { return !mBatches.empty() || mReaderDone; });
+        if (mBatches.empty())
+        {
+            lock.unlock();
+            EndQuery();
+            return false;
+        }
+
+        mBatch = std::move(mBatches.front());
+        mBatches.pop_front();
+        mBatchRow = 0;
+
+        lock.unlock();
+        mBatchCondition.notify_all();
+    }
+
+    size_t const* offsets = &mBatch.offsets[size_t(mBatchRow) * mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetValue(offsets[i] == NULL_VALUE_OFFSET ? nullptr : &mBatch.text[offsets[i]]);
+
+    ++mBatchRow;
+    return true;
+}
+
+void QueryResultMysqlStream::ReadAhead()
+{
+    mConn->DB().ThreadStart();
+
+    bool done = false;
+    bool failed = false;
+    while (!done)
+    {
+        RowBatch batch;
+        while (batch.rows < READ_AHEAD_BATCH_ROWS)
+        {
+            MYSQL_ROW row = mysql_fetch_row(mResult);
+            if (!row)
+            {
+                if (mysql_errno(mMysql))
+                {
+                    sLog.outErrorDb("SQL ERROR: streamed result interrupted: %s", mysql_error(mMysql));
+                    failed = true;
+                }
+
+                done = true;
+                break;
+            }
+
+            unsigned long* lengths = mysql_fetch_lengths(mResult);
+            for (uint32 i = 0; i < mFieldCount; ++i)
+            {
+                if (!row[i])
+                {
+                    batch.offsets.push_back(NULL_VALUE_OFFSET);
+                    continue;
+                }
+
+                batch.offsets.push_back(batch.text.size());
+                batch.text.insert(batch.text.end(), row[i], row[i] + lengths[i]);
+                batch.text.push_back('\0');
+            }
+            ++batch.rows;
+        }
+
+        std::unique_lock<std::mutex> lock(mBatchLock);
+        mBatchCondition.wait(lock, [this] { return mBatches.size() < READ_AHEAD_MAX_BATCHES || mStopReader; });
+        if (mStopReader)
+            break;
+
+        if (batch.rows)
+            mBatches.push_back(std::move(batch));
+
+        // read by NextRow after it saw mReaderDone
+        mFailed = failed;
+        mReaderDone = done;
+        lock.unlock();
+        mBatchCondition.notify_all();
+    }
+
+    mConn->DB().ThreadEnd();
+}
+
+void QueryResultMysqlStream::EndQuery()
+{
+    if (mReader.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mBatchLock);
+            mStopReader = true;
+        }
+        mBatchCondition.notify_all();
+        mReader.join();
+    }
+
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+
+    if (mResult)
+    {
+        // rows not read yet are skipped by mysql_free_result, connection is ready for next query then
+        mysql_free_result(mResult);
+        mResult = nullptr;
+        mConn->DB().ReleaseStreamConnection(mConn);
+    }
+}
+
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
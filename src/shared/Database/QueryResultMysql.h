@@ -30,6 +30,14 @@
 
 #include <mysql.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SqlConnection;
+
 class QueryResultMysql : public QueryResult
 {
     public:
@@ -39,12 +47,104 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
 };
+
+// Result of a prepared statement, read with the binary protocol
+// Rows are fetched out of the statement at once, so the statement can be reused while the result is iterated
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_FIELD* fields, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow() override;
+
+    private:
+        enum
+        {
+            TEXT_BUFFER_SIZE    = 255,                      // per text column, longer values are fetched on their own
+        };
+
+        enum ColumnStorage
+        {
+            COLUMN_INT,
+            COLUMN_UINT,
+            COLUMN_FLOAT,
+            COLUMN_DOUBLE,
+            COLUMN_TEXT
+        };
+
+        struct Cell
+        {
+            union
+            {
+                int64 i;
+                uint64 u;
+                double d;
+                size_t textOffset;                          // in mText, zero terminated
+            };
+            bool isNull;
+        };
+
+        void EndQuery();
+
+        std::vector<ColumnStorage> mColumns;
+        std::vector<Cell> mCells;                           // row after row
+        std::vector<char> mText;
+        uint64 mNextRow;
+};
+// Result read with mysql_use_result, rows are received while the previous ones are processed
+// Owns the connection it is read from until the end of the result
+class QueryResultMysqlStream : public QueryResult
+{
+    public:
+        QueryResultMysqlStream(SqlConnection* conn, MYSQL* mysql, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, bool readAhead);
+
+        ~QueryResultMysqlStream();
+
+        bool NextRow() override;
+
+    private:
+        enum
+        {
+            READ_AHEAD_BATCH_ROWS   = 1024,
+            READ_AHEAD_MAX_BATCHES  = 8,
+        };
+
+        // rows copied by the read ahead thread, values are zero terminated in text
+        struct RowBatch
+        {
+            std::vector<char> text;
+            std::vector<size_t> offsets;                    // per value, NULL_VALUE_OFFSET for NULL
+            uint32 rows = 0;
+        };
+
+        static constexpr size_t NULL_VALUE_OFFSET = size_t(-1);
+
+        void ReadAhead();
+        void EndQuery();
+
+        SqlConnection* mConn;
+        MYSQL* mMysql;
+        MYSQL_RES* mResult;
+
+        std::thread mReader;
+        std::mutex mBatchLock;
+        std::condition_variable mBatchCondition;
+        std::deque<RowBatch> mBatches;
+        bool mReaderDone;
+        bool mStopReader;
+
+        RowBatch mBatch;                                    // batch of current row
+        uint32 mBatchRow;
+};
 #endif
 #endif
 #endif
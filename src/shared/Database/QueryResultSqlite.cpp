@@ -23,26 +23,26 @@
 #include "sqlite3.h"
 #include "QueryResultSqlite.h"
 
-QueryResultSqlite::QueryResultSqlite(sqlite3_stmt** stmt) :
+QueryResultSqlite::QueryResultSqlite(sqlite3_stmt* stmt) :
     QueryResult(0, 0), mStmt(stmt)
 {
-    if (mStmt && *mStmt)
+    if (mStmt)
     {
-        while (sqlite3_step(*mStmt) == SQLITE_ROW)
+        while (sqlite3_step(mStmt) == SQLITE_ROW)
         {
             // Process each row's data here
             mRowCount++;
         }
-        sqlite3_reset(*mStmt);
-        mFieldCount = sqlite3_column_count(*mStmt);
+        sqlite3_reset(mStmt);
+        mFieldCount = sqlite3_column_count(mStmt);
         mCurrentRow = new Field[mFieldCount];
         MANGOS_ASSERT(mCurrentRow);
 
         for (int i = 0; i < mFieldCount; ++i)
         {
-            const unsigned char* value = sqlite3_column_text(*mStmt, i);
+            const unsigned char* value = sqlite3_column_text(mStmt, i);
             mCurrentRow[i].SetValue(value ? reinterpret_cast<const char*>(value) : "");
-            mCurrentRow[i].SetType(ConvertNativeType(sqlite3_column_type(*mStmt, i)));
+            mCurrentRow[i].SetType(ConvertNativeType(sqlite3_column_type(mStmt, i)));
         }
     }
 }
@@ -54,10 +54,10 @@ QueryResultSqlite::~QueryResultSqlite()
 
 bool QueryResultSqlite::NextRow()
 {
-    if (!mStmt || !(*mStmt))
+    if (!mStmt)
         return false;
 
-    int rc = sqlite3_step(*mStmt);
+    int rc = sqlite3_step(mStmt);
     if (rc != SQLITE_ROW)
     {
         EndQuery();
@@ -66,10 +66,10 @@ bool QueryResultSqlite::NextRow()
 
     for (int i = 0; i < mFieldCount; ++i)
     {
-        const unsigned char* value = sqlite3_column_text(*mStmt, i);
+        const unsigned char* value = sqlite3_column_text(mStmt, i);
 
         mCurrentRow[i].SetValue(value ? reinterpret_cast<const char*>(value) : nullptr);
-        mCurrentRow[i].SetType(ConvertNativeType(sqlite3_column_type(*mStmt, i)));
+        mCurrentRow[i].SetType(ConvertNativeType(sqlite3_column_type(mStmt, i)));
     }
 
     return true;
@@ -77,18 +77,85 @@ bool QueryResultSqlite::NextRow()
 
 void QueryResultSqlite::EndQuery()
 {
-    if (mStmt && *mStmt)
+    if (mStmt)
     {
-        sqlite3_finalize(*mStmt);
-        *mStmt = nullptr;
-        //mStmt = nullptr;
+        sqlite3_finalize(mStmt);
+        mStmt = nullptr;
     }
 
     delete[] mCurrentRow;
     mCurrentRow = nullptr;
 }
 
-enum Field::DataTypes QueryResultSqlite::ConvertNativeType(int sqliteType) const
+QueryResultSqliteStmt::QueryResultSqliteStmt(sqlite3_stmt* stmt) :
+    QueryResult(0, sqlite3_column_count(stmt)), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            // types of the first row
+            if (!mRowCount)
+                mCurrentRow[i].SetType(QueryResultSqlite::ConvertNativeType(sqlite3_column_type(stmt, i)));
+
+            const unsigned char* value = sqlite3_column_text(stmt, i);
+            if (!value)
+            {
+                mOffsets.push_back(NULL_VALUE_OFFSET);
+                continue;
+            }
+
+            mOffsets.push_back(mText.size());
+            mText.insert(mText.end(), value, value + sqlite3_column_bytes(stmt, i));
+            mText.push_back('\0');
+        }
+
+        ++mRowCount;
+    }
+
+    if (rc != SQLITE_DONE)
+    {
+        sLog.outErrorDb("SQL ERROR: %s", sqlite3_errmsg(sqlite3_db_handle(stmt)));
+        mFailed = true;
+    }
+}
+
+QueryResultSqliteStmt::~QueryResultSqliteStmt()
+{
+    EndQuery();
+}
+
+bool QueryResultSqliteStmt::NextRow()
+{
+    if (!mCurrentRow)
+        return false;
+
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    size_t const* offsets = &mOffsets[mNextRow * mFieldCount];
+    ++mNextRow;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetValue(offsets[i] != NULL_VALUE_OFFSET ? &mText[offsets[i]] : nullptr);
+
+    return true;
+}
+
+void QueryResultSqliteStmt::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+}
+
+enum Field::DataTypes QueryResultSqlite::ConvertNativeType(int sqliteType)
 {
     switch (sqliteType)
     {
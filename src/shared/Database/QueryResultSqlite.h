@@ -30,10 +30,13 @@
 
 #include <sqlite3.h>
 
+#include <vector>
+
+// Result stepped from the statement while iterated, finalizes the statement at its end
 class QueryResultSqlite : public QueryResult
 {
     public:
-        QueryResultSqlite(sqlite3_stmt** stmt);
+        QueryResultSqlite(sqlite3_stmt* stmt);
 
         ~QueryResultSqlite();
 
@@ -44,12 +47,34 @@ class QueryResultSqlite : public QueryResult
           return (mRowCount * mFieldCount) > 0;
         }
 
+        static enum Field::DataTypes ConvertNativeType(int sqliteType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(int sqliteType) const;
         //enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
-        sqlite3_stmt** mStmt;
+        sqlite3_stmt* mStmt;
+};
+
+// Result of a prepared statement
+// Rows are copied out of the statement at once, so the statement can be reset and reused while the result is iterated
+class QueryResultSqliteStmt : public QueryResult
+{
+    public:
+        QueryResultSqliteStmt(sqlite3_stmt* stmt);
+
+        ~QueryResultSqliteStmt();
+
+        bool NextRow() override;
+
+    private:
+        static constexpr size_t NULL_VALUE_OFFSET = size_t(-1);
+
+        void EndQuery();
+
+        std::vector<size_t> mOffsets;                       // row after row, in mText, NULL_VALUE_OFFSET for NULL
+        std::vector<char> mText;                            // zero terminated values
+        uint64 mNextRow;
 };
 #endif
 #endif
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 #include "DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 class SQLStorageBase
 {
@@ -270,6 +271,11 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        template<class Source>
+        void loadRecord(StorageClass& store, Source& source);
+        bool loadFromSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot);
+        uint32 getRecordSize(StorageClass& store);
+
         template<class V>
         void storeValue(V value, StorageClass& store, char* p, uint32 x, uint32& offset);
         void storeValue(char const* value, StorageClass& store, char* p, uint32 x, uint32& offset);
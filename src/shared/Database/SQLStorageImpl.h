@@ -302,52 +302,165 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+// Value source reading the current row of a query result, optionally copying values into a snapshot
+class SQLStorageFieldSource
+{
+    public:
+        SQLStorageFieldSource(SQLStorageSnapshot& snapshot) : m_snapshot(snapshot), m_fields(nullptr) {}
+
+        void SetRow(Field* fields) { m_fields = fields; }
+
+        uint32 GetRecordId() { return record(m_fields[0].GetUInt32()); }
+        bool GetBool(uint32 y) { return record<uint8>(m_fields[y].GetUInt32() > 0) != 0; }
+        char GetByte(uint32 y) { return record((char)m_fields[y].GetUInt8()); }
+        uint32 GetUInt32(uint32 y) { return record(m_fields[y].GetUInt32()); }
+        float GetFloat(uint32 y) { return record(m_fields[y].GetFloat()); }
+        uint64 GetUInt64(uint32 y) { return record(m_fields[y].GetUInt64()); }
+        char const* GetString(uint32 y)
+        {
+            char const* value = m_fields[y].GetString();
+            if (m_snapshot.IsRecording())
+                m_snapshot.WriteString(value);
+            return value;
+        }
+
+    private:
+        template<typename T>
+        T record(T value)
+        {
+            if (m_snapshot.IsRecording())
+                m_snapshot.Write<T>(value);
+            return value;
+        }
+
+        SQLStorageSnapshot& m_snapshot;
+        Field* m_fields;
+};
+
+// Value source reading values in order from a loaded snapshot
+class SQLStorageSnapshotSource
+{
+    public:
+        SQLStorageSnapshotSource(SQLStorageSnapshot& snapshot, uint32 maxRecordId) : m_snapshot(snapshot), m_maxRecordId(maxRecordId) {}
+
+        uint32 GetRecordId()
+        {
+            // the store index is sized by the header, an id outside of it must not be created
+            uint32 recordId = m_snapshot.Read<uint32>();
+            if (recordId >= m_maxRecordId)
+            {
+                m_snapshot.SetInvalid();
+                return 0;
+            }
+            return recordId;
+        }
+        bool GetBool(uint32 /*y*/) { return m_snapshot.Read<uint8>() != 0; }
+        char GetByte(uint32 /*y*/) { return m_snapshot.Read<char>(); }
+        uint32 GetUInt32(uint32 /*y*/) { return m_snapshot.Read<uint32>(); }
+        float GetFloat(uint32 /*y*/) { return m_snapshot.Read<float>(); }
+        uint64 GetUInt64(uint32 /*y*/) { return m_snapshot.Read<uint64>(); }
+        char const* GetString(uint32 /*y*/) { return m_snapshot.ReadString(); }
+
+    private:
+        SQLStorageSnapshot& m_snapshot;
+        uint32 m_maxRecordId;
+};
+
 template<class DerivedLoader, class StorageClass>
-void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
+template<class Source>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadRecord(StorageClass& store, Source& source)
 {
-    Field* fields = nullptr;
-    auto queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
-    if (!queryResult)
+    char* record = store.createRecord(source.GetRecordId());
+    uint32 offset = 0;
+
+    // dependend on dest-size
+    // iterate two indexes: x over dest, y over source
+    //                      y++ If and only If x != FT_NA*
+    //                      x++ If and only If a value is stored
+    for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
     {
-        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading non exited table or not accessable table
+        switch (store.GetDstFormat(x))
+        {
+            // For default fill continue and do not increase y
+            case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
+            case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
+            case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
+            case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
+            default:
+                break;
+        }
+
+        // It is required that the input has at least as many columns set as the output requires
+        if (y >= store.GetSrcFieldCount())
+            assert(false && "SQL storage has too few columns!");
+
+        switch (store.GetSrcFormat(y))
+        {
+            case FT_LOGIC:  storeValue((bool)source.GetBool(y), store, record, x, offset);            ++x; break;
+            case FT_BYTE:   storeValue((char)source.GetByte(y), store, record, x, offset);            ++x; break;
+            case FT_INT:    storeValue((uint32)source.GetUInt32(y), store, record, x, offset);        ++x; break;
+            case FT_FLOAT:  storeValue((float)source.GetFloat(y), store, record, x, offset);          ++x; break;
+            case FT_STRING: storeValue((char const*)source.GetString(y), store, record, x, offset);   ++x; break;
+            case FT_64BITINT: storeValue((uint64)source.GetUInt64(y), store, record, x, offset);      ++x; break;
+            case FT_NA:
+            case FT_NA_BYTE:
+            case FT_NA_FLOAT:
+                // Do Not increase x
+                break;
+            case FT_IND:
+            case FT_SORT:
+            case FT_NA_POINTER:
+                assert(false && "SQL storage not have sort or pointer field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+        }
+        ++y;
     }
+}
 
-    uint32 maxRecordId = (*queryResult)[0].GetUInt32() + 1;
+template<class DerivedLoader, class StorageClass>
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadFromSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot)
+{
+    uint32 maxRecordId = 0;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
+    if (!snapshot.Open(maxRecordId, recordCount))
+        return false;
 
-    queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
-    if (queryResult)
+    // an empty index can not hold any record, see SQLStorageSnapshotSource::GetRecordId
+    if (recordCount && !maxRecordId)
     {
-        fields = queryResult->Fetch();
-        recordCount = fields[0].GetUInt32();
+        sLog.outError("Snapshot of %s table is corrupted, loading from DB.", store.GetTableName());
+        snapshot.Discard();
+        return false;
     }
 
-    queryResult = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    store.prepareToLoad(maxRecordId, recordCount, getRecordSize(store));
 
-    if (!queryResult)
+    SQLStorageSnapshotSource source(snapshot, maxRecordId);
+    BarGoLink bar(recordCount);
+    for (uint32 i = 0; i < recordCount && snapshot.IsValid(); ++i)
     {
-        if (error_at_empty)
-            sLog.outError("%s table is empty!\n", store.GetTableName());
-        else
-            sLog.outString("%s table is empty!\n", store.GetTableName());
-
-        recordCount = 0;
-        return;
+        bar.step();
+        loadRecord(store, source);
     }
 
-    if (store.GetSrcFieldCount() != queryResult->GetFieldCount())
+    // all values must be consumed by exactly recordCount records
+    if (!snapshot.IsValid() || !snapshot.IsFullyRead())
     {
-        recordCount = 0;
-        sLog.outError("Error in %s table, probably sql file format was updated (there should be %d fields in sql).\n", store.GetTableName(), store.GetSrcFieldCount());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading broken or non-compatible table.
+        sLog.outError("Snapshot of %s table is corrupted, loading from DB.", store.GetTableName());
+        snapshot.Discard();
+        return false;
     }
 
-    // get struct size
-    uint32 offset = 0;
+    sLog.outString("Loaded %u records of %s table from snapshot.", recordCount, store.GetTableName());
+    return true;
+}
+
+template<class DerivedLoader, class StorageClass>
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::getRecordSize(StorageClass& store)
+{
+    uint32 recordsize = 0;
     for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
     {
         switch (store.GetDstFormat(x))
@@ -381,65 +494,84 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
                 break;
         }
     }
+    return recordsize;
+}
 
-    // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+template<class DerivedLoader, class StorageClass>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
+{
+    // unchanged table content, use the stored source values instead of query and field parsing
+    SQLStorageSnapshot snapshot(store.GetTableName(), store.EntryFieldName(), store.GetSrcFormat());
+    if (snapshot.Prepare(WorldDatabase) && loadFromSnapshot(store, snapshot))
+        return;
 
-    BarGoLink bar(recordCount);
-    do
+    Field* fields = nullptr;
+    auto queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
+    if (!queryResult)
+    {
+        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Stop server at loading non exited table or not accessable table
+    }
+
+    uint32 maxRecordId = (*queryResult)[0].GetUInt32() + 1;
+    uint32 recordCount = 0;
+
+    queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+    if (queryResult)
     {
         fields = queryResult->Fetch();
-        bar.step();
+        recordCount = fields[0].GetUInt32();
+    }
 
-        char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+    // prepared statement, so numeric columns are read typed instead of parsed from text
+    SqlStatementID selectAll;
+    SqlStatement stmt = WorldDatabase.CreateStatement(selectAll, (std::string("SELECT * FROM ") + store.GetTableName()).c_str());
+    queryResult = stmt.Query();
 
-        // dependend on dest-size
-        // iterate two indexes: x over dest, y over source
-        //                      y++ If and only If x != FT_NA*
-        //                      x++ If and only If a value is stored
-        for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
-        {
-            switch (store.GetDstFormat(x))
-            {
-                // For default fill continue and do not increase y
-                case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
-                case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
-                case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
-                case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
-                default:
-                    break;
-            }
+    // rows read before the error are not the table content, and must not be stored in the snapshot
+    if (queryResult && queryResult->IsFailed())
+    {
+        sLog.outError("Error loading %s table, reading the rows failed.\n", store.GetTableName());
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Stop server at loading incomplete table
+    }
 
-            // It is required that the input has at least as many columns set as the output requires
-            if (y >= store.GetSrcFieldCount())
-                assert(false && "SQL storage has too few columns!");
+    if (!queryResult)
+    {
+        if (error_at_empty)
+            sLog.outError("%s table is empty!\n", store.GetTableName());
+        else
+            sLog.outString("%s table is empty!\n", store.GetTableName());
 
-            switch (store.GetSrcFormat(y))
-            {
-                case FT_LOGIC:  storeValue((bool)(fields[y].GetUInt32() > 0), store, record, x, offset);  ++x; break;
-                case FT_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
-                case FT_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
-                case FT_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case FT_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
-                case FT_64BITINT: storeValue((uint64)fields[y].GetUInt64(), store, record, x, offset);            ++x; break;
-                case FT_NA:
-                case FT_NA_BYTE:
-                case FT_NA_FLOAT:
-                    // Do Not increase x
-                    break;
-                case FT_IND:
-                case FT_SORT:
-                case FT_NA_POINTER:
-                    assert(false && "SQL storage not have sort or pointer field types");
-                    break;
-                default:
-                    assert(false && "unknown format character");
-            }
-            ++y;
-        }
+        recordCount = 0;
+        return;
+    }
+
+    if (store.GetSrcFieldCount() != queryResult->GetFieldCount())
+    {
+        recordCount = 0;
+        sLog.outError("Error in %s table, probably sql file format was updated (there should be %d fields in sql).\n", store.GetTableName(), store.GetSrcFieldCount());
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Stop server at loading broken or non-compatible table.
+    }
+
+    // Prepare data storage and lookup storage
+    store.prepareToLoad(maxRecordId, recordCount, getRecordSize(store));
+
+    SQLStorageFieldSource source(snapshot);
+    uint32 loadedCount = 0;
+    BarGoLink bar(recordCount);
+    do
+    {
+        bar.step();
+        source.SetRow(queryResult->Fetch());
+        loadRecord(store, source);
+        ++loadedCount;
     }
     while (queryResult->NextRow());
+
+    snapshot.Save(maxRecordId, loadedCount);
 }
 
 #endif
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "Database/Database.h"
+#include "Log/Log.h"
+
+#include <cstdio>
+
+static uint32 const SNAPSHOT_MAGIC   = 0x4E535153;          // "SQSN"
+static uint32 const SNAPSHOT_VERSION = 3;
+
+// FNV-1a over record count, highest entry and values, catches a damaged or truncated body
+static uint64 SnapshotChecksum(uint32 maxEntry, uint32 recordCount, char const* data, size_t size)
+{
+    uint64 hash = 0xCBF29CE484222325ULL;
+    auto add = [&hash](char const* bytes, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i)
+            hash = (hash ^ uint8(bytes[i])) * 0x100000001B3ULL;
+    };
+
+    add(reinterpret_cast<char const*>(&maxEntry), sizeof(maxEntry));
+    add(reinterpret_cast<char const*>(&recordCount), sizeof(recordCount));
+    add(data, size);
+    return hash;
+}
+
+std::string SQLStorageSnapshot::m_directory;
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* tableName, char const* entryField, char const* srcFormat) :
+    m_tableName(tableName), m_entryField(entryField), m_srcFormat(srcFormat), m_signature(0),
+    m_recording(false), m_valid(true), m_readPos(0)
+{
+}
+
+void SQLStorageSnapshot::SetDirectory(std::string const& directory)
+{
+    m_directory = directory;
+
+    // normalize dir path to path/ or path\ form
+    if (!m_directory.empty() && m_directory.back() != '/' && m_directory.back() != '\\')
+        m_directory.append("/");
+}
+
+std::string SQLStorageSnapshot::GetFileName() const
+{
+    return m_directory + m_tableName + ".snapshot";
+}
+
+bool SQLStorageSnapshot::Prepare(Database& db)
+{
+    if (!IsEnabled())
+        return false;
+
+    if (!db.GetTableSignature(m_tableName, m_entryField, m_signature))
+        return false;
+
+    m_recording = true;
+    return true;
+}
+
+bool SQLStorageSnapshot::Open(uint32& maxEntry, uint32& recordCount)
+{
+    FILE* file = fopen(GetFileName().c_str(), "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    m_buffer.resize(size > 0 ? size_t(size) : 0);
+    bool readOk = !m_buffer.empty() && fread(&m_buffer[0], 1, m_buffer.size(), file) == m_buffer.size();
+    fclose(file);
+
+    m_readPos = 0;
+    m_valid = readOk;
+    if (!readOk)
+    {
+        m_buffer.clear();
+        return false;
+    }
+
+    uint32 magic = Read<uint32>();
+    uint32 version = Read<uint32>();
+    uint64 signature = Read<uint64>();
+    char const* format = ReadString();
+    maxEntry = Read<uint32>();
+    recordCount = Read<uint32>();
+    uint64 bodySize = Read<uint64>();
+    uint64 checksum = Read<uint64>();
+
+    bool headerOk = m_valid && magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION && signature == m_signature &&
+                    strcmp(format, m_srcFormat) == 0 && bodySize == m_buffer.size() - m_readPos &&
+                    recordCount <= bodySize / sizeof(uint32);
+    if (headerOk && checksum != SnapshotChecksum(maxEntry, recordCount, m_buffer.data() + m_readPos, size_t(bodySize)))
+    {
+        sLog.outError("SQLStorageSnapshot: Snapshot file %s fails checksum, loading from DB.", GetFileName().c_str());
+        headerOk = false;
+    }
+
+    if (!headerOk)
+    {
+        m_buffer.clear();
+        m_readPos = 0;
+        m_valid = true;
+        return false;
+    }
+
+    // up-to-date snapshot, no need to write it again
+    m_recording = false;
+    return true;
+}
+
+void SQLStorageSnapshot::Save(uint32 maxEntry, uint32 recordCount)
+{
+    if (!m_recording)
+        return;
+
+    std::vector<char> body;
+    body.swap(m_buffer);
+
+    Write<uint32>(SNAPSHOT_MAGIC);
+    Write<uint32>(SNAPSHOT_VERSION);
+    Write<uint64>(m_signature);
+    WriteString(m_srcFormat);
+    Write<uint32>(maxEntry);
+    Write<uint32>(recordCount);
+    Write<uint64>(body.size());
+    Write<uint64>(SnapshotChecksum(maxEntry, recordCount, body.data(), body.size()));
+
+    std::string fileName = GetFileName();
+    std::string tmpName = fileName + ".tmp";
+
+    FILE* file = fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("SQLStorageSnapshot: Can not create snapshot file %s", tmpName.c_str());
+        m_recording = false;
+        return;
+    }
+
+    bool writeOk = fwrite(&m_buffer[0], 1, m_buffer.size(), file) == m_buffer.size();
+    if (!body.empty())
+        writeOk = writeOk && fwrite(&body[0], 1, body.size(), file) == body.size();
+    writeOk = (fclose(file) == 0) && writeOk;
+
+    // replace old snapshot only by completely written one, the old one stays if replacing fails
+#if PLATFORM == PLATFORM_WINDOWS
+    bool replaced = writeOk && MoveFileExA(tmpName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    bool replaced = writeOk && rename(tmpName.c_str(), fileName.c_str()) == 0;
+#endif
+    if (!replaced)
+    {
+        sLog.outError("SQLStorageSnapshot: Can not write snapshot file %s", fileName.c_str());
+        remove(tmpName.c_str());
+    }
+
+    m_buffer.clear();
+    m_recording = false;
+}
+
+void SQLStorageSnapshot::Discard()
+{
+    m_buffer.clear();
+    m_readPos = 0;
+    m_valid = true;
+    m_recording = true;
+}
+
+void SQLStorageSnapshot::WriteString(char const* value)
+{
+    uint32 length = value ? strlen(value) : 0;
+    Write<uint32>(length);
+    if (length)
+        m_buffer.insert(m_buffer.end(), value, value + length);
+    m_buffer.push_back('\0');
+}
+
+char const* SQLStorageSnapshot::ReadString()
+{
+    uint32 length = Read<uint32>();
+    if (!m_valid || m_readPos + length + 1 > m_buffer.size() || m_buffer[m_readPos + length] != '\0')
+    {
+        m_valid = false;
+        return "";
+    }
+
+    char const* value = &m_buffer[m_readPos];
+    m_readPos += length + 1;
+    return value;
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common.h"
+
+#include <string>
+#include <vector>
+
+class Database;
+
+/**
+ * On-disk copy of the source values of one SQLStorage table.
+ *
+ * The snapshot is keyed by the DB side table signature (changed row counter and highest
+ * key, see Database::GetTableSignature) and the source format, so a change of table
+ * content or structure makes it stale and the table is loaded from SQL again. Values
+ * are stored before loader conversion (script names stay strings), so loaders with
+ * custom convert functions produce the same records as from SQL. A checksum over the values
+ * guards against damaged files. Only SQLStorage tables use snapshots, ObjectMgr loaders
+ * with own queries (spawns, loot, waypoints) always read SQL.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        SQLStorageSnapshot(char const* tableName, char const* entryField, char const* srcFormat);
+
+        // directory to store snapshot files in, empty string disables snapshots
+        static void SetDirectory(std::string const& directory);
+        static bool IsEnabled() { return !m_directory.empty(); }
+
+        // fetch table signature, returns false if snapshots disabled or not supported by DB backend
+        bool Prepare(Database& db);
+        // load snapshot file, returns false if not exist or stale
+        bool Open(uint32& maxEntry, uint32& recordCount);
+        // write collected values to snapshot file
+        void Save(uint32 maxEntry, uint32 recordCount);
+        // drop loaded data of a broken snapshot and collect values for rewriting it
+        void Discard();
+
+        // true while values loaded from SQL must be collected for Save
+        bool IsRecording() const { return m_recording; }
+        // false if a read went past the end of loaded data or loaded data is inconsistent
+        bool IsValid() const { return m_valid; }
+        void SetInvalid() { m_valid = false; }
+        // true if all loaded data was read
+        bool IsFullyRead() const { return m_readPos == m_buffer.size(); }
+
+        template<typename T>
+        void Write(T value)
+        {
+            char const* data = reinterpret_cast<char const*>(&value);
+            m_buffer.insert(m_buffer.end(), data, data + sizeof(T));
+        }
+        void WriteString(char const* value);
+
+        template<typename T>
+        T Read()
+        {
+            T value = T();
+            if (m_readPos + sizeof(T) > m_buffer.size())
+            {
+                m_valid = false;
+                return value;
+            }
+
+            memcpy(&value, &m_buffer[m_readPos], sizeof(T));
+            m_readPos += sizeof(T);
+            return value;
+        }
+        char const* ReadString();
+
+    private:
+        std::string GetFileName() const;
+
+        char const* m_tableName;
+        char const* m_entryField;
+        char const* m_srcFormat;
+        uint64 m_signature;
+
+        bool m_recording;
+        bool m_valid;
+
+        std::vector<char> m_buffer;
+        size_t m_readPos;
+
+        static std::string m_directory;
+};
+
+#endif
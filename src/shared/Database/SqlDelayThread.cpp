@@ -88,3 +88,71 @@ void SqlDelayThread::ProcessRequests()
         s->Execute(m_dbConnection);
     }
 }
+
+/// Body of one worker thread, executes tasks on its connection
+class SqlQueryWorkers::Worker : public MaNGOS::Runnable
+{
+    public:
+        Worker(SqlQueryWorkers* workers, SqlConnection* conn) : m_workers(workers), m_conn(conn) {}
+
+        void run() override { m_workers->run(m_conn); }
+
+    private:
+        SqlQueryWorkers* m_workers;
+        SqlConnection* m_conn;
+};
+
+SqlQueryWorkers::SqlQueryWorkers(Database* db, std::vector<SqlConnection*> const& connections) : m_dbEngine(db), m_running(true)
+{
+    for (SqlConnection* conn : connections)
+        m_threads.push_back(new MaNGOS::Thread(new Worker(this, conn)));   // worker is deleted with its thread
+}
+
+SqlQueryWorkers::~SqlQueryWorkers()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_all();
+
+    for (MaNGOS::Thread* thread : m_threads)
+    {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void SqlQueryWorkers::Enqueue(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_tasks.push(std::move(task));
+    }
+    m_queueCondition.notify_one();
+}
+
+void SqlQueryWorkers::run(SqlConnection* conn)
+{
+    m_dbEngine->ThreadStart();
+
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this] { return !m_running || !m_tasks.empty(); });
+
+            // queue is emptied before exiting
+            if (m_tasks.empty())
+                break;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task(conn);
+    }
+
+    m_dbEngine->ThreadEnd();
+}
@@ -23,9 +23,12 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 class Database;
 class SqlOperation;
@@ -58,4 +61,29 @@ class SqlDelayThread : public MaNGOS::Runnable
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
+
+/// Threads with a DB connection each, the queries of a query holder are spread over them
+class SqlQueryWorkers
+{
+    public:
+        typedef std::function<void(SqlConnection*)> Task;
+
+        SqlQueryWorkers(Database* db, std::vector<SqlConnection*> const& connections);
+        ~SqlQueryWorkers();                                 ///< Executes queued tasks and stops the threads
+
+        void Enqueue(Task&& task);
+        size_t GetThreadCount() const { return m_threads.size(); }
+
+    private:
+        class Worker;
+
+        void run(SqlConnection* conn);
+
+        Database* m_dbEngine;
+        std::vector<MaNGOS::Thread*> m_threads;
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCondition;
+        std::queue<Task> m_tasks;
+        bool m_running;
+};
 #endif                                                      //__SQLDELAYTHREAD_H
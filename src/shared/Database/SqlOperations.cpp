@@ -117,14 +117,14 @@ void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback)
     m_queue.push(std::unique_ptr<MaNGOS::IQueryCallback>(callback));
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, SqlQueryWorkers* workers /*= nullptr*/)
 {
     if (!callback || !thread || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, IsParallel() ? workers : nullptr);
     thread->Delay(holderEx);
     return true;
 }
@@ -219,9 +219,43 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     if (!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+
+    /// spread the queries over the worker connections, the last finished one syncs with the caller thread
+    /// still started in delay thread order, so requests queued before the holder are already done
+    if (m_workers)
+    {
+        auto pending = std::make_shared<std::atomic<size_t>>(1);
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            char const* sql = queries[i].first;
+            if (!sql)
+                continue;
+
+            ++*pending;
+            SqlQueryHolder* holder = m_holder;
+            MaNGOS::IQueryCallback* callback = m_callback;
+            SqlResultQueue* queue = m_queue;
+            m_workers->Enqueue([holder, callback, queue, pending, sql, i](SqlConnection* workerConn)
+            {
+                {
+                    LOCK_DB_CONN(workerConn);
+                    holder->SetResult(i, workerConn->Query(sql));
+                }
+
+                if (--*pending == 0)
+                    queue->Add(callback);
+            });
+        }
+
+        if (--*pending == 0)
+            m_queue->Add(m_callback);
+
+        return true;
+    }
+
+    LOCK_DB_CONN(conn);
     for (size_t i = 0; i < queries.size(); ++i)
     {
         /// execute all queries in the holder and pass the results
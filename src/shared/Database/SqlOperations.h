@@ -32,6 +32,7 @@
 class Database;
 class SqlConnection;
 class SqlDelayThread;
+class SqlQueryWorkers;
 class SqlStmtParameters;
 
 class SqlOperation
@@ -130,7 +131,9 @@ class SqlQueryHolder
         void SetSize(size_t size);
         std::unique_ptr<QueryResult> GetResult(size_t index);
         void SetResult(size_t index, std::unique_ptr<QueryResult> queryResult);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        // queries of the holder may be spread over the query workers of the database, none by default
+        virtual bool IsParallel() const { return false; }
+        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, SqlQueryWorkers* workers = nullptr);
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -139,9 +142,10 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        SqlQueryWorkers* m_workers;
     public:
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, SqlQueryWorkers* workers)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_workers(workers) {}
         bool Execute(SqlConnection* conn) override;
 };
 #endif                                                      //__SQLOPERATIONS_H
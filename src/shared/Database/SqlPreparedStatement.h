@@ -21,6 +21,7 @@
 
 #include "Common.h"
 
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
@@ -202,6 +203,9 @@ class SqlStatement
 
         bool Execute();
         bool DirectExecute();
+        // SELECT statement, rows are read without string conversion where the DB backend supports it
+        // rows are read at once, a read error gives a result with IsFailed() set, possibly without rows
+        std::unique_ptr<QueryResult> Query();
 
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -238,6 +242,41 @@ class SqlStatement
             return Execute();
         }
 
+        // templates to simplify 1-4 parameter bindings of queries
+        template<typename ParamType1>
+        std::unique_ptr<QueryResult> PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        std::unique_ptr<QueryResult> PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        std::unique_ptr<QueryResult> PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3, typename ParamType4>
+        std::unique_ptr<QueryResult> PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3, ParamType4 param4)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            arg(param4);
+            return Query();
+        }
+
         // bind parameters with specified type
         void addBool(bool var) { arg(var); }
         void addUInt8(uint8 var) { arg(var); }
@@ -310,6 +349,8 @@ class SqlPreparedStatement
 
         // execute statement w/o result set
         virtual bool execute() = 0;
+        // execute statement with result set, nullptr on error or empty result
+        virtual std::unique_ptr<QueryResult> query() = 0;
 
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) :
@@ -339,6 +380,7 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
         virtual void bind(const SqlStmtParameters& holder) override;
 
         virtual bool execute() override;
+        virtual std::unique_ptr<QueryResult> query() override;
 
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
@@ -37,10 +37,10 @@
 // Format is YYYYMMDDRR where RR is the change in the conf file
 // for that day.
 #ifndef _MANGOSDCONFVERSION
-# define _MANGOSDCONFVERSION 2022012301
+# define _MANGOSDCONFVERSION 2026101902
 #endif
 #ifndef _REALMDCONFVERSION
-# define _REALMDCONFVERSION 2021031501
+# define _REALMDCONFVERSION 2026101901
 #endif
 
 #if MANGOS_ENDIAN == MANGOS_BIG_ENDIAN
@@ -0,0 +1,285 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/BufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    using namespace BufferPool;
+
+    size_t const THREAD_CACHE_BYTES     = 64 * 1024;        // per class and thread
+    size_t const DEPOT_BYTES            = 1024 * 1024;      // per class
+    uint32 const STATS_FLUSH_INTERVAL   = 256;              // operations between publishing thread counters
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+        uint32 count = 0;
+
+        void Push(void* ptr)
+        {
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->next = head;
+            head = block;
+            ++count;
+        }
+
+        void* Pop()
+        {
+            FreeBlock* block = head;
+            if (block)
+            {
+                head = block->next;
+                --count;
+            }
+            return block;
+        }
+    };
+
+    inline size_t GetClassSize(uint32 index) { return size_t(BUFFER_POOL_MIN_BLOCK) << index; }
+
+    inline uint32 GetMaxThreadBlocks(uint32 index) { return std::max<uint32>(THREAD_CACHE_BYTES / GetClassSize(index), 8); }
+    inline uint32 GetMaxDepotBlocks(uint32 index) { return std::max<uint32>(DEPOT_BYTES / GetClassSize(index), 32); }
+
+    // smallest class holding size, -1 if bigger than all
+    inline int32 GetClass(size_t size)
+    {
+        if (size > BUFFER_POOL_MAX_BLOCK)
+            return -1;
+
+        int32 index = 0;
+        for (size_t block = BUFFER_POOL_MIN_BLOCK; block < size; block <<= 1)
+            ++index;
+        return index;
+    }
+
+    std::atomic<uint64> s_hits(0);
+    std::atomic<uint64> s_misses(0);
+    std::atomic<uint64> s_oversized(0);
+    std::atomic<int64> s_bytesRetained(0);
+
+    struct Depot
+    {
+        std::mutex lock[BUFFER_POOL_CLASSES];
+        FreeList lists[BUFFER_POOL_CLASSES];
+    };
+
+    // never destroyed, buffers of static objects may be freed after all other statics are gone
+    Depot& GetDepot()
+    {
+        static Depot* depot = new Depot;
+        return *depot;
+    }
+
+    void* AllocateFromDepot(uint32 index)
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard<std::mutex> guard(depot.lock[index]);
+        return depot.lists[index].Pop();
+    }
+
+    // takes blocks the depot has no room for and frees them
+    void ReleaseToDepot(uint32 index, FreeList& blocks, uint32 count)
+    {
+        int64 freed = 0;
+        {
+            Depot& depot = GetDepot();
+            std::lock_guard<std::mutex> guard(depot.lock[index]);
+            FreeList& list = depot.lists[index];
+            uint32 const maxBlocks = GetMaxDepotBlocks(index);
+            for (; count && blocks.head; --count)
+            {
+                void* block = blocks.Pop();
+                if (list.count < maxBlocks)
+                    list.Push(block);
+                else
+                {
+                    ::operator delete(block);
+                    freed += GetClassSize(index);
+                }
+            }
+        }
+
+        if (freed)
+            s_bytesRetained.fetch_sub(freed, std::memory_order_relaxed);
+    }
+
+    struct ThreadCache
+    {
+        FreeList lists[BUFFER_POOL_CLASSES];
+
+        uint64 hits = 0;
+        uint64 misses = 0;
+        uint64 oversized = 0;
+        int64 bytesRetained = 0;
+        uint32 operations = 0;
+
+        ~ThreadCache();
+
+        void* Allocate(uint32 index)
+        {
+            FreeList& list = lists[index];
+            if (!list.head)
+                Refill(index);
+
+            void* block = list.Pop();
+            if (block)
+            {
+                ++hits;
+                bytesRetained -= GetClassSize(index);
+            }
+            else
+                ++misses;
+
+            Tick();
+            return block;
+        }
+
+        void Deallocate(uint32 index, void* ptr)
+        {
+            FreeList& list = lists[index];
+            list.Push(ptr);
+            bytesRetained += GetClassSize(index);
+
+            if (list.count > GetMaxThreadBlocks(index))
+            {
+                FlushStats();                               // retained bytes must be published before the depot may free them
+                ReleaseToDepot(index, list, list.count / 2);
+            }
+
+            Tick();
+        }
+
+        // takes half a thread cache worth of blocks from the depot
+        void Refill(uint32 index)
+        {
+            Depot& depot = GetDepot();
+            std::lock_guard<std::mutex> guard(depot.lock[index]);
+            FreeList& from = depot.lists[index];
+            for (uint32 count = GetMaxThreadBlocks(index) / 2; count && from.head; --count)
+                lists[index].Push(from.Pop());
+        }
+
+        void Tick()
+        {
+            if (++operations >= STATS_FLUSH_INTERVAL)
+                FlushStats();
+        }
+
+        void FlushStats()
+        {
+            s_hits.fetch_add(hits, std::memory_order_relaxed);
+            s_misses.fetch_add(misses, std::memory_order_relaxed);
+            s_oversized.fetch_add(oversized, std::memory_order_relaxed);
+            s_bytesRetained.fetch_add(bytesRetained, std::memory_order_relaxed);
+            hits = misses = oversized = 0;
+            bytesRetained = 0;
+            operations = 0;
+        }
+    };
+
+    // trivially destructible, so it can be checked by frees done after the thread cache is gone
+    thread_local bool t_cacheDestroyed = false;
+    thread_local ThreadCache t_cache;
+
+    ThreadCache::~ThreadCache()
+    {
+        FlushStats();
+        for (uint32 index = 0; index < BUFFER_POOL_CLASSES; ++index)
+            ReleaseToDepot(index, lists[index], lists[index].count);
+
+        t_cacheDestroyed = true;
+    }
+}
+
+void* BufferPool::Allocate(size_t size)
+{
+    int32 index = GetClass(size);
+    if (index < 0)
+    {
+        if (!t_cacheDestroyed)
+        {
+            ++t_cache.oversized;
+            t_cache.Tick();
+        }
+        else
+            s_oversized.fetch_add(1, std::memory_order_relaxed);
+
+        return ::operator new(size);
+    }
+
+    if (!t_cacheDestroyed)
+    {
+        if (void* block = t_cache.Allocate(index))
+            return block;
+    }
+    else if (void* block = AllocateFromDepot(index))
+    {
+        s_hits.fetch_add(1, std::memory_order_relaxed);
+        s_bytesRetained.fetch_sub(GetClassSize(index), std::memory_order_relaxed);
+        return block;
+    }
+    else
+        s_misses.fetch_add(1, std::memory_order_relaxed);
+
+    return ::operator new(GetClassSize(index));
+}
+
+void BufferPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    int32 index = GetClass(size);
+    if (index < 0)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    if (!t_cacheDestroyed)
+    {
+        t_cache.Deallocate(index, ptr);
+        return;
+    }
+
+    s_bytesRetained.fetch_add(GetClassSize(index), std::memory_order_relaxed);
+    FreeList block;
+    block.Push(ptr);
+    ReleaseToDepot(index, block, 1);
+}
+
+BufferPool::Stats BufferPool::GetStats()
+{
+    Stats stats;
+    stats.hits = s_hits.load(std::memory_order_relaxed);
+    stats.misses = s_misses.load(std::memory_order_relaxed);
+    stats.oversized = s_oversized.load(std::memory_order_relaxed);
+    stats.bytesRetained = s_bytesRetained.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BUFFERPOOL_H
+#define _BUFFERPOOL_H
+
+#include "Common.h"
+
+#include <cstddef>
+
+/**
+ * Size classed memory pool for packet buffers and packet objects.
+ *
+ * Blocks are rounded up to a power of two between BUFFER_POOL_MIN_BLOCK and BUFFER_POOL_MAX_BLOCK,
+ * bigger requests go to the global allocator. Freed blocks are kept in a cache of the freeing thread,
+ * a full thread cache hands half of its blocks to a shared depot where other threads refill from,
+ * so buffers built in map threads and freed in the network thread are reused.
+ */
+namespace BufferPool
+{
+    enum
+    {
+        BUFFER_POOL_MIN_BLOCK   = 32,
+        BUFFER_POOL_MAX_BLOCK   = 16 * 1024,
+        BUFFER_POOL_CLASSES     = 10,                       // 32 << 9 == 16k
+    };
+
+    struct Stats
+    {
+        uint64 hits;                                        // allocations served from a thread cache or the depot
+        uint64 misses;                                      // allocations done by the global allocator
+        uint64 oversized;                                   // requests bigger than the biggest class
+        int64 bytesRetained;                                // free blocks kept by thread caches and the depot
+    };
+
+    void* Allocate(size_t size);
+    void Deallocate(void* ptr, size_t size);
+
+    // counters of thread caches are published in batches, so recent operations may be missing
+    Stats GetStats();
+}
+
+/// std allocator drawing from BufferPool, used for ByteBuffer storage
+template<typename T>
+class BufferPoolAllocator
+{
+    public:
+        typedef T value_type;
+
+        BufferPoolAllocator() noexcept {}
+        template<typename U>
+        BufferPoolAllocator(BufferPoolAllocator<U> const&) noexcept {}
+
+        T* allocate(size_t n) { return static_cast<T*>(BufferPool::Allocate(n * sizeof(T))); }
+        void deallocate(T* ptr, size_t n) noexcept { BufferPool::Deallocate(ptr, n * sizeof(T)); }
+
+        template<typename U>
+        bool operator==(BufferPoolAllocator<U> const&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(BufferPoolAllocator<U> const&) const noexcept { return false; }
+};
+
+#endif
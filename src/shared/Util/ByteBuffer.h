@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Util/ByteConverter.h"
+#include "Util/BufferPool.h"
 #include <utf8.h>
 
 class ByteBufferException
@@ -467,7 +468,7 @@ class ByteBuffer
         }
 
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        std::vector<uint8, BufferPoolAllocator<uint8>> _storage;
 
         static constexpr size_t s_defaultSize = 0x1000;
 };
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/FrameArena.h"
+
+#include <new>
+
+namespace
+{
+    size_t const FRAME_ARENA_CHUNK_SIZE = 64 * 1024;
+    size_t const FRAME_ARENA_MAX_CHUNKS = 16;               // kept over frames, more are freed at reset
+
+    thread_local FrameArena t_frameArena;
+}
+
+thread_local FrameArena* FrameArena::s_active = nullptr;
+
+FrameArena::~FrameArena()
+{
+    Reset();
+    for (Chunk& chunk : m_chunks)
+        ::operator delete(chunk.data);
+}
+
+void* FrameArena::Allocate(size_t size, size_t align)
+{
+    // big requests get a chunk of their own, so they do not waste the rest of a regular chunk
+    if (size > FRAME_ARENA_CHUNK_SIZE / 4)
+    {
+        Chunk chunk = { static_cast<char*>(::operator new(size)), size };
+        m_oversized.push_back(chunk);
+        return chunk.data;
+    }
+
+    while (true)
+    {
+        if (m_current < m_chunks.size())
+        {
+            Chunk& chunk = m_chunks[m_current];
+            size_t offset = (m_offset + align - 1) & ~(align - 1);
+            if (offset + size <= chunk.size)
+            {
+                m_offset = offset + size;
+                return chunk.data + offset;
+            }
+
+            ++m_current;
+            m_offset = 0;
+            continue;
+        }
+
+        Chunk chunk = { static_cast<char*>(::operator new(FRAME_ARENA_CHUNK_SIZE)), FRAME_ARENA_CHUNK_SIZE };
+        m_chunks.push_back(chunk);
+    }
+}
+
+void FrameArena::Reset()
+{
+    for (Chunk& chunk : m_oversized)
+        ::operator delete(chunk.data);
+    m_oversized.clear();
+
+    while (m_chunks.size() > FRAME_ARENA_MAX_CHUNKS)
+    {
+        ::operator delete(m_chunks.back().data);
+        m_chunks.pop_back();
+    }
+
+    m_current = 0;
+    m_offset = 0;
+}
+
+FrameArenaScope::FrameArenaScope() : m_outermost(!FrameArena::s_active)
+{
+    if (m_outermost)
+        FrameArena::s_active = &t_frameArena;
+}
+
+FrameArenaScope::~FrameArenaScope()
+{
+    if (m_outermost)
+    {
+        FrameArena::s_active->Reset();
+        FrameArena::s_active = nullptr;
+    }
+}
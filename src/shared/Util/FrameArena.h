@@ -0,0 +1,129 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _FRAMEARENA_H
+#define _FRAMEARENA_H
+
+#include "Common.h"
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Bump allocator for temporaries of one update frame (one map update) of a thread.
+ *
+ * Memory is handed out from big chunks and never freed on its own, the whole arena is rewound when
+ * the outermost FrameArenaScope of the thread ends. Chunks are kept for the next frame.
+ */
+class FrameArena
+{
+    public:
+        FrameArena() : m_current(0), m_offset(0) {}
+        ~FrameArena();
+
+        FrameArena(FrameArena const&) = delete;
+        FrameArena& operator=(FrameArena const&) = delete;
+
+        void* Allocate(size_t size, size_t align);
+        void Reset();
+
+        // arena of the frame running in this thread, nullptr outside of any FrameArenaScope
+        static FrameArena* GetActive() { return s_active; }
+
+    private:
+        friend class FrameArenaScope;
+
+        struct Chunk
+        {
+            char* data;
+            size_t size;
+        };
+
+        std::vector<Chunk> m_chunks;                        // regular chunks, reused every frame
+        std::vector<Chunk> m_oversized;                     // single big allocations, freed at reset
+        size_t m_current;                                   // chunk allocated from
+        size_t m_offset;                                    // first free byte in the current chunk
+
+        static thread_local FrameArena* s_active;
+};
+
+/// Makes the frame arena of the thread active, the outermost scope rewinds it when it ends
+class FrameArenaScope
+{
+    public:
+        FrameArenaScope();
+        ~FrameArenaScope();
+
+        FrameArenaScope(FrameArenaScope const&) = delete;
+        FrameArenaScope& operator=(FrameArenaScope const&) = delete;
+
+    private:
+        bool m_outermost;
+};
+
+/**
+ * Allocator taking memory from the frame arena active at container construction, or from the heap
+ * when there is none. Containers using it must not outlive the scope they are created in.
+ */
+template<typename T>
+class FrameAllocator
+{
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        FrameAllocator() noexcept : m_arena(FrameArena::GetActive()) {}
+        template<typename U>
+        FrameAllocator(FrameAllocator<U> const& other) noexcept : m_arena(other.GetArena()) {}
+
+        T* allocate(size_t n)
+        {
+            if (m_arena)
+                return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t /*n*/) noexcept
+        {
+            if (!m_arena)
+                ::operator delete(ptr);
+        }
+
+        FrameArena* GetArena() const { return m_arena; }
+
+        template<typename U>
+        bool operator==(FrameAllocator<U> const& other) const noexcept { return m_arena == other.GetArena(); }
+        template<typename U>
+        bool operator!=(FrameAllocator<U> const& other) const noexcept { return m_arena != other.GetArena(); }
+
+    private:
+        FrameArena* m_arena;
+};
+
+template<typename T>
+using FrameUnorderedSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, FrameAllocator<T>>;
+
+template<typename K, typename V>
+using FrameUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, FrameAllocator<std::pair<const K, V>>>;
+
+#endif
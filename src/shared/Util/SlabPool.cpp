@@ -0,0 +1,223 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/SlabPool.h"
+
+#include <new>
+
+namespace
+{
+    uint32 const THREAD_CACHE_OBJECTS   = 64;               // per pool, object size and thread
+    size_t const SLAB_OBJECT_ALIGN      = 16;
+
+    std::atomic<SlabPool*> s_pools[SlabPool::SLAB_POOL_MAX_POOLS];
+    std::atomic<uint32> s_poolCount(0);
+
+    inline size_t GetStride(size_t size) { return (size + SLAB_OBJECT_ALIGN - 1) & ~(SLAB_OBJECT_ALIGN - 1); }
+}
+
+void SlabPool::FreeList::Push(void* ptr)
+{
+    FreeObject* object = static_cast<FreeObject*>(ptr);
+    object->next = head;
+    head = object;
+    ++count;
+}
+
+void* SlabPool::FreeList::Pop()
+{
+    FreeObject* object = head;
+    if (object)
+    {
+        head = object->next;
+        --count;
+    }
+    return object;
+}
+
+struct SlabThreadCache
+{
+    SlabPool::FreeList lists[SlabPool::SLAB_POOL_MAX_POOLS][SlabPool::SLAB_POOL_MAX_SIZES];
+
+    ~SlabThreadCache();
+};
+
+namespace
+{
+    // trivially destructible, so it can be checked by frees done after the thread cache is gone
+    thread_local bool t_slabCacheDestroyed = false;
+    thread_local SlabThreadCache t_slabCache;
+}
+
+SlabThreadCache::~SlabThreadCache()
+{
+    uint32 poolCount = s_poolCount.load(std::memory_order_acquire);
+    for (uint32 id = 0; id < poolCount && id < SlabPool::SLAB_POOL_MAX_POOLS; ++id)
+        if (SlabPool* pool = s_pools[id].load(std::memory_order_acquire))
+            for (uint32 sizeClass = 0; sizeClass < SlabPool::SLAB_POOL_MAX_SIZES; ++sizeClass)
+                if (lists[id][sizeClass].count)
+                    pool->Release(sizeClass, lists[id][sizeClass], lists[id][sizeClass].count);
+
+    t_slabCacheDestroyed = true;
+}
+
+SlabPool::SlabPool(char const* name, uint32 objectsPerSlab) :
+    m_name(name), m_objectsPerSlab(objectsPerSlab ? objectsPerSlab : 1), m_live(0), m_capacity(0), m_bytes(0)
+{
+    for (auto& size : m_sizes)
+        size = 0;
+
+    // pools beyond the limit work without thread caches
+    m_id = s_poolCount.fetch_add(1);
+    if (m_id < SLAB_POOL_MAX_POOLS)
+        s_pools[m_id].store(this, std::memory_order_release);
+}
+
+int32 SlabPool::FindSizeClass(size_t size) const
+{
+    for (uint32 i = 0; i < SLAB_POOL_MAX_SIZES; ++i)
+    {
+        size_t classSize = m_sizes[i].load(std::memory_order_acquire);
+        if (classSize == size)
+            return i;
+        if (!classSize)
+            break;
+    }
+    return -1;
+}
+
+int32 SlabPool::GetSizeClass(size_t size)
+{
+    int32 sizeClass = FindSizeClass(size);
+    if (sizeClass >= 0)
+        return sizeClass;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (uint32 i = 0; i < SLAB_POOL_MAX_SIZES; ++i)
+    {
+        size_t classSize = m_sizes[i].load(std::memory_order_relaxed);
+        if (classSize == size)
+            return i;
+        if (!classSize)
+        {
+            m_sizes[i].store(size, std::memory_order_release);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void SlabPool::Refill(uint32 sizeClass, FreeList& list)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    FreeList& from = m_free[sizeClass];
+    if (!from.head)
+    {
+        size_t stride = GetStride(m_sizes[sizeClass].load(std::memory_order_relaxed));
+        char* slab = static_cast<char*>(::operator new(stride * m_objectsPerSlab));
+        // pushed backwards, so objects are handed out in address order
+        for (uint32 i = m_objectsPerSlab; i > 0; --i)
+            from.Push(slab + (i - 1) * stride);
+
+        m_capacity.fetch_add(m_objectsPerSlab, std::memory_order_relaxed);
+        m_bytes.fetch_add(stride * m_objectsPerSlab, std::memory_order_relaxed);
+    }
+
+    for (uint32 count = THREAD_CACHE_OBJECTS / 2; count && from.head; --count)
+        list.Push(from.Pop());
+}
+
+void SlabPool::Release(uint32 sizeClass, FreeList& list, uint32 count)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (; count && list.head; --count)
+        m_free[sizeClass].Push(list.Pop());
+}
+
+void* SlabPool::Allocate(size_t size)
+{
+    int32 sizeClass = GetSizeClass(size);
+    if (sizeClass < 0)
+        return ::operator new(size);
+
+    m_live.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_id < SLAB_POOL_MAX_POOLS && !t_slabCacheDestroyed)
+    {
+        FreeList& list = t_slabCache.lists[m_id][sizeClass];
+        if (!list.head)
+            Refill(sizeClass, list);
+        return list.Pop();
+    }
+
+    FreeList single;
+    Refill(sizeClass, single);
+    void* ptr = single.Pop();
+    Release(sizeClass, single, single.count);
+    return ptr;
+}
+
+void SlabPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    int32 sizeClass = FindSizeClass(size);
+    if (sizeClass < 0)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    m_live.fetch_sub(1, std::memory_order_relaxed);
+
+    if (m_id < SLAB_POOL_MAX_POOLS && !t_slabCacheDestroyed)
+    {
+        FreeList& list = t_slabCache.lists[m_id][sizeClass];
+        list.Push(ptr);
+        if (list.count > THREAD_CACHE_OBJECTS)
+            Release(sizeClass, list, THREAD_CACHE_OBJECTS / 2);
+        return;
+    }
+
+    FreeList single;
+    single.Push(ptr);
+    Release(sizeClass, single, 1);
+}
+
+SlabPool::Stats SlabPool::GetStats() const
+{
+    Stats stats;
+    stats.name = m_name;
+    int64 live = m_live.load(std::memory_order_relaxed);
+    stats.live = live > 0 ? uint64(live) : 0;
+    uint64 capacity = m_capacity.load(std::memory_order_relaxed);
+    stats.free = capacity > stats.live ? capacity - stats.live : 0;
+    stats.bytes = m_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<SlabPool::Stats> SlabPool::GetAllStats()
+{
+    std::vector<Stats> stats;
+    uint32 poolCount = s_poolCount.load(std::memory_order_acquire);
+    for (uint32 id = 0; id < poolCount && id < SLAB_POOL_MAX_POOLS; ++id)
+        if (SlabPool* pool = s_pools[id].load(std::memory_order_acquire))
+            stats.push_back(pool->GetStats());
+    return stats;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SLABPOOL_H
+#define _SLABPOOL_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * Object pool of one class hierarchy, used by its class operator new and delete.
+ *
+ * Objects of one size are carved from slabs holding many of them, so objects of a type stay together.
+ * Every object size (derived classes) gets its own slabs, sizes beyond SLAB_POOL_MAX_SIZES go to the
+ * global allocator. Freed objects are kept in a cache of the freeing thread (map update threads) and
+ * move to the pool in batches. Slabs are never released, the pool keeps the peak amount of objects.
+ */
+class SlabPool
+{
+    public:
+        enum
+        {
+            SLAB_POOL_MAX_POOLS     = 16,
+            SLAB_POOL_MAX_SIZES     = 16,
+        };
+
+        struct Stats
+        {
+            char const* name;
+            uint64 live;                                    // allocated objects
+            uint64 free;                                    // carved objects not in use
+            uint64 bytes;                                   // memory of all slabs
+        };
+
+        // pools are meant to live until exit, create them with new
+        SlabPool(char const* name, uint32 objectsPerSlab);
+
+        void* Allocate(size_t size);
+        void Deallocate(void* ptr, size_t size);
+
+        Stats GetStats() const;
+        static std::vector<Stats> GetAllStats();
+
+    private:
+        friend struct SlabThreadCache;
+
+        struct FreeObject
+        {
+            FreeObject* next;
+        };
+
+        struct FreeList
+        {
+            FreeObject* head = nullptr;
+            uint32 count = 0;
+
+            void Push(void* ptr);
+            void* Pop();
+        };
+
+        int32 FindSizeClass(size_t size) const;
+        int32 GetSizeClass(size_t size);
+        void Refill(uint32 sizeClass, FreeList& list);
+        void Release(uint32 sizeClass, FreeList& list, uint32 count);
+
+        char const* m_name;
+        uint32 m_id;
+        uint32 m_objectsPerSlab;
+
+        std::mutex m_lock;                                  // guards m_free and size registration
+        std::atomic<size_t> m_sizes[SLAB_POOL_MAX_SIZES];   // object size of each class, 0 for unused ones
+        FreeList m_free[SLAB_POOL_MAX_SIZES];
+
+        std::atomic<int64> m_live;
+        std::atomic<uint64> m_capacity;
+        std::atomic<uint64> m_bytes;
+};
+
+#endif
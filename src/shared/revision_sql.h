@@ -3,5 +3,5 @@
  #define REVISION_DB_REALMD "required_14064_01_realmd_platform"
  #define REVISION_DB_LOGS "required_14039_01_logs_anticheat"
  #define REVISION_DB_CHARACTERS "required_14061_01_characters_fishingSteps"
- #define REVISION_DB_MANGOS "required_14082_01_mangos_spell_template"
+ #define REVISION_DB_MANGOS "required_14086_01_mangos_table_change_counter"
 #endif // __REVISION_SQL_H__